@@ -0,0 +1,191 @@
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "cards/cards.h"
+#include "game_engine/game_engine.h"
+#include "map/map.h"
+#include "orders/orders.h"
+#include "player/player.h"
+#include "player_strategy/PlayerStrategies.h"
+
+using namespace std;
+
+// Measures the memory held by one game: a generated map with its continents, the players with their territories,
+// hands and orders, and the commands that issued those orders. Every allocation of the program goes through the
+// operators below, so the numbers include the containers and the strings of every entity.
+
+namespace {
+    // The number of bytes currently allocated and the number of allocations made.
+    std::atomic<size_t> liveBytes{0};
+    std::atomic<size_t> allocationCount{0};
+
+    // The size of each block is stored in front of it, so that operator delete knows how much is released.
+    constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    void *countedAllocate(size_t size) {
+        void *block = std::malloc(size + HEADER_SIZE);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        *static_cast<size_t *>(block) = size;
+        liveBytes += size;
+        allocationCount++;
+        return static_cast<char *>(block) + HEADER_SIZE;
+    }
+
+    void countedRelease(void *pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        void *block = static_cast<char *>(pointer) - HEADER_SIZE;
+        liveBytes -= *static_cast<size_t *>(block);
+        std::free(block);
+    }
+}
+
+void *operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void *operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    countedRelease(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    countedRelease(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    countedRelease(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    countedRelease(pointer);
+}
+
+namespace {
+    // The memory held by one game.
+    struct Footprint {
+        int numTerritories;
+        size_t bytes;
+        size_t allocations;
+    };
+
+    // Number of players, territories per continent and territories per row of the generated maps.
+    constexpr int NUM_PLAYERS = 6;
+    constexpr int TERRITORIES_PER_CONTINENT = 100;
+    constexpr int MAP_WIDTH = 100;
+
+    // Every player holds a full hand and issues one order for every ORDERS_PER_TERRITORY territories it owns.
+    constexpr int CARDS_PER_PLAYER = 5;
+    constexpr int ORDERS_PER_TERRITORY = 4;
+
+    // Builds a map shaped as a grid, where every territory borders the territories next to it on its row and column.
+    Map *buildGridMap(int numTerritories) {
+        Map *map = new Map("benchmark");
+        int numContinents = (numTerritories + TERRITORIES_PER_CONTINENT - 1) / TERRITORIES_PER_CONTINENT;
+        for (int id = 1; id <= numContinents; id++) {
+            map->addContinent(new Continent("continent-" + to_string(id), "white", 5));
+        }
+
+        for (int id = 1; id <= numTerritories; id++) {
+            int continentId = (id - 1) / TERRITORIES_PER_CONTINENT + 1;
+            auto *territory = new Territory(id, "territory-" + to_string(id), (id - 1) % MAP_WIDTH,
+                                            (id - 1) / MAP_WIDTH, continentId);
+            territory->setNumberOfArmies(3);
+            map->addTerritory(territory);
+            map->getContinentByID(continentId)->addTerritory(territory);
+        }
+
+        for (int id = 1; id <= numTerritories; id++) {
+            if (id % MAP_WIDTH != 0 && id < numTerritories) {
+                map->addEdge(id, id + 1);
+                map->addEdge(id + 1, id);
+            }
+            if (id + MAP_WIDTH <= numTerritories) {
+                map->addEdge(id, id + MAP_WIDTH);
+                map->addEdge(id + MAP_WIDTH, id);
+            }
+        }
+        return map;
+    }
+
+    // Builds one game on a map of the given size, measures what it holds, then releases it.
+    Footprint measureGame(int numTerritories) {
+        size_t bytesBefore = liveBytes;
+        size_t allocationsBefore = allocationCount;
+
+        Map *map = buildGridMap(numTerritories);
+        AggressivePlayerStrategy strategy;
+        vector<Player *> players;
+        for (int i = 0; i < NUM_PLAYERS; i++) {
+            players.push_back(new Player("player-" + to_string(i + 1), &strategy));
+        }
+        for (int id = 1; id <= numTerritories; id++) {
+            players[(id - 1) % NUM_PLAYERS]->acquireTerritory(map->getTerritoryByID(id));
+        }
+
+        Deck deck(NUM_PLAYERS * CARDS_PER_PLAYER);
+        vector<Command *> commands;
+        for (Player *player: players) {
+            for (int i = 0; i < CARDS_PER_PLAYER; i++) {
+                deck.draw(*player->getHand());
+            }
+            vector<Territory *> &territories = *player->getTerritories();
+            for (size_t i = 0; i < territories.size(); i += ORDERS_PER_TERRITORY) {
+                player->getOrdersList()->addOrder(new Deploy(*player, *territories[i], 1));
+                auto *command = new Command("issueorder " + to_string(player->getOrdersList()->getOrders()->size()));
+                command->addCommandArg("issueorder");
+                command->addCommandArg(to_string(player->getOrdersList()->getOrders()->size()));
+                commands.push_back(command);
+            }
+        }
+
+        Footprint footprint{numTerritories, liveBytes - bytesBefore, allocationCount - allocationsBefore};
+
+        // Release the game. The deck and the strategy go out of scope with this function.
+        for (Command *command: commands) {
+            delete command;
+        }
+        for (Player *player: players) {
+            delete player;
+        }
+        for (int id = 1; id <= numTerritories; id++) {
+            delete map->getTerritoryByID(id);
+        }
+        for (unsigned int id = 1; id <= map->getContinentsSize(); id++) {
+            delete map->getContinentByID(static_cast<int>(id));
+        }
+        delete map;
+        return footprint;
+    }
+
+    // Prints the memory held by one game.
+    void printFootprint(const Footprint &footprint) {
+        cout << setw(12) << footprint.numTerritories
+             << setw(16) << footprint.bytes
+             << setw(16) << footprint.allocations
+             << setw(22) << fixed << setprecision(1)
+             << static_cast<double>(footprint.bytes) / footprint.numTerritories << endl;
+    }
+}
+
+int main() {
+    cout << "Memory footprint of one game (" << NUM_PLAYERS << " players, " << CARDS_PER_PLAYER
+         << " cards each, one deploy order per " << ORDERS_PER_TERRITORY << " owned territories)" << endl;
+    cout << setw(12) << "territories" << setw(16) << "bytes" << setw(16) << "allocations"
+         << setw(22) << "bytes per territory" << endl;
+
+    for (int numTerritories: {10000, 100000}) {
+        printFootprint(measureGame(numTerritories));
+    }
+    return 0;
+}
@@ -1,4 +1,7 @@
 #include "cards.h"
+#include "player/player.h"
+#include <type_traits>
+#include "game_state/game_random.h"
 #include <ctime>
 #include <algorithm>
 using namespace std;
@@ -8,61 +11,49 @@ using namespace std;
 //---Implementation of the Card class---
 
 // Default constructor of the Card class which initializes a card type
-Card::Card() {
-    type = new Type(static_cast<Type>(rand() % 5));
-}
+Card::Card() : type(static_cast<Type>(GameRandom::current().nextInt(5))) {}
 
 // Constructor with a card type as the only parameter
-Card::Card(const Type& cardType) {
-    type = new Type(cardType);
-}
+Card::Card(const Type& cardType) : type(cardType) {}
 
 // Copy constructor
-Card::Card(const Card &card) {
-    this->type = new Type(*card.type);
-}
+Card::Card(const Card &card) = default;
 
 // Assignment operator
-Card& Card::operator=(const Card& card) {
-    if(this != &card) {
-        delete this->type;
-        this->type = new Type(*(card.type));
-    }
-    return *this;
-}
+Card& Card::operator=(const Card& card) = default;
 
 // Stream insertion operator
 ostream& operator << (ostream& os, const Card &c){
-    return os << "The card type is: " << *c.type << endl;
+    return os << "The card type is: " << c.type << endl;
 }
 
 // This function overrides the equality operator for two cards. Cards are considered equal if they have the same type
 bool operator == (const Card &c1, const Card &c2){
-    if(*c1.type == *c2.type)
-        return true;
-    return false;
+    return c1.type == c2.type;
 }
 
 // Destructor
-Card::~Card() {
-    delete type;
-    type = nullptr;
-}
+Card::~Card() = default;
 
-// Getter for card type, returns a pointer of Type
-Type* Card::getType() const {
+// Getter for card type
+Type Card::getType() const {
     return type;
 }
 
 // Setter for card type
 void Card::setType(const Type& card_type) {
-    this->type = new Type(card_type);
+    this->type = card_type;
 }
 
 // This function creates an order of the current card and adds it to a list of orders which is a parameter passed by reference.
 // Then, it removes the card that was played from the hand which is a parameter passed by reference
 // Finally, it adds the same card to the deck
-void Card::play(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
+void Card::play(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo) {
+    playAsync(deck, player, orderInfo, InputChannel::console()).get();
+}
+
+Task<void> Card::playAsync(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo,
+                           InputChannel &input) {
 
     // Create references for the content of the hand cards and the content of the card being played
     vector<Card *> *hand_cards = player.getHand()->getHandsCards();
@@ -75,7 +66,7 @@ void Card::play(Deck &deck, Player &player, tuple<Territory *, Territory *, stri
     if (it != hand_cards->end()) {
         cout << "Card found!" << endl;
         // Put the created order in the list of orders
-        player.issueOrder(orderInfo, log);
+        co_await player.issueOrderAsync(orderInfo, input);
         hand_cards->erase(it);
         deck.getWarzoneCards()->insert(deck.getWarzoneCards()->begin(), card_address);
     } else {
@@ -86,51 +77,58 @@ void Card::play(Deck &deck, Player &player, tuple<Territory *, Territory *, stri
 //---Implementation of the Deck class---
 
 // Default constructor of the Deck class which initializes an empty vector of Card
-Deck::Deck() {
-    this->warzoneCards = new vector<Card*>();
-}
+Deck::Deck() = default;
 
 // Constructor with a vector of Card as the only parameter
-Deck::Deck(const vector<Card*> &cards) {
-    this->warzoneCards = new vector<Card*>(cards);
-}
+Deck::Deck(const vector<Card*> &cards) : warzoneCards(cards) {}
 
 // Constructor with the number of cards as the only parameter
 Deck::Deck(const int numOfCards) {
-    this->warzoneCards = new vector<Card*>();
+    this->warzoneCards.reserve(numOfCards);
     for(auto i = 0; i < numOfCards; i ++){
-        this->warzoneCards->emplace_back(new Card());
+        this->warzoneCards.emplace_back(new Card());
     }
 }
 
 // Copy constructor
 Deck::Deck(const Deck &deck) {
-    for(int i = 0; i < deck.getWarzoneCards()->size(); i++) {
-        Card* c = new Card(*(deck.warzoneCards->at(i)));
-        this->warzoneCards->emplace_back(c);
+    this->warzoneCards.reserve(deck.warzoneCards.size());
+    for (Card* card : deck.warzoneCards) {
+        this->warzoneCards.emplace_back(new Card(*card));
     }
 }
 
+// Move constructor, which takes the cards of the given deck and leaves it empty
+Deck::Deck(Deck &&deck) noexcept : warzoneCards(std::move(deck.warzoneCards)) {
+    deck.warzoneCards.clear();
+}
+
+static_assert(std::is_nothrow_move_constructible_v<Deck>, "Decks must be relocated without copies");
+
 // Assignment operator
 Deck& Deck::operator=(const Deck& deck) {
     if(this != &deck){
-        // remove all cards in left hand side in case there are values
-        for(int index = 0; index < this->warzoneCards->size(); index++){
-            this->warzoneCards->pop_back();
-        }
-        // add all cards from right hand side into left side
-        for(int i = 0; i < deck.warzoneCards->size(); i++){
-            Card* c = new Card(*(deck.warzoneCards->at(i)));
-            this->warzoneCards->emplace_back(c);
+        *this = Deck(deck);
+    }
+    return *this;
+}
+
+// Move assignment operator, which releases the cards of this deck and takes the cards of the given deck
+Deck& Deck::operator=(Deck&& deck) noexcept {
+    if(this != &deck){
+        for (Card* card : this->warzoneCards) {
+            delete card;
         }
+        this->warzoneCards = std::move(deck.warzoneCards);
+        deck.warzoneCards.clear();
     }
     return *this;
 }
 
 // Stream insertion operator for the Deck class
 ostream& operator << (ostream &os, const Deck& d){
-    os << "The deck contains " << d.warzoneCards->size() << " cards: " << endl;
-    for(Card* card : *d.getWarzoneCards()){
+    os << "The deck contains " << d.warzoneCards.size() << " cards: " << endl;
+    for(Card* card : d.warzoneCards){
         os << *card;
     }
     return os;
@@ -139,80 +137,96 @@ ostream& operator << (ostream &os, const Deck& d){
 // Destructor for the Deck class
 Deck::~Deck() {
     // delete each card on the heap
-    for (Card* card : *this->warzoneCards){
+    for (Card* card : this->warzoneCards){
         delete card;
     }
-    this->warzoneCards->clear(); // delete all card pointers
-    delete this->warzoneCards;
-    this->warzoneCards = nullptr;
 }
 
 // Getter for the cards in the deck
-vector<Card*>* Deck::getWarzoneCards() const {
-    return this->warzoneCards;
+vector<Card*>* Deck::getWarzoneCards() {
+    return &this->warzoneCards;
+}
+
+// Getter for the cards of a const deck
+const vector<Card*>* Deck::getWarzoneCards() const {
+    return &this->warzoneCards;
 }
 
 // Setter for the cards in the deck
 void Deck::setDeckCards(const vector<Card*> &cards) {
-    this->warzoneCards = new vector<Card*>(cards);
+    this->warzoneCards = cards;
 }
 
 // This function allows a player to draw a card from the deck and to put it in their hand
-void Deck::draw(const Hand &hand) {
-    int lastElementPosition = this->warzoneCards->size() - 1;
-    Card *card = this->warzoneCards->back();
-    cout << "Size of deck: " << this->warzoneCards->size() << endl;
-    cout << "Card Type from back of deck: " << *card->getType() << endl;
+void Deck::draw(Hand &hand) {
+    Card *card = this->warzoneCards.back();
+    cout << "Size of deck: " << this->warzoneCards.size() << endl;
+    cout << "Card Type from back of deck: " << card->getType() << endl;
 
     hand.getHandsCards()->emplace_back(card); // put deck card in hand
-    this->warzoneCards->erase(this->warzoneCards->begin() + lastElementPosition); // erase last pointer
+    this->warzoneCards.pop_back(); // erase last pointer
 }
 
-void Deck::setDeck(const Deck &deck) {
-    delete warzoneCards;
-    warzoneCards = deck.warzoneCards;
+// Replaces the cards of this deck by the cards of the given deck, which is left empty
+void Deck::setDeck(Deck &&deck) {
+    *this = std::move(deck);
 }
 
 //---Implementation of the Hand class---
 
 // Default constructor for the Hand method which initializes an empty vector of Card
-Hand::Hand() {
-    handsCards = new vector<Card *>();
-}
+Hand::Hand() = default;
 
 // Constructor with a vector of Card as the only parameter
-Hand::Hand(const vector<Card *> &cards) {
-    handsCards = new vector<Card*>(cards);
-}
+Hand::Hand(const vector<Card *> &cards) : handsCards(cards) {}
 
 // Copy constructor
-Hand::Hand(const Hand &hand):Hand() {
-    for(int i = 0; i < hand.getHandsCards()->size(); i++) {
-        Card* c = new Card(*(hand.handsCards->at(i)));
-        this->handsCards->emplace_back(c);
+Hand::Hand(const Hand &hand) {
+    this->handsCards.reserve(hand.handsCards.size());
+    for (Card* card : hand.handsCards) {
+        this->handsCards.emplace_back(new Card(*card));
     }
 }
 
+// Move constructor, which takes the cards of the given hand and leaves it empty
+Hand::Hand(Hand &&hand) noexcept : handsCards(std::move(hand.handsCards)) {
+    hand.handsCards.clear();
+}
+
+static_assert(std::is_nothrow_move_constructible_v<Hand>, "Hands must be relocated without copies");
+
 // Assignment operator
 Hand& Hand::operator=(const Hand& hand) {
     if(this != &hand){
         // Delete all cards in left hand side in case there are already members
-        for(int index = 0; index < this->handsCards->size(); index++) {
-            this->handsCards->pop_back();
+        for (Card* card : this->handsCards) {
+            delete card;
         }
+        this->handsCards.clear();
         // add all cards from right hand side to left hand side
-        for (int i = 0 ; i < hand.getHandsCards()->size(); i++) {
-            Card* c = new Card(*(hand.handsCards->at(i)));
-            this->handsCards->emplace_back(c);
+        for (Card* card : hand.handsCards) {
+            this->handsCards.emplace_back(new Card(*card));
         }
     }
     return *this;
 }
 
+// Move assignment operator, which releases the cards of this hand and takes the cards of the given hand
+Hand& Hand::operator=(Hand&& hand) noexcept {
+    if(this != &hand){
+        for (Card* card : this->handsCards) {
+            delete card;
+        }
+        this->handsCards = std::move(hand.handsCards);
+        hand.handsCards.clear();
+    }
+    return *this;
+}
+
 // Stream insertion operator for the Hand class
 ostream& operator << (ostream &os, const Hand& h) {
-    os << "The hand contains " << h.handsCards->size() << " cards" << endl;
-    for(Card* card : *h.handsCards){
+    os << "The hand contains " << h.handsCards.size() << " cards" << endl;
+    for(Card* card : h.handsCards){
         os << *card << endl;
     }
     return os;
@@ -221,22 +235,24 @@ ostream& operator << (ostream &os, const Hand& h) {
 // Destructor
 Hand::~Hand() {
     // delete each card on the heap
-    for (Card* card : *this->handsCards){
+    for (Card* card : this->handsCards){
         delete card;
     }
-    this->handsCards->clear(); // delete all card pointers
-    delete this->handsCards;
-    this->handsCards = nullptr;
 }
 
 // Getter for handsCards
-vector<Card*>* Hand::getHandsCards() const {
-    return this->handsCards;
+vector<Card*>* Hand::getHandsCards() {
+    return &this->handsCards;
+}
+
+// Getter for the handsCards of a const hand
+const vector<Card*>* Hand::getHandsCards() const {
+    return &this->handsCards;
 }
 
 // Setter for handsCards
 void Hand::setHandCards(const vector<Card*> &cards) {
-    this->handsCards = new vector<Card*>(cards);
+    this->handsCards = cards;
 }
 
 void card_driver() {
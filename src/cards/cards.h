@@ -1,7 +1,8 @@
 #pragma once
 
 #include "orders/orders.h"
-#include "player/player.h"
+#include "concurrency/task.h"
+#include "command_processor/input_channel.h"
 #include <iostream>
 #include <vector>
 using namespace std;
@@ -22,13 +23,12 @@ class Card;
 class Player;
 class Order;
 class Territory;
-class LogObserver;
 
 // This class represents the cards that will be played during the game, they can each have one of the 5 types
 class Card {
 private:
-    // Initialization of type enum
-    Type *type;
+    // The type of the card
+    Type type;
 public:
     // Default constructor
     Card();
@@ -49,13 +49,17 @@ public:
     ~Card();
 
     // Getter for enum
-    [[nodiscard]] Type* getType() const;
+    [[nodiscard]] Type getType() const;
 
     // Setter for enum
     void setType(const Type& type);
 
     // A function which lets a player create orders. If a card has been played, remove it from the hands and put it back in the deck
-    void play(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log);
+    void play(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo);
+
+    // The same as play, for a player whose user may have to answer on the given input before the order is created
+    Task<void> playAsync(Deck &deck, Player &player, tuple<Territory *, Territory *, string> *orderInfo,
+                         InputChannel &input);
 
     // A function that checks if two objects are the same
     friend bool operator == (const Card &c1, const Card &c2);
@@ -65,7 +69,7 @@ public:
 class Hand {
 private:
     // Each player contains a finite amount of cards in their hand.
-    vector<Card*>* handsCards;
+    vector<Card*> handsCards;
 public:
     // Default constructor
     Hand();
@@ -76,9 +80,15 @@ public:
     // Copy constructor
     Hand(const Hand& hand);
 
+    // Move constructor
+    Hand(Hand&& hand) noexcept;
+
     // Assignment operator
     Hand& operator=(const Hand& hand);
 
+    // Move assignment operator
+    Hand& operator=(Hand&& hand) noexcept;
+
     // Insertion operator
     friend ostream& operator << (ostream& os, const Hand& h);
 
@@ -86,7 +96,10 @@ public:
     ~Hand();
 
     // Getter for handsCards
-    [[nodiscard]] vector<Card*>* getHandsCards() const;
+    [[nodiscard]] vector<Card*>* getHandsCards();
+
+    // Getter for the handsCards of a const hand
+    [[nodiscard]] const vector<Card*>* getHandsCards() const;
 
     // Setter for handsCards
     void setHandCards(const vector<Card*> &cards);
@@ -96,7 +109,7 @@ public:
 class Deck {
 private:
     // The deck contains a finite amount of cards
-    vector<Card*>* warzoneCards;
+    vector<Card*> warzoneCards;
 public:
     // Default constructor
     Deck();
@@ -110,9 +123,15 @@ public:
     // Copy constructor
     Deck(const Deck& deck);
 
+    // Move constructor
+    Deck(Deck&& deck) noexcept;
+
     // Assignment operator
     Deck& operator=(const Deck& deck);
 
+    // Move assignment operator
+    Deck& operator=(Deck&& deck) noexcept;
+
     // Insertion operator
     friend ostream &operator<<(ostream &os, const Deck &d);
 
@@ -120,15 +139,19 @@ public:
     ~Deck();
 
     // Getter for warzone cards
-    [[nodiscard]] vector<Card *> *getWarzoneCards() const;
+    [[nodiscard]] vector<Card *> *getWarzoneCards();
+
+    // Getter for the warzone cards of a const deck
+    [[nodiscard]] const vector<Card *> *getWarzoneCards() const;
 
     // Setter for warzone cards
     void setDeckCards(const vector<Card *> &cards);
 
-    void setDeck(const Deck &deck);
+    // Replaces the cards of the deck by the cards of the given deck
+    void setDeck(Deck &&deck);
 
     // A function which lets a player draw a card from the deck and places it in their hand
-    void draw(const Hand &hand);
+    void draw(Hand &hand);
 };
 
 void card_driver();
\ No newline at end of file
@@ -3,22 +3,13 @@
 #include <algorithm>
 #include "command_processing.h"
 
-#define CMD_DIR "../commands/"
-
 // One param constructor which creates a Command object with a string corresponding to the entire command entered by
 // the user or read from the file.
-Command::Command(const string &command) {
-    this->commandName = new string(command);
-    this->commandEffect = nullptr;
-    this->commandArgs = new vector<string *>();
-}
+Command::Command(const string &command) : commandName(command) {}
 
 // Copy constructor.
-Command::Command(const Command &cmd) {
-    this->commandName = new string(*cmd.commandName);
-    this->commandEffect = new string(*cmd.commandEffect);
-    this->commandArgs = new vector<string *>(*cmd.commandArgs);
-}
+Command::Command(const Command &cmd)
+        : commandName(cmd.commandName), commandEffect(cmd.commandEffect), commandArgs(cmd.commandArgs) {}
 
 // Swaps the member data between two Command objects.
 void Command::swap(Command &first, Command &second) {
@@ -28,11 +19,7 @@ void Command::swap(Command &first, Command &second) {
 }
 
 // Destructor.
-Command::~Command() {
-    delete commandName;
-    delete commandEffect;
-    delete commandArgs;
-}
+Command::~Command() = default;
 
 // Assignment operator.
 Command &Command::operator=(Command cmd) {
@@ -44,18 +31,18 @@ Command &Command::operator=(Command cmd) {
 std::ostream &operator<<(ostream &stream, const Command &cmd) {
     string effect = "Not executed yet";
 
-    if (cmd.commandEffect != nullptr) {
-        effect = *cmd.getCommandEffect();
+    if (!cmd.commandEffect.empty()) {
+        effect = cmd.commandEffect;
     }
 
-    stream << "----Command information----\nCommand Name: " << *cmd.getCommandName() << "\nCommand Effect: " << effect
+    stream << "----Command information----\nCommand Name: " << cmd.commandName << "\nCommand Effect: " << effect
            << "\nCommand Arguments:";
 
-    if (cmd.getCommandArgs()->empty()) {
+    if (cmd.commandArgs.empty()) {
         stream << " Not parsed yet";
     } else {
-        for (int i = 0; i < cmd.getCommandArgs()->size(); i++) {
-            stream << "\n" << " " << i + 1 << ": " << *cmd.getCommandArgs()->at(i);
+        for (int i = 0; i < cmd.commandArgs.size(); i++) {
+            stream << "\n" << " " << i + 1 << ": " << cmd.commandArgs[i];
         }
     }
 
@@ -63,37 +50,41 @@ std::ostream &operator<<(ostream &stream, const Command &cmd) {
 }
 
 // Getter for the command name.
-string *Command::getCommandName() const {
+const string &Command::getCommandName() const {
     return commandName;
 }
 
 // Getter for the command effect.
-string *Command::getCommandEffect() const {
+const string &Command::getCommandEffect() const {
     return commandEffect;
 }
 
 // Getter for the command arguments (keywords from the command).
-vector<string *> *Command::getCommandArgs() const {
+const vector<string> &Command::getCommandArgs() const {
     return commandArgs;
 }
 
+// Adds a keyword to the arguments of the command.
+void Command::addCommandArg(string_view arg) {
+    commandArgs.emplace_back(arg);
+}
+
 // Method which saves the effect of the command given a certain effect and given whether the command is valid or not.
 void Command::saveEffect(const string &newEffect, bool isCommandValid) {
-    std::string cmd = *this->getCommandName();
-    auto argStart = cmd.find(' ');
+    auto argStart = commandName.find(' ');
 
     if (isCommandValid && argStart != string::npos) {
-        this->commandEffect = new string(newEffect + " " + cmd.substr(argStart + 1, cmd.size() + 1));
+        commandEffect = newEffect + " " + commandName.substr(argStart + 1);
     } else {
-        this->commandEffect = new string(newEffect);
+        commandEffect = newEffect;
     }
 
     // Calling the string to log function from the Command class
-    Notify(*this);
+    Notify(LogEvent::commandEffect, *this);
 }
 
 string Command::stringToLog() const {
-    string message = "The command '" + string(*commandName) +"' has the following effect: " + string(*commandEffect);
+    string message = "The command '" + commandName + "' has the following effect: " + commandEffect;
     return message;
 }
 
@@ -204,7 +195,7 @@ CommandProcessor &CommandProcessor::operator=(CommandProcessor cmdProcessor) {
 
 // Method which reads a command, saves it in a Command object, and then returns that object by calling the readCommand
 // and saveCommand methods.
-Command *CommandProcessor::getCommand(const GameEngine &ge, LogObserver& log) {
+Command *CommandProcessor::getCommand(const GameEngine &ge) {
     string *cmd = readCommand();
 
     if (cmd == nullptr) {
@@ -213,7 +204,6 @@ Command *CommandProcessor::getCommand(const GameEngine &ge, LogObserver& log) {
     }
 
     Command *command = saveCommand(*cmd);
-    log.AddSubject(*command);
 
     delete cmd;
     return command;
@@ -225,7 +215,12 @@ string *CommandProcessor::readCommand() {
 
     cout << "\nPlease enter the word(s) corresponding to the action you wish to take:" << endl;
 
-    getline(cin, cmd);
+    // The console is shared with the human players, who may have left words on the line they answered
+    try {
+        cmd = InputChannel::console().readLine();
+    } catch (InputClosedError &error) {
+        return nullptr;
+    }
     trim(cmd);
 
     cout << "\nYou entered option: " << cmd << endl;
@@ -243,7 +238,7 @@ Command *CommandProcessor::saveCommand(const string &command) {
     cout << "\nAdding new command.\n\n" << *this << endl;
 
     // Calling the stringLog method of the Command Processor class
-    Notify(*this);
+    Notify(LogEvent::commandRead, *this);
 
     return cmd;
 }
@@ -252,63 +247,75 @@ Command *CommandProcessor::saveCommand(const string &command) {
 // it parses the command in order to extract all the keywords from the command and stores it in the command. The method
 // returns a tuple made of:
 // <0> A boolean indicating if the command is valid or not
-// <1> A string corresponding to the command keyword without arguments
+// <1> The type of the command (CommandType::invalid if the keyword is unknown)
 // <2> A string saying that the command is valid or why the command is invalid
-tuple<bool, string, string> CommandProcessor::validate(const GameEngine &ge, const Command &cmd) {
-    vector<string> *actions = ge.getStateMap()->at(*ge.getCurrentState());
-    string command;
-    string delim = " ";
+tuple<bool, CommandType, string> CommandProcessor::validate(const GameEngine &ge, Command &cmd) {
+    string_view name = cmd.getCommandName();
+    string_view command;
+    string_view delim = " ";
     string result;
     int argCounter = 0;
     auto start = 0U;
-    auto end = cmd.getCommandName()->find(delim);
+    auto end = name.find(delim);
 
     // If there is no space in the command, then the command has no arguments and can be directly used.
     if (end == string::npos) {
-        command = *cmd.getCommandName();
-        cmd.getCommandArgs()->emplace_back(new string(command));
+        command = name;
+        cmd.addCommandArg(command);
     } else { // Else, there are arguments in the command.
 
         // Take the first word as the command keyword and add that keyword to the list of arguments.
-        command = cmd.getCommandName()->substr(start, end);
-        cmd.getCommandArgs()->emplace_back(new string(command));
+        command = name.substr(start, end);
+        cmd.addCommandArg(command);
 
         // Count the number of arguments in the command and store the arguments in the arguments list of the command.
         while (end != std::string::npos) {
             argCounter++;
             start = end + delim.length();
-            end = cmd.getCommandName()->find(delim, start);
-            cmd.getCommandArgs()->emplace_back(new string(cmd.getCommandName()->substr(start, end - start)));
+            end = name.find(delim, start);
+            cmd.addCommandArg(name.substr(start, end - start));
         }
     }
 
-    // Iterate over the allowed actions in the current state and check if the first keyword of the command matches to one
-    // of those allowed actions.
-    for (const string &action: *actions) {
-        if (action == command) {
-            if (argCounter == get<1>(ge.getDescriptionMap()->at(command))) {
-                result = "Command is valid.";
-                cout << "\n" << result << endl;
-                return make_tuple(true, command, result);
-            } else { // If the number of counted arguments is not equal to the number of required arguments for the command, then it is an invalid command.
-                result =
-                        "The command \"" + *cmd.getCommandName() + "\" has the wrong number of parameters. Expected: " +
-                        to_string(get<1>(ge.getDescriptionMap()->at(command))) + ", Obtained: " +
-                        to_string(argCounter);
-                cout << "\n" << result << endl;
-                return make_tuple(false, command, result);
-            }
-        }
+    CommandType type = validateKeyword(ge, name, command, argCounter, result);
+    if (type != CommandType::invalid) {
+        result = "Command is valid.";
+        cout << "\n" << result << endl;
+        return make_tuple(true, type, result);
     }
 
-    result = "The command " + command + " does not exist in the current state \"" + *ge.getCurrentState() + "\".";
     cout << "\n" << result << endl;
-    return make_tuple(false, command, result);
+    return make_tuple(false, type, result);
+}
+
+// Method which checks that a command keyword is allowed in the current state of the game and that it has the right
+// number of arguments. The keyword is found with the perfect hash of the state machine and the command is not copied,
+// which allows validating the commands of a script in place. The reason is only written if the command is invalid.
+CommandType CommandProcessor::validateKeyword(const GameEngine &ge, string_view commandText, string_view keyword,
+                                              int argCount, string &reason) {
+    CommandType type = lookupCommand(keyword);
+
+    if (!isCommandAllowed(ge.getCurrentState(), type)) {
+        reason = "The command " + string(keyword) + " does not exist in the current state \"" +
+                 string(ge.getCurrentStateName()) + "\".";
+        return CommandType::invalid;
+    }
+
+    // If the number of counted arguments is neither the number of required arguments for the command nor that number
+    // followed by the optional arguments, then it is an invalid command.
+    const CommandInfo &info = commandInfo(type);
+    if (argCount != info.numArgs && (info.numOptionalArgs == 0 || argCount != info.numArgs + info.numOptionalArgs)) {
+        reason = "The command \"" + string(commandText) + "\" has the wrong number of parameters. Expected: " +
+                 to_string(commandInfo(type).numArgs) + ", Obtained: " + to_string(argCount);
+        return CommandType::invalid;
+    }
+
+    return type;
 }
 
 string CommandProcessor::stringToLog() const {
     deque<Command*>::iterator it = commandList->end() - 1;
-    string& name = *(*it)->getCommandName();
+    const string& name = (*it)->getCommandName();
     string message = "A new COMMAND \"" + name + "\" has been added to the COMMAND PROCESSOR";
     return message;
 }
@@ -7,6 +7,8 @@
 #include <game_engine/game_engine.h>
 #include <game_log/log_observer.h>
 #include "observer/logging_observer.h"
+#include "command_processor/command_script.h"
+#include "game_engine/engine_state_machine.h"
 
 using namespace std;
 
@@ -18,14 +20,14 @@ class GameEngine;
 class Command : public Subject, public ILoggable {
 private:
     // A string which holds the entire command entered by the user or read from the file.
-    string *commandName;
+    string commandName;
 
     // A string which holds the effect of the command on the game (if valid, the effect it had on the game and if invalid,
-    // then the reason why the command is invalid).
-    string *commandEffect;
+    // then the reason why the command is invalid). It stays empty until the command is executed.
+    string commandEffect;
 
     // A list containing all the keywords from the command (i.e. all the words that were separated by spaces).
-    vector<string *> *commandArgs;
+    vector<string> commandArgs;
 
     // Defining the output operator for the Command object.
     friend std::ostream &operator<<(std::ostream &stream, const Command &cmd);
@@ -49,13 +51,16 @@ public:
     ~Command();
 
     // Getter for the command name (entire command).
-    [[nodiscard]] string *getCommandName() const;
+    [[nodiscard]] const string &getCommandName() const;
 
     // Getter for the command effect.
-    [[nodiscard]] string *getCommandEffect() const;
+    [[nodiscard]] const string &getCommandEffect() const;
 
     // Getter for the command arguments.
-    [[nodiscard]] vector<string *> *getCommandArgs() const;
+    [[nodiscard]] const vector<string> &getCommandArgs() const;
+
+    // Adds a keyword to the arguments of the command.
+    void addCommandArg(string_view arg);
 
     // Method which saves the effect of the command given a certain effect and given whether the command is valid or not.
     void saveEffect(const string &newEffect, bool isCommandValid);
@@ -138,15 +143,21 @@ public:
 
     // Method which reads a command, saves it in a Command object, and then returns that object by calling the readCommand
     // and saveCommand methods.
-    [[nodiscard]] Command *getCommand(const GameEngine &ge, LogObserver& log);
+    [[nodiscard]] Command *getCommand(const GameEngine &ge);
 
     // Method which validates the given Command object, given the current state of the game. If the method is valid, then
     // it parses the command in order to extract all the keywords from the command and stores it in the command. The method
     // returns a tuple made of:
     // <0> A boolean indicating if the command is valid or not
-    // <1> A string corresponding to the command keyword without arguments
+    // <1> The type of the command (CommandType::invalid if the keyword is unknown)
     // <2> A string saying that the command is valid or why the command is invalid
-    tuple<bool, string, string> validate(const GameEngine &ge, const Command &cmd);
+    tuple<bool, CommandType, string> validate(const GameEngine &ge, Command &cmd);
+
+    // Method which checks that a command keyword is allowed in the current state of the game and that it has the right
+    // number of arguments, without copying the command. Returns the type of the command, or CommandType::invalid with
+    // the reason written if the command is invalid.
+    static CommandType validateKeyword(const GameEngine &ge, string_view commandText, string_view keyword, int argCount,
+                                       string &reason);
 
     // Override class from ILoggable
     virtual string stringToLog() const override;
@@ -0,0 +1,122 @@
+#include "command_script.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+// The implementation file of the CommandScript class.
+
+// Default constructor which creates an empty script.
+CommandScript::CommandScript() = default;
+
+// One param constructor which reads the script with the given name from the commands directory.
+CommandScript::CommandScript(const string &fileName) {
+    if (!loadFile(CMD_DIR + fileName)) {
+        std::cerr << "Could not read the command script " << CMD_DIR << fileName << std::endl;
+    }
+}
+
+// Reads a whole file into the buffer with a single read, then tokenizes it.
+bool CommandScript::loadFile(const string &filePath) {
+    std::ifstream file(filePath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        buffer.clear();
+        tokenize();
+        return false;
+    }
+
+    std::streamsize fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+    buffer.resize(static_cast<size_t>(fileSize));
+    file.read(buffer.data(), fileSize);
+    buffer.resize(static_cast<size_t>(file.gcount()));
+
+    tokenize();
+    return true;
+}
+
+// Replaces the script with the given text.
+void CommandScript::loadText(string_view text) {
+    buffer.assign(text);
+    tokenize();
+}
+
+// Splits the buffer into tokens and lines. The vectors are sized from an upper bound first, so that they are
+// allocated at most once per script.
+void CommandScript::tokenize() {
+    size_t maxLines = std::count(buffer.begin(), buffer.end(), '\n') + 1;
+    size_t maxTokens = std::count(buffer.begin(), buffer.end(), ' ') + maxLines;
+
+    tokens.clear();
+    lines.clear();
+    tokens.reserve(maxTokens);
+    lines.reserve(maxLines);
+
+    string_view text(buffer);
+    size_t lineStart = 0;
+    size_t lineNumber = 1;
+
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == string_view::npos) {
+            lineEnd = text.size();
+        }
+
+        ScriptLine line{tokens.size(), 0, lineNumber};
+        size_t position = lineStart;
+        while (position < lineEnd) {
+            // Skip the blanks before the next word
+            while (position < lineEnd && (text[position] == ' ' || text[position] == '\t' || text[position] == '\r')) {
+                position++;
+            }
+            size_t wordStart = position;
+            while (position < lineEnd && text[position] != ' ' && text[position] != '\t' && text[position] != '\r') {
+                position++;
+            }
+            if (position > wordStart) {
+                tokens.push_back(text.substr(wordStart, position - wordStart));
+                line.numTokens++;
+            }
+        }
+
+        if (line.numTokens > 0 && tokens[line.firstToken][0] != '#') {
+            lines.push_back(line);
+        } else {
+            tokens.resize(line.firstToken);
+        }
+
+        lineStart = lineEnd + 1;
+        lineNumber++;
+    }
+}
+
+// Getter for the number of commands.
+size_t CommandScript::size() const {
+    return lines.size();
+}
+
+// Getter for the keyword of a command.
+string_view CommandScript::getKeyword(size_t index) const {
+    return tokens[lines[index].firstToken];
+}
+
+// Getter for the number of arguments of a command (keyword excluded).
+int CommandScript::getArgumentCount(size_t index) const {
+    return static_cast<int>(lines[index].numTokens) - 1;
+}
+
+// Getter for a token of a command, where token 0 is the keyword.
+string_view CommandScript::getToken(size_t index, size_t token) const {
+    return tokens[lines[index].firstToken + token];
+}
+
+// Getter for the whole text of a command, from its keyword to its last argument.
+string_view CommandScript::getText(size_t index) const {
+    string_view first = tokens[lines[index].firstToken];
+    string_view last = tokens[lines[index].firstToken + lines[index].numTokens - 1];
+    return {first.data(), static_cast<size_t>(last.data() + last.size() - first.data())};
+}
+
+// Getter for the line of the file a command comes from.
+size_t CommandScript::getLineNumber(size_t index) const {
+    return lines[index].lineNumber;
+}
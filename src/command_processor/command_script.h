@@ -0,0 +1,81 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_COMMAND_SCRIPT_H
+#define COMP_345_PROJECT_TEAM_N12_COMMAND_SCRIPT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+// The directory holding the command files.
+#define CMD_DIR "../commands/"
+
+// One command of a script: a range of tokens, the first one being the command keyword.
+struct ScriptLine {
+    // The index of the keyword in the tokens of the script.
+    size_t firstToken;
+
+    // The number of tokens of the command, keyword included.
+    size_t numTokens;
+
+    // The line of the file the command comes from (starting at 1).
+    size_t lineNumber;
+};
+
+// A whole file of commands read at once. The text is kept in a single buffer and is split into string views over that
+// buffer, so that a script of any length is loaded with a handful of allocations and its commands can be validated and
+// executed without copying them. Empty lines and lines starting with '#' are skipped.
+class CommandScript {
+private:
+    // The text of the script.
+    string buffer;
+
+    // Every space separated word of the script, pointing into the buffer.
+    vector<string_view> tokens;
+
+    // The commands of the script, in order.
+    vector<ScriptLine> lines;
+
+    // Splits the buffer into tokens and lines.
+    void tokenize();
+
+public:
+    // Default constructor which creates an empty script.
+    CommandScript();
+
+    // One param constructor which reads the script with the given name from the commands directory.
+    explicit CommandScript(const string &fileName);
+
+    // The tokens point into the buffer of the script, so a script is not copied.
+    CommandScript(const CommandScript &script) = delete;
+    CommandScript &operator=(const CommandScript &script) = delete;
+
+    // Reads a whole file into the buffer and tokenizes it. Returns false if the file cannot be read.
+    bool loadFile(const string &filePath);
+
+    // Replaces the script with the given text.
+    void loadText(string_view text);
+
+    // Getter for the number of commands.
+    [[nodiscard]] size_t size() const;
+
+    // Getter for the keyword of a command.
+    [[nodiscard]] string_view getKeyword(size_t index) const;
+
+    // Getter for the number of arguments of a command (keyword excluded).
+    [[nodiscard]] int getArgumentCount(size_t index) const;
+
+    // Getter for a token of a command, where token 0 is the keyword.
+    [[nodiscard]] string_view getToken(size_t index, size_t token) const;
+
+    // Getter for the whole text of a command, from its keyword to its last argument.
+    [[nodiscard]] string_view getText(size_t index) const;
+
+    // Getter for the line of the file a command comes from.
+    [[nodiscard]] size_t getLineNumber(size_t index) const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_COMMAND_SCRIPT_H
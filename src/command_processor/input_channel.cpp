@@ -0,0 +1,168 @@
+#include "input_channel.h"
+#include <cctype>
+#include <charconv>
+#include <utility>
+
+// The implementation file of the InputChannel class.
+
+InputChannel::InputChannel()
+        : source(nullptr), output(&bufferedOutput), position(0), isClosed(false), isWaitingForWord(false) {}
+
+InputChannel::InputChannel(istream &source, ostream &output)
+        : source(&source), output(&output), position(0), isClosed(false), isWaitingForWord(false) {}
+
+InputChannel &InputChannel::console() {
+    static InputChannel consoleChannel(cin, cout);
+    return consoleChannel;
+}
+
+bool InputChannel::tryReadLine(string &line) {
+    // The rest of a line read word by word comes first
+    while (position < currentLine.size() && isspace(static_cast<unsigned char>(currentLine[position]))) {
+        position++;
+    }
+    if (position < currentLine.size()) {
+        line = currentLine.substr(position);
+        currentLine.clear();
+        position = 0;
+        return true;
+    }
+
+    if (!lines.empty()) {
+        line = std::move(lines.front());
+        lines.pop_front();
+        return true;
+    }
+    if (source != nullptr && !isClosed) {
+        if (getline(*source, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        isClosed = true;
+    }
+    return false;
+}
+
+bool InputChannel::tryReadWord(string &word) {
+    while (true) {
+        while (position < currentLine.size() && isspace(static_cast<unsigned char>(currentLine[position]))) {
+            position++;
+        }
+        if (position < currentLine.size()) {
+            size_t end = position;
+            while (end < currentLine.size() && !isspace(static_cast<unsigned char>(currentLine[end]))) {
+                end++;
+            }
+            word = currentLine.substr(position, end - position);
+            position = end;
+            return true;
+        }
+
+        currentLine.clear();
+        position = 0;
+        if (!lines.empty()) {
+            currentLine = std::move(lines.front());
+            lines.pop_front();
+        } else if (source != nullptr && !isClosed && getline(*source, currentLine)) {
+            continue;
+        } else {
+            if (source != nullptr) {
+                isClosed = true;
+            }
+            return false;
+        }
+    }
+}
+
+void InputChannel::push(string line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    for (char c: line) {
+        if (!isspace(static_cast<unsigned char>(c))) {
+            lines.push_back(std::move(line));
+            return;
+        }
+    }
+}
+
+void InputChannel::close() {
+    isClosed = true;
+}
+
+bool InputChannel::isWaiting() const {
+    return static_cast<bool>(waiting);
+}
+
+bool InputChannel::isWaitingForAnswer() const {
+    return waiting && isWaitingForWord;
+}
+
+coroutine_handle<> InputChannel::takeWaiting() {
+    return std::exchange(waiting, nullptr);
+}
+
+ostream &InputChannel::prompts() {
+    return *output;
+}
+
+string InputChannel::takeOutput() {
+    string text = bufferedOutput.str();
+    bufferedOutput.str("");
+    return text;
+}
+
+InputChannel::ReadAwaiter InputChannel::nextLine() {
+    return {*this, false};
+}
+
+InputChannel::ReadAwaiter InputChannel::nextWord() {
+    return {*this, true};
+}
+
+string InputChannel::readLine() {
+    string line;
+    if (!tryReadLine(line)) {
+        throw InputClosedError("The input ended");
+    }
+    return line;
+}
+
+string InputChannel::readWord() {
+    string word;
+    if (!tryReadWord(word)) {
+        throw InputClosedError("The input ended");
+    }
+    return word;
+}
+
+int InputChannel::toInt(const string &word, int invalid) {
+    int value;
+    auto [end, error] = from_chars(word.data(), word.data() + word.size(), value);
+    return error == errc() && end == word.data() + word.size() ? value : invalid;
+}
+
+InputChannel::ReadAwaiter::ReadAwaiter(InputChannel &channel, bool isWord)
+        : channel(channel), isWord(isWord), hasValue(false) {}
+
+bool InputChannel::ReadAwaiter::await_ready() {
+    hasValue = isWord ? channel.tryReadWord(value) : channel.tryReadLine(value);
+    return hasValue || channel.isClosed;
+}
+
+void InputChannel::ReadAwaiter::await_suspend(coroutine_handle<> handle) {
+    channel.waiting = handle;
+    channel.isWaitingForWord = isWord;
+}
+
+string InputChannel::ReadAwaiter::await_resume() {
+    if (!hasValue) {
+        hasValue = isWord ? channel.tryReadWord(value) : channel.tryReadLine(value);
+    }
+    if (!hasValue) {
+        throw InputClosedError("The input ended");
+    }
+    return std::move(value);
+}
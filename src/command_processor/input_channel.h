@@ -0,0 +1,118 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_INPUT_CHANNEL_H
+#define COMP_345_PROJECT_TEAM_N12_INPUT_CHANNEL_H
+
+#include <coroutine>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Thrown to a coroutine waiting on an input channel which was closed, such as a console at its end or a client which
+// hung up.
+class InputClosedError : public runtime_error {
+public:
+    using runtime_error::runtime_error;
+};
+
+// Where a game reads what its user types, and writes what it asks them. A channel either reads from a stream (the
+// console or a script), in which case reading never suspends, or is given its lines with push() (a socket), in which
+// case a coroutine reading from it suspends until a line arrives and is resumed by whoever pushes it.
+//
+// A channel is read by whole lines, like commands, or by words, like the numbers a human player enters. Reading a word
+// after a line, or a line after a word, goes on where the last read stopped, as with cin.
+class InputChannel {
+private:
+    // The stream the lines are read from, or nullptr if they are pushed.
+    istream *source;
+
+    // Where the prompts are written. A channel with pushed lines keeps its prompts until they are taken.
+    ostream *output;
+    ostringstream bufferedOutput;
+
+    // The pushed lines not read yet, and the line being read word by word.
+    deque<string> lines;
+    string currentLine;
+    size_t position;
+
+    bool isClosed;
+
+    // The coroutine waiting for a line, and whether it waits for the answer to a prompt (a word) rather than for a
+    // command (a line).
+    coroutine_handle<> waiting;
+    bool isWaitingForWord;
+
+    // Takes the next line, or the rest of the current one. Returns false if there is none yet.
+    bool tryReadLine(string &line);
+
+    // Takes the next word. Returns false if there is none yet.
+    bool tryReadWord(string &word);
+
+public:
+    // Waits for a line (isWord false) or a word (isWord true) of the channel.
+    class ReadAwaiter {
+    private:
+        InputChannel &channel;
+        bool isWord;
+        bool hasValue;
+        string value;
+
+    public:
+        ReadAwaiter(InputChannel &channel, bool isWord);
+
+        bool await_ready();
+
+        void await_suspend(coroutine_handle<> handle);
+
+        string await_resume();
+    };
+
+    // Default constructor for a channel whose lines are pushed, and whose prompts are kept until they are taken.
+    InputChannel();
+
+    // Two param constructor for a channel reading its lines from a stream and writing its prompts to another.
+    InputChannel(istream &source, ostream &output);
+
+    // A channel may hold a waiting coroutine, so it cannot be copied.
+    InputChannel(const InputChannel &channel) = delete;
+    InputChannel &operator=(const InputChannel &channel) = delete;
+
+    // The channel of the console, reading cin and writing to cout.
+    static InputChannel &console();
+
+    // Adds a line typed by the user. Blank lines are ignored.
+    void push(string line);
+
+    // Marks the end of the input. A coroutine reading past it gets an InputClosedError.
+    void close();
+
+    // Checks if a coroutine waits for input, and if it waits for the answer to a prompt.
+    [[nodiscard]] bool isWaiting() const;
+    [[nodiscard]] bool isWaitingForAnswer() const;
+
+    // Returns the waiting coroutine, which no longer waits, to be resumed by the caller.
+    coroutine_handle<> takeWaiting();
+
+    // Where the prompts for the user are written.
+    ostream &prompts();
+
+    // Returns and clears the prompts kept by a channel whose lines are pushed.
+    string takeOutput();
+
+    // Reads the next line, suspending until it arrives.
+    ReadAwaiter nextLine();
+
+    // Reads the next word, suspending until it arrives.
+    ReadAwaiter nextWord();
+
+    // Reads the next line or word of a channel which reads from a stream, without suspending.
+    string readLine();
+    string readWord();
+
+    // Converts a word to an int. A word that is not a number gives the invalid value.
+    static int toInt(const string &word, int invalid);
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_INPUT_CHANNEL_H
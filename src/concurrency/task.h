@@ -0,0 +1,181 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_TASK_H
+#define COMP_345_PROJECT_TEAM_N12_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// A coroutine returning a T, started lazily. A task is either awaited by another coroutine (co_await task), which
+// resumes the awaiting coroutine once the task is done, or driven by its owner with start() and isDone().
+//
+// A chain of tasks awaiting each other suspends as a whole when its innermost coroutine waits for something (such as
+// input), and the chain is resumed by resuming that innermost coroutine. Destroying a task destroys its coroutine, and
+// with it the tasks the coroutine was awaiting.
+template<typename T>
+class Task;
+
+namespace task_detail {
+    // The part of the promise of a task which does not depend on its result.
+    struct PromiseBase {
+        // The coroutine awaiting the task, resumed when the task is done (none for the outermost task).
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        // Resumes the awaiting coroutine once the task is done, without growing the stack.
+        struct FinalAwaiter {
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                std::coroutine_handle<> continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() const noexcept {
+            return {};
+        }
+
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+
+        void return_value(T result) {
+            value = std::move(result);
+        }
+
+        T result() {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            return std::move(*value);
+        }
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase {
+        Task<void> get_return_object();
+
+        void return_void() const noexcept {}
+
+        void result() const {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+}
+
+template<typename T>
+class Task {
+public:
+    using promise_type = task_detail::Promise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    // Default constructor for a task with no coroutine.
+    Task() = default;
+
+    // One param constructor which takes the coroutine of the task.
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    // A task owns its coroutine, so it can be moved but not copied.
+    Task(const Task &task) = delete;
+    Task &operator=(const Task &task) = delete;
+
+    Task(Task &&task) noexcept : handle(std::exchange(task.handle, nullptr)) {}
+
+    Task &operator=(Task &&task) noexcept {
+        if (this != &task) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(task.handle, nullptr);
+        }
+        return *this;
+    }
+
+    // Destructor which destroys the coroutine, wherever it is suspended.
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Checks if the task has a coroutine.
+    [[nodiscard]] bool isValid() const {
+        return static_cast<bool>(handle);
+    }
+
+    // Checks if the coroutine of the task returned.
+    [[nodiscard]] bool isDone() const {
+        return handle && handle.done();
+    }
+
+    // Runs the task until it first suspends or returns. A suspended task goes on when the coroutine it waits on is
+    // resumed, not through the task.
+    void start() {
+        handle.resume();
+    }
+
+    // Returns the result of a finished task, or throws the exception which ended it.
+    T result() {
+        return handle.promise().result();
+    }
+
+    // Runs the task to its end on the calling thread and returns its result. The task must not suspend, which is the
+    // case when every input it waits on is read from a stream.
+    T get() {
+        start();
+        if (!handle.done()) {
+            throw std::logic_error("The task suspended while it was run to its end");
+        }
+        return result();
+    }
+
+    // Awaiting a task starts it, and resumes the awaiting coroutine with its result once it is done.
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        return handle.promise().result();
+    }
+};
+
+namespace task_detail {
+    template<typename T>
+    Task<T> Promise<T>::get_return_object() {
+        return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object() {
+        return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+}
+
+#endif //COMP_345_PROJECT_TEAM_N12_TASK_H
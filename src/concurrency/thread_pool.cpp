@@ -0,0 +1,68 @@
+#include "thread_pool.h"
+
+// The implementation file of the ThreadPool class.
+
+// One param constructor which starts the given number of worker threads (at least one).
+ThreadPool::ThreadPool(unsigned int numThreads) : stopping(false) {
+    if (numThreads == 0) {
+        numThreads = 1;
+    }
+    for (unsigned int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+// Destructor which finishes the queued tasks and joins the workers.
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+// The loop run by every worker thread: take the next task, run it, repeat until the pool stops.
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// Runs one queued task on the calling thread.
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (tasks.empty()) {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+// Getter for the number of worker threads.
+unsigned int ThreadPool::size() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+// Returns the pool shared by the whole application.
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
@@ -0,0 +1,84 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_THREAD_POOL_H
+#define COMP_345_PROJECT_TEAM_N12_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::vector;
+
+// A fixed-size pool of worker threads executing submitted tasks in FIFO order. A thread waiting on one of the pool's
+// futures through await() runs queued tasks while it waits, so tasks may themselves submit and await other tasks
+// without starving the pool.
+class ThreadPool {
+private:
+    // The worker threads.
+    vector<std::thread> workers;
+
+    // The tasks waiting to be executed.
+    std::deque<std::function<void()>> tasks;
+
+    // Protects the task queue and the stopping flag.
+    std::mutex queueMutex;
+
+    // Signaled when a task is queued or when the pool is stopping.
+    std::condition_variable taskAvailable;
+
+    // True once the pool is being destroyed.
+    bool stopping;
+
+    // The loop run by every worker thread.
+    void workerLoop();
+
+    // Runs one queued task on the calling thread. Returns false if there was no task to run.
+    bool runPendingTask();
+
+public:
+    // One param constructor which starts the given number of worker threads (at least one).
+    explicit ThreadPool(unsigned int numThreads);
+
+    // A thread pool owns threads, so it cannot be copied.
+    ThreadPool(const ThreadPool &pool) = delete;
+    ThreadPool &operator=(const ThreadPool &pool) = delete;
+
+    // Destructor which finishes the queued tasks and joins the workers.
+    ~ThreadPool();
+
+    // Getter for the number of worker threads.
+    [[nodiscard]] unsigned int size() const;
+
+    // Queues a task and returns a future holding its result.
+    template<typename Function>
+    auto submit(Function &&function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        taskAvailable.notify_one();
+        return result;
+    }
+
+    // Waits for the given future, running queued tasks on the calling thread in the meantime.
+    template<typename Result>
+    Result await(std::future<Result> &future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!runPendingTask()) {
+                future.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+        return future.get();
+    }
+
+    // Returns the pool shared by the whole application, sized to the number of hardware threads.
+    static ThreadPool &shared();
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_THREAD_POOL_H
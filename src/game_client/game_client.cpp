@@ -0,0 +1,217 @@
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Plays games on a game server (started with the "-server <socketpath>" read mode). Every session sends the lines of
+// the file one at a time, waiting for the reply to a line before sending the next one, and prints what it gets back. A
+// reply ends with a line starting with "OK" or "ERROR" for a command, or with "INPUT" when a human player waits for
+// their answer, which is the next line of the file. Without a file, a single session reads its lines from the console.
+//
+// Usage: WARZONE_CLIENT <socketpath> [-file <commands>] [-sessions <n>]
+
+namespace {
+    // One connection to the server.
+    struct ClientSession {
+        int fd = -1;
+        // The index of the next command to send, and the bytes of a reply not complete yet.
+        size_t nextCommand = 0;
+        string input;
+        bool isWaiting = false;
+        size_t numErrors = 0;
+    };
+
+    // Connects to the server. Returns -1 if it cannot.
+    int connectTo(const string &socketPath) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            return -1;
+        }
+        strcpy(address.sun_path, socketPath.c_str());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // Sends a whole line to the server.
+    bool sendLine(int fd, const string &line) {
+        string text = line + "\n";
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t count = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(count);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char const *argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <socketpath> [-file <commands>] [-sessions <n>]" << endl;
+        return 1;
+    }
+
+    string socketPath = argv[1];
+    string commandFile;
+    int numSessions = 1;
+    for (int i = 2; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 == argc) {
+            cout << "Missing value for option " << option << endl;
+            return 1;
+        } else if (option == "-file") {
+            commandFile = argv[++i];
+        } else if (option == "-sessions") {
+            numSessions = max(1, atoi(argv[++i]));
+        } else {
+            cout << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+
+    // Without a file, the commands are read from the console one at a time, by a single session
+    vector<string> commands;
+    bool isInteractive = commandFile.empty();
+    if (isInteractive) {
+        numSessions = 1;
+    } else {
+        ifstream file(commandFile);
+        if (!file) {
+            cout << "Could not open " << commandFile << endl;
+            return 1;
+        }
+        string line;
+        while (getline(file, line)) {
+            if (!line.empty()) {
+                commands.push_back(line);
+            }
+        }
+    }
+
+    vector<ClientSession> sessions(numSessions);
+    for (auto &session: sessions) {
+        session.fd = connectTo(socketPath);
+        if (session.fd < 0) {
+            cout << "Could not connect to " << socketPath << ": " << strerror(errno) << endl;
+            return 1;
+        }
+    }
+
+    size_t numReplies = 0;
+    size_t numPrompts = 0;
+    size_t numOpen = sessions.size();
+    while (numOpen > 0) {
+        // Every session with no command in flight sends its next one
+        for (auto &session: sessions) {
+            if (session.fd < 0 || session.isWaiting) {
+                continue;
+            }
+            string command;
+            if (isInteractive) {
+                cout << "> " << flush;
+                if (!getline(cin, command)) {
+                    close(session.fd);
+                    session.fd = -1;
+                    numOpen--;
+                    continue;
+                }
+            } else if (session.nextCommand < commands.size()) {
+                command = commands[session.nextCommand++];
+            } else {
+                close(session.fd);
+                session.fd = -1;
+                numOpen--;
+                continue;
+            }
+            if (command.empty()) {
+                continue;
+            }
+            if (!sendLine(session.fd, command)) {
+                close(session.fd);
+                session.fd = -1;
+                numOpen--;
+                continue;
+            }
+            session.isWaiting = true;
+        }
+
+        vector<pollfd> pollFds;
+        vector<size_t> pollSessions;
+        for (size_t i = 0; i < sessions.size(); i++) {
+            if (sessions[i].fd >= 0 && sessions[i].isWaiting) {
+                pollFds.push_back({sessions[i].fd, POLLIN, 0});
+                pollSessions.push_back(i);
+            }
+        }
+        if (pollFds.empty()) {
+            continue;
+        }
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (size_t p = 0; p < pollFds.size(); p++) {
+            if (pollFds[p].revents == 0) {
+                continue;
+            }
+            ClientSession &session = sessions[pollSessions[p]];
+            char buffer[4096];
+            ssize_t count = read(session.fd, buffer, sizeof(buffer));
+            if (count <= 0) {
+                // The server closed the session (after quit, or when it stopped)
+                close(session.fd);
+                session.fd = -1;
+                numOpen--;
+                continue;
+            }
+            session.input.append(buffer, static_cast<size_t>(count));
+
+            size_t lineEnd;
+            while ((lineEnd = session.input.find('\n')) != string::npos) {
+                string reply = session.input.substr(0, lineEnd);
+                session.input.erase(0, lineEnd + 1);
+                cout << "[" << pollSessions[p] << "] " << reply << "\n";
+                bool isError = reply.rfind("ERROR", 0) == 0;
+                if (isError || reply.rfind("OK", 0) == 0) {
+                    session.numErrors += isError ? 1 : 0;
+                    session.isWaiting = false;
+                    numReplies++;
+                } else if (reply == "INPUT") {
+                    session.isWaiting = false;
+                    numPrompts++;
+                }
+            }
+        }
+        cout << flush;
+    }
+
+    size_t numErrors = 0;
+    for (const auto &session: sessions) {
+        numErrors += session.numErrors;
+    }
+    cout << numSessions << " session(s), " << numReplies << " repl" << (numReplies == 1 ? "y" : "ies") << ", "
+         << numErrors << " error(s), " << numPrompts << " answer(s) asked" << endl;
+    return 0;
+}
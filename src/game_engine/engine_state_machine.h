@@ -0,0 +1,236 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_ENGINE_STATE_MACHINE_H
+#define COMP_345_PROJECT_TEAM_N12_ENGINE_STATE_MACHINE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+// The state machine of the game engine. Every table below is built at compile time: the states and commands are
+// enums, the commands allowed in each state are bit sets, and the keyword of a command is found with a perfect hash,
+// so validating a command never allocates nor compares more than one string.
+
+// The states the game engine can be in.
+enum class EngineState : uint8_t {
+    start,
+    tournament,
+    mapLoaded,
+    mapValidated,
+    playersAdded,
+    assignReinforcement,
+    issueOrders,
+    executeOrders,
+    win,
+    end
+};
+
+// The number of states.
+constexpr size_t NUM_ENGINE_STATES = 10;
+
+// The commands understood by the game engine. CommandType::invalid is used for unknown keywords.
+enum class CommandType : uint8_t {
+    loadMap,
+    tournament,
+    adaptiveTournament,
+    resumeTournament,
+    validateMap,
+    addPlayer,
+    gameStart,
+    issueOrder,
+    issueOrdersEnd,
+    execOrder,
+    endExecOrders,
+    win,
+    replay,
+    quit,
+    invalid
+};
+
+// The number of valid commands.
+constexpr size_t NUM_COMMAND_TYPES = 14;
+
+// The name of each state, as displayed to the user and written to the log.
+constexpr std::string_view ENGINE_STATE_NAMES[NUM_ENGINE_STATES] = {
+        "start", "tournament", "maploaded", "mapvalidated", "playersadded", "assignreinforcement", "issueorders",
+        "executeorders", "win", "end"
+};
+
+// Returns the name of a state.
+constexpr std::string_view stateName(EngineState state) {
+    return ENGINE_STATE_NAMES[static_cast<size_t>(state)];
+}
+
+// Defining the output operator for a state, which prints its name.
+inline std::ostream &operator<<(std::ostream &stream, EngineState state) {
+    return stream << stateName(state);
+}
+
+// Everything known about a command: its keyword, the number of arguments following the keyword, the number of optional
+// arguments that may follow them, the description shown to the user, the effect written to the log and the state the
+// engine moves to once the command succeeds.
+struct CommandInfo {
+    std::string_view keyword;
+    int numArgs;
+    int numOptionalArgs;
+    std::string_view description;
+    std::string_view effect;
+    EngineState transitionState;
+};
+
+// The commands, indexed by CommandType.
+constexpr CommandInfo COMMAND_TABLE[NUM_COMMAND_TYPES] = {
+        {"loadmap", 1, 0, "Load a file with your map(s): loadmap <mapfile>",
+                "Loading map from file with the following name:", EngineState::mapLoaded},
+        {"tournament", 8, 2, "Configure a tournament with the given maps, number of players/strategies, number of games per map and maximum number of turns: tournament -M <listofmapfiles> -P <listofplayerstrategies> -G <numberofgames> -D <maxnumberofturns> [-S <stalemateturns>]",
+                "Creating a tournament with configuration:", EngineState::win},
+        {"adaptivetournament", 10, 2, "Configure a tournament that stops playing a map once the leading player is separated at the given confidence level: adaptivetournament -M <listofmapfiles> -P <listofplayerstrategies> -G <maxnumberofgames> -D <maxnumberofturns> -C <confidencelevel> [-S <stalemateturns>]",
+                "Creating an adaptive tournament with configuration:", EngineState::win},
+        {"resumetournament", 0, 0, "Go on with the last tournament started, skipping the games it already played: resumetournament",
+                "Resuming the last tournament.", EngineState::win},
+        {"validatemap", 0, 0, "Validate the given file with map(s): validatemap",
+                "Validating the map.", EngineState::mapValidated},
+        {"addplayer", 2, 0, "Add a new player to the game: addplayer <playername>",
+                "Adding a player with the following name and strategy:", EngineState::playersAdded},
+        {"gamestart", 0, 0, "Automatically assign each country to a player and start the game: gamestart",
+                "Assigning the countries and starting the game.", EngineState::assignReinforcement},
+        {"issueorder", 1, 0, "Issue an order: issueorder <ordernumber>",
+                "Issuing the following order:", EngineState::issueOrders},
+        {"issueordersend", 0, 0, "End the phase of issuing orders: issueordersend",
+                "Ending the phase to issue orders.", EngineState::executeOrders},
+        {"execorder", 1, 0, "Execute an order: execorder <ordernumber>",
+                "Executing the following order:", EngineState::executeOrders},
+        {"endexecorders", 0, 0, "End the phase of executing orders: endexecorders",
+                "Ending the phase to execute orders.", EngineState::assignReinforcement},
+        {"win", 0, 0, "Win the game (temporary option): win",
+                "Winning the game.", EngineState::win},
+        {"replay", 0, 0, "Play another game: replay",
+                "Triggering the start of another game.", EngineState::start},
+        {"quit", 0, 0, "Quit the game: quit",
+                "Signaling the end of the game. Exiting the program...", EngineState::end}
+};
+
+// Returns the entry of a command in the command table.
+constexpr const CommandInfo &commandInfo(CommandType type) {
+    return COMMAND_TABLE[static_cast<size_t>(type)];
+}
+
+// Returns the bit of a command in a set of commands.
+constexpr uint32_t commandBit(CommandType type) {
+    return uint32_t{1} << static_cast<uint32_t>(type);
+}
+
+// The commands allowed in each state, indexed by EngineState.
+constexpr uint32_t ALLOWED_COMMANDS[NUM_ENGINE_STATES] = {
+        // start
+        commandBit(CommandType::loadMap) | commandBit(CommandType::tournament) |
+        commandBit(CommandType::adaptiveTournament) | commandBit(CommandType::resumeTournament),
+        // tournament
+        commandBit(CommandType::win),
+        // maploaded
+        commandBit(CommandType::loadMap) | commandBit(CommandType::validateMap),
+        // mapvalidated
+        commandBit(CommandType::addPlayer),
+        // playersadded
+        commandBit(CommandType::addPlayer) | commandBit(CommandType::gameStart),
+        // assignreinforcement
+        commandBit(CommandType::issueOrder),
+        // issueorders
+        commandBit(CommandType::issueOrder) | commandBit(CommandType::issueOrdersEnd),
+        // executeorders
+        commandBit(CommandType::execOrder) | commandBit(CommandType::endExecOrders) | commandBit(CommandType::win),
+        // win
+        commandBit(CommandType::replay) | commandBit(CommandType::quit),
+        // end
+        0
+};
+
+// Checks if a command can be used in the given state.
+constexpr bool isCommandAllowed(EngineState state, CommandType type) {
+    return type != CommandType::invalid && (ALLOWED_COMMANDS[static_cast<size_t>(state)] & commandBit(type)) != 0;
+}
+
+// The number of slots of the keyword hash table, and the number of bits of a slot index.
+constexpr size_t COMMAND_HASH_BITS = 5;
+constexpr size_t COMMAND_HASH_SIZE = size_t{1} << COMMAND_HASH_BITS;
+
+// Seeded FNV-1a hash of a command keyword.
+constexpr uint32_t keywordHash(std::string_view keyword, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c: keyword) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns the slot of a keyword in the hash table. The top bits of the hash are used, since they depend on every
+// character of the keyword and on every bit of the seed.
+constexpr size_t keywordSlot(std::string_view keyword, uint32_t seed) {
+    return keywordHash(keyword, seed) >> (32 - COMMAND_HASH_BITS);
+}
+
+// Checks if every keyword lands in its own slot of the hash table with the given seed.
+constexpr bool isPerfectHashSeed(uint32_t seed) {
+    bool usedSlots[COMMAND_HASH_SIZE] = {};
+    for (const CommandInfo &command: COMMAND_TABLE) {
+        size_t slot = keywordSlot(command.keyword, seed);
+        if (usedSlots[slot]) {
+            return false;
+        }
+        usedSlots[slot] = true;
+    }
+    return true;
+}
+
+// Returns the first seed giving a perfect hash of the keywords.
+constexpr uint32_t findPerfectHashSeed() {
+    uint32_t seed = 0;
+    while (!isPerfectHashSeed(seed)) {
+        seed++;
+    }
+    return seed;
+}
+
+// The seed of the keyword hash, found by the compiler.
+constexpr uint32_t COMMAND_HASH_SEED = findPerfectHashSeed();
+
+static_assert(isPerfectHashSeed(COMMAND_HASH_SEED), "The command keywords must not collide in the hash table");
+
+// Builds the hash table mapping each slot to the command whose keyword lands there.
+constexpr std::array<CommandType, COMMAND_HASH_SIZE> buildCommandHashTable() {
+    std::array<CommandType, COMMAND_HASH_SIZE> table{};
+    table.fill(CommandType::invalid);
+    for (size_t i = 0; i < NUM_COMMAND_TYPES; i++) {
+        table[keywordSlot(COMMAND_TABLE[i].keyword, COMMAND_HASH_SEED)] =
+                static_cast<CommandType>(i);
+    }
+    return table;
+}
+
+// The keyword hash table.
+constexpr std::array<CommandType, COMMAND_HASH_SIZE> COMMAND_HASH_TABLE = buildCommandHashTable();
+
+// Returns the command with the given keyword, or CommandType::invalid if there is none.
+constexpr CommandType lookupCommand(std::string_view keyword) {
+    CommandType type = COMMAND_HASH_TABLE[keywordSlot(keyword, COMMAND_HASH_SEED)];
+    if (type != CommandType::invalid && commandInfo(type).keyword == keyword) {
+        return type;
+    }
+    return CommandType::invalid;
+}
+
+// Checks that every command is found from its own keyword.
+constexpr bool isEveryKeywordFound() {
+    for (size_t i = 0; i < NUM_COMMAND_TYPES; i++) {
+        if (lookupCommand(COMMAND_TABLE[i].keyword) != static_cast<CommandType>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isEveryKeywordFound(), "Every command must be found from its keyword");
+static_assert(lookupCommand("load") == CommandType::invalid, "unknown keywords must not be found");
+
+#endif //COMP_345_PROJECT_TEAM_N12_ENGINE_STATE_MACHINE_H
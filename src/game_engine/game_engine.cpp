@@ -1,4 +1,13 @@
 #include "game_engine.h"
+#include <type_traits>
+#include "tournament/tournament_statistics.h"
+#include "tournament/tournament_journal.h"
+#include "tournament/tournament_coordinator.h"
+#include "tournament/tournament_results.h"
+#include "orders/order_scheduler.h"
+#include "concurrency/thread_pool.h"
+#include "map/map_cache.h"
+#include "game_state/game_random.h"
 #include <iostream>
 #include <vector>
 #include <map>
@@ -9,7 +18,10 @@
 #include <random>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <memory>
 #include <sstream>
+#include <unordered_set>
 
 using namespace std;
 
@@ -18,189 +30,162 @@ using namespace std;
 // One param constructor which initializes all the maps, the current game state, and the mode in which the game
 // start-up commands will be read (from console or file).
 GameEngine::GameEngine(const string &readMode) {
-    // Add the Observer and attach the game engine
+    // Add the Observer, registered once for every kind of event of the game
     log = new LogObserver();
-    log->AddSubject(*this);
+    observers.subscribeAll(log);
+    indexedLog = nullptr;
+    if (IndexedLogObserver::isGameLogIndexed()) {
+        indexedLog = new IndexedLogObserver(IndexedLogObserver::isGameLogInMemory() ? ""
+                                                                                   : IndexedLogObserver::gameLogPath());
+        observers.subscribe(LogEvent::orderExecuted, indexedLog);
+    }
+    ObserverRegistry::setCurrent(&observers);
 
     // Map and state initializations
-    currentState = new string("start");
-    stateMap = new std::map<string, vector<string> *>{};
-    descriptionMap = new std::map<string, tuple<string, int, string>>{};
-    functionMap = new std::map<string, pair<Game_Engine_Mem_Fn, string>>{};
+    currentState = EngineState::start;
     commandReadMode = new string(readMode);
     players = new std::vector<Player*>{};
     gameMap = new Map("gameMap");
     deck = new Deck(20);
     neutralPlayer = nullptr;
 
-    tournamentMaps = new vector<Map*>{};
     tournamentPlayerStrategies = new vector<string>{};
 
+    commandScript = nullptr;
+    stalemateTurns = 0;
+    ownNeutralPlayer = nullptr;
+    isIssuingOrders = false;
+    input = &InputChannel::console();
+    waitsForInput = true;
+    turnLimit = 0;
+    resumedJournal = nullptr;
+
     if (*commandReadMode == "-console") {
         cout << "Taking commands from console!" << endl;
         commandProcessor = new CommandProcessor();
-        log->AddSubject(*commandProcessor);
+    } else if (commandReadMode->rfind("-batch ", 0) == 0) {
+        cout << "Taking commands from a batch script!" << endl;
+        commandProcessor = new CommandProcessor();
+        commandScript = new CommandScript(readMode.substr(readMode.find(' ') + 1, readMode.size() + 1));
     } else {
         cout << "Taking commands from file!" << endl;
         commandProcessor = new FileCommandProcessorAdapter(
                 readMode.substr(readMode.find(' ') + 1, readMode.size() + 1));
-        log->AddSubject(*commandProcessor);
-    }
-
-    // Creating the vectors. One vector for each state where a vector contains
-    // all the possible actions from each state.
-    auto *start = new vector<string>();
-    start->emplace_back("loadmap");
-    start->emplace_back("tournament");
-
-    auto *tournament = new vector<string>();
-    tournament->emplace_back("win");
-
-    auto *mapLoaded = new vector<string>();
-    mapLoaded->emplace_back("loadmap");
-    mapLoaded->emplace_back("validatemap");
-
-    auto *mapValidated = new vector<string>();
-    mapValidated->emplace_back("addplayer");
-
-    auto *playersAdded = new vector<string>();
-    playersAdded->emplace_back("addplayer");
-    playersAdded->emplace_back("gamestart");
-
-    auto *assignReinforcement = new vector<string>();
-    assignReinforcement->emplace_back("issueorder");
-
-    auto *issueOrders = new vector<string>();
-    issueOrders->emplace_back("issueorder");
-    issueOrders->emplace_back("issueordersend");
-
-    auto *executeOrders = new vector<string>();
-    executeOrders->emplace_back("execorder");
-    executeOrders->emplace_back("endexecorders");
-    executeOrders->emplace_back("win");
-
-    auto *winVector = new vector<string>();
-    winVector->emplace_back("replay");
-    winVector->emplace_back("quit");
-
-    // Linking states to their vector of possible actions.
-    stateMap->insert(make_pair("start", start));
-    stateMap->insert(make_pair("tournament", tournament));
-    stateMap->insert(make_pair("maploaded", mapLoaded));
-    stateMap->insert(make_pair("mapvalidated", mapValidated));
-    stateMap->insert(make_pair("playersadded", playersAdded));
-    stateMap->insert(make_pair("assignreinforcement", assignReinforcement));
-    stateMap->insert(make_pair("issueorders", issueOrders));
-    stateMap->insert(make_pair("executeorders", executeOrders));
-    stateMap->insert(make_pair("win", winVector));
-
-    // Linking actions to their corresponding description to trigger the action and the effect of that action.
-    descriptionMap->insert(make_pair("loadmap", make_tuple("Load a file with your map(s): loadmap <mapfile>", 1,
-                                                           "Loading map from file with the following name:")));
-    descriptionMap->insert(make_pair("tournament", make_tuple("Configure a tournament with the given maps, number of players/strategies, number of games per map and maximum number of turns: tournament -M <listofmapfiles> -P <listofplayerstrategies> -G <numberofgames> -D <maxnumberofturns>", 8,
-                           "Creating a tournament with configuration:")));
-    descriptionMap->insert(make_pair("validatemap", make_tuple("Validate the given file with map(s): validatemap", 0,
-                                                               "Validating the map.")));
-    descriptionMap->insert(make_pair("addplayer", make_tuple("Add a new player to the game: addplayer <playername>", 2,
-                                                             "Adding a player with the following name and strategy:")));
-    descriptionMap->insert(make_pair("gamestart", make_tuple(
-            "Automatically assign each country to a player and start the game: gamestart", 0,
-            "Assigning the countries and starting the game.")));
-    descriptionMap->insert(make_pair("issueorder", make_tuple("Issue an order: issueorder <ordernumber>", 1,
-                                                              "Issuing the following order:")));
-    descriptionMap->insert(
-            make_pair("issueordersend", make_tuple("End the phase of issuing orders: issueordersend", 0,
-                                                   "Ending the phase to issue orders.")));
-    descriptionMap->insert(make_pair("execorder", make_tuple("Execute an order: execorder <ordernumber>", 1,
-                                                             "Executing the following order:")));
-    descriptionMap->insert(
-            make_pair("endexecorders", make_tuple("End the phase of executing orders: endexecorders", 0,
-                                                  "Ending the phase to execute orders.")));
-    descriptionMap->insert(
-            make_pair("win", make_tuple("Win the game (temporary option): win", 0, "Winning the game.")));
-    descriptionMap->insert(
-            make_pair("replay", make_tuple("Play another game: replay", 0, "Triggering the start of another game.")));
-    descriptionMap->insert(make_pair("quit", make_tuple("Quit the game: quit", 0,
-                                                        "Signaling the end of the game. Exiting the program...")));
-
-    // Creating pointers to functions that will be called for the corresponding action.
-    Game_Engine_Mem_Fn loadMap = &GameEngine::loadMap;
-    Game_Engine_Mem_Fn tournamentMethod = &GameEngine::tournament;
-    Game_Engine_Mem_Fn validateMap = &GameEngine::validateMap;
-    Game_Engine_Mem_Fn addPlayer = &GameEngine::addPlayer;
-    Game_Engine_Mem_Fn gameStart = &GameEngine::gameStart;
-    Game_Engine_Mem_Fn issueOrder = &GameEngine::issueOrder;
-    Game_Engine_Mem_Fn issueOrdersEnd = &GameEngine::issueOrdersEnd;
-    Game_Engine_Mem_Fn execOrder = &GameEngine::execOrder;
-    Game_Engine_Mem_Fn endExecOrders = &GameEngine::endExecOrders;
-    Game_Engine_Mem_Fn winMethod = &GameEngine::win;
-    Game_Engine_Mem_Fn replayMethod = &GameEngine::replay;
-    Game_Engine_Mem_Fn quitMethod = &GameEngine::quit;
-
-    // Linking the trigger keyword of an action to their method handler and the transition state.
-    functionMap->insert(make_pair("loadmap", make_pair(loadMap, "maploaded")));
-    functionMap->insert(make_pair("tournament", make_pair(tournamentMethod, "win")));
-    functionMap->insert(make_pair("validatemap", make_pair(validateMap, "mapvalidated")));
-    functionMap->insert(make_pair("addplayer", make_pair(addPlayer, "playersadded")));
-    functionMap->insert(make_pair("gamestart", make_pair(gameStart, "assignreinforcement")));
-    functionMap->insert(make_pair("issueorder", make_pair(issueOrder, "issueorders")));
-    functionMap->insert(make_pair("issueordersend", make_pair(issueOrdersEnd, "executeorders")));
-    functionMap->insert(make_pair("execorder", make_pair(execOrder, "executeorders")));
-    functionMap->insert(make_pair("endexecorders", make_pair(endExecOrders, "assignreinforcement")));
-    functionMap->insert(make_pair("win", make_pair(winMethod, "win")));
-    functionMap->insert(make_pair("replay", make_pair(replayMethod, "start")));
-    functionMap->insert(make_pair("quit", make_pair(quitMethod, "end")));
+    }
 }
 
 // Copy constructor.
 GameEngine::GameEngine(const GameEngine &e) {
-    this->currentState = new string(*e.currentState);
-    this->stateMap = new map(*e.stateMap);
-    this->descriptionMap = new map(*e.descriptionMap);
-    this->functionMap = new map(*e.functionMap);
+    this->currentState = e.currentState;
     this->log = new LogObserver(*e.log);
+    this->observers.subscribeAll(this->log);
+    // The indexed log file belongs to the copied engine
+    this->indexedLog = nullptr;
     this->commandReadMode = new string(*e.commandReadMode);
     this->commandProcessor = new CommandProcessor(*e.commandProcessor);
-    this->players = new std::vector(*e.players);
+    this->commandScript = nullptr;
+    this->players = new std::vector<Player *>{};
+    for (Player *player: *e.players) {
+        this->players->push_back(new Player(*player));
+    }
     this->gameMap = new Map(*e.gameMap);
     this->deck = new Deck(*e.deck);
-    this->tournamentMaps = new std::vector(*e.tournamentMaps);
+    this->tournamentMaps = e.tournamentMaps;
+    this->mapTopology = e.mapTopology;
     this->tournamentPlayerStrategies = new vector(*e.tournamentPlayerStrategies);
 
     this->turnCount = 0;
     this->maxTurns = 0;
+    this->stalemateTurns = e.stalemateTurns;
+    this->ownNeutralPlayer = nullptr;
+    this->isIssuingOrders = false;
+    this->input = e.input;
+    this->waitsForInput = e.waitsForInput;
+    this->turnLimit = e.turnLimit;
+    this->tournamentFileSuffix = e.tournamentFileSuffix;
+    this->resumedJournal = nullptr;
 }
 
+// Move constructor, which takes everything the given engine owns, including its observers. The given engine is left
+// empty.
+GameEngine::GameEngine(GameEngine &&e) noexcept
+        : log(e.log), indexedLog(e.indexedLog), observers(std::move(e.observers)), currentState(e.currentState), commandProcessor(e.commandProcessor),
+          commandReadMode(e.commandReadMode), commandScript(e.commandScript), scriptArgs(std::move(e.scriptArgs)),
+          players(e.players), gameMap(e.gameMap), mapRenderer(std::move(e.mapRenderer)),
+          tournamentMaps(std::move(e.tournamentMaps)),
+          mapTopology(std::move(e.mapTopology)),
+          tournamentPlayerStrategies(e.tournamentPlayerStrategies), deck(e.deck), turnCount(e.turnCount),
+          eliminations(std::move(e.eliminations)), telemetryName(std::move(e.telemetryName)),
+          maxTurns(e.maxTurns), stalemateTurns(e.stalemateTurns), ownNeutralPlayer(e.ownNeutralPlayer),
+          isIssuingOrders(e.isIssuingOrders), input(e.input), waitsForInput(e.waitsForInput), turnLimit(e.turnLimit),
+          tournamentFileSuffix(std::move(e.tournamentFileSuffix)),
+          resumedJournal(nullptr) {
+    e.ownNeutralPlayer = nullptr;
+    e.log = nullptr;
+    e.indexedLog = nullptr;
+    e.commandProcessor = nullptr;
+    e.commandReadMode = nullptr;
+    e.commandScript = nullptr;
+    e.players = nullptr;
+    e.gameMap = nullptr;
+    e.tournamentPlayerStrategies = nullptr;
+    e.deck = nullptr;
+
+    if (ObserverRegistry::current() == &e.observers) {
+        ObserverRegistry::setCurrent(&observers);
+    }
+}
+
+static_assert(std::is_nothrow_move_constructible_v<GameEngine>, "Game engines must be relocated without copies");
+
 // Swaps the member data between two GameEngine objects.
 void GameEngine::swap(GameEngine &first, GameEngine &second) {
     std::swap(first.currentState, second.currentState);
-    std::swap(first.stateMap, second.stateMap);
-    std::swap(first.descriptionMap, second.descriptionMap);
-    std::swap(first.functionMap, second.functionMap);
     std::swap(first.log, second.log);
+    std::swap(first.indexedLog, second.indexedLog);
+    std::swap(first.observers, second.observers);
     std::swap(first.commandProcessor, second.commandProcessor);
+    std::swap(first.commandScript, second.commandScript);
+    std::swap(first.scriptArgs, second.scriptArgs);
     std::swap(first.commandReadMode, second.commandReadMode);
     std::swap(first.players, second.players);
     std::swap(first.gameMap, second.gameMap);
+    std::swap(first.mapRenderer, second.mapRenderer);
     std::swap(first.deck, second.deck);
     std::swap(first.tournamentMaps, second.tournamentMaps);
+    std::swap(first.mapTopology, second.mapTopology);
     std::swap(first.tournamentPlayerStrategies, second.tournamentPlayerStrategies);
+    std::swap(first.turnCount, second.turnCount);
+    std::swap(first.eliminations, second.eliminations);
+    std::swap(first.maxTurns, second.maxTurns);
+    std::swap(first.stalemateTurns, second.stalemateTurns);
+    std::swap(first.ownNeutralPlayer, second.ownNeutralPlayer);
+    std::swap(first.isIssuingOrders, second.isIssuingOrders);
+    std::swap(first.input, second.input);
+    std::swap(first.waitsForInput, second.waitsForInput);
+    std::swap(first.turnLimit, second.turnLimit);
+    std::swap(first.tournamentFileSuffix, second.tournamentFileSuffix);
+    std::swap(first.telemetryName, second.telemetryName);
 }
 
 // Destructor.
 GameEngine::~GameEngine() {
-    delete currentState;
-    delete stateMap;
-    delete descriptionMap;
-    delete functionMap;
+    if (players != nullptr) {
+        for (Player *player: *players) {
+            releasePlayer(player);
+        }
+    }
     delete commandProcessor;
+    delete commandScript;
     delete commandReadMode;
-    delete neutralPlayer;
+    if (ObserverRegistry::current() == &observers) {
+        ObserverRegistry::setCurrent(nullptr);
+    }
     delete log;
+    delete indexedLog;
     delete players;
     delete gameMap;
     delete deck;
-    delete tournamentMaps;
     delete tournamentPlayerStrategies;
 }
 
@@ -217,49 +202,29 @@ GameEngine &GameEngine::operator=(GameEngine ge) {
 // Defining the output operator.
 std::ostream &operator<<(ostream &stream, const GameEngine &ge) {
     return stream << "GameEngine information:" << "\n Command Read Mode: " << *ge.commandReadMode
-                  << "\n Current state: " << *ge.getCurrentState() << "\n Command Processor info:\n"
+                  << "\n Current state: " << ge.getCurrentState() << "\n Command Processor info:\n"
                   << *ge.commandProcessor;
 }
 
 // Getter for the currentState.
-string *GameEngine::getCurrentState() const {
+EngineState GameEngine::getCurrentState() const {
     return currentState;
 }
 
-// Setter for the currentState.
-void GameEngine::transition(const string &state) {
-    this->currentState = new string(state);
-    Notify(*this);
-}
-
-// Getter for the stateMap.
-std::map<string, vector<string> *> *GameEngine::getStateMap() const {
-    return stateMap;
-}
-
-// Setter for the stateMap.
-void GameEngine::setStateMap(const std::map<string, vector<string> *> &mapOfStates) {
-    this->stateMap = new std::map(mapOfStates);
+// Getter for the name of the currentState.
+string_view GameEngine::getCurrentStateName() const {
+    return stateName(currentState);
 }
 
-// Getter for the descriptionMap.
-std::map<string, tuple<string, int, string>> *GameEngine::getDescriptionMap() const {
-    return descriptionMap;
-}
-
-// Setter for the descriptionMap.
-void GameEngine::setDescriptionMap(const std::map<string, tuple<string, int, string>> &mapOfDescriptions) {
-    this->descriptionMap = new std::map(mapOfDescriptions);
-}
-
-// Getter for the functionMap.
-std::map<string, pair<GameEngine::Game_Engine_Mem_Fn, string>> *GameEngine::getFunctionMap() const {
-    return functionMap;
+// Setter for the currentState.
+void GameEngine::transition(EngineState state) {
+    this->currentState = state;
+    Notify(LogEvent::stateChanged, *this);
 }
 
-// Setter for the functionMap.
-void GameEngine::setFunctionMap(const std::map<string, pair<GameEngine::Game_Engine_Mem_Fn, string>> &mapOfFunctions) {
-    this->functionMap = new std::map(mapOfFunctions);
+// Runs the handler of a command with the transition state of the command.
+void GameEngine::executeCommand(CommandType type, const vector<string> &commandArgs) {
+    std::invoke(COMMAND_HANDLERS[static_cast<size_t>(type)], this, commandInfo(type).transitionState, commandArgs);
 }
 
 // Getter for the commandProcessor
@@ -287,10 +252,21 @@ std::vector<Player*>* GameEngine::getPlayers() const {
     return players;
 }
 
-// Setter for the players.
-void GameEngine::setPlayers(std::vector<Player *> &newPlayers) {
-    delete this->players;
-    this->players = &newPlayers;
+// Setter for the players. The engine takes ownership of the given players and releases the players of the previous
+// game, so nothing is copied between games.
+void GameEngine::setPlayers(std::vector<Player *> &&newPlayers) {
+    for (Player *player: *players) {
+        releasePlayer(player);
+    }
+    *players = std::move(newPlayers);
+}
+
+// Deletes a player owned by the engine. The neutral player is forgotten with the game it was created in.
+void GameEngine::releasePlayer(Player *player) {
+    if (player == neutralPlayer) {
+        neutralPlayer = nullptr;
+    }
+    delete player;
 }
 
 // Getter for the Map.
@@ -300,8 +276,39 @@ Map *GameEngine::getMap() const {
 
 // Setter for the Map.
 void GameEngine::setMap(const string &filename) {
+    setMap(MapLoader::load(filename));
+}
+
+// Setter for the Map, which takes ownership of the given map.
+void GameEngine::setMap(Map *newMap) {
     delete this->gameMap;
-    this->gameMap = MapLoader::load(filename);
+    this->gameMap = newMap;
+    this->mapTopology = nullptr;
+}
+
+// Getter for the topology of the current map.
+const shared_ptr<const MapTopology> &GameEngine::getMapTopology() const {
+    return mapTopology;
+}
+
+// Getter for the deck.
+Deck *GameEngine::getDeck() const {
+    return deck;
+}
+
+// Getter for the observer of the indexed game log.
+IndexedLogObserver *GameEngine::getIndexedLog() const {
+    return indexedLog;
+}
+
+// Getter for the turn count.
+int GameEngine::getTurnCount() const {
+    return turnCount;
+}
+
+// Setter for the turn count.
+void GameEngine::setTurnCount(int turn) {
+    turnCount = turn;
 }
 
 // A function that prints the actions available for the user if setting up the game from the console.
@@ -310,25 +317,27 @@ void GameEngine::printActionsIfNeeded() {
         return;
     }
 
-    if (*currentState == "end") {
+    if (currentState == EngineState::end) {
         return;
     }
     cout << "\n****************************************\n" << endl;
     cout << "\nHere are the current actions you can take:" << endl;
 
-    for (const string &action: *stateMap->at(*currentState)) {
-        cout << "\n- " << get<0>(descriptionMap->at(action)) << endl;
+    for (size_t i = 0; i < NUM_COMMAND_TYPES; i++) {
+        if (isCommandAllowed(currentState, static_cast<CommandType>(i))) {
+            cout << "\n- " << COMMAND_TABLE[i].description << endl;
+        }
     }
 }
 
 // A function which will load the game map using the map class.
 // Currently just changes the current state of the game to mapLoaded.
-void GameEngine::loadMap(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::loadMap(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
-    cout << "Inside the load map function! You are loading a map from the file: " << *commandArgs.at(1) << endl;
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "Inside the load map function! You are loading a map from the file: " << commandArgs.at(1) << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
-    string filename = *commandArgs.at(1);
+    string filename = commandArgs.at(1);
 
     // Check that file exists
     ifstream file;
@@ -347,16 +356,208 @@ void GameEngine::loadMap(const string &transitionState, const vector<string *> &
         }
     }
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will attempt to create a tournament
-void GameEngine::tournament(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::tournament(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the tournament function! You are creating a tournament!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
+
+    int gamesPerMap = -1;
+    if (configureTournament(commandArgs, gamesPerMap)) {
+        startTournament(commandArgs, gamesPerMap, maxTurns);
+        transition(transitionState);
+    }
+
+    cout << "\nThis is the state after the action: " << currentState << endl;
+}
+
+// Validates the arguments of the tournament command and loads the maps and players of the tournament
+bool GameEngine::configureTournament(const vector<string> &commandArgs, int &gamesPerMap) {
+    // Same arguments as described in parseTournamentCommand, optionally followed by:
+    //  commandArgs[9] == "-S"
+    //  commandArgs[10] == {number of turns without a conquest after which a game is a draw}
+    bool isValidTournament = parseTournamentCommand(commandArgs, 5, gamesPerMap);
+    return parseStalemateTurns(commandArgs, 9) && isValidTournament;
+}
+
+// A function which will attempt to create an adaptive tournament
+void GameEngine::adaptiveTournament(EngineState transitionState, const vector<string> &commandArgs) {
+    cout << "\n****************************************\n" << endl;
+    cout << "Inside the adaptive tournament function! You are creating an adaptive tournament!" << endl;
+
+    cout << "\nThis is the state before the action: " << currentState << endl;
+
+    // Same arguments as the tournament command, where -G is the maximum number of games per map, followed by:
+    //  commandArgs[9] == "-C"
+    //  commandArgs[10] == {confidence level at which a map is decided, e.g. 0.95}
+    //  commandArgs[11] == "-S" (optional)
+    //  commandArgs[12] == {number of turns without a conquest after which a game is a draw} (optional)
+    int maxGamesPerMap = -1;
+    bool isValidTournament = parseTournamentCommand(commandArgs, 100, maxGamesPerMap);
+
+    if (commandArgs[9] != "-C") {
+        cout << "Error parsing arguments: expected arg 9 as \"-C\", instead received \"" << commandArgs[9] << "\"" << endl;
+        isValidTournament = false;
+    }
+
+    // Validate the confidence level
+    double confidence = -1;
+    try {
+        confidence = stod(commandArgs[10]);
+    } catch (exception &e) {
+        cout << "Error: Cannot parse -C argument as a number -- " << e.what() << endl;
+    }
+
+    if (confidence < 0.5 || confidence >= 1) {
+        cout << "Error: Provided invalid confidence level. Number must be at least 0.5 and less than 1" << endl;
+        isValidTournament = false;
+    }
+
+    isValidTournament = parseStalemateTurns(commandArgs, 11) && isValidTournament;
+
+    if (isValidTournament) {
+        startTournament(commandArgs, maxGamesPerMap, maxTurns, confidence);
+        transition(transitionState);
+    }
+
+    cout << "\nThis is the state after the action: " << currentState << endl;
+}
+
+// A function which will go on with the last tournament started
+void GameEngine::resumeTournament(EngineState transitionState, const vector<string> &commandArgs) {
+    cout << "\n****************************************\n" << endl;
+    cout << "Inside the resume tournament function! You are resuming the last tournament!" << endl;
+
+    // The journal starts with the command of the tournament, which is run again with the games of the journal skipped
+    TournamentJournal journal(tournamentFilePath(TOURNAMENT_JOURNAL_PATH));
+    if (!journal.load()) {
+        cout << "Error: There is no tournament to resume" << endl;
+        return;
+    }
+
+    const vector<string> &tournamentArgs = journal.getCommandArgs();
+    CommandType type = lookupCommand(tournamentArgs[0]);
+    int argCount = static_cast<int>(tournamentArgs.size()) - 1;
+    if ((type != CommandType::tournament && type != CommandType::adaptiveTournament) ||
+        argCount < commandInfo(type).numArgs || argCount > commandInfo(type).numArgs + commandInfo(type).numOptionalArgs) {
+        cout << "Error: The tournament journal does not start with a tournament command" << endl;
+        return;
+    }
+
+    cout << "Resuming \"" << journal.getCommandArgs()[0] << "\" with " << journal.getRecords().size()
+         << " games already played" << endl;
+
+    resumedJournal = &journal;
+    executeCommand(type, tournamentArgs);
+    resumedJournal = nullptr;
+}
+
+// Returns the names of the players of a tournament game, numbered in the order of the tournament strategies
+vector<string> GameEngine::tournamentPlayerNames() const {
+    vector<string> playerNames;
+    for (size_t k = 0; k < tournamentPlayerStrategies->size(); k++) {
+        playerNames.emplace_back(to_string(k + 1) + "-" + tournamentPlayerStrategies->at(k));
+    }
+    return playerNames;
+}
+
+// Returns the line starting the log of a tournament game
+string GameEngine::tournamentGameHeader(int mapIndex, int gameIndex) const {
+    return "Game " + to_string(gameIndex + 1) + " on map " + tournamentMaps[mapIndex].name + ":";
+}
+
+// Getter for the number of maps of the configured tournament
+size_t GameEngine::getTournamentMapCount() const {
+    return tournamentMaps.size();
+}
+
+// Plays one game of the tournament on the map at the given index
+string GameEngine::playTournamentGame(int mapIndex, shared_ptr<LogSink> gameLog, TournamentGameResult *result) {
+    uint64_t seed = GameRandom::current().getState();
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Set up a fresh copy of the map loaded for the tournament (validation not necessary)
+    const TournamentMap &tournamentMap = tournamentMaps.at(mapIndex);
+    setMap(tournamentMap.loadedMap->prototype->freshCopy(tournamentMap.name));
+    mapTopology = tournamentMap.loadedMap->topology;
+
+    // Set up the players, created in the order of the tournament strategies
+    vector<string> playerNames = tournamentPlayerNames();
+    vector<Player*> newPlayers;
+    for (size_t k = 0; k < tournamentPlayerStrategies->size(); k++) {
+        newPlayers.emplace_back(new Player(playerNames[k], getStrategyObjectByStrategyName(tournamentPlayerStrategies->at(k))));
+    }
+    setPlayers(std::move(newPlayers));
+
+    // Start from a fresh deck, so that nothing is left from the previous game and the seed alone decides the game
+    deck->setDeck(Deck(20));
+
+    shared_ptr<LogSink> engineLog = log->getSink();
+    log->setSink(std::move(gameLog));
+
+    // Start the game proper
+    gameStart();
+
+    // reset the turn count
+    turnCount = 0;
+
+    // Name the telemetry of the game after its place in the tournament
+    if (result != nullptr) {
+        telemetryName = "map" + to_string(mapIndex) + "-game" + to_string(result->gameIndex);
+    }
+
+    // Run the main game loop
+    mainGameLoop();
+
+    log->setSink(engineLog);
+
+    // At end of game, find the winning player (or draw if no player won)
+    string winner = "draw";
+    for (auto & player : *players) {
+        if (player->getTerritories()->size() == gameMap->getSize()) {
+            winner = player->getPName();
+        }
+    }
+
+    if (result != nullptr) {
+        result->mapName = tournamentMaps[mapIndex].name;
+        result->seed = seed;
+        result->participants = playerNames;
+        result->winner = -1;
+        result->turnsPlayed = turnCount;
+        result->wallTimeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - startTime).count();
+        result->territories.assign(playerNames.size(), 0);
+        result->armies.assign(playerNames.size(), 0);
+        result->eliminationTurns.assign(playerNames.size(), 0);
+        for (size_t k = 0; k < playerNames.size(); k++) {
+            if (playerNames[k] == winner) {
+                result->winner = static_cast<int>(k);
+            }
+            for (Player *player : *players) {
+                if (player->getPName() == playerNames[k]) {
+                    result->territories[k] = static_cast<int>(player->getTerritories()->size());
+                    for (Territory *territory : *player->getTerritories()) {
+                        result->armies[k] += territory->getNumberOfArmies();
+                    }
+                }
+            }
+            for (const auto &[name, turn] : eliminations) {
+                if (name == playerNames[k]) {
+                    result->eliminationTurns[k] = turn;
+                }
+            }
+        }
+    }
+    return winner;
+}
 
+// Validates the arguments shared by the tournament commands and loads the maps and players of the tournament
+bool GameEngine::parseTournamentCommand(const vector<string> &commandArgs, int maxGamesPerMap, int &gamesPerMap) {
     // The commandArgs array must follow this format:
     //  commandArgs[0] == "tournament" // already validated by command processor
     //  commandArgs[1] == "-M"
@@ -376,33 +577,33 @@ void GameEngine::tournament(const string &transitionState, const vector<string *
     // Check that commandArgs array at indices 1,3,5 and 7 has values "-M","-P","-G","-D" respectively
     for (int i = 0; i < 4; i++) {
         // If the arguments at positions 1,3,5 and 7 are not as defined, the tournament is invalid
-        if (*commandArgs[i*2+1] != VALID_PARAM_NAMES[i]) {
-            cout << "Error parsing arguments: expected arg " << (i*2+1) << " as \"" << VALID_PARAM_NAMES[i] << "\", instead received \"" << *commandArgs[1] << "\"" << endl;
+        if (commandArgs[i*2+1] != VALID_PARAM_NAMES[i]) {
+            cout << "Error parsing arguments: expected arg " << (i*2+1) << " as \"" << VALID_PARAM_NAMES[i] << "\", instead received \"" << commandArgs[1] << "\"" << endl;
             isValidTournament = false;
         }
     }
 
     // Create vectors of maps and players
-    parseTournamentMaps(*commandArgs[2]);
-    parseTournamentPlayers(*commandArgs[4]);
+    isValidTournament = parseTournamentMaps(commandArgs[2]) && isValidTournament;
+    isValidTournament = parseTournamentPlayers(commandArgs[4]) && isValidTournament;
 
     // Validate number of games per map
-    int gamesPerMap = -1;
+    gamesPerMap = -1;
     try {
-        gamesPerMap = stoi(*commandArgs[6]);
+        gamesPerMap = stoi(commandArgs[6]);
     } catch (exception &e) {
         cout << "Error: Cannot parse -G argument as integer -- " << e.what() << endl;
     }
 
-    if (gamesPerMap < 1 || gamesPerMap > 5) {
-        cout << "Error: Provided invalid games per map. Number must be between 1 and 5" << endl;
+    if (gamesPerMap < 1 || gamesPerMap > maxGamesPerMap) {
+        cout << "Error: Provided invalid games per map. Number must be between 1 and " << maxGamesPerMap << endl;
         isValidTournament = false;
     }
 
     // Validate maximum number of turns
     maxTurns = -1;
     try {
-        maxTurns = stoi(*commandArgs[8]);
+        maxTurns = stoi(commandArgs[8]);
     } catch (exception &e) {
         cout << "Error: Cannot parse -D argument as integer -- " << e.what() << endl;
     }
@@ -412,26 +613,67 @@ void GameEngine::tournament(const string &transitionState, const vector<string *
         isValidTournament = false;
     }
 
-    if (isValidTournament) {
-        startTournament(gamesPerMap, maxTurns);
-        transition(transitionState);
+    return isValidTournament;
+}
+
+// Validates the optional stalemate arguments of the tournament commands. Without them, games are played until maxTurns.
+bool GameEngine::parseStalemateTurns(const vector<string> &commandArgs, size_t index) {
+    stalemateTurns = 0;
+    if (commandArgs.size() <= index) {
+        return true;
+    }
+
+    if (commandArgs[index] != "-S") {
+        cout << "Error parsing arguments: expected arg " << index << " as \"-S\", instead received \"" << commandArgs[index] << "\"" << endl;
+        return false;
     }
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    try {
+        stalemateTurns = stoi(commandArgs[index + 1]);
+    } catch (exception &e) {
+        cout << "Error: Cannot parse -S argument as integer -- " << e.what() << endl;
+    }
+
+    if (stalemateTurns < 1 || stalemateTurns > 50) {
+        cout << "Error: Provided invalid number of stalemate turns. Number must be between 1 and 50" << endl;
+        stalemateTurns = 0;
+        return false;
+    }
+    return true;
 }
 
-void GameEngine::startTournament(int gamesPerMap, int maxTurns) {
+void GameEngine::startTournament(const vector<string> &commandArgs, int gamesPerMap, int maxTurns, double confidence) {
     cout << "Beginning the tournament" << endl;
 
+    bool isAdaptive = confidence > 0;
+
+    // The games already played by a resumed tournament are read from its journal, and a new tournament starts one
+    TournamentJournal newJournal(tournamentFilePath(TOURNAMENT_JOURNAL_PATH));
+    TournamentJournal *journal = resumedJournal;
+    if (journal == nullptr) {
+        journal = &newJournal;
+        if (!journal->begin(commandArgs)) {
+            cerr << "Error: Cannot write the tournament journal, the tournament will not be resumable" << endl;
+        }
+    }
+
+    // Every game adds a row to the result store, which the tables below are made from. A resumed tournament goes on
+    // with the rows of the games already played.
+    string resultsPath = tournamentFilePath(TOURNAMENT_RESULTS_PATH);
+    TournamentResultStore results(resultsPath);
+    if ((resumedJournal == nullptr || !results.load()) && !results.begin()) {
+        cerr << "Error: Cannot write the tournament results to " << resultsPath << endl;
+    }
+
     ofstream tournamentLogfile;
-    tournamentLogfile.open("../log/tournamentlog.txt");
+    tournamentLogfile.open(tournamentFilePath("../log/tournamentlog.txt"));
 
     tournamentLogfile << "Tournament mode:" << endl;
 
     // Print out the maps in the tourney
     string mapsLine;
-    for (const auto &item : *tournamentMaps) {
-        mapsLine += item->getName() + "\t";
+    for (const TournamentMap &item : tournamentMaps) {
+        mapsLine += item.name + "\t";
     }
 
     tournamentLogfile << "M: " << mapsLine << endl;
@@ -447,59 +689,138 @@ void GameEngine::startTournament(int gamesPerMap, int maxTurns) {
     // Print out the games per map and the maximum number of turns
     tournamentLogfile <<"G: " << gamesPerMap << endl;
     tournamentLogfile <<"D: " << maxTurns << endl;
+    if (isAdaptive) {
+        tournamentLogfile << "C: " << confidence << endl;
+    }
+    if (stalemateTurns > 0) {
+        tournamentLogfile << "S: " << stalemateTurns << endl;
+    }
 
     cout << "Printed out the configuration to the log file" << endl;
 
-    // Array to store the winning player (or draw) for every game to be played in the tournament
-    string winners[tournamentMaps->size()][tournamentPlayerStrategies->size()];
-
-    for (int i = 0; i < tournamentMaps->size(); i++) {
-        cout << "Changing active map to index " << i << ": " << tournamentMaps->at(i)->getName() << endl;
-
-        // Play each map j times
-        for (int j = 0; j < gamesPerMap; j++) {
-            // Set up a new map (validation not necessary)
-            setMap(tournamentMaps->at(i)->getName());
-
-            // Set up the players
-            auto *newPlayers = new vector<Player*>{};
-            int playerIndex = 1;
-            // Read the vector of tournament strategies and create a new player configured in order
-            for (int k = 0; k < tournamentPlayerStrategies->size(); k++) {
-                auto *player = new Player(to_string(playerIndex) + "-" + tournamentPlayerStrategies->at(k), &getStrategyObjectByStrategyName(tournamentPlayerStrategies->at(j)));
-                newPlayers->emplace_back(player);
-                playerIndex++;
+    // The outcomes of the games played on each map
+    vector<TournamentStatistics> statistics;
+
+    // Every game logs to its own shard, merged into the game log in the order the games were started
+    shared_ptr<LogSink> gameLogSink = log->getSink();
+    ShardedLogSink gameLogs(gameLogSink);
+    size_t gameNumber = 0;
+
+    // The names of the players of every game, numbered in the order of their strategies
+    vector<string> playerNames = tournamentPlayerNames();
+
+    // With worker processes, the games not played yet are first handed to the workers, and their results recorded in
+    // the journal like the results of a resumed tournament. A game the workers could not play is played below.
+    bool isSharded = false;
+    uint64_t shardSeed = 0;
+    if (tournamentWorkers > 0 && isAdaptive) {
+        cout << "An adaptive tournament decides which game to play next from the last one, so it is played in this "
+                "process" << endl;
+    } else if (tournamentWorkers > 0) {
+        vector<pair<int, int>> pendingGames;
+        for (int i = 0; i < static_cast<int>(tournamentMaps.size()); i++) {
+            for (int j = 0; j < gamesPerMap; j++) {
+                if (journal->find(i, j) == nullptr) {
+                    pendingGames.emplace_back(i, j);
+                }
             }
-            setPlayers(*newPlayers);
+        }
 
-            // Start the game proper
-            gameStart();
+        isSharded = true;
+        shardSeed = GameRandom::current().next();
+        // The games of the workers are numbered in the indexed log as in the game log, where they come first
+        uint32_t firstIndexedGame = 0;
+        if (indexedLog != nullptr) {
+            firstIndexedGame = indexedLog->reserveGames(static_cast<uint32_t>(pendingGames.size()));
+        }
 
-            // reset the turn count
-            turnCount = 0;
+        TournamentCoordinator coordinator(tournamentWorkers, commandArgs);
+        coordinator.play(pendingGames, shardSeed,
+                         [&](size_t index, const TournamentJournal::GameRecord &record, TournamentGameResult result,
+                             const string &gameLog, const string &indexedRecords) {
+            gameLogs.openShard(index, tournamentGameHeader(record.mapIndex, record.gameIndex))->writeBlock(gameLog);
+            gameLogs.closeShard(index);
+            if (indexedLog != nullptr &&
+                !indexedLog->addGameRecords(firstIndexedGame + static_cast<uint32_t>(index), indexedRecords)) {
+                cerr << "Error: The indexed log of game " << record.gameIndex + 1 << " on map index "
+                     << record.mapIndex << " is malformed, it is left out of the indexed log" << endl;
+            }
+            journal->append(record);
+
+            result.mapName = tournamentMaps[record.mapIndex].name;
+            result.participants = playerNames;
+            auto slot = find(playerNames.begin(), playerNames.end(), record.winner);
+            result.winner = slot == playerNames.end() ? -1 : static_cast<int>(slot - playerNames.begin());
+            results.append(result);
+        });
+        gameNumber = pendingGames.size();
+    }
 
-            // Run the main game loop
-            mainGameLoop();
+    for (int i = 0; i < tournamentMaps.size(); i++) {
+        cout << "Changing active map to index " << i << ": " << tournamentMaps[i].name << endl;
+        statistics.emplace_back(static_cast<int>(tournamentPlayerStrategies->size()), isAdaptive ? confidence : 0.95,
+                                gamesPerMap);
 
-            // At end of game, register the name of the winning player (or draw if no player won)
-            bool gameHasWinner = false;
-            for (auto & player : *players) {
-                if (player->getTerritories()->size() == gameMap->getSize()) {
-                    winners[i][j] = *player->getPName();
-                    gameHasWinner = true;
+        // Play each map j times
+        for (int j = 0; j < gamesPerMap; j++) {
+            // A game recorded in the journal is not played again. The random generator goes on from where the game
+            // left it, as if it had just been played.
+            const TournamentJournal::GameRecord *record = journal->find(i, j);
+            if (record != nullptr && (record->winner == "draw" ||
+                                      find(playerNames.begin(), playerNames.end(), record->winner) != playerNames.end())) {
+                GameRandom::current().setState(record->randomState);
+                cout << "Game " << j + 1 << " on map " << tournamentMaps[i].name
+                     << " is recorded in the journal: " << record->winner << endl;
+
+                // The row of a game is written with the next block of rows, so a crash may have lost it: only what
+                // the journal knows is kept
+                if (results.find(i, j) == nullptr) {
+                    TournamentGameResult result;
+                    result.mapIndex = i;
+                    result.gameIndex = j;
+                    result.mapName = tournamentMaps[i].name;
+                    result.participants = playerNames;
+                    auto slot = find(playerNames.begin(), playerNames.end(), record->winner);
+                    result.winner = slot == playerNames.end() ? -1 : static_cast<int>(slot - playerNames.begin());
+                    results.append(result);
+                }
+            } else {
+                // A game the workers gave up on is seeded as a worker would have seeded it
+                if (isSharded) {
+                    GameRandom::current().seed(TournamentCoordinator::gameSeed(shardSeed, {i, j}));
                 }
+                TournamentGameResult result;
+                result.mapIndex = i;
+                result.gameIndex = j;
+                shared_ptr<MemoryLogSink> gameLog = gameLogs.openShard(gameNumber, tournamentGameHeader(i, j));
+                string winner = playTournamentGame(i, gameLog, &result);
+                gameLogs.closeShard(gameNumber++);
+
+                journal->append({i, j, winner, GameRandom::current().getState()});
+                results.append(result);
             }
 
-            // If no player has won, the result of the game is a draw
-            if (!gameHasWinner) {
-                winners[i][j] = "draw";
+            const TournamentGameResult *result = results.find(i, j);
+            if (result->winner < 0) {
+                statistics[i].recordDraw();
+            } else {
+                statistics[i].recordWin(result->winner);
             }
 
-
+            // In adaptive mode, stop playing this map once its leader can no longer be caught
+            if (isAdaptive && statistics[i].isLeaderSeparated()) {
+                cout << "The outcome of map " << tournamentMaps[i].name << " is decided after "
+                     << statistics[i].getGamesPlayed() << " games" << endl;
+                break;
+            }
         }
     }
 
-    // Print out final results
+    if (!results.flush()) {
+        cerr << "Error: Cannot write the tournament results to " << resultsPath << endl;
+    }
+
+    // Print out final results, from the result store
     // Header line
 
     tournamentLogfile << "\nResults:" << endl;
@@ -509,17 +830,44 @@ void GameEngine::startTournament(int gamesPerMap, int maxTurns) {
     tournamentLogfile << endl;
 
     // Print out one row at a time
-    for (auto i = 0; i < tournamentMaps->size(); i++) {
+    for (auto i = 0; i < tournamentMaps.size(); i++) {
         // Print out the map name as the first column of the row
-        tournamentLogfile << tournamentMaps->at(i)->getName() << "\t";
+        tournamentLogfile << tournamentMaps[i].name << "\t";
 
-        for (auto j = 0; j < tournamentPlayerStrategies->size(); j++){
-            tournamentLogfile << winners[i][j] << "\t";
+        for (auto j = 0; j < gamesPerMap; j++){
+            const TournamentGameResult *result = results.find(i, j);
+            tournamentLogfile << (result != nullptr ? result->getWinnerName() : "-") << "\t";
         }
 
         tournamentLogfile << endl;
     }
 
+    // Print out the win rate of every player on every map, and the games saved by stopping early
+    if (isAdaptive) {
+        int gamesSaved = 0;
+        tournamentLogfile << "\nWin rates (" << confidence * 100 << "% simultaneous confidence intervals):" << endl;
+        for (size_t i = 0; i < tournamentMaps.size(); i++) {
+            const TournamentStatistics &mapStatistics = statistics[i];
+            tournamentLogfile << tournamentMaps[i].name << "\t";
+
+            for (int k = -1; k < static_cast<int>(tournamentPlayerStrategies->size()); k++) {
+                pair<double, double> interval = mapStatistics.rateInterval(k);
+                tournamentLogfile << (k < 0 ? "draw" : to_string(k + 1) + "-" + tournamentPlayerStrategies->at(k))
+                                  << ": " << (k < 0 ? mapStatistics.getDraws() : mapStatistics.getWins(k)) << "/"
+                                  << mapStatistics.getGamesPlayed() << " [" << interval.first << ", "
+                                  << interval.second << "]\t";
+            }
+
+            int mapGamesSaved = gamesPerMap - mapStatistics.getGamesPlayed();
+            gamesSaved += mapGamesSaved;
+            tournamentLogfile << (mapStatistics.isLeaderSeparated() ? "decided" : "undecided") << ", "
+                              << mapGamesSaved << " games saved" << endl;
+        }
+
+        tournamentLogfile << "\nGames played: " << gamesPerMap * tournamentMaps.size() - gamesSaved << " of "
+                          << gamesPerMap * tournamentMaps.size() << " (" << gamesSaved << " games saved)" << endl;
+    }
+
     cout << endl;
 
     tournamentLogfile.close();
@@ -527,7 +875,7 @@ void GameEngine::startTournament(int gamesPerMap, int maxTurns) {
 
 bool GameEngine::parseTournamentPlayers(const string &playersLine) const {
     bool isValidPlayers = true;
-    const string VALID_STRATEGIES[] = {"aggressive", "benevolent", "neutral", "cheater"};
+    const string VALID_STRATEGIES[] = {"aggressive", "benevolent", "neutral", "cheater", "montecarlo"};
 
     vector<string> playerStrategies;
     extractCsv(&playersLine, playerStrategies);
@@ -550,9 +898,19 @@ bool GameEngine::parseTournamentPlayers(const string &playersLine) const {
             }
         }
 
+        // The Monte Carlo strategy can be given its settings after its name
+        unique_ptr<MonteCarloPlayerStrategy> monteCarlo(MonteCarloPlayerStrategy::fromName(playerStrategy));
+        foundMatch = foundMatch || monteCarlo != nullptr;
+
+        // A named parameter set plays the aggressive strategy with its parameters
+        StrategyParameters parameters;
+        foundMatch = foundMatch || StrategyParameters::find(playerStrategy, parameters);
+
         if (!foundMatch) {
             cout << "Error: strategy name \"" << playerStrategy << "\" is not a valid strategy. "
-                    << R"(Possible values are "aggressive", "benevolent", "neutral", "cheater")" << endl;
+                    << R"(Possible values are "aggressive", "benevolent", "neutral", "cheater", "montecarlo")"
+                    << R"( (or "montecarlo:<simulations>:<time budget in ms>:<rollout depth>:<deploy targets>"))"
+                    << " or the name of a loaded parameter set" << endl;
 
             isValidPlayers = false;
         }
@@ -571,50 +929,35 @@ bool GameEngine::parseTournamentPlayers(const string &playersLine) const {
     return isValidPlayers;
 }
 
-// Loads the maps listed as CSVs in the tournament command
-bool GameEngine::parseTournamentMaps(const string &mapsLine) const {
-    // Assume string is invalid. Only when all map files described in the mapsLine have been successfully loaded
-    bool isValidMapsLine = false;
+// Loads the maps listed as CSVs in the tournament command, in place of the maps of an earlier tournament. Every file
+// is read, parsed and validated at most once, in parallel, through the map cache, which keeps the loaded maps; each
+// game then plays on a fresh copy of its map.
+bool GameEngine::parseTournamentMaps(const string &mapsLine) {
+    tournamentMaps.clear();
 
     vector<string> mapFiles;
     // Split the CSV and store into vector of strings
     extractCsv(&mapsLine, mapFiles);
 
-    if (mapFiles.empty() || mapFiles.size() > 5) {
-        cout << "Error: Provided " << mapFiles.size() << " map files. Number must be between 1 and 5" << endl;
-        isValidMapsLine = false;
-    } else {
-        // Load and validate each map file
-
-        for (const auto &mapFile : mapFiles) {
-            // Check that file exists
-            ifstream file;
-            file.open(MAPS_DIR + mapFile);
-            if (!file) {
-                // File doesn't exist
-                cout << "Error: File " << mapFile << " doesn't exist" << endl;
-                isValidMapsLine = false;
-            } else {
-                // File exists, create the map
-                try {
-                    // Load map from file
-                    Map *loadedMap = MapLoader::load(mapFile);
-
-                    // Validate loaded map
-                    loadedMap->validate();
-
-                    // If map is valid, add to the list of tournament maps
-                    tournamentMaps->emplace_back(MapLoader::load(mapFile));
-                } catch (runtime_error &exp) {
-                    // Catch all exceptions defined as runtime errors
-                    cerr << "Error: Could not load/validate map " << mapFile << endl;
-                    cerr << exp.what() << endl;
-                }
-            }
+    if (mapFiles.empty()) {
+        cout << "Error: Provided no map files. At least one map file is required" << endl;
+        return false;
+    }
+
+    vector<string> errors;
+    vector<shared_ptr<const LoadedMap>> loadedMaps = MapCache::shared().load(mapFiles, errors);
+    for (const string &error : errors) {
+        cerr << "Error: " << error << endl;
+    }
+
+    // Add the valid maps to the list of tournament maps
+    for (size_t i = 0; i < mapFiles.size(); i++) {
+        if (loadedMaps[i] != nullptr) {
+            tournamentMaps.push_back({mapFiles[i], loadedMaps[i]});
         }
     }
 
-    return isValidMapsLine;
+    return errors.empty();
 }
 
 void GameEngine::extractCsv(const string *csvLine, vector<string> &csvVector) const {
@@ -628,11 +971,11 @@ void GameEngine::extractCsv(const string *csvLine, vector<string> &csvVector) co
 
 // A function which will validate the game map using the map class.
 // Currently just changes the current state of the game to mapValidated.
-void GameEngine::validateMap(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::validateMap(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the validate map function! You are validating a map!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     try {
         gameMap->validate();
@@ -645,37 +988,41 @@ void GameEngine::validateMap(const string &transitionState, const vector<string
         cerr << exp.what() << endl;
     }
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will add a player to the game using the player class.
 // Currently just changes the current state of the game to playersAdded.
-void GameEngine::addPlayer(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::addPlayer(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
-    cout << "Inside the add a player function! You are adding a player with name: " << *commandArgs.at(1) << " with the strategy: " << *commandArgs.at(2) << endl;
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "Inside the add a player function! You are adding a player with name: " << commandArgs.at(1) << " with the strategy: " << commandArgs.at(2) << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     // Note: only a maximum of 6 players are supported
+    PlayerStrategy *strategy = nullptr;
     if (players->size() >= 6) {
         cerr << "Error: Cannot add more than 6 players to game" << endl;
+    } else if ((strategy = getStrategyObjectByStrategyName(commandArgs.at(2))) == nullptr) {
+        cerr << "Error: " << commandArgs.at(2) << " is neither a strategy nor a loaded strategy parameter set" << endl;
     } else {
         bool playerExists = false;
         // Check if player already exists
         for (const auto &player : *players) {
-            if (*player->getPName() == *commandArgs.at(1)) {
-                cerr << "Error: Player with name " << *commandArgs.at(1) << " already exists" << endl;
+            if (player->getPName() == commandArgs.at(1)) {
+                cerr << "Error: Player with name " << commandArgs.at(1) << " already exists" << endl;
                 playerExists = true;
                 break;
             }
         }
 
-        if (!playerExists) {
-            cout << "Adding player " << *commandArgs.at(1) << " with " << *commandArgs.at(2) << " strategy to the list of players" << endl;
+        if (playerExists) {
+            delete strategy;
+        } else {
+            cout << "Adding player " << commandArgs.at(1) << " with " << commandArgs.at(2) << " strategy to the list of players" << endl;
 
 
-            Player *player = new Player(*commandArgs.at(1), &getStrategyObjectByStrategyName(*commandArgs.at(2)));
+            Player *player = new Player(commandArgs.at(1), strategy);
             players->emplace_back(player);
-            this->log->AddSubject(*player->getOrdersList());
 
             transition(transitionState);
         }
@@ -683,19 +1030,19 @@ void GameEngine::addPlayer(const string &transitionState, const vector<string *>
 
     cout << "\nCurrent list of players:" << endl;
     for (const auto &player : *players) {
-        cout << "\t" << *player->getPName() << " - " << player->getPlayerStrategy()->printStrategy() << endl;
+        cout << "\t" << player->getPName() << " - " << player->getPlayerStrategy()->printStrategy() << endl;
     }
     cout << endl;
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will assign each country to a player at the start of the game using the map class.
 // Currently just changes the current state of the game to assignReinforcement.
-void GameEngine::gameStart(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::gameStart(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the game start function! You are assigning countries and will start the game!" << endl;
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     if (players->size() < 2) {
         cerr << "Not enough players to start the game!" << endl;
@@ -710,20 +1057,20 @@ void GameEngine::gameStart(const string &transitionState, const vector<string *>
 
         transition(transitionState);
     }
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
     cout << "\nGame is about to start!" << endl;
 }
 
 void GameEngine::gameStart() {
     // Enough players to begin the game!
-    // Shuffle list of players to randomize order of play
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    default_random_engine randomEngine(seed);
-    shuffle(players->begin(), players->end(), randomEngine);
+    // Shuffle list of players to randomize order of play. The shuffles draw from the random stream of the game, so a
+    // game started from the same state of the stream plays again the same way
+    GameRandom &random = GameRandom::current();
+    shuffle(players->begin(), players->end(), random);
 
     cout << "\nOrder of play:" << endl;
     for (const auto &player : *players) {
-        cout << "\t" << *player->getPName() << endl;
+        cout << "\t" << player->getPName() << endl;
     }
     cout << endl;
 
@@ -740,16 +1087,15 @@ void GameEngine::gameStart() {
         for (const auto &territory : continent->getTerritories()) {
             if (iterator == unpickedPlayers.cend()) {
                 unpickedPlayers = *players;
-                randomEngine.seed(std::chrono::system_clock::now().time_since_epoch().count());
-                shuffle(unpickedPlayers.begin(), unpickedPlayers.end(), randomEngine);
+                shuffle(unpickedPlayers.begin(), unpickedPlayers.end(), random);
                 iterator = unpickedPlayers.cbegin();
             }
 
             // Iterator points to the next player to be assigned a territory
-            if(!*static_cast<Player*>(*iterator)->getIsNeutral()){
+            if(!static_cast<Player*>(*iterator)->getIsNeutral()){
                 static_cast<Player*>(*iterator)->acquireTerritory(territory);
             }
-            cout << "Territory " << territory->getId() << " (" << territory->getName() << ") is owned by player " << *static_cast<Player>(**iterator).getPName() << endl;
+            cout << "Territory " << territory->getId() << " (" << territory->getName() << ") is owned by player " << static_cast<Player>(**iterator).getPName() << endl;
 
             // Point iterator to next player
             iterator++;
@@ -761,7 +1107,7 @@ void GameEngine::gameStart() {
     // Give 50 initial armies to each player
     for (auto player : *players) {
         player->increasePool(50);
-        cout << "Player " << *player->getPName() << " has army count " << *player->getReinforcementPool() << endl;
+        cout << "Player " << player->getPName() << " has army count " << player->getReinforcementPool() << endl;
 
         // Draw 2 cards per player
         for (int i = 0; i < 2; ++i) {
@@ -771,102 +1117,102 @@ void GameEngine::gameStart() {
             }
         }
 
-        cout << "Player " << *player->getPName() << " has drawn cards in their hand" << endl;
+        cout << "Player " << player->getPName() << " has drawn cards in their hand" << endl;
         cout << *player->getHand() << endl;
     }
 }
 
 // A function which will allow the issuing of an order using the orders_list class.
 // Currently just changes the current state of the game to issueOrders.
-void GameEngine::issueOrder(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::issueOrder(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the issue order function! You are issuing an order!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will quit the order issuing phase using the orders_list class.
 // Currently just changes the current state of the game to executeOrders.
-void GameEngine::issueOrdersEnd(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::issueOrdersEnd(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the quit issue orders function! You are ending the order issuing phase!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will allow the execution of an order using the orders_list class.
 // Currently just changes the current state of the game to executeOrders.
-void GameEngine::execOrder(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::execOrder(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the execute order function! You are executing an order!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will quit the order execution phase using the orders_list class.
 // Currently just changes the current state of the game to assignReinforcement.
-void GameEngine::endExecOrders(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::endExecOrders(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the quit execute orders function! You are ending the order execution phase!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will signal the quit of the current game once a player controls all the countries.
 // Currently just changes the current state of the game to win.
-void GameEngine::win(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::win(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the win function! You won!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will start a new game after the current game has ended.
 // Currently just changes the current state of the game to start.
-void GameEngine::replay(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::replay(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
     cout << "Inside the replay function! You are starting a new game!" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
 
     transition(transitionState);
 
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 }
 
 // A function which will start the shut-down process of the game once the current game has ended.
 // Currently just changes the current state of the game to quit.
-void GameEngine::quit(const string &transitionState, const vector<string *> &commandArgs) {
+void GameEngine::quit(EngineState transitionState, const vector<string> &commandArgs) {
     cout << "\n****************************************\n" << endl;
 
-    cout << "\nThis is the state before the action: " << *currentState << endl;
+    cout << "\nThis is the state before the action: " << currentState << endl;
     transition(transitionState);
-    cout << "\nThis is the state after the action: " << *currentState << endl;
+    cout << "\nThis is the state after the action: " << currentState << endl;
 
     cout << "\nThank you for playing Risk! Shutting down game..." << endl;
 }
 
-PlayerStrategy& GameEngine::getStrategyObjectByStrategyName(string& name) {
+PlayerStrategy* GameEngine::getStrategyObjectByStrategyName(const string& name) {
     PlayerStrategy* ps;
 
     if(name == "human")
@@ -879,8 +1225,18 @@ PlayerStrategy& GameEngine::getStrategyObjectByStrategyName(string& name) {
         ps = new NeutralPlayerStrategy();
     else if(name == "cheater")
         ps = new CheaterPlayerStrategy();
+    else if(MonteCarloPlayerStrategy *monteCarlo = MonteCarloPlayerStrategy::fromName(name))
+        ps = monteCarlo;
+    else {
+        // A named parameter set plays the aggressive strategy with its parameters
+        StrategyParameters parameters;
+        if (!StrategyParameters::find(name, parameters)) {
+            return nullptr;
+        }
+        ps = new AggressivePlayerStrategy(parameters);
+    }
 
-    return *ps;
+    return ps;
 }
 
 // Free function in order to test the functionality of the GameEngine for assignment #1.
@@ -931,14 +1287,22 @@ void game_engine_driver(const string &cmdArg) {
 }
 
 void GameEngine::start() {
-    while (*currentState != "end") {
+    // The subjects created while playing notify the observers of this engine
+    ObserverRegistry::setCurrent(&observers);
+
+    if (commandScript != nullptr) {
+        runScript();
+        return;
+    }
+
+    while (currentState != EngineState::end) {
         // Initial state at startup
 
-        setPlayers(*(new vector<Player *>{}));
+        setPlayers({});
 
-        deck->setDeck(*(new Deck(20)));
+        deck->setDeck(Deck(20));
 
-        transition("start");
+        transition(EngineState::start);
 
         if(startupPhase()){
             break;
@@ -946,7 +1310,7 @@ void GameEngine::start() {
 
         mainGameLoop();
 
-        vector<string> states = vector{string("end"), string("start")};
+        vector<EngineState> states = {EngineState::end, EngineState::start};
 
         if (readingCommands(states)) {
             break;
@@ -954,7 +1318,58 @@ void GameEngine::start() {
     }
 }
 
-Player *GameEngine::neutralPlayer = nullptr;
+// Runs every command of the batch script in order. Each command is validated in place against the state table and its
+// arguments are copied into a buffer reused from one command to the next, so the script itself causes no allocation
+// per command. A game is played as soon as a command moves the engine to the reinforcement phase.
+void GameEngine::runScript() {
+    cout << "\nRunning " << commandScript->size() << " commands from the batch script" << endl;
+
+    setPlayers({});
+    transition(EngineState::start);
+
+    string reason;
+    int invalidCommands = 0;
+
+    for (size_t i = 0; i < commandScript->size() && currentState != EngineState::end; i++) {
+        string_view keyword = commandScript->getKeyword(i);
+        int argCount = commandScript->getArgumentCount(i);
+
+        CommandType type = CommandProcessor::validateKeyword(*this, commandScript->getText(i), keyword, argCount, reason);
+        if (type == CommandType::invalid) {
+            cerr << "BAD INPUT at line " << commandScript->getLineNumber(i) << "! " << reason << endl;
+            cerr << "Remaining in state " << currentState << endl;
+            invalidCommands++;
+            continue;
+        }
+
+        // Copy the tokens into the reusable argument buffer. Strings keep their capacity between commands.
+        scriptArgs.resize(argCount + 1);
+        for (int token = 0; token <= argCount; token++) {
+            scriptArgs[token].assign(commandScript->getToken(i, token));
+        }
+
+        executeCommand(type, scriptArgs);
+
+        if (currentState == EngineState::assignReinforcement) {
+            mainGameLoop();
+        } else if (currentState == EngineState::start) {
+            // A replay starts from an empty game
+            setPlayers({});
+            deck->setDeck(Deck(20));
+        }
+    }
+
+    cout << "\nBatch script finished with " << invalidCommands << " invalid command(s), in state " << currentState
+         << endl;
+}
+
+int GameEngine::tournamentWorkers = 0;
+
+void GameEngine::setTournamentWorkers(int workers) {
+    tournamentWorkers = workers < 0 ? 0 : workers;
+}
+
+thread_local Player *GameEngine::neutralPlayer = nullptr;
 
 void GameEngine::setNeutralPlayer(Player *ntrPlayer) {
     neutralPlayer = ntrPlayer;
@@ -964,16 +1379,59 @@ Player *GameEngine::getNeutralPlayer() {
     return neutralPlayer;
 }
 
+thread_local GameEngine *GameEngine::activeEngine = nullptr;
+
+GameEngine *GameEngine::getActiveEngine() {
+    return activeEngine;
+}
+
 void GameEngine::mainGameLoop() {
+    try {
+        playGame().get();
+    } catch (InputClosedError &error) {
+        cout << "The input ended before the end of the game." << endl;
+        activeEngine = nullptr;
+        isIssuingOrders = false;
+        transition(EngineState::win);
+    }
+}
+
+Task<void> GameEngine::playGame() {
+    // The hashes of the board at the end of every turn, the hash of the owners at the end of the last turn and the
+    // number of turns since a territory last changed owner, to end tournament games that can no longer be decided
+    unordered_set<uint64_t> boardStates;
+    uint64_t lastOwnershipHash = gameMap->getOwnershipHash();
+    int turnsWithoutConquest = 0;
+
+    // The first print of the map of a game shows every territory
+    mapRenderer.reset();
+    eliminations.clear();
+
+    if (indexedLog != nullptr) {
+        indexedLog->startGame();
+    }
+
+    // The telemetry of the game, recorded at the end of every turn when it is enabled
+    unique_ptr<GameTelemetry> telemetry;
+    if (GameTelemetry::isTelemetryEnabled()) {
+        static atomic<int> gameNumber = 0;
+        string name = telemetryName.empty() ? "game-" + to_string(++gameNumber) : telemetryName;
+        telemetry = make_unique<GameTelemetry>(GameTelemetry::telemetryPath(name), *players);
+        telemetryName.clear();
+    }
+
     bool gameOver = false;
     while (!gameOver) {
-        if (!tournamentMaps->empty()) {
+        if (!tournamentMaps.empty() || turnLimit > 0) {
             turnCount++;
             cout << "Turn #" << turnCount << " of " << maxTurns << endl;
         }
+        if (indexedLog != nullptr) {
+            indexedLog->startTurn();
+        }
 
         reinforcementPhase();
-        issueOrdersPhase();
+        co_await issueOrders();
         executeOrdersPhase();
 
         cout << "Player array size " << players->size() << " | Game over status " << gameOver << endl;
@@ -981,17 +1439,39 @@ void GameEngine::mainGameLoop() {
         //Check if a player owns at least 1 territory, remove this player if the player does not own any territory
         for (auto i = 0; i < players->size(); i++) {
             if (players->at(i)->getTerritories()->empty()) {
-                cout << "Player " << *players->at(i)->getPName()
+                cout << "Player " << players->at(i)->getPName()
                      << " has no territories left. Player is therefore eliminated." << endl;
-                delete players->at(i);
+                eliminations.emplace_back(players->at(i)->getPName(), turnCount);
+                releasePlayer(players->at(i));
                 players->erase(players->begin() + i);
 
-                cout << "Waiting for input before continuing (enter 0)..." << endl;
-                int val;
-                cin >> val;
+                co_await waitForInput();
             }
         }
         gameOver = checkForWin();
+
+        if (telemetry != nullptr) {
+            telemetry->recordTurn(*players, gameMap->getContinentGraph());
+        }
+
+        if (!gameOver && stalemateTurns > 0) {
+            if (!boardStates.insert(gameMap->getStateHash()).second) {
+                cout << "The board is back to a state it was already in - draw" << endl;
+                break;
+            }
+
+            if (gameMap->getOwnershipHash() == lastOwnershipHash) {
+                turnsWithoutConquest++;
+            } else {
+                lastOwnershipHash = gameMap->getOwnershipHash();
+                turnsWithoutConquest = 0;
+            }
+            if (turnsWithoutConquest >= stalemateTurns) {
+                cout << "No territory changed owner in " << turnsWithoutConquest << " turns - draw" << endl;
+                break;
+            }
+        }
+
         if(!gameOver && turnCount < maxTurns){
             for(Player* player: *players){
                 player->clearPlayerFriends();
@@ -1001,7 +1481,7 @@ void GameEngine::mainGameLoop() {
                     }
                     else {
                         deck->draw(*player->getHand());
-                        cout << *player->getPName() << " drew a card!" << endl;
+                        cout << player->getPName() << " drew a card!" << endl;
                     }
                     player->setConqueredTerritoryInTurn(false);
                 }
@@ -1013,11 +1493,14 @@ void GameEngine::mainGameLoop() {
         }
     }
 
-    transition("win");
+    // The index covers the game even if the program stops before the next one
+    if (indexedLog != nullptr) {
+        indexedLog->checkpoint();
+    }
+
+    transition(EngineState::win);
 
-    cout << "Waiting for input before continuing (enter 0)..." << endl;
-    int val;
-    cin >> val;
+    co_await waitForInput();
 }
 
 void GameEngine::reinforcementPhase(){
@@ -1030,73 +1513,71 @@ void GameEngine::reinforcementPhase(){
         int currentNumberToGive = max(3, static_cast<int>(floor(static_cast<float>(player->getTerritories()->size())/3.0)));
 
         //Give to player an amount of armies depending of the continents they own (owning a continent means having all territories on that continent)
-        for(auto i = 1; i <= gameMap->getContinentsSize(); i++){
-
-            if(gameMap->getContinentByID(i)->isCompletelyOwned(*player)){
-                currentNumberToGive += gameMap->getContinentByID(i)->getArmyBonusNumber();
-            }
-
-        }
+        //The continent graph keeps the owners of the continents, so this does not look at the territories
+        currentNumberToGive += gameMap->getContinentGraph().getContinentBonus(*player);
 
         cout << "\nplayer->getTerritories()->size(): " << player->getTerritories()->size() << endl;
-        cout << "Giving " << currentNumberToGive << " armies to " << *player->getPName() << endl;
+        cout << "Giving " << currentNumberToGive << " armies to " << player->getPName() << endl;
 
         //Increasing the reinforcement pool of the player with the amounts calculated above
         player->increasePool(currentNumberToGive);
 
-        cout << "Current number of armies: " << *player->getReinforcementPool() << endl;
+        cout << "Current number of armies: " << player->getReinforcementPool() << endl;
     }
 }
 
 void GameEngine::issueOrdersPhase(){
+    issueOrders().get();
+}
+
+Task<void> GameEngine::issueOrders(){
     cout << "\n*****************************Starting Issuing Phase ...*****************************\n" << endl;
-    vector<int> multipliers = {1000,100,10,9,8,7,6,5,4,3,2};
+    activeEngine = this;
+    isIssuingOrders = true;
     for(auto & player : *players){ //for each player
-        cout << "\n**********issueOrdersPhase() for player " << *player->getPName() << endl;
+        cout << "\n**********issueOrdersPhase() for player " << player->getPName() << endl;
             //Issue orders related to defend the player's territories
-            vector<tuple<Territory*,Territory*,string>> territoriesToDefend = player->toDefend();
+            vector<tuple<Territory*,Territory*,string>> territoriesToDefend = co_await player->toDefendAsync(*input);
         cout << "\n\nIssuing orders for defend" << endl;
             for(auto& territoryTuple: territoriesToDefend){
                 if(get<2>(territoryTuple) == "airlift"){
-                    cout << "\nIssuing airlift order for player " << *player->getPName() << endl;
-                    player->getHand()->getHandsCards()->at(player->hasCard(3))->play(*deck, *player, &territoryTuple,
-                                                                                     *log);
+                    cout << "\nIssuing airlift order for player " << player->getPName() << endl;
+                    co_await player->getHand()->getHandsCards()->at(player->hasCard(3))->playAsync(*deck, *player, &territoryTuple, *input);
                 }
                 else if(get<2>(territoryTuple) == "deploy"){
-                    cout << "\nIssuing deploy order for player " << *player->getPName() << endl;
-                    player->issueOrder(&territoryTuple, *log);
+                    cout << "\nIssuing deploy order for player " << player->getPName() << endl;
+                    co_await player->issueOrderAsync(&territoryTuple, *input);
                 }
                 else if(get<2>(territoryTuple) == "negotiate"){
-                    cout << "\nIssuing negotiate order for player " << *player->getPName() << endl;
-                    player->getHand()->getHandsCards()->at(player->hasCard(4))->play(*deck, *player, &territoryTuple,
-                                                                                     *log);
+                    cout << "\nIssuing negotiate order for player " << player->getPName() << endl;
+                    co_await player->getHand()->getHandsCards()->at(player->hasCard(4))->playAsync(*deck, *player, &territoryTuple, *input);
                 }
                 else if(get<2>(territoryTuple) == "blockade"){
-                    cout << "\nIssuing blockade order for player " << *player->getPName() << endl;
+                    cout << "\nIssuing blockade order for player " << player->getPName() << endl;
                     if(this->getNeutralPlayer() == nullptr) {
                         Player *neutralPlyr = new Player("Neutral", new NeutralPlayerStrategy());
                         setNeutralPlayer(neutralPlyr);
                         players->emplace_back(neutralPlyr);
                         cout << "Created new Neutral player due to Blockade" << endl;
                     }
-                    player->getHand()->getHandsCards()->at(player->hasCard(2))->play(*deck, *player, &territoryTuple, *log);
+                    co_await player->getHand()->getHandsCards()->at(player->hasCard(2))->playAsync(*deck, *player, &territoryTuple, *input);
                 }
                 else if(get<2>(territoryTuple) == "advance"){
-                    cout << "\nIssuing advance order for player " << *player->getPName() << endl;
-                    player->issueOrder(&territoryTuple, *log);
+                    cout << "\nIssuing advance order for player " << player->getPName() << endl;
+                    co_await player->issueOrderAsync(&territoryTuple, *input);
                 }
             }
             //Issue the orders related to attack other territories
         cout << "\n\nIssuing orders for attack" << endl;
-            for(auto& territoryTuple: player->toAttack()){
+            vector<tuple<Territory*,Territory*,string>> territoriesToAttack = co_await player->toAttackAsync(*input);
+            for(auto& territoryTuple: territoriesToAttack){
                 if(get<2>(territoryTuple) == "advance"){
-                    cout << "\nIssuing advance order for player " << *player->getPName() << endl;
-                    player->issueOrder(&territoryTuple, *log);
+                    cout << "\nIssuing advance order for player " << player->getPName() << endl;
+                    co_await player->issueOrderAsync(&territoryTuple, *input);
                 }
                 else if(get<2>(territoryTuple) == "bomb"){
-                    cout << "\nIssuing bomb order for player " << *player->getPName() << endl;
-                    player->getHand()->getHandsCards()->at(player->hasCard(0))->play(*deck, *player, &territoryTuple,
-                                                                                     *log);
+                    cout << "\nIssuing bomb order for player " << player->getPName() << endl;
+                    co_await player->getHand()->getHandsCards()->at(player->hasCard(0))->playAsync(*deck, *player, &territoryTuple, *input);
                 } else if (get<2>(territoryTuple) == "cheating") {
                     cout << "\n Shh.. The cheater is cheating, he will conquer 1 random neighbor territory" << endl;
                     if(get<1>(territoryTuple)->getOwner())
@@ -1105,21 +1586,23 @@ void GameEngine::issueOrdersPhase(){
                 }
             }
     }
+    activeEngine = nullptr;
+    isIssuingOrders = false;
 }
 
 //For each player, executes the deploy orders first from their respective orderlist and then the other orders
 void GameEngine::executeOrdersPhase(){
     cout << "\n*****************************Executing Orders Phase ...*****************************\n" << endl;
     cout << "\n%%% Map Before Execution %%%" << endl;
-    cout << gameMap << endl;
+    mapRenderer.render(cout, *gameMap);
     for(Player* player : *players) {
         //execute deploy orders first
-        cout << "\n**************executeOrdersPhase --> Player: " << *player->getPName() << " | NumOrders: "
+        cout << "\n**************executeOrdersPhase --> Player: " << player->getPName() << " | NumOrders: "
              << player->getOrdersList()->getOrders()->size() << endl;
-        cout << "\nExecuting deploy orders for player " << *player->getPName() << endl;
+        cout << "\nExecuting deploy orders for player " << player->getPName() << endl;
         int loopIndex = 0;
         while (loopIndex < player->getOrdersList()->getOrders()->size()) {
-            if (player->getOrdersList()->getOrders()->at(loopIndex)->getDescription()->find("deploy") !=
+            if (player->getOrdersList()->getOrders()->at(loopIndex)->getDescription().find("deploy") !=
                 std::string::npos) {
                 player->getOrdersList()->getOrders()->at(loopIndex)->execute();
                 delete player->getOrdersList()->getOrders()->at(loopIndex);
@@ -1129,36 +1612,39 @@ void GameEngine::executeOrdersPhase(){
             }
             }
     }
-    //execute the other orders after in a round-robin fashion
-    int loopIndex = 0;
-    int maxOrderToExecute = 0;
+    //execute the other orders after in a round-robin fashion: the sequence takes the next order of every player in
+    //turn, and the scheduler executes the orders of the sequence that do not conflict at the same time
+    size_t maxOrderToExecute = 0;
     for(Player* player: *players){
-        int sizeOfOrdersList = player->getOrdersList()->getOrders()->size();
-        if(sizeOfOrdersList > maxOrderToExecute){
-            maxOrderToExecute = sizeOfOrdersList;
-        }
+        maxOrderToExecute = std::max(maxOrderToExecute, player->getOrdersList()->getOrders()->size());
     }
+    vector<Order*> sequence;
     //Number of round-robins to do
-    for(int i = 0; i < maxOrderToExecute; i++){
+    for(size_t i = 0; i < maxOrderToExecute; i++){
         for(Player* player: *players){
-            cout << "\nExecuting order for player " << *player->getPName() << endl;
-            //Checks if the player has any order left in their orders list
-            if(player->getOrdersList()->getOrders()->size() != 0){
-                player->getOrdersList()->getOrders()->at(loopIndex)->execute();
-                delete player->getOrdersList()->getOrders()->at(loopIndex);
-                player->getOrdersList()->getOrders()->erase(player->getOrdersList()->getOrders()->begin());
+            //Checks if the player has an order left for this round
+            if(i < player->getOrdersList()->getOrders()->size()){
+                sequence.push_back(player->getOrdersList()->getOrders()->at(i));
             }
         }
     }
+    cout << "\nExecuting " << sequence.size() << " orders in round-robin order" << endl;
+    OrderScheduler(ThreadPool::shared()).execute(sequence, GameRandom::current().next());
+    for(Player* player: *players){
+        for(Order* order: *player->getOrdersList()->getOrders()){
+            delete order;
+        }
+        player->getOrdersList()->getOrders()->clear();
+    }
     cout << "\n%%% Map After Execution %%%" << endl;
-    cout << gameMap << endl;
+    mapRenderer.render(cout, *gameMap);
 }
 
 //Checks if the player owns all the territories of the game map
 bool GameEngine::checkForWin(){
     for(auto i = 0; i < players->size(); i++){
         if(players->at(i)->getTerritories()->size() == gameMap->getSize()){
-            cout << "Player "<< *players->at(i)->getPName() << " has captured all territories and won!" << endl;
+            cout << "Player "<< players->at(i)->getPName() << " has captured all territories and won!" << endl;
             return true;
         }
     }
@@ -1168,15 +1654,15 @@ bool GameEngine::checkForWin(){
 bool GameEngine::startupPhase() {
     cout << "\nStartup phase\n" << endl;
 
-    vector<string> states = vector{string("assignreinforcement")};
+    vector<EngineState> states = {EngineState::assignReinforcement};
 
     return readingCommands(states);
 }
 
-bool GameEngine::readingCommands(const vector<string> &states) {
+bool GameEngine::readingCommands(const vector<EngineState> &states) {
     printActionsIfNeeded();
-    Command *nextCommand = commandProcessor->getCommand(*this, *log);;
-    tuple<bool, string, string> commandProcessorResult;
+    Command *nextCommand = commandProcessor->getCommand(*this);;
+    tuple<bool, CommandType, string> commandProcessorResult;
 
     while (true) {
         if (nextCommand == nullptr) {
@@ -1190,27 +1676,20 @@ bool GameEngine::readingCommands(const vector<string> &states) {
         if (get<0>(commandProcessorResult)) {
             // Command is valid, execute action given the state
 
-            nextCommand->saveEffect(get<2>(descriptionMap->at(get<1>(commandProcessorResult))), true);
+            nextCommand->saveEffect(string(commandInfo(get<1>(commandProcessorResult)).effect), true);
 
-            std::invoke(
-                    functionMap->at(get<1>(commandProcessorResult)).first, // Command name - as a string
-                    this, // Object being called
-                    functionMap->at(get<1>(commandProcessorResult)).second, // Pair of function reference and transition state
-                    *nextCommand->getCommandArgs() // Arguments
-            );
+            executeCommand(get<1>(commandProcessorResult), nextCommand->getCommandArgs());
 
         } else {
             // Report bad input
             nextCommand->saveEffect(get<2>(commandProcessorResult), false);
             cerr << "BAD INPUT! " << get<2>(commandProcessorResult) << endl;
-            cerr << "Remaining in state " << *getCurrentState() << endl;
+            cerr << "Remaining in state " << currentState << endl;
         }
 
-        for (const string &state: states) {
-            if (*currentState == state) {
-                cout << "Waiting for input before continuing (enter 0)..." << endl;
-                int val;
-                cin >> val;
+        for (EngineState state: states) {
+            if (currentState == state) {
+                waitForInput().get();
                 return false;
             }
         }
@@ -1218,11 +1697,108 @@ bool GameEngine::readingCommands(const vector<string> &states) {
         printActionsIfNeeded();
 
         // Get next command from command processor
-        nextCommand = commandProcessor->getCommand(*this, *log);
+        nextCommand = commandProcessor->getCommand(*this);
     }
 }
 
 string GameEngine::stringToLog() const {
-    std::string message =  std::string("The state of the game engine has been changed, it is now at: ") + std::string(*currentState);
+    std::string message =  std::string("The state of the game engine has been changed, it is now at: ") + std::string(stateName(currentState));
     return message;
 }
+
+// Waits for the user to enter a value before going on, unless the engine runs without a user.
+Task<void> GameEngine::waitForInput() {
+    if (!waitsForInput) {
+        co_return;
+    }
+    input->prompts() << "Waiting for input before continuing (enter 0)..." << endl;
+    try {
+        co_await input->nextWord();
+    } catch (InputClosedError &error) {
+        // Nobody is left to wait for
+    }
+}
+
+// Validates and executes one command line. The engine may share its thread with other engines, so whoever resumes it
+// makes it current on the thread first (see ThreadScope).
+Task<bool> GameEngine::runCommand(string commandLine, string &result) {
+    Command command(commandLine);
+    auto [isValid, type, reason] = commandProcessor->validate(*this, command);
+    if (isValid) {
+        command.saveEffect(string(commandInfo(type).effect), true);
+        executeCommand(type, command.getCommandArgs());
+        result = command.getCommandEffect();
+
+        if (currentState == EngineState::assignReinforcement) {
+            if (turnLimit > 0) {
+                maxTurns = turnLimit;
+                turnCount = 0;
+            }
+            co_await playGame();
+
+            string winner;
+            for (Player *player: *players) {
+                if (player->getTerritories()->size() == gameMap->getSize()) {
+                    winner = player->getPName();
+                }
+            }
+            result += winner.empty() ? " Game over: draw" : " Game over: " + winner + " won";
+            if (turnLimit > 0) {
+                result += " after " + to_string(turnCount) + " turns";
+            }
+        } else if (currentState == EngineState::start) {
+            // A replay starts from an empty game
+            setPlayers({});
+            deck->setDeck(Deck(20));
+        }
+    } else {
+        command.saveEffect(reason, false);
+        result = reason;
+    }
+    co_return isValid;
+}
+
+InputChannel *GameEngine::getInput() const {
+    return input;
+}
+
+void GameEngine::setInput(InputChannel *channel) {
+    input = channel;
+}
+
+void GameEngine::setWaitsForInput(bool waits) {
+    waitsForInput = waits;
+}
+
+void GameEngine::setTurnLimit(int turns) {
+    turnLimit = turns < 0 ? 0 : turns;
+}
+
+void GameEngine::setTournamentFileSuffix(const string &suffix) {
+    tournamentFileSuffix = suffix;
+}
+
+// The suffix goes before the extension of the file name, so "../log/tournamentlog.txt" becomes
+// "../log/tournamentlog<suffix>.txt".
+string GameEngine::tournamentFilePath(const string &path) const {
+    size_t extension = path.rfind('.');
+    if (extension == string::npos || extension < path.rfind('/') + 1) {
+        return path + tournamentFileSuffix;
+    }
+    return path.substr(0, extension) + tournamentFileSuffix + path.substr(extension);
+}
+
+GameEngine::ThreadScope::ThreadScope(GameEngine &engine)
+        : engine(engine), previousRegistry(ObserverRegistry::current()), previousNeutralPlayer(neutralPlayer),
+          previousActiveEngine(activeEngine) {
+    ObserverRegistry::setCurrent(&engine.observers);
+    neutralPlayer = engine.ownNeutralPlayer;
+    activeEngine = engine.isIssuingOrders ? &engine : nullptr;
+}
+
+GameEngine::ThreadScope::~ThreadScope() {
+    engine.ownNeutralPlayer = neutralPlayer;
+    neutralPlayer = previousNeutralPlayer;
+    activeEngine = previousActiveEngine;
+    ObserverRegistry::setCurrent(previousRegistry);
+}
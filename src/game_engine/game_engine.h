@@ -8,8 +8,16 @@
 #include "command_processor/command_processing.h"
 #include "player/player.h"
 #include "map/map.h"
+#include "map/map_cache.h"
+#include "map/map_renderer.h"
+#include "game_state/map_topology.h"
 #include "observer/logging_observer.h"
 #include "game_log/log_observer.h"
+#include "game_log/indexed_log.h"
+#include "game_log/game_telemetry.h"
+#include "game_engine/engine_state_machine.h"
+#include "tournament/tournament_journal.h"
+#include "tournament/tournament_results.h"
 
 using namespace std;
 
@@ -18,25 +26,20 @@ using namespace std;
 
 class GameEngine : public Subject, public ILoggable {
 // Defining a type of pointer to any void and two params (the transition state and the arguments of the command to be executed).
-    typedef void (GameEngine::*Game_Engine_Mem_Fn)(const string &transitionState, const vector<string *> &commandArgs);
+    typedef void (GameEngine::*Game_Engine_Mem_Fn)(EngineState transitionState, const vector<string> &commandArgs);
 
 private:
     // An observer
     LogObserver* log;
 
-    // A string which holds the current state in which the game is (e.g. players added or issue orders).
-    string *currentState;
+    // The observer keeping the executed orders in the indexed game log (nullptr if it is not written).
+    IndexedLogObserver* indexedLog;
 
-    // A map of states to a vector of possible actions that can be taken from that state.
-    map<string, vector<string> *> *stateMap;
+    // The observers of the game, by kind of event. The registry is current on the thread running the engine.
+    ObserverRegistry observers;
 
-    // A map of action keywords to a tuple of the action description, the amount of arguments needed for the action, and
-    // the description of the effect of the action.
-    map<string, tuple<string, int, string>> *descriptionMap;
-
-    // A map of action trigger keywords to the corresponding method that will handle the action and the transition state
-    // the game will be in after the action is executed.
-    map<string, pair<Game_Engine_Mem_Fn, string>> *functionMap;
+    // The current state in which the game is (e.g. players added or issue orders).
+    EngineState currentState;
 
     // An object used to process the commands given to set up the game.
     CommandProcessor *commandProcessor;
@@ -44,14 +47,33 @@ private:
     // A string which indicates whether the commands to start the game will be taken in via the console or from a file.
     string *commandReadMode;
 
+    // The script run in batch mode (nullptr when reading from the console or line by line from a file).
+    CommandScript *commandScript;
+
+    // The arguments of the script command being executed. The strings are reused from one command to the next.
+    vector<string> scriptArgs;
+
     //A collection of players present in the game.
     std::vector<Player *> *players;
 
     //The map the players will fight on.
     Map *gameMap;
 
+    // Prints the map before and after the execution of the orders, with only what changed in between full dumps.
+    MapDeltaRenderer mapRenderer;
+
+    // A map of the tournament: the name it was listed under, and the map loaded once through the map cache. Every game
+    // plays on a fresh copy of it, and shares its topology.
+    struct TournamentMap {
+        string name;
+        shared_ptr<const LoadedMap> loadedMap;
+    };
+
     // The ordered collection of Maps for use in the tournament
-    vector<Map *> *tournamentMaps;
+    vector<TournamentMap> tournamentMaps;
+
+    // The topology of the current map when it is a tournament map (nullptr otherwise)
+    shared_ptr<const MapTopology> mapTopology;
 
     // The ordered collection of Player strategies for use in the tournament
     vector<string> *tournamentPlayerStrategies;
@@ -59,15 +81,62 @@ private:
     //The deck from which the players will draw cards
     Deck *deck;
 
-    //The neutral player of the game (if they exist yet)
-    static Player *neutralPlayer;
+    //The neutral player of the game (if they exist yet). A thread plays one game at a time, so each has its own.
+    static thread_local Player *neutralPlayer;
+
+    // The engine issuing orders on the current thread, so that strategies can look at the whole game
+    static thread_local GameEngine *activeEngine;
+
+    // The number of worker processes playing the games of a tournament (0 to play them in this process)
+    static int tournamentWorkers;
 
     // The turn count of the current game
     int turnCount;
 
+    // The players eliminated in the current game, with the turn they were eliminated in
+    vector<pair<string, int>> eliminations;
+
+    // The name of the telemetry file of the next game (empty to number the game instead)
+    string telemetryName;
+
     // The maximum number of turns allowed in tournament play
     int maxTurns;
 
+    // The number of turns without any territory changing owner after which a tournament game is a draw (0 to play
+    // until maxTurns). A game is also a draw as soon as the board repeats a state it was in at the end of a turn.
+    int stalemateTurns;
+
+    // The neutral player of this engine, and whether it was issuing orders, kept while the engine is not playing on the
+    // thread (see ThreadScope)
+    Player *ownNeutralPlayer;
+    bool isIssuingOrders;
+
+    // Where the users of the game answer what the engine and the human players ask them (the console unless set)
+    InputChannel *input;
+
+    // True if the engine waits for the user to enter a value after an elimination and at the end of a game
+    bool waitsForInput;
+
+    // The number of turns after which a game started with gamestart is a draw (0 to play until a player wins)
+    int turnLimit;
+
+    // Added to the names of the tournament log, journal and results files, so that engines playing tournaments at the
+    // same time do not write the same files (empty for the files shared with the next run)
+    string tournamentFileSuffix;
+
+    // Returns the path of a tournament file with the suffix of the engine added before its extension.
+    [[nodiscard]] string tournamentFilePath(const string &path) const;
+
+    // The journal of the tournament being resumed, whose games are not played again (nullptr for a new tournament)
+    TournamentJournal *resumedJournal;
+
+    // Waits for the user to enter a value before going on, unless the engine runs without a user
+    Task<void> waitForInput();
+
+    // The main game loop and its issue orders phase, suspending whenever a human player waits for their user
+    Task<void> playGame();
+    Task<void> issueOrders();
+
     // Defining the output operator for the GameEngine object.
     friend std::ostream &operator<<(std::ostream &stream, const GameEngine &ge);
 
@@ -75,61 +144,100 @@ private:
     // between two GameEngine objects.
     void swap(GameEngine &first, GameEngine &second);
 
+    // Deletes a player owned by the engine.
+    void releasePlayer(Player *player);
+
     // A function which will load the game map using the map class. It takes in the transition state the game will be in
     // after the method is executed and the arguments of the command that triggered the execution of this method.
-    void loadMap(const string &transitionState, const vector<string *> &commandArgs);
+    void loadMap(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will set up a new tournament. It takes in the transition state the game will be in
     // after the method is executed and the arguments of the command that triggered the execution of this method.
-    void tournament(const string &transitionState, const vector<string *> &commandArgs);
+    void tournament(EngineState transitionState, const vector<string> &commandArgs);
+
+    // A function which will set up a new tournament that stops playing a map once its outcome is decided at a given
+    // confidence level. It takes in the transition state the game will be in after the method is executed and the
+    // arguments of the command that triggered the execution of this method.
+    void adaptiveTournament(EngineState transitionState, const vector<string> &commandArgs);
+
+    // A function which will go on with the last tournament started, from the games recorded in its journal. It takes
+    // in the transition state the game will be in after the method is executed and the arguments of the command that
+    // triggered the execution of this method.
+    void resumeTournament(EngineState transitionState, const vector<string> &commandArgs);
+
+    // Returns the names of the players of a tournament game, numbered in the order of the tournament strategies
+    [[nodiscard]] vector<string> tournamentPlayerNames() const;
+
+    // Returns the line starting the log of a tournament game
+    [[nodiscard]] string tournamentGameHeader(int mapIndex, int gameIndex) const;
+
+    // Validates the arguments shared by the tournament commands and loads the maps and players of the tournament
+    bool parseTournamentCommand(const vector<string> &commandArgs, int maxGamesPerMap, int &gamesPerMap);
+
+    // Validates the optional "-S <stalemateturns>" arguments of a tournament command, starting at the given index
+    bool parseStalemateTurns(const vector<string> &commandArgs, size_t index);
 
     // A function which will validate the game map using the map class. It takes in the transition state the game will
     // be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void validateMap(const string &transitionState, const vector<string *> &commandArgs);
+    void validateMap(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will add a player to the game using the player class. It takes in the transition state the game
     // will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void addPlayer(const string &transitionState, const vector<string *> &commandArgs);
+    void addPlayer(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will assign each country to a player using the map class and will then start the game. It takes
     // in the transition state the game will be in after the method is executed and the arguments of the command that
     // triggered the execution of this method.
-    void gameStart(const string &transitionState, const vector<string *> &commandArgs);
+    void gameStart(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will allow the issuing of an order using the orders_list class. It takes in the transition state
     // the game will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void issueOrder(const string &transitionState, const vector<string *> &commandArgs);
+    void issueOrder(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will quit the order issuing phase using the orders_list class. It takes in the transition state
     // the game will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void issueOrdersEnd(const string &transitionState, const vector<string *> &commandArgs);
+    void issueOrdersEnd(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will allow the execution of an order using the orders_list class. It takes in the transition state
     // the game will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void execOrder(const string &transitionState, const vector<string *> &commandArgs);
+    void execOrder(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will quit the order execution phase using the orders_list class. It takes in the transition state
     // the game will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void endExecOrders(const string &transitionState, const vector<string *> &commandArgs);
+    void endExecOrders(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will signal the quit of the current game once a player controls all the countries. It takes in
     // the transition state the game will be in after the method is executed and the arguments of the command that
     // triggered the execution of this method.
-    void win(const string &transitionState, const vector<string *> &commandArgs);
+    void win(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will start a new game after the current game has ended. It takes in the transition state the game
     // will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void replay(const string &transitionState, const vector<string *> &commandArgs);
+    void replay(EngineState transitionState, const vector<string> &commandArgs);
 
     // A function which will start the shut-down process of the game once the current game has ended. It takes in the
     // transition state the game will be in after the method is executed and the arguments of the command that triggered the execution of this method.
-    void quit(const string &transitionState, const vector<string *> &commandArgs);
+    void quit(EngineState transitionState, const vector<string> &commandArgs);
+
+    // The method handling each command, indexed by CommandType.
+    static constexpr Game_Engine_Mem_Fn COMMAND_HANDLERS[NUM_COMMAND_TYPES] = {
+            &GameEngine::loadMap, &GameEngine::tournament, &GameEngine::adaptiveTournament,
+            &GameEngine::resumeTournament, &GameEngine::validateMap, &GameEngine::addPlayer, &GameEngine::gameStart, &GameEngine::issueOrder, &GameEngine::issueOrdersEnd,
+            &GameEngine::execOrder, &GameEngine::endExecOrders, &GameEngine::win, &GameEngine::replay, &GameEngine::quit
+    };
 
-    // A function which sets the player's strategy
-    PlayerStrategy &getStrategyObjectByStrategyName(string &name);
+    // Runs the handler of a command, which moves the engine to the transition state of the command if it succeeds.
+    void executeCommand(CommandType type, const vector<string> &commandArgs);
 
-    // Starts the tournament with a provided number of games per map and limit on number of turns in each game
-    void startTournament(int gamesPerMap, int maxTurns);
+    // A function which creates the strategy of a player from its name, or returns nullptr if the name is neither a
+    // strategy nor a loaded strategy parameter set
+    PlayerStrategy *getStrategyObjectByStrategyName(const string &name);
+
+    // Starts the tournament with a provided number of games per map and limit on number of turns in each game. With a
+    // confidence level, the tournament is adaptive and gamesPerMap is the maximum number of games played on each map.
+    // The result of every game is added to the journal of the tournament, started from the arguments of the command
+    // unless the tournament is resumed
+    void startTournament(const vector<string> &commandArgs, int gamesPerMap, int maxTurns, double confidence = 0);
 
 public:
 
@@ -140,6 +248,9 @@ public:
     // A copy constructor.
     GameEngine(const GameEngine &ge);
 
+    // A move constructor.
+    GameEngine(GameEngine &&ge) noexcept;
+
     // Defining the assignment operator.
     GameEngine &operator=(GameEngine ge);
 
@@ -147,28 +258,13 @@ public:
     ~GameEngine();
 
     // Getter for currentState.
-    [[nodiscard]] string *getCurrentState() const;
-
-    // Setter for currentState
-    void transition(const string &state);
-
-    // Getter for stateMap.
-    [[nodiscard]] map<string, vector<string> *> *getStateMap() const;
-
-    // Setter for mapOfStates.
-    void setStateMap(const map<string, vector<string> *> &mapOfStates);
-
-    // Getter for descriptionMap.
-    [[nodiscard]] map<string, tuple<string, int, string>> *getDescriptionMap() const;
-
-    // Setter for descriptionMap.
-    void setDescriptionMap(const map<string, tuple<string, int, string>> &descriptionMap);
+    [[nodiscard]] EngineState getCurrentState() const;
 
-    // Getter for functionMap.
-    [[nodiscard]] map<string, pair<GameEngine::Game_Engine_Mem_Fn, string>> *getFunctionMap() const;
+    // Getter for the name of currentState, for display.
+    [[nodiscard]] string_view getCurrentStateName() const;
 
-    // Setter for functionMap.
-    void setFunctionMap(const map<string, pair<GameEngine::Game_Engine_Mem_Fn, string>> &functionMap);
+    // Setter for currentState
+    void transition(EngineState state);
 
     // Getter for the commandProcessor.
     [[nodiscard]] CommandProcessor *getCommandProcessor() const;
@@ -185,8 +281,8 @@ public:
     // Getter for the players.
     [[nodiscard]] std::vector<Player*>* getPlayers() const;
 
-    // Setter for the players.
-    void setPlayers(std::vector<Player *> &newPlayers);
+    // Setter for the players, which takes ownership of the given players.
+    void setPlayers(std::vector<Player *> &&newPlayers);
 
     // Getter for the Map.
     [[nodiscard]] Map *getMap() const;
@@ -194,6 +290,24 @@ public:
     // Setter for the Map.
     void setMap(const string &filename);
 
+    // Setter for the Map, which takes ownership of the given map.
+    void setMap(Map *newMap);
+
+    // Getter for the topology of the current map, shared by the games played on it (nullptr if it has none).
+    [[nodiscard]] const shared_ptr<const MapTopology> &getMapTopology() const;
+
+    // Getter for the deck.
+    [[nodiscard]] Deck *getDeck() const;
+
+    // Getter for the observer of the indexed game log (nullptr if the game log is not indexed).
+    [[nodiscard]] IndexedLogObserver *getIndexedLog() const;
+
+    // Getter for the turn count.
+    [[nodiscard]] int getTurnCount() const;
+
+    // Setter for the turn count.
+    void setTurnCount(int turn);
+
     // A function which allows the user to start a game of Risk.
     void start();
 
@@ -224,27 +338,88 @@ public:
     // A function which returns the neutral player (if they exist)
     static Player *getNeutralPlayer();
 
+    // A function which returns the engine issuing orders on the current thread (nullptr outside of the issue orders phase)
+    static GameEngine *getActiveEngine();
+
     // Override class from ILoggable
     string stringToLog() const override;
 
     // Reads the commands
-    bool readingCommands(const vector<string> &states);
+    bool readingCommands(const vector<EngineState> &states);
 
     // Converts a string of comma separated values and stores into a provided vector of strings
     void extractCsv(const string *csvLine, vector<string> &csvVector) const;
 
-    // Reads the value of "-M" parameter when executing the tournament command, storing the corresponding Maps
-    bool parseTournamentMaps(const string &mapsLine) const;
+    // Reads the value of "-M" parameter when executing the tournament command, storing the corresponding Maps. Returns
+    // false if any of the maps cannot be loaded.
+    bool parseTournamentMaps(const string &mapsLine);
 
     // Reads the value of the "-P" parameter when executing the tournament command, saving the player strategie names in a vector
     bool parseTournamentPlayers(const string &playersLine) const;
 
     // Starts the game, whether from regular gameplay or from tournament play
     void gameStart();
+
+    // Validates the arguments of a tournament command and loads the maps and players of the tournament, without
+    // playing it. Returns false if the tournament is invalid.
+    bool configureTournament(const vector<string> &commandArgs, int &gamesPerMap);
+
+    // Getter for the number of maps of the configured tournament.
+    [[nodiscard]] size_t getTournamentMapCount() const;
+
+    // Plays one game of the configured tournament on the map at the given index, writing its log to the given sink.
+    // Returns the name of the winner, or "draw". The outcome of the game is also filled in the given result, if any,
+    // apart from the index of the game.
+    string playTournamentGame(int mapIndex, shared_ptr<LogSink> gameLog, TournamentGameResult *result = nullptr);
+
+    // Setter for the number of worker processes playing the games of a tournament (0 to play them in this process).
+    static void setTournamentWorkers(int workers);
+
+    // Runs every command of the batch script
+    void runScript();
+
+    // Validates and executes one command line. The engine of a server session is driven this way, one command at a
+    // time, instead of reading its commands itself; a command starting a game plays the game to its end, suspending
+    // while a human player waits for their user to answer on the input of the engine. Returns true if the command was
+    // valid. The result holds its effect, or why it is invalid.
+    Task<bool> runCommand(string commandLine, string &result);
+
+    // Getter and setter for where the users of the game answer.
+    [[nodiscard]] InputChannel *getInput() const;
+    void setInput(InputChannel *channel);
+
+    // Setter for whether the engine waits for the user to enter a value after an elimination and at the end of a game.
+    void setWaitsForInput(bool waits);
+
+    // Setter for the number of turns after which a game started with gamestart is a draw (0 for no limit).
+    void setTurnLimit(int turns);
+
+    // Setter for the suffix added to the names of the tournament files of the engine.
+    void setTournamentFileSuffix(const string &suffix);
+
+    // Makes an engine the one playing on the current thread while the scope lasts: its observers, its neutral player
+    // and, if it was issuing orders, the engine itself as the active engine. The thread gets back what it had when the
+    // scope ends. Many suspended games can so be resumed on the same thread, each with its own state.
+    class ThreadScope {
+    private:
+        GameEngine &engine;
+        ObserverRegistry *previousRegistry;
+        Player *previousNeutralPlayer;
+        GameEngine *previousActiveEngine;
+
+    public:
+        explicit ThreadScope(GameEngine &engine);
+
+        ThreadScope(const ThreadScope &scope) = delete;
+        ThreadScope &operator=(const ThreadScope &scope) = delete;
+
+        ~ThreadScope();
+    };
 };
 
 // Free function in order to test the functionality of the GameEngine for assignment #2. Takes in a commandline argument
-// which specifies if the commands are to be read through the console (-console) or from a file (-file <filename>).
+// which specifies if the commands are to be read through the console (-console), from a file (-file <filename>) or
+// from a batch script read at once (-batch <filename>).
 void game_engine_driver(const string &cmdArg);
 
 
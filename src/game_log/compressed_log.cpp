@@ -0,0 +1,114 @@
+#include "compressed_log.h"
+#include "lz_block.h"
+#include <algorithm>
+
+namespace {
+    // Writes a 32-bit value in little-endian order.
+    void writeUint32(ofstream &os, uint32_t value) {
+        char bytes[4] = {static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16),
+                         static_cast<char>(value >> 24)};
+        os.write(bytes, sizeof(bytes));
+    }
+
+    // Reads a 32-bit value in little-endian order. Returns false at the end of the file.
+    bool readUint32(ifstream &is, uint32_t &value) {
+        unsigned char bytes[4];
+        if (!is.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+            return false;
+        }
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        return true;
+    }
+}
+
+/////////////////////// CompressedLogSink class ///////////////////////
+CompressedLogSink::CompressedLogSink(const string &path) {
+    os.open(path, ios::binary);
+    os.write(COMPRESSED_LOG_MAGIC, sizeof(COMPRESSED_LOG_MAGIC) - 1);
+    pending.reserve(BLOCK_SIZE);
+}
+
+CompressedLogSink::~CompressedLogSink() {
+    writePendingBlock();
+}
+
+void CompressedLogSink::appendLine(string_view line) {
+    if (!pending.empty() && pending.size() + line.size() + 1 > BLOCK_SIZE) {
+        writePendingBlock();
+    }
+    pending.append(line);
+    pending.push_back('\n');
+}
+
+void CompressedLogSink::writePendingBlock() {
+    if (pending.empty()) {
+        return;
+    }
+
+    lzCompressBlock(pending, compressed);
+    bool isStored = compressed.size() >= pending.size();
+    const string &payload = isStored ? pending : compressed;
+
+    writeUint32(os, static_cast<uint32_t>(pending.size()));
+    writeUint32(os, static_cast<uint32_t>(payload.size()) | (isStored ? STORED_BLOCK_FLAG : 0));
+    os.write(payload.data(), static_cast<streamsize>(payload.size()));
+    pending.clear();
+}
+
+void CompressedLogSink::writeLine(string_view line) {
+    lock_guard<mutex> lock(writeMutex);
+    appendLine(line);
+}
+
+// Splits the lines so that the blocks keep ending at line breaks.
+void CompressedLogSink::writeBlock(string_view lines) {
+    lock_guard<mutex> lock(writeMutex);
+    while (!lines.empty()) {
+        size_t end = lines.find('\n');
+        if (end == string_view::npos) {
+            end = lines.size();
+        }
+        appendLine(lines.substr(0, end));
+        lines.remove_prefix(min(end + 1, lines.size()));
+    }
+}
+
+void CompressedLogSink::flush() {
+    lock_guard<mutex> lock(writeMutex);
+    writePendingBlock();
+    os.flush();
+}
+
+/////////////////////// CompressedLogReader class ///////////////////////
+CompressedLogReader::CompressedLogReader(const string &path) : is(path, ios::binary), isValidFile(false) {
+    char magic[sizeof(COMPRESSED_LOG_MAGIC) - 1];
+    if (is.read(magic, sizeof(magic))) {
+        isValidFile = string_view(magic, sizeof(magic)) == string_view(COMPRESSED_LOG_MAGIC, sizeof(magic));
+    }
+}
+
+bool CompressedLogReader::isValid() const {
+    return isValidFile;
+}
+
+bool CompressedLogReader::readBlock(CompressedLogBlock &block) {
+    uint32_t storedSize;
+    if (!isValidFile || !readUint32(is, block.rawSize) || !readUint32(is, storedSize)) {
+        return false;
+    }
+    block.isStored = (storedSize & STORED_BLOCK_FLAG) != 0;
+    storedSize &= ~STORED_BLOCK_FLAG;
+    if (block.rawSize > MAX_COMPRESSED_LOG_BLOCK || storedSize > MAX_COMPRESSED_LOG_BLOCK) {
+        return false;
+    }
+    block.payload.resize(storedSize);
+    return static_cast<bool>(is.read(block.payload.data(), static_cast<streamsize>(block.payload.size())));
+}
+
+bool CompressedLogReader::decompress(const CompressedLogBlock &block, string &text) {
+    if (block.isStored) {
+        text = block.payload;
+        return text.size() == block.rawSize;
+    }
+    return lzDecompressBlock(block.payload, block.rawSize, text);
+}
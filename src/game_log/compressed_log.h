@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "log_sink.h"
+
+using namespace std;
+
+// A compressed log file starts with this magic text, followed by blocks. Every block starts with its size once
+// decompressed and its size in the file (4 bytes each, little-endian); the high bit of the size in the file is set
+// when the block is stored as is because compressing it did not make it smaller.
+constexpr char COMPRESSED_LOG_MAGIC[] = "WZLZ1\n";
+constexpr uint32_t STORED_BLOCK_FLAG = 0x80000000u;
+
+// The largest block accepted by the reader, so that a corrupted size cannot exhaust the memory.
+constexpr uint32_t MAX_COMPRESSED_LOG_BLOCK = 256u * 1024 * 1024;
+
+// One block of a compressed log, as read from the file.
+struct CompressedLogBlock {
+    uint32_t rawSize = 0;
+    bool isStored = false;
+    string payload;
+};
+
+// Writes the lines to a file of independently compressed blocks. A block is cut at the end of a line once it holds
+// BLOCK_SIZE bytes, so every block holds whole lines and can be decompressed and searched on its own.
+class CompressedLogSink : public LogSink {
+private:
+    ofstream os;
+    mutex writeMutex;
+
+    // The lines of the block being filled, and the buffer receiving a compressed block.
+    string pending;
+    string compressed;
+
+    // Adds one line (with its line break) to the block being filled. The caller holds writeMutex.
+    void appendLine(string_view line);
+
+    // Compresses the block being filled and writes it to the file. The caller holds writeMutex.
+    void writePendingBlock();
+
+public:
+    // The number of bytes of text in a block.
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    // One param constructor which opens (and truncates) the file at the given path.
+    explicit CompressedLogSink(const string &path);
+
+    // A compressed sink owns its stream, so it cannot be copied.
+    CompressedLogSink(const CompressedLogSink &sink) = delete;
+    CompressedLogSink &operator=(const CompressedLogSink &sink) = delete;
+
+    // Destructor which writes the last block.
+    ~CompressedLogSink() override;
+
+    void writeLine(string_view line) override;
+    void writeBlock(string_view lines) override;
+
+    // Writes the block being filled, even if it is not full, so that everything written so far can be read back.
+    void flush() override;
+};
+
+// Reads the blocks of a compressed log file one after the other.
+class CompressedLogReader {
+private:
+    ifstream is;
+    bool isValidFile;
+public:
+    // One param constructor which opens the file at the given path and checks its magic text.
+    explicit CompressedLogReader(const string &path);
+
+    // Checks if the file was opened and starts with the magic text.
+    [[nodiscard]] bool isValid() const;
+
+    // Reads the next block. Returns false at the end of the file or if the file is truncated.
+    bool readBlock(CompressedLogBlock &block);
+
+    // Decompresses a block into the given text. Returns false if the block is corrupted.
+    static bool decompress(const CompressedLogBlock &block, string &text);
+};
@@ -0,0 +1,133 @@
+#include "game_telemetry.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include "cards/cards.h"
+#include "map/continent_graph.h"
+#include "player/player.h"
+
+// The implementation file of the game telemetry.
+
+namespace {
+    // True if the telemetry files are written.
+    bool isGameTelemetry = false;
+
+    // Appends a number and the separator after it.
+    template<typename Value>
+    void putField(string &text, Value value, char separator) {
+        char digits[24];
+        char *last = to_chars(begin(digits), end(digits), value).ptr;
+        text.append(digits, last);
+        text.push_back(separator);
+    }
+}
+
+GameTelemetry::GameTelemetry(const string &path, const vector<Player *> &players)
+        : os(path, ios::trunc), gamePlayers(players.begin(), players.end()), turn(0),
+          turnArmies(players.size()), turnContinents(players.size()), turnContinentBonuses(players.size()) {
+    for (vector<int32_t> *column: {&turns, &playerIds, &territories, &cards, &continents, &continentBonuses,
+                                   &reinforcementPools}) {
+        column->reserve(ROWS_PER_FLUSH);
+    }
+    armies.reserve(ROWS_PER_FLUSH);
+
+    playerNames.reserve(players.size());
+    for (const Player *player: players) {
+        playerNames.push_back(player->getPName());
+    }
+    os << "turn,player,territories,armies,cards,continents,continent_bonus,reinforcement_pool\n";
+}
+
+GameTelemetry::~GameTelemetry() {
+    flush();
+}
+
+int GameTelemetry::playerId(const Player *player) const {
+    auto slot = find(gamePlayers.begin(), gamePlayers.end(), player);
+    return slot == gamePlayers.end() ? -1 : static_cast<int>(slot - gamePlayers.begin());
+}
+
+void GameTelemetry::recordTurn(const vector<Player *> &players, const ContinentGraph &graph) {
+    turn++;
+
+    // Sum the totals of the continents once for every player, rather than once per territory
+    fill(turnArmies.begin(), turnArmies.end(), 0);
+    fill(turnContinents.begin(), turnContinents.end(), 0);
+    fill(turnContinentBonuses.begin(), turnContinentBonuses.end(), 0);
+    for (int continentId = 1; continentId <= graph.getNumberOfContinents(); continentId++) {
+        int owner = playerId(graph.getOwner(continentId));
+        if (owner >= 0) {
+            turnContinents[owner]++;
+            turnContinentBonuses[owner] += graph.getArmyBonus(continentId);
+        }
+        for (const Player *player: players) {
+            int id = playerId(player);
+            if (id >= 0) {
+                turnArmies[id] += graph.getArmies(continentId, player);
+            }
+        }
+    }
+
+    for (Player *player: players) {
+        int id = playerId(player);
+        if (id < 0) {
+            continue;
+        }
+        turns.push_back(turn);
+        playerIds.push_back(id);
+        territories.push_back(static_cast<int32_t>(player->getTerritories()->size()));
+        armies.push_back(turnArmies[id]);
+        cards.push_back(static_cast<int32_t>(player->getHand()->getHandsCards()->size()));
+        continents.push_back(turnContinents[id]);
+        continentBonuses.push_back(turnContinentBonuses[id]);
+        reinforcementPools.push_back(player->getReinforcementPool());
+    }
+
+    if (turns.size() >= ROWS_PER_FLUSH) {
+        flush();
+    }
+}
+
+bool GameTelemetry::flush() {
+    if (turns.empty()) {
+        return bool(os);
+    }
+
+    string text;
+    text.reserve(turns.size() * 48);
+    for (size_t row = 0; row < turns.size(); row++) {
+        putField(text, turns[row], ',');
+        text += playerNames[playerIds[row]];
+        text.push_back(',');
+        putField(text, territories[row], ',');
+        putField(text, armies[row], ',');
+        putField(text, cards[row], ',');
+        putField(text, continents[row], ',');
+        putField(text, continentBonuses[row], ',');
+        putField(text, reinforcementPools[row], '\n');
+    }
+    os.write(text.data(), static_cast<streamsize>(text.size()));
+    os.flush();
+
+    // Clearing keeps the capacity of the columns for the next rows
+    for (vector<int32_t> *column: {&turns, &playerIds, &territories, &cards, &continents, &continentBonuses,
+                                   &reinforcementPools}) {
+        column->clear();
+    }
+    armies.clear();
+    return bool(os);
+}
+
+string GameTelemetry::telemetryPath(const string &gameName) {
+    error_code error;
+    filesystem::create_directories(TELEMETRY_DIRECTORY, error);
+    return TELEMETRY_DIRECTORY + gameName + ".csv";
+}
+
+void GameTelemetry::setTelemetryEnabled(bool enabled) {
+    isGameTelemetry = enabled;
+}
+
+bool GameTelemetry::isTelemetryEnabled() {
+    return isGameTelemetry;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Forward declarations.
+class Player;
+class ContinentGraph;
+
+// The directory the telemetry files of the games are written to.
+#define TELEMETRY_DIRECTORY "../log/telemetry/"
+
+// The state of every player at the end of every turn of one game, written as a CSV file with one row per player per
+// turn:
+//
+//     turn,player,territories,armies,cards,continents,continent_bonus,reinforcement_pool
+//
+// The values are read from counters the game already keeps up to date (the territories and the hand of a player, and
+// the totals of the continent graph), so a turn costs a few reads per player and continent rather than a scan of the
+// map. The rows are kept in columns reserved up front and written ROWS_PER_FLUSH at a time, and when the game ends.
+// The cards are the cards held once the orders are executed, before the cards of the turn are drawn.
+class GameTelemetry {
+private:
+    ofstream os;
+
+    // The players the game started with: a row names its player by their index here.
+    vector<const Player *> gamePlayers;
+    vector<string> playerNames;
+
+    // The turn of the next rows.
+    int32_t turn;
+
+    // The rows not written yet, column by column.
+    vector<int32_t> turns;
+    vector<int32_t> playerIds;
+    vector<int32_t> territories;
+    vector<int64_t> armies;
+    vector<int32_t> cards;
+    vector<int32_t> continents;
+    vector<int32_t> continentBonuses;
+    vector<int32_t> reinforcementPools;
+
+    // The totals of the turn being recorded, per player of the game.
+    vector<int64_t> turnArmies;
+    vector<int32_t> turnContinents;
+    vector<int32_t> turnContinentBonuses;
+
+    // Returns the index of a player of the game, or -1 if they did not start it.
+    [[nodiscard]] int playerId(const Player *player) const;
+
+public:
+    // The number of rows written together.
+    static constexpr size_t ROWS_PER_FLUSH = 4096;
+
+    // Two param constructor which opens (and truncates) the file at the given path and writes its header, for a game
+    // started by the given players.
+    GameTelemetry(const string &path, const vector<Player *> &players);
+
+    // A telemetry file belongs to one game, so it cannot be copied.
+    GameTelemetry(const GameTelemetry &telemetry) = delete;
+    GameTelemetry &operator=(const GameTelemetry &telemetry) = delete;
+
+    // Destructor which writes the rows still buffered.
+    ~GameTelemetry();
+
+    // Records the state of the players still in the game at the end of the next turn.
+    void recordTurn(const vector<Player *> &players, const ContinentGraph &graph);
+
+    // Writes the rows buffered so far. Returns false if the file cannot be written.
+    bool flush();
+
+    // Returns the path of the telemetry file of the game of the given name, making the directory if needed.
+    static string telemetryPath(const string &gameName);
+
+    // Writes a telemetry file for every game played, which must be chosen before the games are started.
+    static void setTelemetryEnabled(bool enabled);
+
+    // Checks if the telemetry files are written.
+    static bool isTelemetryEnabled();
+};
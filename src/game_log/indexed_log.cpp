@@ -0,0 +1,433 @@
+#include "indexed_log.h"
+#include <algorithm>
+#include <iterator>
+
+#define LOG_DIRECTORY "../"
+
+// The implementation file of the indexed log.
+
+namespace {
+    // True if the indexed game log file is written.
+    bool isIndexedGameLog = false;
+
+    // True if the records of the indexed game log are kept in memory instead of being written to the file.
+    bool isIndexedGameLogInMemory = false;
+
+    // The number of bytes of a block summary in the footer.
+    constexpr size_t SUMMARY_SIZE = 8 + 4 * 5 + 8 + 4 + 8 * (TERRITORY_MASK_BITS / 64) + 1;
+
+    // The number of bytes of the end of the file: the position of the footer and the magic text.
+    constexpr size_t TRAILER_SIZE = 8 + sizeof(INDEXED_LOG_MAGIC) - 1;
+
+    // Appends a value in little-endian order.
+    template<typename Value>
+    void put(string &bytes, Value value) {
+        auto raw = static_cast<uint64_t>(value);
+        for (size_t i = 0; i < sizeof(Value); i++) {
+            bytes.push_back(static_cast<char>(raw >> (8 * i)));
+        }
+    }
+
+    // Reads a value in little-endian order and moves past it.
+    template<typename Value>
+    Value get(const char *&bytes) {
+        uint64_t raw = 0;
+        for (size_t i = 0; i < sizeof(Value); i++) {
+            raw |= static_cast<uint64_t>(static_cast<unsigned char>(*bytes++)) << (8 * i);
+        }
+        return static_cast<Value>(raw);
+    }
+
+    // Returns the id of an order type, or the number of order types if it is unknown.
+    size_t orderTypeId(string_view orderType) {
+        return find(begin(INDEXED_LOG_ORDER_TYPES), end(INDEXED_LOG_ORDER_TYPES), orderType) -
+               begin(INDEXED_LOG_ORDER_TYPES);
+    }
+
+    // Sets the bit of a territory in a mask.
+    void addTerritory(uint64_t *mask, int32_t territory) {
+        if (territory >= 0) {
+            size_t bit = static_cast<size_t>(territory) % TERRITORY_MASK_BITS;
+            mask[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+
+    // Checks the bit of a territory in a mask.
+    bool hasTerritory(const uint64_t *mask, int territory) {
+        size_t bit = static_cast<size_t>(territory) % TERRITORY_MASK_BITS;
+        return (mask[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    // Reads a record.
+    IndexedLogRecord readRecord(const char *&bytes) {
+        IndexedLogRecord record;
+        record.game = get<uint32_t>(bytes);
+        record.turn = get<uint32_t>(bytes);
+        record.player = get<uint32_t>(bytes);
+        record.sourceTerritory = get<int32_t>(bytes);
+        record.targetTerritory = get<int32_t>(bytes);
+        record.orderType = get<uint8_t>(bytes);
+        record.isBattle = get<uint8_t>(bytes) != 0;
+        return record;
+    }
+}
+
+/////////////////////// IndexedLogBlockSummary struct ///////////////////////
+void IndexedLogBlockSummary::add(const IndexedLogRecord &record) {
+    numRecords++;
+    minGame = min(minGame, record.game);
+    maxGame = max(maxGame, record.game);
+    minTurn = min(minTurn, record.turn);
+    maxTurn = max(maxTurn, record.turn);
+    playerMask |= uint64_t{1} << (record.player % 64);
+    orderTypeMask |= uint32_t{1} << record.orderType;
+    addTerritory(territoryMask, record.sourceTerritory);
+    addTerritory(territoryMask, record.targetTerritory);
+    hasBattle = hasBattle || record.isBattle;
+}
+
+/////////////////////// IndexedLogObserver class ///////////////////////
+IndexedLogObserver::IndexedLogObserver(const string &path) : isInMemory(path.empty()), blocksEnd(0), game(0), turn(0) {
+    if (!isInMemory) {
+        os.open(path, ios::binary);
+        os.write(INDEXED_LOG_MAGIC, sizeof(INDEXED_LOG_MAGIC) - 1);
+        blocksEnd = sizeof(INDEXED_LOG_MAGIC) - 1;
+    }
+    pending.reserve(RECORDS_PER_BLOCK * IndexedLogRecord::SIZE);
+}
+
+IndexedLogObserver::~IndexedLogObserver() {
+    checkpoint();
+}
+
+void IndexedLogObserver::fillPendingBlock() {
+    if (pending.empty()) {
+        return;
+    }
+    pendingSummary.offset = blocksEnd + filledBlocks.size();
+    filledBlocks.append(pending);
+    summaries.push_back(pendingSummary);
+    pending.clear();
+    pendingSummary = IndexedLogBlockSummary();
+}
+
+// The filled blocks, the footer (the names of the players and the summaries of the blocks) and the trailer are written
+// at once over the footer of the last checkpoint. The footer only grows, so nothing of the previous one is left after
+// the new trailer. The block being filled is written as a block of its own, so that the footer covers every record.
+void IndexedLogObserver::checkpoint() {
+    if (isInMemory) {
+        return;
+    }
+    fillPendingBlock();
+
+    uint64_t footerOffset = blocksEnd + filledBlocks.size();
+    string &bytes = filledBlocks;
+    put(bytes, static_cast<uint32_t>(playerNames.size()));
+    for (const string &name: playerNames) {
+        put(bytes, static_cast<uint32_t>(name.size()));
+        bytes.append(name);
+    }
+    put(bytes, static_cast<uint32_t>(summaries.size()));
+    for (const IndexedLogBlockSummary &summary: summaries) {
+        put(bytes, summary.offset);
+        put(bytes, summary.numRecords);
+        put(bytes, summary.minGame);
+        put(bytes, summary.maxGame);
+        put(bytes, summary.minTurn);
+        put(bytes, summary.maxTurn);
+        put(bytes, summary.playerMask);
+        put(bytes, summary.orderTypeMask);
+        for (uint64_t bits: summary.territoryMask) {
+            put(bytes, bits);
+        }
+        put(bytes, static_cast<uint8_t>(summary.hasBattle));
+    }
+    put(bytes, footerOffset);
+    bytes.append(INDEXED_LOG_MAGIC, sizeof(INDEXED_LOG_MAGIC) - 1);
+
+    os.seekp(static_cast<streamoff>(blocksEnd));
+    os.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+    os.flush();
+    blocksEnd = footerOffset;
+    filledBlocks.clear();
+}
+
+uint32_t IndexedLogObserver::playerId(const string &name) {
+    auto [slot, isNew] = playerIds.try_emplace(name, static_cast<uint32_t>(playerNames.size()));
+    if (isNew) {
+        playerNames.push_back(name);
+    }
+    return slot->second;
+}
+
+void IndexedLogObserver::startGame() {
+    game++;
+    turn = 0;
+}
+
+void IndexedLogObserver::startTurn() {
+    turn++;
+}
+
+uint32_t IndexedLogObserver::reserveGames(uint32_t count) {
+    uint32_t firstGame = game + 1;
+    game += count;
+    turn = 0;
+    return firstGame;
+}
+
+string IndexedLogObserver::takeGameRecords() {
+    string records;
+    records.swap(gameRecords);
+    return records;
+}
+
+// The records are read twice: once to check them, then to add them, so that a malformed game adds nothing.
+bool IndexedLogObserver::addGameRecords(uint32_t gameNumber, string_view records) {
+    for (bool isChecked: {false, true}) {
+        const char *cursor = records.data();
+        const char *recordsEnd = records.data() + records.size();
+        while (cursor != recordsEnd) {
+            if (recordsEnd - cursor < 8) {
+                return false;
+            }
+            IndexedLogRecord record;
+            record.game = gameNumber;
+            record.turn = get<uint32_t>(cursor);
+            auto length = get<uint32_t>(cursor);
+            if (static_cast<size_t>(recordsEnd - cursor) < size_t{length} + 10) {
+                return false;
+            }
+            string player(cursor, length);
+            cursor += length;
+            record.sourceTerritory = get<int32_t>(cursor);
+            record.targetTerritory = get<int32_t>(cursor);
+            record.orderType = get<uint8_t>(cursor);
+            record.isBattle = get<uint8_t>(cursor) != 0;
+            if (record.orderType == 0 || record.orderType >= size(INDEXED_LOG_ORDER_TYPES)) {
+                return false;
+            }
+            if (isChecked) {
+                addRecord(record, player);
+            }
+        }
+    }
+    checkpoint();
+    return true;
+}
+
+void IndexedLogObserver::addRecord(IndexedLogRecord record, const string &player) {
+    if (isInMemory) {
+        put(gameRecords, record.turn);
+        put(gameRecords, static_cast<uint32_t>(player.size()));
+        gameRecords.append(player);
+        put(gameRecords, record.sourceTerritory);
+        put(gameRecords, record.targetTerritory);
+        put(gameRecords, record.orderType);
+        put(gameRecords, static_cast<uint8_t>(record.isBattle));
+        return;
+    }
+
+    record.player = playerId(player);
+    put(pending, record.game);
+    put(pending, record.turn);
+    put(pending, record.player);
+    put(pending, record.sourceTerritory);
+    put(pending, record.targetTerritory);
+    put(pending, record.orderType);
+    put(pending, static_cast<uint8_t>(record.isBattle));
+    pendingSummary.add(record);
+
+    if (pendingSummary.numRecords == RECORDS_PER_BLOCK) {
+        fillPendingBlock();
+    }
+}
+
+void IndexedLogObserver::Update(const ILoggable &log) {
+    LogFields fields;
+    log.addLogFields(fields);
+    size_t orderType = orderTypeId(fields.orderType);
+    if (fields.orderType.empty() || orderType == size(INDEXED_LOG_ORDER_TYPES)) {
+        return;
+    }
+
+    IndexedLogRecord record;
+    record.game = game;
+    record.turn = turn;
+    record.sourceTerritory = fields.sourceTerritory;
+    record.targetTerritory = fields.targetTerritory;
+    record.orderType = static_cast<uint8_t>(orderType);
+    record.isBattle = fields.isBattle;
+    addRecord(record, fields.player);
+}
+
+string IndexedLogObserver::gameLogPath() {
+    return LOG_DIRECTORY "gamelog.idx";
+}
+
+void IndexedLogObserver::setGameLogIndexed(bool indexed) {
+    isIndexedGameLog = indexed;
+}
+
+bool IndexedLogObserver::isGameLogIndexed() {
+    return isIndexedGameLog;
+}
+
+void IndexedLogObserver::setGameLogInMemory(bool inMemory) {
+    isIndexedGameLogInMemory = inMemory;
+}
+
+bool IndexedLogObserver::isGameLogInMemory() {
+    return isIndexedGameLogInMemory;
+}
+
+/////////////////////// IndexedLogReader class ///////////////////////
+IndexedLogReader::IndexedLogReader(const string &path) : is(path, ios::binary), isValidFile(false) {
+    isValidFile = readFooter();
+}
+
+bool IndexedLogReader::readFooter() {
+    if (!is.seekg(0, ios::end)) {
+        return false;
+    }
+    auto fileSize = static_cast<uint64_t>(is.tellg());
+    if (fileSize < sizeof(INDEXED_LOG_MAGIC) - 1 + TRAILER_SIZE) {
+        return false;
+    }
+
+    string trailer(TRAILER_SIZE, '\0');
+    is.seekg(static_cast<streamoff>(fileSize - TRAILER_SIZE));
+    if (!is.read(trailer.data(), static_cast<streamsize>(trailer.size())) ||
+        trailer.compare(8, string::npos, INDEXED_LOG_MAGIC) != 0) {
+        return false;
+    }
+    const char *cursor = trailer.data();
+    auto footerOffset = get<uint64_t>(cursor);
+    if (footerOffset > fileSize - TRAILER_SIZE) {
+        return false;
+    }
+
+    string footer(fileSize - TRAILER_SIZE - footerOffset, '\0');
+    is.seekg(static_cast<streamoff>(footerOffset));
+    if (!is.read(footer.data(), static_cast<streamsize>(footer.size()))) {
+        return false;
+    }
+
+    // Every size is checked against the bytes left, so that a corrupted footer is rejected
+    cursor = footer.data();
+    const char *footerEnd = footer.data() + footer.size();
+    auto bytesLeft = [&cursor, footerEnd]() { return static_cast<size_t>(footerEnd - cursor); };
+
+    if (bytesLeft() < 4) {
+        return false;
+    }
+    auto numPlayers = get<uint32_t>(cursor);
+    for (uint32_t i = 0; i < numPlayers; i++) {
+        if (bytesLeft() < 4) {
+            return false;
+        }
+        auto length = get<uint32_t>(cursor);
+        if (bytesLeft() < length) {
+            return false;
+        }
+        playerNames.emplace_back(cursor, length);
+        cursor += length;
+    }
+
+    if (bytesLeft() < 4) {
+        return false;
+    }
+    auto numBlocks = get<uint32_t>(cursor);
+    if (bytesLeft() != numBlocks * SUMMARY_SIZE) {
+        return false;
+    }
+    summaries.resize(numBlocks);
+    for (IndexedLogBlockSummary &summary: summaries) {
+        summary.offset = get<uint64_t>(cursor);
+        summary.numRecords = get<uint32_t>(cursor);
+        summary.minGame = get<uint32_t>(cursor);
+        summary.maxGame = get<uint32_t>(cursor);
+        summary.minTurn = get<uint32_t>(cursor);
+        summary.maxTurn = get<uint32_t>(cursor);
+        summary.playerMask = get<uint64_t>(cursor);
+        summary.orderTypeMask = get<uint32_t>(cursor);
+        for (uint64_t &bits: summary.territoryMask) {
+            bits = get<uint64_t>(cursor);
+        }
+        summary.hasBattle = get<uint8_t>(cursor) != 0;
+        if (summary.offset + uint64_t{summary.numRecords} * IndexedLogRecord::SIZE > footerOffset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IndexedLogReader::isValid() const {
+    return isValidFile;
+}
+
+const vector<string> &IndexedLogReader::getPlayerNames() const {
+    return playerNames;
+}
+
+const vector<IndexedLogBlockSummary> &IndexedLogReader::getSummaries() const {
+    return summaries;
+}
+
+bool IndexedLogReader::mayMatch(const IndexedLogBlockSummary &summary, const IndexedLogQuery &query) const {
+    if (summary.maxGame < query.minGame || summary.minGame > query.maxGame || summary.maxTurn < query.minTurn ||
+        summary.minTurn > query.maxTurn || (query.battlesOnly && !summary.hasBattle)) {
+        return false;
+    }
+    if (!query.player.empty()) {
+        auto slot = find(playerNames.begin(), playerNames.end(), query.player);
+        if (slot == playerNames.end() || ((summary.playerMask >> ((slot - playerNames.begin()) % 64)) & 1) == 0) {
+            return false;
+        }
+    }
+    if (!query.orderType.empty()) {
+        size_t orderType = orderTypeId(query.orderType);
+        if (orderType == size(INDEXED_LOG_ORDER_TYPES) || ((summary.orderTypeMask >> orderType) & 1) == 0) {
+            return false;
+        }
+    }
+    return query.territory < 0 || hasTerritory(summary.territoryMask, query.territory);
+}
+
+bool IndexedLogReader::matches(const IndexedLogRecord &record, const IndexedLogQuery &query) const {
+    return record.game >= query.minGame && record.game <= query.maxGame && record.turn >= query.minTurn &&
+           record.turn <= query.maxTurn && (!query.battlesOnly || record.isBattle) &&
+           (query.player.empty() || (record.player < playerNames.size() && playerNames[record.player] == query.player)) &&
+           (query.orderType.empty() || (record.orderType < size(INDEXED_LOG_ORDER_TYPES) &&
+                                        INDEXED_LOG_ORDER_TYPES[record.orderType] == query.orderType)) &&
+           (query.territory < 0 || record.sourceTerritory == query.territory ||
+            record.targetTerritory == query.territory);
+}
+
+// Only the blocks whose summary may hold a match are read; the records of those blocks are then checked one by one.
+size_t IndexedLogReader::query(const IndexedLogQuery &query,
+                               const function<void(const IndexedLogRecord &)> &visitor) const {
+    size_t blocksRead = 0;
+    string block;
+    for (const IndexedLogBlockSummary &summary: summaries) {
+        if (!mayMatch(summary, query)) {
+            continue;
+        }
+        block.resize(summary.numRecords * IndexedLogRecord::SIZE);
+        is.clear();
+        is.seekg(static_cast<streamoff>(summary.offset));
+        if (!is.read(block.data(), static_cast<streamsize>(block.size()))) {
+            break;
+        }
+        blocksRead++;
+
+        const char *cursor = block.data();
+        for (uint32_t i = 0; i < summary.numRecords; i++) {
+            IndexedLogRecord record = readRecord(cursor);
+            if (matches(record, query)) {
+                visitor(record);
+            }
+        }
+    }
+    return blocksRead;
+}
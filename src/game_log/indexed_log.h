@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "observer/logging_observer.h"
+
+using namespace std;
+
+// An indexed log file keeps one fixed-size record per executed order, with the game, the turn, the player, the
+// territories and the type of the order. The records are written in blocks, and the footer at the end of the file
+// summarizes every block (the games and turns it covers, and masks of its players, order types and territories), so a
+// query only reads the blocks whose summary may hold a match.
+//
+// The file starts with the magic text and ends with the position of the footer followed by the magic text again.
+constexpr char INDEXED_LOG_MAGIC[] = "WZIX1\n";
+
+// The kinds of orders, in the order of their id in the records. Id 0 is for events that are not about an order.
+constexpr string_view INDEXED_LOG_ORDER_TYPES[] = {"", "deploy", "advance", "bomb", "blockade", "airlift", "negotiate"};
+
+// The number of bits of the mask of the territories of a block.
+constexpr size_t TERRITORY_MASK_BITS = 256;
+
+// One record of an indexed log.
+struct IndexedLogRecord {
+    uint32_t game = 0;
+    uint32_t turn = 0;
+    // The index of the player in the names of the players of the file.
+    uint32_t player = 0;
+    int32_t sourceTerritory = -1;
+    int32_t targetTerritory = -1;
+    // The index of the type of the order in INDEXED_LOG_ORDER_TYPES.
+    uint8_t orderType = 0;
+    bool isBattle = false;
+
+    // The number of bytes of a record in the file.
+    static constexpr size_t SIZE = 22;
+};
+
+// The summary of one block of records, kept in the footer of the file.
+struct IndexedLogBlockSummary {
+    uint64_t offset = 0;
+    uint32_t numRecords = 0;
+    uint32_t minGame = UINT32_MAX;
+    uint32_t maxGame = 0;
+    uint32_t minTurn = UINT32_MAX;
+    uint32_t maxTurn = 0;
+    // Bit (player % 64) is set if a record of the block is about that player.
+    uint64_t playerMask = 0;
+    // Bit i is set if a record of the block has the order type i.
+    uint32_t orderTypeMask = 0;
+    // Bit (territory % TERRITORY_MASK_BITS) is set if a record of the block is about that territory.
+    uint64_t territoryMask[TERRITORY_MASK_BITS / 64] = {};
+    bool hasBattle = false;
+
+    // Adds a record to the summary.
+    void add(const IndexedLogRecord &record);
+};
+
+// The records a query looks for. A field left to its default value matches every record.
+struct IndexedLogQuery {
+    uint32_t minGame = 0;
+    uint32_t maxGame = UINT32_MAX;
+    uint32_t minTurn = 0;
+    uint32_t maxTurn = UINT32_MAX;
+    string player;
+    // A territory matches both the source and the target of an order.
+    int territory = -1;
+    string orderType;
+    bool battlesOnly = false;
+};
+
+// Keeps the executed orders of the games in an indexed log file. The game engine tells the observer when a game and a
+// turn start, since orders do not know which turn they belong to. The footer is written at every checkpoint, after
+// every game, so the file is a complete index of the games played so far even if the program stops.
+//
+// An observer without a file keeps the records of the current game in memory instead, with the names of their players,
+// so that a tournament worker can send them to the coordinator, which adds them to its own file.
+class IndexedLogObserver : public Observer {
+private:
+    ofstream os;
+
+    // True if the records are kept in memory rather than written to a file.
+    bool isInMemory;
+
+    // The names of the players, and their index in the names.
+    vector<string> playerNames;
+    unordered_map<string, uint32_t> playerIds;
+
+    // The records of the block being filled, the blocks filled since the last checkpoint and the summaries of every
+    // block. The blocks are only written at a checkpoint, over the footer of the previous one.
+    string pending;
+    IndexedLogBlockSummary pendingSummary;
+    string filledBlocks;
+    vector<IndexedLogBlockSummary> summaries;
+
+    // The position in the file of the first block not written yet, where the footer of the last checkpoint starts.
+    uint64_t blocksEnd;
+
+    // The records of the current game kept in memory, in the format of takeGameRecords().
+    string gameRecords;
+
+    // The game and the turn the next records belong to.
+    uint32_t game;
+    uint32_t turn;
+
+    // Moves the block being filled to the filled blocks.
+    void fillPendingBlock();
+
+    // Adds a record about the given player.
+    void addRecord(IndexedLogRecord record, const string &player);
+
+    // Returns the index of a player, adding them to the names if needed.
+    uint32_t playerId(const string &name);
+
+public:
+    // The number of records in a block.
+    static constexpr size_t RECORDS_PER_BLOCK = 512;
+
+    // One param constructor which opens (and truncates) the file at the given path, or keeps the records in memory if
+    // the path is empty.
+    explicit IndexedLogObserver(const string &path);
+
+    // An indexed log observer owns its stream, so it cannot be copied.
+    IndexedLogObserver(const IndexedLogObserver &observer) = delete;
+    IndexedLogObserver &operator=(const IndexedLogObserver &observer) = delete;
+
+    // Destructor which writes a last checkpoint.
+    ~IndexedLogObserver();
+
+    // Starts the next game, at turn 0.
+    void startGame();
+
+    // Starts the next turn of the current game.
+    void startTurn();
+
+    // Writes the blocks filled so far, the records of the block being filled and the footer, and flushes the file.
+    void checkpoint();
+
+    // Takes the numbers of the next count games, for games played elsewhere and added with addGameRecords(), and
+    // returns the number of the first one.
+    uint32_t reserveGames(uint32_t count);
+
+    // Returns the records of the current game kept in memory and forgets them. Every record is its turn, the length of
+    // the name of its player, the name, its territories, its order type and whether it is a battle.
+    string takeGameRecords();
+
+    // Adds the records of a game returned by takeGameRecords() of another observer as the given game, then writes a
+    // checkpoint. Returns false if the records are malformed, in which case none of them is added.
+    bool addGameRecords(uint32_t gameNumber, string_view records);
+
+    // Keeps the event if it is about an order.
+    void Update(const ILoggable &log) override;
+
+    // Returns the path of the indexed game log file.
+    static string gameLogPath();
+
+    // Writes the indexed game log file while games are played, which must be chosen before the game engine is created.
+    static void setGameLogIndexed(bool indexed);
+
+    // Checks if the indexed game log file is written.
+    static bool isGameLogIndexed();
+
+    // Keeps the records of the indexed game log in memory instead of writing the file, as tournament workers do.
+    static void setGameLogInMemory(bool inMemory);
+
+    // Checks if the records of the indexed game log are kept in memory.
+    static bool isGameLogInMemory();
+};
+
+// Answers queries on an indexed log file.
+class IndexedLogReader {
+private:
+    mutable ifstream is;
+    bool isValidFile;
+    vector<string> playerNames;
+    vector<IndexedLogBlockSummary> summaries;
+
+    // Reads the footer of the file. Returns false if the file is not a complete indexed log.
+    bool readFooter();
+
+public:
+    // One param constructor which opens the file at the given path and reads its footer.
+    explicit IndexedLogReader(const string &path);
+
+    // Checks if the file was opened and its footer was read.
+    [[nodiscard]] bool isValid() const;
+
+    // Getters for the names of the players and the summaries of the blocks.
+    [[nodiscard]] const vector<string> &getPlayerNames() const;
+    [[nodiscard]] const vector<IndexedLogBlockSummary> &getSummaries() const;
+
+    // Checks if the summary of a block may hold a record matching the query.
+    [[nodiscard]] bool mayMatch(const IndexedLogBlockSummary &summary, const IndexedLogQuery &query) const;
+
+    // Checks if a record matches the query.
+    [[nodiscard]] bool matches(const IndexedLogRecord &record, const IndexedLogQuery &query) const;
+
+    // Calls the visitor with every record matching the query, in the order they were written. Returns the number of
+    // blocks read from the file.
+    size_t query(const IndexedLogQuery &query, const function<void(const IndexedLogRecord &)> &visitor) const;
+};
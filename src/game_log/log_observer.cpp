@@ -1,84 +1,62 @@
 #include "log_observer.h"
+#include <mutex>
 
 #define LOG_DIRECTORY "../"
 
+// True if the game log file is written compressed.
+static bool isGameLogCompressed = false;
 
-// Default constructor
-LogObserver::LogObserver() {
-    os.open(LOG_DIRECTORY + filename);
-
-    this->_listOfSubjects = new list<Subject*>();
-}
+// True if the game log is kept in memory instead of being written to the file.
+static bool isGameLogInMemory = false;
 
-// Parametrized constructor
-LogObserver::LogObserver(vector<Subject*> *subjectsList) {
-    os.open(LOG_DIRECTORY + filename);
+// Returns the sink of the game log file, opening it if no observer is writing to it anymore.
+static shared_ptr<LogSink> gameLogSink() {
+    static mutex sinkMutex;
+    static weak_ptr<LogSink> openSink;
 
-    this->_listOfSubjects = new list<Subject*>(subjectsList->begin(), subjectsList->end());
-    for(Subject* s : *_listOfSubjects) {
-        s->Attach(this);
+    lock_guard<mutex> lock(sinkMutex);
+    shared_ptr<LogSink> sink = openSink.lock();
+    if (sink == nullptr) {
+        if (isGameLogInMemory) {
+            sink = make_shared<MemoryLogSink>();
+        } else if (isGameLogCompressed) {
+            sink = make_shared<CompressedLogSink>(LOG_DIRECTORY + filename + ".lz");
+        } else {
+            sink = make_shared<FileLogSink>(LOG_DIRECTORY + filename);
+        }
+        openSink = sink;
     }
+    return sink;
 }
 
+// Default constructor
+LogObserver::LogObserver() : sink(gameLogSink()) {}
+
+// One param constructor
+LogObserver::LogObserver(shared_ptr<LogSink> sink) : sink(std::move(sink)) {}
+
 // Copy constructor
-LogObserver::LogObserver(const LogObserver &log) {
-    list<Subject*>::iterator it;
-    for(int i = 0; i < log.getAllSubjects()->size(); i++) {
-        it = log.getAllSubjects()->begin();
-        advance(it,i);
-        Subject* c = new Subject(*(*it));
-        this->_listOfSubjects->emplace_back(c);
-    }
-    this->os.open(LOG_DIRECTORY + filename);
-}
+LogObserver::LogObserver(const LogObserver &log) : sink(log.sink) {}
 
 // Assignment operator
 LogObserver& LogObserver::operator=(const LogObserver& logObserver) {
-    if(this != &logObserver){
-        // Delete all cards in left hand side in case there are already members
-        for(int index = 0; index < this->_listOfSubjects->size(); index++) {
-            this->_listOfSubjects->pop_back();
-        }
-        // add all cards from right hand side to left hand side
-        list<Subject*>::iterator it;
-        for (int i = 0 ; i < logObserver.getAllSubjects()->size(); i++) {
-            it = logObserver.getAllSubjects()->begin();
-            advance(it,i);
-            Subject* c = new Subject(*(*it));
-            this->_listOfSubjects->emplace_back(c);
-        }
+    if (this != &logObserver) {
+        this->sink = logObserver.sink;
     }
-    this->os.open(LOG_DIRECTORY + filename);
     return *this;
 }
 
 // Output operator
 ostream& operator << (ostream& out, const LogObserver& lo) {
-    out << "The log observer contains " << lo._listOfSubjects->size() << " subjects" << endl;
+    out << "The log observer writes to " << LOG_DIRECTORY << filename << endl;
     return out;
 }
 
 // Destructor
 LogObserver::~LogObserver() {
-    os.close();
-    for(Subject* s : *_listOfSubjects) {
-        s->Detach(this);
-        delete s;
+    if (sink != nullptr) {
+        sink->flush();
     }
-    delete _listOfSubjects;
-    _listOfSubjects = nullptr;
-}
-
-// Adding a subject to the list of subjects
-void LogObserver::AddSubject(Subject &subject) {
-    _listOfSubjects->push_back(&subject);
-    subject.Attach(this);
-}
-
-// Removing a subject to the list of subjects
-void LogObserver::RemoveSubject(Subject &subject) {
-    _listOfSubjects->remove(&subject);
-    subject.Detach(this);
 }
 
 void LogObserver::Update(const ILoggable& log) {
@@ -87,9 +65,21 @@ void LogObserver::Update(const ILoggable& log) {
 }
 
 void LogObserver::writeLog(const string& text) {
-    os << text << endl;
+    sink->writeLine(text);
+}
+
+const shared_ptr<LogSink>& LogObserver::getSink() const {
+    return sink;
 }
 
-list<Subject*>* LogObserver::getAllSubjects() const {
-    return this->_listOfSubjects;
-}
\ No newline at end of file
+void LogObserver::setSink(shared_ptr<LogSink> newSink) {
+    sink = std::move(newSink);
+}
+
+void LogObserver::setGameLogCompressed(bool compressed) {
+    isGameLogCompressed = compressed;
+}
+
+void LogObserver::setGameLogInMemory(bool inMemory) {
+    isGameLogInMemory = inMemory;
+}
@@ -2,27 +2,30 @@
 
 #include "observer/logging_observer.h"
 #include "orders/orders.h"
-#include <fstream>
+#include "log_sink.h"
+#include "compressed_log.h"
+#include <memory>
 #include <vector>
 
 
+// Writes every event it is subscribed to in a log sink. The observer does not know the subjects: it is registered
+// once per kind of event in the ObserverRegistry of a game.
 class LogObserver : public Observer {
 private:
-    // Declare a pointer to a list of pointers to subjects
-    list<Subject*>* _listOfSubjects;
-
-    ofstream os;
+    // The sink receiving the lines, shared with the copies of this observer.
+    shared_ptr<LogSink> sink;
 public:
-    // Default constructor
+    // Default constructor, which writes to the game log file. Every observer writing to the game log file shares it,
+    // so the file is only truncated once.
     LogObserver();
 
-    // Parametrized constructor
-    LogObserver(vector<Subject*>* subjectsList);
+    // One param constructor which writes to the given sink.
+    explicit LogObserver(shared_ptr<LogSink> sink);
 
-    // Copy constructor
+    // Copy constructor, which writes to the same sink as the given observer
     LogObserver(const LogObserver& log);
 
-    // Assignment operator
+    // Assignment operator, which writes to the same sink as the given observer
     LogObserver& operator=(const LogObserver& logObserver);
 
     // Defining the output operator
@@ -31,20 +34,23 @@ public:
     // Destructor
     ~LogObserver();
 
-    // Add a subject
-    void AddSubject(Subject& subject);
-
-    // Remove a subject
-    void RemoveSubject(Subject& subject);
-
     // This method calls the writeLog method to update the text file
     void Update(const ILoggable& log) override;
 
-    // This method writes the corresponding text to the text file
+    // This method writes the corresponding text to the sink
     void writeLog(const string& text);
 
-    // Get all subjects associated to the log obserber
-    list<Subject*>* getAllSubjects() const;
+    // Getter and setter for the sink
+    const shared_ptr<LogSink>& getSink() const;
+    void setSink(shared_ptr<LogSink> newSink);
+
+    // Writes the game log file compressed (to gamelog.txt.lz), which must be chosen before the first observer of the
+    // game log file is created. The file can be read back with the log reader.
+    static void setGameLogCompressed(bool compressed);
+
+    // Keeps the game log in memory instead of writing the file, for a process whose games are logged by another one
+    // (a tournament worker). It must be chosen before the first observer of the game log file is created.
+    static void setGameLogInMemory(bool inMemory);
 };
 
-static string filename = "gamelog.txt";
\ No newline at end of file
+static string filename = "gamelog.txt";
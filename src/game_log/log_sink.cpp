@@ -0,0 +1,86 @@
+#include "log_sink.h"
+
+/////////////////////// LogSink class ///////////////////////
+LogSink::~LogSink() {}
+
+void LogSink::flush() {}
+
+/////////////////////// FileLogSink class ///////////////////////
+FileLogSink::FileLogSink(const string &path) {
+    os.open(path);
+}
+
+void FileLogSink::writeLine(string_view line) {
+    lock_guard<mutex> lock(writeMutex);
+    os << line << '\n';
+}
+
+void FileLogSink::writeBlock(string_view lines) {
+    lock_guard<mutex> lock(writeMutex);
+    os << lines;
+}
+
+void FileLogSink::flush() {
+    lock_guard<mutex> lock(writeMutex);
+    os.flush();
+}
+
+/////////////////////// MemoryLogSink class ///////////////////////
+void MemoryLogSink::writeLine(string_view line) {
+    buffer.append(line);
+    buffer.push_back('\n');
+}
+
+void MemoryLogSink::writeBlock(string_view lines) {
+    buffer.append(lines);
+}
+
+const string &MemoryLogSink::getContents() const {
+    return buffer;
+}
+
+/////////////////////// ShardedLogSink class ///////////////////////
+ShardedLogSink::ShardedLogSink(shared_ptr<LogSink> target) : target(std::move(target)), nextShard(0) {}
+
+ShardedLogSink::~ShardedLogSink() {
+    merge();
+}
+
+shared_ptr<MemoryLogSink> ShardedLogSink::openShard(size_t number, string_view header) {
+    auto shard = make_shared<MemoryLogSink>();
+    shard->writeLine(header);
+
+    lock_guard<mutex> lock(shardsMutex);
+    openShards[number] = shard;
+    return shard;
+}
+
+void ShardedLogSink::closeShard(size_t number) {
+    lock_guard<mutex> lock(shardsMutex);
+    auto it = openShards.find(number);
+    if (it == openShards.end()) {
+        return;
+    }
+    closedShards[number] = std::move(it->second);
+    openShards.erase(it);
+    writeReadyShards();
+}
+
+void ShardedLogSink::writeReadyShards() {
+    for (auto it = closedShards.begin(); it != closedShards.end() && it->first == nextShard;
+         it = closedShards.erase(it)) {
+        target->writeBlock(it->second->getContents());
+        nextShard++;
+    }
+}
+
+void ShardedLogSink::merge() {
+    lock_guard<mutex> lock(shardsMutex);
+    closedShards.merge(openShards);
+    for (auto &[number, shard]: closedShards) {
+        target->writeBlock(shard->getContents());
+        nextShard = number + 1;
+    }
+    closedShards.clear();
+    target->flush();
+}
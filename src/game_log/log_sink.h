@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// The destination of the lines written by a log observer.
+class LogSink {
+public:
+    virtual ~LogSink();
+
+    // Writes one line, followed by a line break.
+    virtual void writeLine(string_view line) = 0;
+
+    // Writes a block of complete lines as is.
+    virtual void writeBlock(string_view lines) = 0;
+
+    // Pushes the lines written so far to their destination.
+    virtual void flush();
+};
+
+// Writes the lines to a file. The file is shared by every observer writing to it, so each write holds a lock.
+class FileLogSink : public LogSink {
+private:
+    ofstream os;
+    mutex writeMutex;
+public:
+    // One param constructor which opens (and truncates) the file at the given path.
+    explicit FileLogSink(const string &path);
+
+    // A file sink owns its stream, so it cannot be copied.
+    FileLogSink(const FileLogSink &sink) = delete;
+    FileLogSink &operator=(const FileLogSink &sink) = delete;
+
+    void writeLine(string_view line) override;
+    void writeBlock(string_view lines) override;
+    void flush() override;
+};
+
+// Keeps the lines in memory. A memory sink is written by a single thread, so it takes no lock.
+class MemoryLogSink : public LogSink {
+private:
+    string buffer;
+public:
+    void writeLine(string_view line) override;
+    void writeBlock(string_view lines) override;
+
+    // Getter for the lines written so far.
+    const string &getContents() const;
+};
+
+// Splits a log into one in-memory shard per game, so that games played at the same time never share a stream. Shards
+// are numbered in the order the games were started; a closed shard is written to the target once every shard before
+// it has been written, so the combined log is ordered by game whatever order the games finish in.
+class ShardedLogSink {
+private:
+    // The sink receiving the merged shards.
+    shared_ptr<LogSink> target;
+
+    // Protects the shards and the number of the next shard to write. Only taken to open and close shards.
+    mutex shardsMutex;
+
+    // The shards still being written, by number.
+    std::map<size_t, shared_ptr<MemoryLogSink>> openShards;
+
+    // The closed shards waiting for an earlier shard to be written, by number.
+    std::map<size_t, shared_ptr<MemoryLogSink>> closedShards;
+
+    // The number of the next shard to write to the target.
+    size_t nextShard;
+
+    // Writes the closed shards that directly follow the last written shard. The caller holds shardsMutex.
+    void writeReadyShards();
+
+public:
+    // One param constructor which takes the sink receiving the merged shards.
+    explicit ShardedLogSink(shared_ptr<LogSink> target);
+
+    // A sharded sink hands out its shards, so it cannot be copied.
+    ShardedLogSink(const ShardedLogSink &sink) = delete;
+    ShardedLogSink &operator=(const ShardedLogSink &sink) = delete;
+
+    // Destructor which merges the remaining shards.
+    ~ShardedLogSink();
+
+    // Opens the shard with the given number, starting with the given header line.
+    shared_ptr<MemoryLogSink> openShard(size_t number, string_view header);
+
+    // Closes the shard with the given number. It is written to the target as soon as the shards before it are.
+    void closeShard(size_t number);
+
+    // Writes every remaining shard to the target in order, open or closed, and flushes the target.
+    void merge();
+};
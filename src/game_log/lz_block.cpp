@@ -0,0 +1,158 @@
+#include "lz_block.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// The implementation file of the LZ block compressor.
+
+namespace {
+    // The number of bits of the index of the table of recent positions.
+    constexpr size_t HASH_BITS = 14;
+
+    // The largest length stored in a nibble of the token.
+    constexpr size_t NIBBLE_MAX = 15;
+
+    // Reads 4 bytes, whatever their alignment.
+    uint32_t read32(const char *bytes) {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // Returns the slot of 4 bytes in the table of recent positions (Knuth's multiplicative hash).
+    size_t hash4(uint32_t bytes) {
+        return (bytes * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Writes the part of a length that does not fit in its nibble.
+    void writeExtraLength(std::string &output, size_t length) {
+        length -= NIBBLE_MAX;
+        while (length >= 255) {
+            output.push_back(static_cast<char>(255));
+            length -= 255;
+        }
+        output.push_back(static_cast<char>(length));
+    }
+
+    // Reads the part of a length that does not fit in its nibble. Returns false if the block ends first.
+    bool readExtraLength(const unsigned char *&in, const unsigned char *end, size_t &length) {
+        unsigned char byte;
+        do {
+            if (in == end) {
+                return false;
+            }
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    // Writes one sequence: the literals, then the match (if matchLength is not 0).
+    void writeSequence(std::string &output, const char *literals, size_t numLiterals, size_t distance,
+                       size_t matchLength) {
+        size_t extraMatch = matchLength == 0 ? 0 : matchLength - LZ_MIN_MATCH;
+        output.push_back(static_cast<char>((std::min(numLiterals, NIBBLE_MAX) << 4) | std::min(extraMatch, NIBBLE_MAX)));
+        if (numLiterals >= NIBBLE_MAX) {
+            writeExtraLength(output, numLiterals);
+        }
+        output.append(literals, numLiterals);
+        if (matchLength == 0) {
+            return;
+        }
+        output.push_back(static_cast<char>(distance & 0xFF));
+        output.push_back(static_cast<char>(distance >> 8));
+        if (extraMatch >= NIBBLE_MAX) {
+            writeExtraLength(output, extraMatch);
+        }
+    }
+}
+
+// Compresses the input. Every position is hashed on its next 4 bytes into a table remembering the last position with
+// the same hash; a position matching its candidate starts a match, which is extended as far as possible. The search
+// skips ahead faster the longer it goes without finding a match, as incompressible text gains nothing from it.
+void lzCompressBlock(std::string_view input, std::string &output) {
+    output.clear();
+    output.reserve(input.size() / 2 + 16);
+
+    static thread_local std::vector<int64_t> recentPositions;
+    recentPositions.assign(size_t{1} << HASH_BITS, -1);
+
+    const char *base = input.data();
+    size_t size = input.size();
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + LZ_MIN_MATCH <= size) {
+        uint32_t bytes = read32(base + position);
+        int64_t &slot = recentPositions[hash4(bytes)];
+        int64_t candidate = slot;
+        slot = static_cast<int64_t>(position);
+
+        if (candidate < 0 || position - candidate > LZ_MAX_DISTANCE || read32(base + candidate) != bytes) {
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        size_t matchLength = LZ_MIN_MATCH;
+        while (position + matchLength < size && base[candidate + matchLength] == base[position + matchLength]) {
+            matchLength++;
+        }
+        writeSequence(output, base + anchor, position - anchor, position - candidate, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+
+    writeSequence(output, base + anchor, size - anchor, 0, 0);
+}
+
+// Decompresses a block, checking every length and distance against the bounds of the input and of the output.
+bool lzDecompressBlock(std::string_view input, size_t rawSize, std::string &output) {
+    output.clear();
+    output.reserve(rawSize);
+
+    auto in = reinterpret_cast<const unsigned char *>(input.data());
+    const unsigned char *end = in + input.size();
+
+    while (in < end) {
+        unsigned char token = *in++;
+
+        size_t numLiterals = token >> 4;
+        if (numLiterals == NIBBLE_MAX && !readExtraLength(in, end, numLiterals)) {
+            return false;
+        }
+        if (numLiterals > static_cast<size_t>(end - in) || output.size() + numLiterals > rawSize) {
+            return false;
+        }
+        output.append(reinterpret_cast<const char *>(in), numLiterals);
+        in += numLiterals;
+
+        // The last sequence has no match
+        if (in == end) {
+            break;
+        }
+
+        if (end - in < 2) {
+            return false;
+        }
+        size_t distance = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == NIBBLE_MAX && !readExtraLength(in, end, matchLength)) {
+            return false;
+        }
+        matchLength += LZ_MIN_MATCH;
+
+        if (distance == 0 || distance > output.size() || output.size() + matchLength > rawSize) {
+            return false;
+        }
+        // The match may overlap the bytes it produces, so it is copied one byte at a time
+        size_t from = output.size() - distance;
+        for (size_t i = 0; i < matchLength; i++) {
+            output.push_back(output[from + i]);
+        }
+    }
+
+    return output.size() == rawSize;
+}
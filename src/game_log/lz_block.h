@@ -0,0 +1,29 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_LZ_BLOCK_H
+#define COMP_345_PROJECT_TEAM_N12_LZ_BLOCK_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// A small LZ77 block compressor in the style of LZ4, written for the game logs: their lines repeat a handful of
+// messages over and over, which a byte-oriented matcher with a 64 KiB window compresses well at a few hundred MB/s.
+//
+// A block is a list of sequences. Every sequence starts with a token byte whose high nibble is the number of literals
+// and low nibble the length of the match minus 4 (15 meaning that more length bytes follow, each adding up to 255),
+// then the literals, then the 2-byte little-endian distance back to the match and the extra match length bytes. The
+// last sequence only has literals. A block never refers to another block, so blocks can be decompressed in any order.
+
+// The shortest match encoded as a reference instead of literals.
+constexpr size_t LZ_MIN_MATCH = 4;
+
+// The farthest a match can be found back in the block.
+constexpr size_t LZ_MAX_DISTANCE = 65535;
+
+// Compresses the input into the output (which is cleared first).
+void lzCompressBlock(std::string_view input, std::string &output);
+
+// Decompresses a block holding rawSize bytes into the output (which is cleared first). Returns false if the block is
+// corrupted.
+bool lzDecompressBlock(std::string_view input, size_t rawSize, std::string &output);
+
+#endif //COMP_345_PROJECT_TEAM_N12_LZ_BLOCK_H
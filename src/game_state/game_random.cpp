@@ -0,0 +1,48 @@
+#include "game_random.h"
+
+// The implementation file of the GameRandom class.
+
+// One param constructor which seeds the generator.
+GameRandom::GameRandom(uint64_t seed) : state(seed) {}
+
+// Returns the next 64-bit value of the stream (SplitMix64 step).
+uint64_t GameRandom::next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Returns the next 64-bit value of the stream.
+GameRandom::result_type GameRandom::operator()() {
+    return next();
+}
+
+// Returns a value uniformly distributed in [0, bound) using the multiply-shift reduction.
+int GameRandom::nextInt(int bound) {
+    if (bound <= 0) {
+        return 0;
+    }
+    return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+}
+
+// Restarts the stream from the given seed.
+void GameRandom::seed(uint64_t seed) {
+    state = seed;
+}
+
+// Getter for the state of the generator.
+uint64_t GameRandom::getState() const {
+    return state;
+}
+
+// Setter for the state of the generator.
+void GameRandom::setState(uint64_t newState) {
+    state = newState;
+}
+
+// Returns the generator of the calling thread.
+GameRandom &GameRandom::current() {
+    static thread_local GameRandom generator;
+    return generator;
+}
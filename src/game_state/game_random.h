@@ -0,0 +1,46 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_GAME_RANDOM_H
+#define COMP_345_PROJECT_TEAM_N12_GAME_RANDOM_H
+
+#include <cstdint>
+
+// Seed used by every generator that has not been explicitly seeded (matches the behaviour of an unseeded rand()).
+#define DEFAULT_GAME_SEED 0x9E3779B97F4A7C15ULL
+
+// A small seedable pseudo-random generator (SplitMix64). Its whole state is a single 64-bit word, which means it can be
+// saved in a GameState snapshot and restored later so that a restored game rolls exactly the same battles again.
+class GameRandom {
+private:
+    // The current position of the generator in its stream.
+    uint64_t state;
+
+public:
+    // The generator is a uniform random bit generator, so it can drive the algorithms of the standard library.
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    // One param constructor which seeds the generator.
+    explicit GameRandom(uint64_t seed = DEFAULT_GAME_SEED);
+
+    // Returns the next 64-bit value of the stream.
+    uint64_t next();
+    result_type operator()();
+
+    // Returns a value uniformly distributed in [0, bound).
+    int nextInt(int bound);
+
+    // Restarts the stream from the given seed.
+    void seed(uint64_t seed);
+
+    // Getter for the state of the generator.
+    [[nodiscard]] uint64_t getState() const;
+
+    // Setter for the state of the generator.
+    void setState(uint64_t newState);
+
+    // Returns the generator used by the orders and cards on the calling thread. Every thread owns its own stream so
+    // that games simulated on different threads never share random state.
+    static GameRandom &current();
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_GAME_RANDOM_H
@@ -0,0 +1,481 @@
+#include "game_state.h"
+#include "game_engine/game_engine.h"
+#include <algorithm>
+
+// The implementation file of the GameState class.
+
+// Takes the cards a collection has beyond the given count out of it, keeping them as spare cards.
+static void trimCards(vector<Card *> &cards, int count, vector<Card *> &spareCards) {
+    while (static_cast<int>(cards.size()) > count) {
+        spareCards.push_back(cards.back());
+        cards.pop_back();
+    }
+}
+
+// Writes the given card types back into a collection of cards, reusing the Card objects already in the collection and
+// then the spare cards. A card is only allocated once there are no spare cards left.
+static void restoreCards(vector<Card *> &cards, const uint8_t *types, int count, vector<Card *> &spareCards) {
+    trimCards(cards, count, spareCards);
+    while (static_cast<int>(cards.size()) < count && !spareCards.empty()) {
+        cards.push_back(spareCards.back());
+        spareCards.pop_back();
+    }
+    for (int i = static_cast<int>(cards.size()); i < count; i++) {
+        cards.push_back(new Card(static_cast<Type>(types[i])));
+    }
+    for (int i = 0; i < count; i++) {
+        cards[i]->setType(static_cast<Type>(types[i]));
+    }
+}
+
+// Returns the kind of an order. Returns false for orders that are not of a kind a GameState records.
+static bool orderKindOf(const Order &order, OrderKind &kind) {
+    if (dynamic_cast<const Deploy *>(&order)) {
+        kind = OrderKind::deploy;
+    } else if (dynamic_cast<const Advance *>(&order)) {
+        kind = OrderKind::advance;
+    } else if (dynamic_cast<const Bomb *>(&order)) {
+        kind = OrderKind::bomb;
+    } else if (dynamic_cast<const Blockade *>(&order)) {
+        kind = OrderKind::blockade;
+    } else if (dynamic_cast<const Airlift *>(&order)) {
+        kind = OrderKind::airlift;
+    } else if (dynamic_cast<const Negotiate *>(&order)) {
+        kind = OrderKind::negotiate;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Constructor which preallocates the buffers for a game with the given sizes.
+GameState::GameState(int numTerritories, int numPlayers, int cardCapacity, int orderCapacity) : turnCount(0) {
+    if (numPlayers > MAX_PLAYERS) {
+        throw std::runtime_error("A GameState cannot describe more than " + std::to_string(MAX_PLAYERS) + " players");
+    }
+
+    territoryOwners.reserve(numTerritories);
+    territoryArmies.reserve(numTerritories);
+    playerTerritories.reserve(numTerritories);
+    playerTerritoryOffsets.reserve(numPlayers + 1);
+    players.reserve(numPlayers);
+    reinforcementPools.reserve(numPlayers);
+    conqueredInTurn.reserve(numPlayers);
+    friendMasks.reserve(numPlayers);
+    handCards.reserve(cardCapacity);
+    handOffsets.reserve(numPlayers + 1);
+    deckCards.reserve(cardCapacity);
+    orders.reserve(orderCapacity);
+    orderOffsets.reserve(numPlayers + 1);
+    spareCards.reserve(cardCapacity);
+    for (vector<Order *> &spare: spareOrders) {
+        spare.reserve(orderCapacity);
+    }
+}
+
+// Destructor which deletes the spare cards and orders.
+GameState::~GameState() {
+    for (Card *card: spareCards) {
+        delete card;
+    }
+    for (vector<Order *> &spare: spareOrders) {
+        for (Order *order: spare) {
+            delete order;
+        }
+    }
+}
+
+// One param constructor which sizes the buffers for the given game and captures it. Room is left for a neutral
+// player and for every card of the game to end up in a single place.
+GameState::GameState(const GameEngine &engine)
+        : GameState(static_cast<int>(engine.getMap()->getSize()),
+                    static_cast<int>(engine.getPlayers()->size()) + 1,
+                    [&engine]() {
+                        int cards = static_cast<int>(engine.getDeck()->getWarzoneCards()->size());
+                        for (Player *player: *engine.getPlayers()) {
+                            cards += static_cast<int>(player->getHand()->getHandsCards()->size());
+                        }
+                        return cards;
+                    }(),
+                    static_cast<int>(engine.getMap()->getSize()) * 4) {
+    capture(engine);
+}
+
+// Returns the index of the given player in the state, or -1 if the player is not part of it.
+int GameState::indexOf(const Player *player) const {
+    for (int i = 0; i < static_cast<int>(players.size()); i++) {
+        if (players[i] == player) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Converts an Order object into its compact record.
+bool GameState::recordOrder(const Order &order, OrderRecord &record) const {
+    record.issuer = static_cast<int8_t>(indexOf(order.getIssuingPlayer()));
+    record.otherPlayer = -1;
+    record.source = 0;
+    record.target = 0;
+    record.armies = 0;
+
+    if (auto deploy = dynamic_cast<const Deploy *>(&order)) {
+        record.kind = OrderKind::deploy;
+        record.target = deploy->getTargetTerritory()->getId();
+        record.armies = deploy->getNumArmies();
+    } else if (auto advance = dynamic_cast<const Advance *>(&order)) {
+        record.kind = OrderKind::advance;
+        record.source = advance->getSourceTerritory()->getId();
+        record.target = advance->getTargetTerritory()->getId();
+        record.armies = advance->getNumArmies();
+    } else if (auto bomb = dynamic_cast<const Bomb *>(&order)) {
+        record.kind = OrderKind::bomb;
+        record.target = bomb->getTargetTerritory()->getId();
+    } else if (auto blockade = dynamic_cast<const Blockade *>(&order)) {
+        record.kind = OrderKind::blockade;
+        record.target = blockade->getTargetTerritory()->getId();
+        record.otherPlayer = static_cast<int8_t>(indexOf(blockade->getNeutralPlayer()));
+    } else if (auto airlift = dynamic_cast<const Airlift *>(&order)) {
+        record.kind = OrderKind::airlift;
+        record.source = airlift->getSourceTerritory()->getId();
+        record.target = airlift->getTargetTerritory()->getId();
+        record.armies = airlift->getNumArmies();
+    } else if (auto negotiate = dynamic_cast<const Negotiate *>(&order)) {
+        record.kind = OrderKind::negotiate;
+        record.otherPlayer = static_cast<int8_t>(indexOf(negotiate->getEnemyPlayer()));
+        // A negotiation with a player that is not part of the state cannot be built again, so it is dropped
+        if (record.otherPlayer < 0) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    return record.issuer >= 0;
+}
+
+// Writes a compact record into an Order object of the same kind: a spare order of the state if there is one, or a new
+// one.
+Order *GameState::buildOrder(const OrderRecord &record, GameEngine &engine) const {
+    Map *map = engine.getMap();
+    Player &issuer = *players[record.issuer];
+    vector<Order *> &spare = spareOrders[static_cast<size_t>(record.kind)];
+    Order *order = nullptr;
+    if (!spare.empty()) {
+        order = spare.back();
+        spare.pop_back();
+    }
+
+    // The orders are built in place from temporary orders, which only hold pointers
+    switch (record.kind) {
+        case OrderKind::deploy: {
+            Deploy deploy(issuer, *map->getTerritoryByID(record.target), record.armies);
+            return order != nullptr ? &(static_cast<Deploy &>(*order) = deploy) : new Deploy(deploy);
+        }
+        case OrderKind::advance: {
+            Advance advance(issuer, *map->getTerritoryByID(record.source), *map->getTerritoryByID(record.target),
+                            record.armies);
+            return order != nullptr ? &(static_cast<Advance &>(*order) = advance) : new Advance(advance);
+        }
+        case OrderKind::bomb: {
+            Bomb bomb(issuer, *map->getTerritoryByID(record.target));
+            return order != nullptr ? &(static_cast<Bomb &>(*order) = bomb) : new Bomb(bomb);
+        }
+        case OrderKind::blockade: {
+            Player *neutral = record.otherPlayer >= 0 ? players[record.otherPlayer] : GameEngine::getNeutralPlayer();
+            Blockade blockade(issuer, *neutral, *map->getTerritoryByID(record.target));
+            return order != nullptr ? &(static_cast<Blockade &>(*order) = blockade) : new Blockade(blockade);
+        }
+        case OrderKind::airlift: {
+            Airlift airlift(issuer, *map->getTerritoryByID(record.source), *map->getTerritoryByID(record.target),
+                            record.armies);
+            return order != nullptr ? &(static_cast<Airlift &>(*order) = airlift) : new Airlift(airlift);
+        }
+        case OrderKind::negotiate: {
+            // Only negotiations with a player of the state are recorded
+            Negotiate negotiate(issuer, *players[record.otherPlayer]);
+            return order != nullptr ? &(static_cast<Negotiate &>(*order) = negotiate) : new Negotiate(negotiate);
+        }
+    }
+    return nullptr;
+}
+
+// Copies the current state of the game into the buffers.
+void GameState::capture(const GameEngine &engine) {
+    Map *map = engine.getMap();
+    const vector<Player *> &gamePlayers = *engine.getPlayers();
+
+    if (gamePlayers.size() > MAX_PLAYERS) {
+        throw std::runtime_error("A GameState cannot describe more than " + std::to_string(MAX_PLAYERS) + " players");
+    }
+
+    players.assign(gamePlayers.begin(), gamePlayers.end());
+
+    // Territory columns
+    int numTerritories = static_cast<int>(map->getSize());
+    territoryOwners.resize(numTerritories);
+    territoryArmies.resize(numTerritories);
+    for (int id = 1; id <= numTerritories; id++) {
+        Territory *territory = map->getTerritoryByID(id);
+        territoryOwners[id - 1] = static_cast<int8_t>(indexOf(territory->getOwner()));
+        territoryArmies[id - 1] = territory->getNumberOfArmies();
+    }
+
+    // Player columns
+    playerTerritories.clear();
+    playerTerritoryOffsets.assign(1, 0);
+    reinforcementPools.clear();
+    conqueredInTurn.clear();
+    friendMasks.clear();
+    handCards.clear();
+    handOffsets.assign(1, 0);
+    orders.clear();
+    orderOffsets.assign(1, 0);
+
+    for (Player *player: players) {
+        for (Territory *territory: *player->getTerritories()) {
+            playerTerritories.push_back(territory->getId());
+        }
+        playerTerritoryOffsets.push_back(static_cast<int>(playerTerritories.size()));
+
+        reinforcementPools.push_back(player->getReinforcementPool());
+        conqueredInTurn.push_back(player->hasConqueredTerritoryInTurn());
+
+        uint32_t mask = 0;
+        for (int j = 0; j < static_cast<int>(players.size()); j++) {
+            if (player->isPlayerFriend(players[j])) {
+                mask |= 1u << j;
+            }
+        }
+        friendMasks.push_back(mask);
+
+        for (Card *card: *player->getHand()->getHandsCards()) {
+            handCards.push_back(static_cast<uint8_t>(card->getType()));
+        }
+        handOffsets.push_back(static_cast<int>(handCards.size()));
+
+        OrderRecord record{};
+        for (Order *order: *player->getOrdersList()->getOrders()) {
+            if (recordOrder(*order, record)) {
+                orders.push_back(record);
+            }
+        }
+        orderOffsets.push_back(static_cast<int>(orders.size()));
+    }
+
+    deckCards.clear();
+    for (Card *card: *engine.getDeck()->getWarzoneCards()) {
+        deckCards.push_back(static_cast<uint8_t>(card->getType()));
+    }
+
+    random.setState(GameRandom::current().getState());
+    turnCount = engine.getTurnCount();
+}
+
+// Writes the captured state back into the game. The cards and the pending orders the game holds are first taken out
+// of the hands, the deck and the orders lists as spare objects, then written back from the spare objects, so that the
+// Card and Order objects of the game are reused rather than deleted and allocated again.
+void GameState::restore(GameEngine &engine) const {
+    Map *map = engine.getMap();
+
+    for (int id = 1; id <= static_cast<int>(territoryOwners.size()); id++) {
+        Territory *territory = map->getTerritoryByID(id);
+        int owner = territoryOwners[id - 1];
+        territory->setOwner(owner >= 0 ? players[owner] : nullptr);
+        territory->setNumberOfArmies(territoryArmies[id - 1]);
+    }
+
+    engine.getPlayers()->assign(players.begin(), players.end());
+
+    // Take out every card the collections hold beyond what they held when captured, and every pending order
+    for (int i = 0; i < static_cast<int>(players.size()); i++) {
+        trimCards(*players[i]->getHand()->getHandsCards(), handOffsets[i + 1] - handOffsets[i], spareCards);
+
+        vector<Order *> &pendingOrders = *players[i]->getOrdersList()->getOrders();
+        for (Order *order: pendingOrders) {
+            OrderKind kind;
+            if (orderKindOf(*order, kind)) {
+                spareOrders[static_cast<size_t>(kind)].push_back(order);
+            } else {
+                delete order;
+            }
+        }
+        pendingOrders.clear();
+    }
+    trimCards(*engine.getDeck()->getWarzoneCards(), static_cast<int>(deckCards.size()), spareCards);
+
+    for (int i = 0; i < static_cast<int>(players.size()); i++) {
+        Player *player = players[i];
+
+        vector<Territory *> &territories = *player->getTerritories();
+        territories.clear();
+        for (int k = playerTerritoryOffsets[i]; k < playerTerritoryOffsets[i + 1]; k++) {
+            territories.push_back(map->getTerritoryByID(playerTerritories[k]));
+        }
+
+        player->setReinforcementPool(reinforcementPools[i]);
+        player->setConqueredTerritoryInTurn(conqueredInTurn[i]);
+
+        player->clearPlayerFriends();
+        for (int j = 0; j < static_cast<int>(players.size()); j++) {
+            if (friendMasks[i] & (1u << j)) {
+                player->addFriendPlayer(players[j]);
+            }
+        }
+
+        restoreCards(*player->getHand()->getHandsCards(), handCards.data() + handOffsets[i],
+                     handOffsets[i + 1] - handOffsets[i], spareCards);
+
+        vector<Order *> &pendingOrders = *player->getOrdersList()->getOrders();
+        for (int k = orderOffsets[i]; k < orderOffsets[i + 1]; k++) {
+            pendingOrders.push_back(buildOrder(orders[k], engine));
+        }
+    }
+
+    restoreCards(*engine.getDeck()->getWarzoneCards(), deckCards.data(), static_cast<int>(deckCards.size()),
+                 spareCards);
+
+    GameRandom::current().setState(random.getState());
+    engine.setTurnCount(turnCount);
+}
+
+// Copies this state into another, already allocated, state.
+void GameState::forkInto(GameState &other) const {
+    other.territoryOwners.assign(territoryOwners.begin(), territoryOwners.end());
+    other.territoryArmies.assign(territoryArmies.begin(), territoryArmies.end());
+    other.playerTerritories.assign(playerTerritories.begin(), playerTerritories.end());
+    other.playerTerritoryOffsets.assign(playerTerritoryOffsets.begin(), playerTerritoryOffsets.end());
+    other.players.assign(players.begin(), players.end());
+    other.reinforcementPools.assign(reinforcementPools.begin(), reinforcementPools.end());
+    other.conqueredInTurn.assign(conqueredInTurn.begin(), conqueredInTurn.end());
+    other.friendMasks.assign(friendMasks.begin(), friendMasks.end());
+    other.handCards.assign(handCards.begin(), handCards.end());
+    other.handOffsets.assign(handOffsets.begin(), handOffsets.end());
+    other.deckCards.assign(deckCards.begin(), deckCards.end());
+    other.orders.assign(orders.begin(), orders.end());
+    other.orderOffsets.assign(orderOffsets.begin(), orderOffsets.end());
+    other.random = random;
+    other.turnCount = turnCount;
+}
+
+// Getter for the number of territories.
+int GameState::getNumberOfTerritories() const {
+    return static_cast<int>(territoryOwners.size());
+}
+
+// Getter for the number of players.
+int GameState::getNumberOfPlayers() const {
+    return static_cast<int>(players.size());
+}
+
+// Getter for the player at the given index.
+Player *GameState::getPlayer(int playerIndex) const {
+    return players[playerIndex];
+}
+
+// Returns the index of the given player in the state, or -1 if the player is not part of it.
+int GameState::getPlayerIndex(const Player *player) const {
+    return indexOf(player);
+}
+
+// Getter for the owner of a territory.
+int GameState::getOwner(int territoryId) const {
+    return territoryOwners[territoryId - 1];
+}
+
+// Setter for the owner of a territory.
+void GameState::setOwner(int territoryId, int playerIndex) {
+    territoryOwners[territoryId - 1] = static_cast<int8_t>(playerIndex);
+}
+
+// Getter for the armies of a territory.
+int GameState::getArmies(int territoryId) const {
+    return territoryArmies[territoryId - 1];
+}
+
+// Setter for the armies of a territory.
+void GameState::setArmies(int territoryId, int armies) {
+    territoryArmies[territoryId - 1] = armies;
+}
+
+// Getter for the reinforcement pool of a player.
+int GameState::getReinforcementPool(int playerIndex) const {
+    return reinforcementPools[playerIndex];
+}
+
+// Setter for the reinforcement pool of a player.
+void GameState::setReinforcementPool(int playerIndex, int armies) {
+    reinforcementPools[playerIndex] = armies;
+}
+
+// Checks if two players negotiated a truce for the current turn.
+bool GameState::areFriends(int firstPlayer, int secondPlayer) const {
+    return (friendMasks[firstPlayer] & (1u << secondPlayer)) != 0;
+}
+
+// Getter for the number of cards in the hand of a player.
+int GameState::getHandSize(int playerIndex) const {
+    return handOffsets[playerIndex + 1] - handOffsets[playerIndex];
+}
+
+// Getter for the number of pending orders of a player.
+int GameState::getOrderCount(int playerIndex) const {
+    return orderOffsets[playerIndex + 1] - orderOffsets[playerIndex];
+}
+
+// Getter for the random generator of the state.
+GameRandom &GameState::getRandom() {
+    return random;
+}
+
+// Getter for the turn count.
+int GameState::getTurnCount() const {
+    return turnCount;
+}
+
+// Defining the output operator for the GameState class.
+std::ostream &operator<<(std::ostream &stream, const GameState &state) {
+    stream << "GameState of turn " << state.turnCount << " with " << state.territoryOwners.size() << " territories, "
+           << state.deckCards.size() << " cards in the deck and " << state.players.size() << " players:";
+
+    for (int i = 0; i < static_cast<int>(state.players.size()); i++) {
+        stream << "\n\t" << state.players[i]->getPName() << " | Territories: "
+               << state.playerTerritoryOffsets[i + 1] - state.playerTerritoryOffsets[i]
+               << " | Reinforcement pool: " << state.reinforcementPools[i]
+               << " | Cards: " << state.getHandSize(i)
+               << " | Pending orders: " << state.getOrderCount(i);
+    }
+    return stream;
+}
+
+// Free function in order to test the functionality of the GameState.
+void game_state_driver(const std::string &filename) {
+    cout << "\n***************************GameState driver function***************************" << endl;
+
+    GameEngine engine("-console");
+    engine.setMap(filename);
+
+    vector<Player *> players;
+    players.emplace_back(new Player("Aggressive", new AggressivePlayerStrategy()));
+    players.emplace_back(new Player("Benevolent", new BenevolentPlayerStrategy()));
+    engine.setPlayers(std::move(players));
+    engine.gameStart();
+
+    // Take a snapshot of the game right after the start-up phase
+    GameState snapshot(engine);
+    cout << "\nSnapshot taken:\n" << snapshot << endl;
+
+    // Fork the snapshot into a second, preallocated state
+    GameState fork(snapshot.getNumberOfTerritories(), snapshot.getNumberOfPlayers() + 1, 64, 256);
+    snapshot.forkInto(fork);
+    cout << "\nFork of the snapshot:\n" << fork << endl;
+
+    // Play a turn, which changes the owners and armies of the territories
+    engine.reinforcementPhase();
+    engine.issueOrdersPhase();
+    engine.executeOrdersPhase();
+    cout << "\nState after one turn:\n" << GameState(engine) << endl;
+
+    // Go back to the snapshot
+    snapshot.restore(engine);
+    cout << "\nState after restoring the snapshot:\n" << GameState(engine) << endl;
+}
@@ -0,0 +1,168 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_GAME_STATE_H
+#define COMP_345_PROJECT_TEAM_N12_GAME_STATE_H
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "game_state/game_random.h"
+
+using std::vector;
+
+// Forward declarations.
+class GameEngine;
+class Player;
+class Order;
+class Card;
+
+// The kind of a pending order recorded in a GameState.
+enum class OrderKind : uint8_t {
+    deploy,
+    advance,
+    bomb,
+    blockade,
+    airlift,
+    negotiate
+};
+
+// A compact, pointer-free description of a pending order. Territories are referred to by their ID and players by
+// their index in the GameState (-1 when unused).
+struct OrderRecord {
+    OrderKind kind;
+    int8_t issuer;
+    int8_t otherPlayer;
+    int source;
+    int target;
+    int armies;
+};
+
+// This class holds everything that changes while a game is played (territory owners and armies, reinforcement pools,
+// hands, the deck, pending orders, the diplomacy relations set by Negotiate orders and the random generator) in flat,
+// preallocated buffers. A running game can be captured into it, restored from it, or forked into another GameState
+// in time proportional to the size of the game. Capturing and forking never allocate as long as the game stays within
+// the capacities given at construction, which makes it suitable for what-if analysis and lookahead.
+class GameState {
+private:
+    // Owner (player index, -1 if nobody) and armies of each territory, indexed by territory ID - 1.
+    vector<int8_t> territoryOwners;
+    vector<int> territoryArmies;
+
+    // The territories of each player in the order the player holds them. The territories of player i are found
+    // between playerTerritoryOffsets[i] and playerTerritoryOffsets[i + 1].
+    vector<int> playerTerritories;
+    vector<int> playerTerritoryOffsets;
+
+    // The players captured in the state, in the order of play. Restoring writes back into these objects.
+    vector<Player *> players;
+
+    // Per player scalars.
+    vector<int> reinforcementPools;
+    vector<uint8_t> conqueredInTurn;
+
+    // Bit j of friendMasks[i] is set when player i cannot attack player j for the rest of the turn.
+    vector<uint32_t> friendMasks;
+
+    // The card types in each player's hand (same offset layout as the territories) and in the deck.
+    vector<uint8_t> handCards;
+    vector<int> handOffsets;
+    vector<uint8_t> deckCards;
+
+    // The pending orders of each player (same offset layout as the territories).
+    vector<OrderRecord> orders;
+    vector<int> orderOffsets;
+
+    // The random generator of the game and the turn being played.
+    GameRandom random;
+    int turnCount;
+
+    // The Card and Order objects (by kind of order) taken out of the game by restore and not written back yet, which
+    // the next restores write into before allocating any.
+    mutable vector<Card *> spareCards;
+    mutable std::array<vector<Order *>, 6> spareOrders;
+
+    // Returns the index of the given player in the state, or -1 if the player is not part of it.
+    [[nodiscard]] int indexOf(const Player *player) const;
+
+    // Converts an Order object into its compact record. Returns false for orders that cannot be recorded, such as a
+    // negotiation with a player that is not part of the state.
+    bool recordOrder(const Order &order, OrderRecord &record) const;
+
+    // Builds an Order object from its compact record, for the given game, reusing a spare order of its kind if there is
+    // one.
+    Order *buildOrder(const OrderRecord &record, GameEngine &engine) const;
+
+public:
+    // Maximum number of players a GameState can describe (one bit per player in the friend masks).
+    static const int MAX_PLAYERS = 32;
+
+    // Constructor which preallocates the buffers for a game with the given sizes.
+    GameState(int numTerritories, int numPlayers, int cardCapacity, int orderCapacity);
+
+    // One param constructor which sizes the buffers for the given game and captures it.
+    explicit GameState(const GameEngine &engine);
+
+    // A state owns its spare cards and orders, so it cannot be copied (see forkInto).
+    GameState(const GameState &state) = delete;
+    GameState &operator=(const GameState &state) = delete;
+
+    // Destructor which deletes the spare cards and orders.
+    ~GameState();
+
+    // Copies the current state of the game into the buffers.
+    void capture(const GameEngine &engine);
+
+    // Writes the captured state back into the game. The players captured must still be alive. The Card and Order objects
+    // the game holds are reused, so restore only allocates when the game holds fewer cards, or fewer orders of a kind,
+    // than the state, and earlier restores left no spare ones: one object per missing card or order.
+    void restore(GameEngine &engine) const;
+
+    // Copies this state into another, already allocated, state.
+    void forkInto(GameState &other) const;
+
+    // Getter for the number of territories.
+    [[nodiscard]] int getNumberOfTerritories() const;
+
+    // Getter for the number of players.
+    [[nodiscard]] int getNumberOfPlayers() const;
+
+    // Getter for the player at the given index.
+    [[nodiscard]] Player *getPlayer(int playerIndex) const;
+
+    // Returns the index of the given player in the state, or -1 if the player is not part of it.
+    [[nodiscard]] int getPlayerIndex(const Player *player) const;
+
+    // Getter and setter for the owner of a territory (player index, -1 if nobody).
+    [[nodiscard]] int getOwner(int territoryId) const;
+    void setOwner(int territoryId, int playerIndex);
+
+    // Getter and setter for the armies of a territory.
+    [[nodiscard]] int getArmies(int territoryId) const;
+    void setArmies(int territoryId, int armies);
+
+    // Getter and setter for the reinforcement pool of a player.
+    [[nodiscard]] int getReinforcementPool(int playerIndex) const;
+    void setReinforcementPool(int playerIndex, int armies);
+
+    // Checks if two players negotiated a truce for the current turn.
+    [[nodiscard]] bool areFriends(int firstPlayer, int secondPlayer) const;
+
+    // Getter for the number of cards in the hand of a player.
+    [[nodiscard]] int getHandSize(int playerIndex) const;
+
+    // Getter for the number of pending orders of a player.
+    [[nodiscard]] int getOrderCount(int playerIndex) const;
+
+    // Getter for the random generator of the state.
+    [[nodiscard]] GameRandom &getRandom();
+
+    // Getter for the turn count.
+    [[nodiscard]] int getTurnCount() const;
+
+    // Defining the output operator for the GameState object.
+    friend std::ostream &operator<<(std::ostream &stream, const GameState &state);
+};
+
+// Free function in order to test the functionality of the GameState.
+void game_state_driver(const std::string &filename);
+
+#endif //COMP_345_PROJECT_TEAM_N12_GAME_STATE_H
@@ -0,0 +1,66 @@
+#include "map_topology.h"
+#include "map/map.h"
+
+// The implementation file of the MapTopology class.
+
+// One param constructor which extracts the topology of the given map.
+MapTopology::MapTopology(Map &map) {
+    int numTerritories = static_cast<int>(map.getSize());
+    int numContinents = static_cast<int>(map.getContinentsSize());
+
+    neighbourOffsets.reserve(numTerritories + 1);
+    neighbourOffsets.push_back(0);
+    territoryContinents.reserve(numTerritories);
+
+    for (int id = 1; id <= numTerritories; id++) {
+        Territory *territory = map.getTerritoryByID(id);
+        for (Territory *neighbour: territory->getNeighbours()) {
+            neighbours.push_back(neighbour->getId());
+        }
+        neighbourOffsets.push_back(static_cast<int>(neighbours.size()));
+        territoryContinents.push_back(territory->getContinentId());
+    }
+
+    continentBonuses.reserve(numContinents);
+    continentSizes.reserve(numContinents);
+    for (int id = 1; id <= numContinents; id++) {
+        Continent *continent = map.getContinentByID(id);
+        continentBonuses.push_back(continent->getArmyBonusNumber());
+        continentSizes.push_back(static_cast<int>(continent->getTerritories().size()));
+    }
+}
+
+// Getter for the number of territories.
+int MapTopology::getNumberOfTerritories() const {
+    return static_cast<int>(territoryContinents.size());
+}
+
+// Getter for the number of continents.
+int MapTopology::getNumberOfContinents() const {
+    return static_cast<int>(continentBonuses.size());
+}
+
+// Returns a pointer to the first neighbour ID of a territory.
+const int *MapTopology::neighboursBegin(int territoryId) const {
+    return neighbours.data() + neighbourOffsets[territoryId - 1];
+}
+
+// Returns a pointer past the last neighbour ID of a territory.
+const int *MapTopology::neighboursEnd(int territoryId) const {
+    return neighbours.data() + neighbourOffsets[territoryId];
+}
+
+// Getter for the continent ID of a territory.
+int MapTopology::getContinentId(int territoryId) const {
+    return territoryContinents[territoryId - 1];
+}
+
+// Getter for the army bonus of a continent.
+int MapTopology::getContinentBonus(int continentId) const {
+    return continentBonuses[continentId - 1];
+}
+
+// Getter for the number of territories of a continent.
+int MapTopology::getContinentSize(int continentId) const {
+    return continentSizes[continentId - 1];
+}
@@ -0,0 +1,52 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_MAP_TOPOLOGY_H
+#define COMP_345_PROJECT_TEAM_N12_MAP_TOPOLOGY_H
+
+#include <vector>
+
+using std::vector;
+
+// Forward declaration.
+class Map;
+
+// An immutable, pointer-free copy of the parts of a Map that never change during a game: the borders between
+// territories (stored as one flat adjacency array) and the continents. It is safe to read from several threads.
+class MapTopology {
+private:
+    // The neighbours of territory id are found between neighbourOffsets[id - 1] and neighbourOffsets[id].
+    vector<int> neighbourOffsets;
+    vector<int> neighbours;
+
+    // The continent ID of each territory, indexed by territory ID - 1.
+    vector<int> territoryContinents;
+
+    // The army bonus and the number of territories of each continent, indexed by continent ID - 1.
+    vector<int> continentBonuses;
+    vector<int> continentSizes;
+
+public:
+    // One param constructor which extracts the topology of the given map.
+    explicit MapTopology(Map &map);
+
+    // Getter for the number of territories.
+    [[nodiscard]] int getNumberOfTerritories() const;
+
+    // Getter for the number of continents.
+    [[nodiscard]] int getNumberOfContinents() const;
+
+    // Returns a pointer to the first neighbour ID of a territory.
+    [[nodiscard]] const int *neighboursBegin(int territoryId) const;
+
+    // Returns a pointer past the last neighbour ID of a territory.
+    [[nodiscard]] const int *neighboursEnd(int territoryId) const;
+
+    // Getter for the continent ID of a territory.
+    [[nodiscard]] int getContinentId(int territoryId) const;
+
+    // Getter for the army bonus of a continent.
+    [[nodiscard]] int getContinentBonus(int continentId) const;
+
+    // Getter for the number of territories of a continent.
+    [[nodiscard]] int getContinentSize(int continentId) const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_MAP_TOPOLOGY_H
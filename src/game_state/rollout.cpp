@@ -0,0 +1,180 @@
+#include "rollout.h"
+#include "orders/battle_odds.h"
+#include <algorithm>
+
+// The implementation file of the RolloutSimulator class.
+
+// Constructor which takes the topology of the map and the behaviour of each player.
+RolloutSimulator::RolloutSimulator(const MapTopology &topology, const vector<RolloutPolicy> &policies)
+        : topology(topology), policies(policies) {}
+
+// Returns the number of armies the given player receives at the start of a turn: one army per three territories (at
+// least 3) plus the bonus of every continent the player completely owns.
+int RolloutSimulator::reinforcementsFor(const GameState &state, int playerIndex) const {
+    static thread_local vector<int> ownedPerContinent;
+    ownedPerContinent.assign(topology.getNumberOfContinents(), 0);
+
+    int ownedTerritories = 0;
+    for (int id = 1; id <= state.getNumberOfTerritories(); id++) {
+        if (state.getOwner(id) == playerIndex) {
+            ownedTerritories++;
+            ownedPerContinent[topology.getContinentId(id) - 1]++;
+        }
+    }
+
+    int reinforcements = std::max(3, ownedTerritories / 3);
+    for (int continentId = 1; continentId <= topology.getNumberOfContinents(); continentId++) {
+        if (ownedPerContinent[continentId - 1] == topology.getContinentSize(continentId)) {
+            reinforcements += topology.getContinentBonus(continentId);
+        }
+    }
+    return reinforcements;
+}
+
+// Checks if the territory borders a territory owned by someone else.
+bool RolloutSimulator::isBorder(const GameState &state, int territoryId) const {
+    int owner = state.getOwner(territoryId);
+    for (const int *it = topology.neighboursBegin(territoryId); it != topology.neighboursEnd(territoryId); it++) {
+        if (state.getOwner(*it) != owner) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Resolves an attack with the same rules as Advance::execute: every attacking army kills a defender with a 60% chance,
+// then every surviving defender kills an attacker with a 70% chance (see battle_odds.h).
+bool RolloutSimulator::resolveBattle(GameState &state, int attacker, int sourceId, int targetId, int armies) const {
+    GameRandom &random = state.getRandom();
+    int attackingArmies = armies;
+    int defendingArmies = state.getArmies(targetId);
+    state.setArmies(sourceId, state.getArmies(sourceId) - attackingArmies);
+
+    for (int i = 0; i < attackingArmies; i++) {
+        if (random.nextInt(100) + 1 <= ATTACK_SUCCESS_PERCENT) {
+            if (defendingArmies == 0) {
+                break;
+            }
+            defendingArmies--;
+        }
+    }
+    for (int i = 0; i < defendingArmies; i++) {
+        if (random.nextInt(100) + 1 <= DEFENCE_SUCCESS_PERCENT) {
+            if (attackingArmies == 0) {
+                break;
+            }
+            attackingArmies--;
+        }
+    }
+
+    if (attackingArmies > 0 && defendingArmies == 0) {
+        state.setOwner(targetId, attacker);
+        state.setArmies(targetId, attackingArmies);
+        return true;
+    }
+    state.setArmies(targetId, defendingArmies);
+    return false;
+}
+
+// Plays the reinforcement, deployment and attack steps of one player.
+void RolloutSimulator::playPlayerTurn(GameState &state, int playerIndex) const {
+    int numTerritories = state.getNumberOfTerritories();
+    RolloutPolicy policy = policies[playerIndex];
+
+    // Pick the territory receiving the reinforcements
+    int deployTarget = 0;
+    for (int id = 1; id <= numTerritories; id++) {
+        if (state.getOwner(id) != playerIndex || !isBorder(state, id)) {
+            continue;
+        }
+        if (deployTarget == 0 ||
+            (policy == RolloutPolicy::passive && state.getArmies(id) < state.getArmies(deployTarget)) ||
+            (policy != RolloutPolicy::passive && state.getArmies(id) > state.getArmies(deployTarget))) {
+            deployTarget = id;
+        }
+    }
+
+    // A player without border territories owns everything or nothing; either way there is nothing left to play
+    if (deployTarget == 0) {
+        return;
+    }
+
+    int pool = state.getReinforcementPool(playerIndex) + reinforcementsFor(state, playerIndex);
+    state.setArmies(deployTarget, state.getArmies(deployTarget) + pool);
+    state.setReinforcementPool(playerIndex, 0);
+
+    if (policy == RolloutPolicy::passive) {
+        return;
+    }
+
+    if (policy == RolloutPolicy::cheater) {
+        for (const int *it = topology.neighboursBegin(deployTarget); it != topology.neighboursEnd(deployTarget); it++) {
+            if (state.getOwner(*it) != playerIndex) {
+                state.setOwner(*it, playerIndex);
+                return;
+            }
+        }
+        return;
+    }
+
+    // Aggressive: every territory with spare armies attacks its weakest enemy neighbour if it is likely to capture it
+    for (int id = 1; id <= numTerritories; id++) {
+        if (state.getOwner(id) != playerIndex || state.getArmies(id) < 2) {
+            continue;
+        }
+
+        int weakestEnemy = 0;
+        for (const int *it = topology.neighboursBegin(id); it != topology.neighboursEnd(id); it++) {
+            int owner = state.getOwner(*it);
+            if (owner == playerIndex || (owner >= 0 && state.areFriends(playerIndex, owner))) {
+                continue;
+            }
+            if (weakestEnemy == 0 || state.getArmies(*it) < state.getArmies(weakestEnemy)) {
+                weakestEnemy = *it;
+            }
+        }
+
+        int attackingArmies = state.getArmies(id) - 1;
+        if (weakestEnemy != 0 &&
+            BattleOdds::table().winProbability(attackingArmies, state.getArmies(weakestEnemy)) >= 0.5) {
+            resolveBattle(state, playerIndex, id, weakestEnemy, attackingArmies);
+        }
+    }
+}
+
+// Plays the given number of full turns, starting with the player after firstPlayer.
+void RolloutSimulator::playTurns(GameState &state, int firstPlayer, int numTurns) const {
+    int numPlayers = state.getNumberOfPlayers();
+    for (int turn = 0; turn < numTurns; turn++) {
+        for (int i = 1; i <= numPlayers; i++) {
+            playPlayerTurn(state, (firstPlayer + i) % numPlayers);
+        }
+    }
+}
+
+// Scores the state from the point of view of the given player: mostly the share of territories, partly the share of
+// armies on the board.
+double RolloutSimulator::evaluate(const GameState &state, int playerIndex) const {
+    int ownedTerritories = 0;
+    long ownedArmies = 0;
+    long totalArmies = 0;
+
+    for (int id = 1; id <= state.getNumberOfTerritories(); id++) {
+        totalArmies += state.getArmies(id);
+        if (state.getOwner(id) == playerIndex) {
+            ownedTerritories++;
+            ownedArmies += state.getArmies(id);
+        }
+    }
+
+    if (ownedTerritories == 0) {
+        return 0.0;
+    }
+    if (ownedTerritories == state.getNumberOfTerritories()) {
+        return 1.0;
+    }
+
+    double territoryShare = static_cast<double>(ownedTerritories) / state.getNumberOfTerritories();
+    double armyShare = totalArmies > 0 ? static_cast<double>(ownedArmies) / static_cast<double>(totalArmies) : 0.0;
+    return 0.7 * territoryShare + 0.3 * armyShare;
+}
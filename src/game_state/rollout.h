@@ -0,0 +1,55 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_ROLLOUT_H
+#define COMP_345_PROJECT_TEAM_N12_ROLLOUT_H
+
+#include <cstdint>
+#include <vector>
+#include "game_state/game_state.h"
+#include "game_state/map_topology.h"
+
+using std::vector;
+
+// How a player is assumed to behave while a game is rolled out.
+enum class RolloutPolicy : uint8_t {
+    // Deploys on its strongest border territory and attacks every weaker enemy neighbour.
+    aggressive,
+    // Deploys on its weakest border territory and never attacks (benevolent and neutral players).
+    passive,
+    // Takes over one enemy neighbour per turn without fighting.
+    cheater
+};
+
+// Plays simplified turns directly on a GameState, without touching the Map or the Player objects, so that many games
+// can be rolled out in parallel from forked states. Battles follow the same rules as Advance::execute and draw from
+// the random generator of the state.
+class RolloutSimulator {
+private:
+    // The borders and continents of the map being played.
+    const MapTopology &topology;
+
+    // The assumed behaviour of each player of the state.
+    vector<RolloutPolicy> policies;
+
+public:
+    // Constructor which takes the topology of the map and the behaviour of each player.
+    RolloutSimulator(const MapTopology &topology, const vector<RolloutPolicy> &policies);
+
+    // Returns the number of armies the given player receives at the start of a turn.
+    [[nodiscard]] int reinforcementsFor(const GameState &state, int playerIndex) const;
+
+    // Checks if the territory borders a territory owned by someone else.
+    [[nodiscard]] bool isBorder(const GameState &state, int territoryId) const;
+
+    // Resolves an attack of the given number of armies from source to target. Returns true if the target was captured.
+    bool resolveBattle(GameState &state, int attacker, int sourceId, int targetId, int armies) const;
+
+    // Plays the reinforcement, deployment and attack steps of one player.
+    void playPlayerTurn(GameState &state, int playerIndex) const;
+
+    // Plays the given number of full turns, starting with the player after firstPlayer.
+    void playTurns(GameState &state, int firstPlayer, int numTurns) const;
+
+    // Scores the state from the point of view of the given player, between 0 (eliminated) and 1 (owns every territory).
+    [[nodiscard]] double evaluate(const GameState &state, int playerIndex) const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_ROLLOUT_H
@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "game_log/indexed_log.h"
+
+using namespace std;
+
+// Lists the executed orders kept in an indexed game log (gamelog.idx) that match the given filters, reading only the
+// blocks of the file whose summary may hold a match.
+//
+// Usage: WARZONE_LOG_QUERY <file> [-game <g>] [-turns <first>-<last>] [-player <name>] [-territory <id>]
+//                                 [-order <type>] [-battles]
+
+namespace {
+    // Reads a range "<first>-<last>" (or a single value) into the given bounds.
+    void parseRange(const string &text, uint32_t &first, uint32_t &last) {
+        size_t dash = text.find('-');
+        first = static_cast<uint32_t>(strtoul(text.c_str(), nullptr, 10));
+        last = dash == string::npos ? first : static_cast<uint32_t>(strtoul(text.c_str() + dash + 1, nullptr, 10));
+    }
+}
+
+int main(int argc, char const *argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <file> [-game <g>] [-turns <first>-<last>] [-player <name>]"
+             << " [-territory <id>] [-order <type>] [-battles]" << endl;
+        return 1;
+    }
+
+    IndexedLogQuery query;
+    for (int i = 2; i < argc; i++) {
+        string option = argv[i];
+        if (option == "-battles") {
+            query.battlesOnly = true;
+        } else if (i + 1 == argc) {
+            cout << "Missing value for option " << option << endl;
+            return 1;
+        } else if (option == "-game") {
+            parseRange(argv[++i], query.minGame, query.maxGame);
+        } else if (option == "-turns") {
+            parseRange(argv[++i], query.minTurn, query.maxTurn);
+        } else if (option == "-player") {
+            query.player = argv[++i];
+        } else if (option == "-territory") {
+            query.territory = atoi(argv[++i]);
+        } else if (option == "-order") {
+            query.orderType = argv[++i];
+        } else {
+            cout << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+
+    IndexedLogReader reader(argv[1]);
+    if (!reader.isValid()) {
+        cout << argv[1] << " is not a complete indexed log file." << endl;
+        return 1;
+    }
+
+    size_t numMatches = 0;
+    size_t blocksRead = reader.query(query, [&reader, &numMatches](const IndexedLogRecord &record) {
+        cout << "Game " << record.game << " | Turn " << record.turn << " | "
+             << reader.getPlayerNames()[record.player] << " | " << INDEXED_LOG_ORDER_TYPES[record.orderType];
+        if (record.sourceTerritory >= 0) {
+            cout << " | From " << record.sourceTerritory;
+        }
+        if (record.targetTerritory >= 0) {
+            cout << " | To " << record.targetTerritory;
+        }
+        if (record.isBattle) {
+            cout << " | Battle";
+        }
+        cout << "\n";
+        numMatches++;
+    });
+
+    cout << numMatches << " matching order(s), " << blocksRead << " of " << reader.getSummaries().size()
+         << " block(s) read" << endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "concurrency/thread_pool.h"
+#include "game_log/compressed_log.h"
+
+using namespace std;
+
+// Prints a compressed game log (gamelog.txt.lz), optionally keeping only the lines containing a given text. The blocks
+// are read from the file in order, decompressed and filtered in parallel a batch at a time, and printed in order.
+//
+// Usage: WARZONE_LOG_READER <file> [-grep <text>] [-threads <n>]
+
+namespace {
+    // The number of blocks in a batch, per thread.
+    constexpr size_t BLOCKS_PER_THREAD = 4;
+
+    // Decompresses a block and keeps its lines containing the pattern (all of them if the pattern is empty).
+    string filterBlock(const CompressedLogBlock &block, const string &pattern, bool &isCorrupted) {
+        string text;
+        if (!CompressedLogReader::decompress(block, text)) {
+            isCorrupted = true;
+            return "";
+        }
+        if (pattern.empty()) {
+            return text;
+        }
+
+        string kept;
+        string_view lines(text);
+        while (!lines.empty()) {
+            size_t end = lines.find('\n');
+            end = end == string_view::npos ? lines.size() : end + 1;
+            string_view line = lines.substr(0, end);
+            if (line.find(pattern) != string_view::npos) {
+                kept.append(line);
+            }
+            lines.remove_prefix(end);
+        }
+        return kept;
+    }
+}
+
+int main(int argc, char const *argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <file> [-grep <text>] [-threads <n>]" << endl;
+        return 1;
+    }
+
+    string path = argv[1];
+    string pattern;
+    unsigned int numThreads = thread::hardware_concurrency();
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "-grep") {
+            pattern = argv[i + 1];
+        } else if (option == "-threads") {
+            numThreads = static_cast<unsigned int>(atoi(argv[i + 1]));
+        } else {
+            cout << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+
+    CompressedLogReader reader(path);
+    if (!reader.isValid()) {
+        cout << path << " is not a compressed log file." << endl;
+        return 1;
+    }
+
+    ThreadPool pool(numThreads == 0 ? 1 : numThreads);
+    size_t batchSize = BLOCKS_PER_THREAD * pool.size();
+
+    vector<CompressedLogBlock> batch;
+    bool isEndOfFile = false;
+    while (!isEndOfFile) {
+        batch.clear();
+        CompressedLogBlock block;
+        while (batch.size() < batchSize && !(isEndOfFile = !reader.readBlock(block))) {
+            batch.push_back(std::move(block));
+        }
+
+        vector<future<string>> filtered;
+        filtered.reserve(batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            filtered.push_back(pool.submit([&batch, &pattern, i]() {
+                bool isCorrupted = false;
+                string kept = filterBlock(batch[i], pattern, isCorrupted);
+                return isCorrupted ? string("\n[corrupted block]\n") : kept;
+            }));
+        }
+        for (future<string> &lines: filtered) {
+            cout << pool.await(lines);
+        }
+    }
+    cout.flush();
+    return 0;
+}
@@ -2,6 +2,11 @@
 #include "game_engine/game_engine.h"
 #include "player/player.h"
 #include "game_log/log_observer.h"
+#include "game_state/game_state.h"
+#include "map/map_editor.h"
+#include "server/game_server.h"
+#include "tournament/tournament_coordinator.h"
+#include "player_strategy/strategy_parameters.h"
 #include <fstream>
 
 using namespace std;
@@ -11,6 +16,37 @@ int main(int argc, char const *argv[]) {
 
     int classDemo = 4;
 
+    // "-compresslog" after the read mode writes the game log compressed, "-indexlog" also writes the executed
+    // orders to the indexed game log, "-mapdump <n>" prints the whole map once every n prints (1 for every time) and
+    // "-workers <n>" plays the games of a tournament in n worker processes, "-strategies <file>" loads named
+    // strategy parameter sets (written by the strategy tuner) which tournaments can use as player strategies, and
+    // "-telemetry" writes the state of every player at the end of every turn to a file per game in log/telemetry
+    for (int i = 2; i < argc; i++) {
+        if (string(argv[i]) == "-compresslog") {
+            LogObserver::setGameLogCompressed(true);
+        } else if (string(argv[i]) == "-indexlog") {
+            IndexedLogObserver::setGameLogIndexed(true);
+        } else if (string(argv[i]) == "-mapdump" && i + 1 < argc) {
+            MapDeltaRenderer::setFullDumpInterval(atoi(argv[++i]));
+        } else if (string(argv[i]) == "-workers" && i + 1 < argc) {
+            GameEngine::setTournamentWorkers(atoi(argv[++i]));
+        } else if (string(argv[i]) == "-strategies" && i + 1 < argc) {
+            StrategyParameters::load(argv[++i]);
+        } else if (string(argv[i]) == "-telemetry") {
+            GameTelemetry::setTelemetryEnabled(true);
+        }
+    }
+
+    // "-server <socketpath> [<workers>]" as the read mode hosts game sessions instead of playing one game
+    if (argc > 1 && string(argv[1]).rfind("-server ", 0) == 0) {
+        return game_server_driver(argv[1]);
+    }
+
+    // "-worker <fd>" as the read mode plays the games of a tournament run by a coordinator on the other end of fd
+    if (argc > 1 && string(argv[1]).rfind("-worker ", 0) == 0) {
+        return tournament_worker_driver(argv[1]);
+    }
+
     string filename1 = "canada.txt";
     string filename2 = "demo-map.txt";
     string filename3 = "canada-map-not-connected.txt";
@@ -43,6 +79,12 @@ int main(int argc, char const *argv[]) {
         case 8:
             game_engine_driver(argv[5]); // Read commands from file commands_play_fail_2.txt.
             break;
+        case 9:
+            game_state_driver(filename1);
+            break;
+        case 10:
+            map_editor_driver();
+            break;
         default:
             break;
     }
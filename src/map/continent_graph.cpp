@@ -0,0 +1,186 @@
+#include "continent_graph.h"
+#include <algorithm>
+#include "map.h"
+
+// The implementation file of the ContinentGraph class.
+
+// One param constructor which contracts the given map, with the current owners and armies of its territories.
+ContinentGraph::ContinentGraph(Map &map)
+        : continents(new ContinentNode[map.getContinentsSize()]),
+          numContinents(static_cast<int>(map.getContinentsSize())) {
+    int numTerritories = static_cast<int>(map.getSize());
+    territoryContinents.reserve(numTerritories);
+    for (int id = 1; id <= numTerritories; id++) {
+        territoryContinents.push_back(map.getTerritoryByID(id)->getContinentId());
+    }
+
+    for (int id = 1; id <= numContinents; id++) {
+        ContinentNode &continent = continents[id - 1];
+        continent.size = static_cast<int>(map.getContinentByID(id)->getTerritories().size());
+        continent.armyBonus = map.getContinentByID(id)->getArmyBonusNumber();
+    }
+
+    for (int id = 1; id <= numTerritories; id++) {
+        Territory *territory = map.getTerritoryByID(id);
+        int continentId = territory->getContinentId();
+        if (continentId < 1 || continentId > numContinents) {
+            continue;
+        }
+        ContinentNode &continent = continents[continentId - 1];
+        addTotals(continent, territory->getOwner(), 1, territory->getNumberOfArmies());
+
+        // Count the borders towards every other continent, and list the territory once if it has any
+        bool isBorder = false;
+        for (Territory *neighbour: territory->getNeighbours()) {
+            int neighbourContinentId = neighbour->getContinentId();
+            if (neighbourContinentId == continentId || neighbourContinentId < 1 || neighbourContinentId > numContinents) {
+                continue;
+            }
+            isBorder = true;
+            auto edge = std::find_if(continent.neighbours.begin(), continent.neighbours.end(),
+                                     [&](const ContinentEdge &e) { return e.continentId == neighbourContinentId; });
+            if (edge == continent.neighbours.end()) {
+                continent.neighbours.push_back({neighbourContinentId, 1});
+            } else {
+                edge->numBorders++;
+            }
+        }
+        if (isBorder) {
+            continent.borderTerritories.push_back(id);
+        }
+    }
+}
+
+// Copy constructor, which takes a snapshot of the totals of the players.
+ContinentGraph::ContinentGraph(const ContinentGraph &graph)
+        : territoryContinents(graph.territoryContinents), continents(new ContinentNode[graph.numContinents]),
+          numContinents(graph.numContinents) {
+    for (int i = 0; i < numContinents; i++) {
+        const ContinentNode &other = graph.continents[i];
+        ContinentNode &continent = continents[i];
+        continent.size = other.size;
+        continent.armyBonus = other.armyBonus;
+        continent.borderTerritories = other.borderTerritories;
+        continent.neighbours = other.neighbours;
+        std::lock_guard<std::mutex> lock(other.mutex);
+        continent.players = other.players;
+    }
+}
+
+// Adds a number of territories and armies to the totals of a player on a continent. There are only a few players on a
+// continent, so they are kept in a small vector.
+void ContinentGraph::addTotals(ContinentNode &continent, Player *player, int numTerritories, long armies) {
+    auto totals = std::find_if(continent.players.begin(), continent.players.end(),
+                               [&](const PlayerTotals &t) { return t.player == player; });
+    if (totals == continent.players.end()) {
+        continent.players.push_back({player, numTerritories, armies});
+        return;
+    }
+    totals->numTerritories += numTerritories;
+    totals->armies += armies;
+    if (totals->numTerritories == 0) {
+        continent.players.erase(totals);
+    }
+}
+
+// Returns the totals of a player on a continent, or nullptr if the player has nothing there.
+const ContinentGraph::PlayerTotals *ContinentGraph::findTotals(const ContinentNode &continent, const Player *player) {
+    for (const PlayerTotals &totals: continent.players) {
+        if (totals.player == player) {
+            return &totals;
+        }
+    }
+    return nullptr;
+}
+
+// Moves a territory from the totals of its old owner and armies to the totals of its new owner and armies.
+void ContinentGraph::onTerritoryChanged(int territoryId, Player *oldOwner, int oldArmies, Player *newOwner,
+                                        int newArmies) {
+    int continentId = getContinentId(territoryId);
+    if (continentId < 1 || continentId > numContinents) {
+        return;
+    }
+    ContinentNode &continent = continents[continentId - 1];
+    std::lock_guard<std::mutex> lock(continent.mutex);
+    if (oldOwner == newOwner) {
+        addTotals(continent, newOwner, 0, newArmies - oldArmies);
+    } else {
+        addTotals(continent, newOwner, 1, newArmies);
+        addTotals(continent, oldOwner, -1, -oldArmies);
+    }
+}
+
+// Getter for the number of continents.
+int ContinentGraph::getNumberOfContinents() const {
+    return numContinents;
+}
+
+// Getter for the continent ID of a territory.
+int ContinentGraph::getContinentId(int territoryId) const {
+    return territoryContinents[territoryId - 1];
+}
+
+// Getter for the number of territories of a continent.
+int ContinentGraph::getSize(int continentId) const {
+    return continents[continentId - 1].size;
+}
+
+// Getter for the army bonus of a continent.
+int ContinentGraph::getArmyBonus(int continentId) const {
+    return continents[continentId - 1].armyBonus;
+}
+
+// Getter for the IDs of the territories of a continent with a neighbour on another continent.
+const vector<int> &ContinentGraph::getBorderTerritories(int continentId) const {
+    return continents[continentId - 1].borderTerritories;
+}
+
+// Getter for the continents bordering a continent.
+const vector<ContinentGraph::ContinentEdge> &ContinentGraph::getNeighbours(int continentId) const {
+    return continents[continentId - 1].neighbours;
+}
+
+// Returns the number of territories a player owns on a continent.
+int ContinentGraph::getOwnedCount(int continentId, const Player *player) const {
+    const ContinentNode &continent = continents[continentId - 1];
+    std::lock_guard<std::mutex> lock(continent.mutex);
+    const PlayerTotals *totals = findTotals(continent, player);
+    return totals == nullptr ? 0 : totals->numTerritories;
+}
+
+// Returns the number of armies a player has on a continent.
+long ContinentGraph::getArmies(int continentId, const Player *player) const {
+    const ContinentNode &continent = continents[continentId - 1];
+    std::lock_guard<std::mutex> lock(continent.mutex);
+    const PlayerTotals *totals = findTotals(continent, player);
+    return totals == nullptr ? 0 : totals->armies;
+}
+
+// Returns a copy of the totals of every player with territories on a continent.
+vector<ContinentGraph::PlayerTotals> ContinentGraph::getPlayerTotals(int continentId) const {
+    const ContinentNode &continent = continents[continentId - 1];
+    std::lock_guard<std::mutex> lock(continent.mutex);
+    return continent.players;
+}
+
+// Returns the player owning every territory of a continent, or nullptr if there is none. An empty continent has no
+// owner.
+Player *ContinentGraph::getOwner(int continentId) const {
+    const ContinentNode &continent = continents[continentId - 1];
+    std::lock_guard<std::mutex> lock(continent.mutex);
+    if (continent.players.size() != 1 || continent.players[0].numTerritories != continent.size) {
+        return nullptr;
+    }
+    return continent.players[0].player;
+}
+
+// Returns the sum of the army bonuses of the continents a player owns completely.
+int ContinentGraph::getContinentBonus(const Player &player) const {
+    int bonus = 0;
+    for (int id = 1; id <= numContinents; id++) {
+        if (getOwner(id) == &player) {
+            bonus += continents[id - 1].armyBonus;
+        }
+    }
+    return bonus;
+}
@@ -0,0 +1,107 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_CONTINENT_GRAPH_H
+#define COMP_345_PROJECT_TEAM_N12_CONTINENT_GRAPH_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using std::vector;
+
+// Forward declarations.
+class Map;
+class Player;
+
+// The map contracted to its continents: one node per continent, and one edge between two continents with a border
+// between their territories. Every node keeps the number of territories and the armies each player has on the
+// continent, which the map updates as territories change owner or number of armies, so that questions such as "which
+// continents does this player own" or "which continent is this player closest to owning" take O(continents) rather
+// than a scan of every territory.
+class ContinentGraph {
+public:
+    // An edge of the graph: a neighbouring continent, and the number of borders between the two continents.
+    struct ContinentEdge {
+        int continentId;
+        int numBorders;
+    };
+
+    // What a player has on a continent. The territories without an owner are counted under a null player.
+    struct PlayerTotals {
+        Player *player;
+        int numTerritories;
+        long armies;
+    };
+
+private:
+    // A continent of the graph. Orders on disjoint territories may be executed at the same time, even on the same
+    // continent, so the totals of the players are guarded by a mutex; the rest never changes once built.
+    struct ContinentNode {
+        int size = 0;
+        int armyBonus = 0;
+        vector<int> borderTerritories;
+        vector<ContinentEdge> neighbours;
+        vector<PlayerTotals> players;
+        mutable std::mutex mutex;
+    };
+
+    // The continent ID of each territory, indexed by territory ID - 1.
+    vector<int> territoryContinents;
+
+    // The continents, indexed by continent ID - 1.
+    std::unique_ptr<ContinentNode[]> continents;
+    int numContinents;
+
+    // Adds a number of territories and armies to the totals of a player on a continent, dropping the totals of a
+    // player left without territories there. The mutex of the continent must be held.
+    static void addTotals(ContinentNode &continent, Player *player, int numTerritories, long armies);
+
+    // Returns the totals of a player on a continent, or nullptr if the player has nothing there. The mutex of the
+    // continent must be held.
+    static const PlayerTotals *findTotals(const ContinentNode &continent, const Player *player);
+
+public:
+    // One param constructor which contracts the given map, with the current owners and armies of its territories.
+    explicit ContinentGraph(Map &map);
+
+    // Copy constructor, which takes a snapshot of the totals of the players.
+    ContinentGraph(const ContinentGraph &graph);
+
+    ContinentGraph &operator=(const ContinentGraph &graph) = delete;
+
+    // Moves a territory from the totals of its old owner and armies to the totals of its new owner and armies.
+    void onTerritoryChanged(int territoryId, Player *oldOwner, int oldArmies, Player *newOwner, int newArmies);
+
+    // Getter for the number of continents.
+    [[nodiscard]] int getNumberOfContinents() const;
+
+    // Getter for the continent ID of a territory.
+    [[nodiscard]] int getContinentId(int territoryId) const;
+
+    // Getter for the number of territories of a continent.
+    [[nodiscard]] int getSize(int continentId) const;
+
+    // Getter for the army bonus of a continent.
+    [[nodiscard]] int getArmyBonus(int continentId) const;
+
+    // Getter for the IDs of the territories of a continent with a neighbour on another continent.
+    [[nodiscard]] const vector<int> &getBorderTerritories(int continentId) const;
+
+    // Getter for the continents bordering a continent.
+    [[nodiscard]] const vector<ContinentEdge> &getNeighbours(int continentId) const;
+
+    // Returns the number of territories a player owns on a continent.
+    [[nodiscard]] int getOwnedCount(int continentId, const Player *player) const;
+
+    // Returns the number of armies a player has on a continent.
+    [[nodiscard]] long getArmies(int continentId, const Player *player) const;
+
+    // Returns a copy of the totals of every player with territories on a continent.
+    [[nodiscard]] vector<PlayerTotals> getPlayerTotals(int continentId) const;
+
+    // Returns the player owning every territory of a continent, or nullptr if there is none.
+    [[nodiscard]] Player *getOwner(int continentId) const;
+
+    // Returns the sum of the army bonuses of the continents a player owns completely.
+    [[nodiscard]] int getContinentBonus(const Player &player) const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_CONTINENT_GRAPH_H
@@ -1,4 +1,6 @@
 #include "map.h"
+#include "player/player.h"
+#include <type_traits>
 #include <vector>
 #include <fstream>
 #include <iostream>
@@ -11,6 +13,31 @@ using std::ifstream;
 using std::find;
 using std::regex_constants::ECMAScript;
 
+/**
+ * Mixes the bits of a value (the finalizer of SplitMix64), so that close inputs give unrelated keys
+ */
+static uint64_t mixKey(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @return the Zobrist key of a territory owned by the given player. The keys are computed rather than drawn from a
+ * table, since the players of a game are only known by their address.
+ */
+static uint64_t ownerKey(int territoryId, const Player* owner) {
+    return mixKey(mixKey(static_cast<uint64_t>(territoryId)) ^ reinterpret_cast<uintptr_t>(owner));
+}
+
+/**
+ * @return the Zobrist key of a territory holding the given number of armies
+ */
+static uint64_t armiesKey(int territoryId, int numArmies) {
+    return mixKey((static_cast<uint64_t>(territoryId) << 32) ^ static_cast<uint32_t>(numArmies) ^ 0x5bd1e995ULL);
+}
+
 //denotes possible values for section headers in map txt files
 enum section {HEAD, FILES, CONTINENTS, COUNTRIES, BORDERS, DEFAULT};
 section getSectionFromString(const string& str) {
@@ -145,7 +172,8 @@ Continent &Continent::operator=(Continent other) {
  * @param continent a pointer to the continent belonging to the territory
  */
 Territory::Territory(const int id, const string &name, const int x, const int y, int continentId)
-        : id(id), name(name), x(x), y(y), continentId(continentId), owner(nullptr), numberOfArmies(0) {
+        : id(id), name(name), x(x), y(y), continentId(continentId), owner(nullptr), numberOfArmies(0), map(nullptr),
+          dirty(false) {
 }
 
 /**
@@ -188,7 +216,11 @@ int Territory::getNumberOfArmies() const {
  * @param numArmies armies in the territory
  */
 void Territory::setNumberOfArmies(const int numArmies) {
+    int oldArmies = numberOfArmies;
     this->numberOfArmies = numArmies;
+    if (map != nullptr) {
+        map->onTerritoryChanged(*this, owner, oldArmies);
+    }
 }
 
 /**
@@ -203,7 +235,11 @@ Player* Territory::getOwner() const {
  * @param player pointer to a player which is the owner of the territory
  */
 void Territory::setOwner(Player* player) {
-     this->owner = player;
+    Player* oldOwner = owner;
+    this->owner = player;
+    if (map != nullptr) {
+        map->onTerritoryChanged(*this, oldOwner, numberOfArmies);
+    }
 }
 
 /**
@@ -219,7 +255,7 @@ void Territory::addNeighbour(Territory *territory) {
  * @param numArmies number of armies to be incremented to the territory
  */
 void Territory::addArmies(const int numArmies) {
-    numberOfArmies += numArmies;
+    setNumberOfArmies(numberOfArmies + numArmies);
 }
 
 /**
@@ -227,7 +263,37 @@ void Territory::addArmies(const int numArmies) {
  * @param numArmies number of armies to be decremented from the territory
  */
 void Territory::removeArmies(const int numArmies) {
-    numberOfArmies -= numArmies;
+    setNumberOfArmies(numberOfArmies - numArmies);
+}
+
+/**
+ * Sets the map the territory belongs to, which is told about every change of owner or armies
+ * @param newMap pointer to the map (nullptr to stop reporting changes)
+ */
+void Territory::setMap(Map* newMap) {
+    map = newMap;
+}
+
+/**
+ * @return the map the territory belongs to (nullptr if there is none)
+ */
+Map* Territory::getMap() const {
+    return map;
+}
+
+/**
+ * @return true if the territory changed since its map last handed out its dirty territories
+ */
+bool Territory::isDirty() const {
+    return dirty;
+}
+
+/**
+ * Marks the territory as changed or not
+ * @param isDirty true if the territory changed
+ */
+void Territory::setDirty(bool isDirty) {
+    dirty = isDirty;
 }
 
 /**
@@ -247,7 +313,7 @@ int Territory::getY() const {
 /**
  * Copy constructor for the Territory class
  */
-Territory::Territory(const Territory& territory) : id(territory.id), name(territory.name), x(territory.x), y(territory.y), owner(territory.owner) {
+Territory::Territory(const Territory& territory) : id(territory.id), name(territory.name), x(territory.x), y(territory.y), owner(territory.owner), map(nullptr), dirty(false) {
     numberOfArmies = 0;
 
     continentId = territory.continentId;
@@ -261,7 +327,7 @@ std::ostream &operator<<(std::ostream &out, const Territory *territory) {
     out << "Country #" << territory->getId() << " of name " << territory->getName();
     out << " of continent #" << territory->getContinentId();
     if (territory->getOwner() != nullptr) {
-        out << " , owned by " << *territory->getOwner()->getPName();
+        out << " , owned by " << territory->getOwner()->getPName();
     } else {
         out << " , owned by no one";
     }
@@ -272,6 +338,8 @@ std::ostream &operator<<(std::ostream &out, const Territory *territory) {
 
 Territory &Territory::operator=(Territory other) {
     if (this != &other) {
+        Player* oldOwner = owner;
+        int oldArmies = numberOfArmies;
         id = other.id;
         name = other.name;
         x = other.x;
@@ -280,6 +348,9 @@ Territory &Territory::operator=(Territory other) {
         numberOfArmies = other.numberOfArmies;
         swap(owner, other.owner);
         swap(neighbours, other.neighbours);
+        if (map != nullptr) {
+            map->onTerritoryChanged(*this, oldOwner, oldArmies);
+        }
     }
 
     return *this;
@@ -416,6 +487,107 @@ void Map::validate() {
  */
 void Map::addTerritory(Territory* territory) {
     territories.emplace_back(territory);
+    territory->setMap(this);
+    continentGraph.reset();
+    ownershipHash.fetch_xor(ownerKey(territory->getId(), territory->getOwner()));
+    armiesHash.fetch_xor(armiesKey(territory->getId(), territory->getNumberOfArmies()));
+}
+
+/**
+ * @return the continent graph of the map, built from the current continents, borders and territories on the first call
+ */
+const ContinentGraph& Map::getContinentGraph() {
+    if (continentGraph == nullptr) {
+        continentGraph = std::make_unique<ContinentGraph>(*this);
+    }
+    return *continentGraph;
+}
+
+/**
+ * Updates the hashes of the board after a territory changed: the keys of its old owner and armies are removed and the
+ * keys of its new owner and armies are added, so the hashes never need to look at the other territories. The continent
+ * graph moves the territory from the totals of its old owner to the totals of its new owner in the same way.
+ * @param territory the territory that changed
+ * @param oldOwner the owner of the territory before the change
+ * @param oldArmies the number of armies in the territory before the change
+ */
+void Map::onTerritoryChanged(Territory& territory, Player* oldOwner, int oldArmies) {
+    int id = territory.getId();
+    bool hasChanged = false;
+    if (oldOwner != territory.getOwner()) {
+        ownershipHash.fetch_xor(ownerKey(id, oldOwner) ^ ownerKey(id, territory.getOwner()));
+        hasChanged = true;
+    }
+    if (oldArmies != territory.getNumberOfArmies()) {
+        armiesHash.fetch_xor(armiesKey(id, oldArmies) ^ armiesKey(id, territory.getNumberOfArmies()));
+        hasChanged = true;
+    }
+    if (hasChanged && continentGraph != nullptr) {
+        continentGraph->onTerritoryChanged(id, oldOwner, oldArmies, territory.getOwner(), territory.getNumberOfArmies());
+    }
+
+    // Only the order changing the territory reads its flag, so the flag itself needs no lock
+    if (hasChanged && !territory.isDirty()) {
+        territory.setDirty(true);
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        dirtyTerritories.push_back(&territory);
+    }
+}
+
+/**
+ * @return the territories which changed since the last call, by ID, which are marked clean
+ */
+vector<Territory*> Map::takeDirtyTerritories() {
+    vector<Territory*> changed;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        changed.swap(dirtyTerritories);
+    }
+    // The orders of a wave mark their territories from several threads, so the territories are returned by ID
+    std::sort(changed.begin(), changed.end(), [](const Territory* first, const Territory* second) {
+        return first->getId() < second->getId();
+    });
+    for (Territory* territory : changed) {
+        territory->setDirty(false);
+    }
+    return changed;
+}
+
+/**
+ * @param copyName the name of the new map
+ * @return a new map with its own continents and territories, and the same borders as this map
+ */
+Map* Map::freshCopy(const string& copyName) const {
+    Map* copy = new Map(copyName);
+    for (const Continent* continent : continents) {
+        copy->addContinent(new Continent(continent->getName(), continent->getColour(), continent->getArmyBonusNumber()));
+    }
+    for (const Territory* territory : territories) {
+        auto* newTerritory = new Territory(territory->getId(), territory->getName(), territory->getX(),
+                                           territory->getY(), territory->getContinentId());
+        copy->getContinentByID(territory->getContinentId())->addTerritory(newTerritory);
+        copy->addTerritory(newTerritory);
+    }
+    for (Territory* territory : territories) {
+        for (Territory* neighbour : territory->getNeighbours()) {
+            copy->addEdge(territory->getId(), neighbour->getId());
+        }
+    }
+    return copy;
+}
+
+/**
+ * @return the hash of the owners of the territories
+ */
+uint64_t Map::getOwnershipHash() const {
+    return ownershipHash;
+}
+
+/**
+ * @return the hash of the owners and armies of the territories
+ */
+uint64_t Map::getStateHash() const {
+    return ownershipHash ^ armiesHash;
 }
 
 /**
@@ -433,6 +605,7 @@ Territory* Map::getTerritoryByID(int i) {
  */
 void Map::addEdge(int originID, int destID) {
     territories[originID - 1]->addNeighbour(territories[destID - 1]);
+    continentGraph.reset();
 }
 /**
  * @return the number of territories in the Map
@@ -491,6 +664,7 @@ string Map::toMermaid() {
  */
 void Map::addContinent(Continent *continent) {
     continents.emplace_back(continent);
+    continentGraph.reset();
 }
 
 /**
@@ -513,16 +687,33 @@ unsigned int Map::getContinentsSize() {
  * Constructs a new map
  * @param name the common name given to the map
  */
-Map::Map(string name) : name(name) {}
+Map::Map(string name) : name(name), ownershipHash(0), armiesHash(0) {}
 
 /**
  * Copy constructor for Map class
  */
-Map::Map(const Map& map) : name(map.name) {
+Map::Map(const Map& map) : name(map.name), ownershipHash(map.ownershipHash.load()), armiesHash(map.armiesHash.load()) {
     territories = map.territories;
     continents = map.continents;
+    if (map.continentGraph != nullptr) {
+        continentGraph = std::make_unique<ContinentGraph>(*map.continentGraph);
+    }
 }
 
+/**
+ * Move constructor for Map class, which takes the territories and continents of the given map
+ */
+Map::Map(Map&& map) noexcept
+        : territories(std::move(map.territories)), continents(std::move(map.continents)), name(std::move(map.name)),
+          ownershipHash(map.ownershipHash.load()), armiesHash(map.armiesHash.load()),
+          dirtyTerritories(std::move(map.dirtyTerritories)), continentGraph(std::move(map.continentGraph)) {
+    for (Territory* territory : territories) {
+        territory->setMap(this);
+    }
+}
+
+static_assert(std::is_nothrow_move_constructible_v<Map>, "Maps must be relocated without copies");
+
 /**
  * Stream insertion operator for the Map class
  */
@@ -550,8 +741,13 @@ Map &Map::operator=(Map other) {
     if (this != &other) {
         swap(territories, other.territories);
         swap(continents, other.continents);
-
-        name = other.name;
+        swap(name, other.name);
+        ownershipHash = other.ownershipHash.exchange(ownershipHash);
+        armiesHash = other.armiesHash.exchange(armiesHash);
+        swap(continentGraph, other.continentGraph);
+        for (Territory* territory : territories) {
+            territory->setMap(this);
+        }
     }
 
     return *this;
@@ -567,6 +763,28 @@ string Map::getName() {
  * @return the Map object
  */
 Map* MapLoader::load(const string& filename) {
+    // Input file stream opened using provided filename
+    ifstream file(filename);
+    file.open(MAPS_DIR + filename);
+
+    Map* gameMap = parse(filename, file);
+
+    cout << "Printout of Map:" << endl;
+    cout << gameMap << endl;
+
+    file.close();
+
+    cout << "Finished reading file into Map" << endl;
+    return gameMap;
+}
+
+/**
+ * Parse a map from a stream, while making sure the text is valid (i.e. can be fully parsed)
+ * @param name the name of the map
+ * @param file the stream holding the text of the map file
+ * @return the Map object
+ */
+Map* MapLoader::parse(const string& name, std::istream& file) {
     //
     const vector<string> sections = {"files", "continents", "countries", "borders"};
 
@@ -579,7 +797,7 @@ Map* MapLoader::load(const string& filename) {
     const std::regex borderRegex(R"(^\d+( \d+)+$)", ECMAScript); // e.g. "7 4 5 6 8 11"
 
     // Create new map object to be used for parsing
-    Map* gameMap = new Map(filename);
+    Map* gameMap = new Map(name);
 
     // Some text appears above the first section, call this "head"
     string currentSection = "head";
@@ -588,10 +806,6 @@ Map* MapLoader::load(const string& filename) {
     int currentCountryIndex = 0;
     int currentBorderIndex = 0;
 
-    // Input file stream opened using provided filename
-    ifstream file(filename);
-    file.open(MAPS_DIR + filename);
-
     // Iterate through the map file one line at a time
     string line;
     while (std::getline(file, line)) {
@@ -740,12 +954,6 @@ Map* MapLoader::load(const string& filename) {
         }
     }
 
-    cout << "Printout of Map:" << endl;
-    cout << gameMap << endl;
-
-    file.close();
-
-    cout << "Finished reading file into Map" << endl;
     return gameMap;
 }
 
@@ -3,11 +3,15 @@
 #ifndef COMP_345_PROJECT_TEAM_N12_MAP_H
 #define COMP_345_PROJECT_TEAM_N12_MAP_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <iostream>
-#include "player/player.h"
+#include "continent_graph.h"
 
 #define MAPS_DIR "../maps/"
 
@@ -17,6 +21,7 @@ using std::vector;
 
 class Territory;
 class Player;
+class Map;
 
 class Continent{
 private:
@@ -58,6 +63,10 @@ private:
     list<Territory*> neighbours;
     int numberOfArmies;
     Player* owner;
+    // The map the territory was added to, told about every change of owner or armies (nullptr if there is none)
+    Map* map;
+    // True if the territory changed since its map last handed out its dirty territories
+    bool dirty;
 public:
     Territory(int id, const string &name, int x, int y, int continentId);
     const string &getName() const;
@@ -71,6 +80,10 @@ public:
     void addNeighbour(Territory* territory);
     void addArmies(const int numArmies);
     void removeArmies(const int numArmies);
+    void setMap(Map* newMap);
+    Map* getMap() const;
+    bool isDirty() const;
+    void setDirty(bool isDirty);
 
     int getX() const;
 
@@ -94,6 +107,18 @@ private:
     vector<Territory*> territories;
     vector<Continent*> continents;
     string name;
+    // Zobrist-style hashes of the board, kept up to date by the territories: the XOR of one key per territory and
+    // owner, and of one key per territory and number of armies. Orders on disjoint territories may be executed at the
+    // same time, so the hashes are updated atomically; XOR commutes, so they do not depend on the order of updates.
+    std::atomic<uint64_t> ownershipHash;
+    std::atomic<uint64_t> armiesHash;
+    // The territories which changed owner or number of armies since they were last taken, each listed once. Orders on
+    // disjoint territories may be executed at the same time, so the list is guarded by a mutex.
+    vector<Territory*> dirtyTerritories;
+    std::mutex dirtyMutex;
+    // The map contracted to its continents, built on first use and dropped when a territory, a border or a continent
+    // is added (nullptr until then). The territories keep its totals up to date through onTerritoryChanged.
+    std::unique_ptr<ContinentGraph> continentGraph;
     static bool isConnected(const vector<Territory*>& territories);
     static void dfs(Territory *const &currentTerritory, const vector<Territory *> &territories, list<int> &visitedTerritories);
 
@@ -112,11 +137,36 @@ public:
 
     unsigned int getContinentsSize();
 
+    // Getter for the continent graph of the map, which is built on the first call. The first call must not be made
+    // while orders are being executed.
+    const ContinentGraph& getContinentGraph();
+
+    // Updates the hashes of the board and the continent graph after a territory changed owner or number of armies,
+    // and marks it dirty
+    void onTerritoryChanged(Territory& territory, Player* oldOwner, int oldArmies);
+
+    // Returns the territories which changed since the last call, by ID, and marks them clean
+    vector<Territory*> takeDirtyTerritories();
+
+    // Builds a new map of the given name with its own continents and territories and the same borders, whose
+    // territories have no owner and no armies. Unlike the copy constructor, the new map shares nothing with this one.
+    Map* freshCopy(const string& copyName) const;
+
+    // Getter for the hash of the owners of the territories
+    uint64_t getOwnershipHash() const;
+
+    // Getter for the hash of the whole board: the owners and the armies of the territories
+    uint64_t getStateHash() const;
+
     Map(string name);
 
-    // Copy constructor
+    // Copy constructor. The territories are shared and keep reporting their changes to the map they were added to, so
+    // the copy gets a snapshot of the continent graph.
     Map(const Map& map);
 
+    // Move constructor
+    Map(Map&& map) noexcept;
+
     // Stream insertion operator
     friend std::ostream &operator<<(std::ostream &out, Map* map);
 
@@ -127,6 +177,10 @@ public:
 class MapLoader {
 public:
     static Map* load(const string& filename);
+
+    // Parses a map of the given name from the given stream, without printing it. Throws a runtime_error if the text
+    // does not describe a map.
+    static Map* parse(const string& name, std::istream& input);
 };
 
 // Free function in order to test the functionality of the Map for assignment #1.
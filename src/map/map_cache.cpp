@@ -0,0 +1,118 @@
+#include "map_cache.h"
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include "concurrency/thread_pool.h"
+
+// The implementation file of the MapCache class.
+
+MapCache::MapCache(ThreadPool &pool) : pool(pool) {}
+
+uint64_t MapCache::hashContent(const std::string &text) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char byte: text) {
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::shared_ptr<const LoadedMap> MapCache::build(const std::string &filename, const std::string &text, uint64_t hash) {
+    std::istringstream input(text);
+    Map *map = MapLoader::parse(filename, input);
+    try {
+        map->validate();
+    } catch (std::exception &) {
+        delete map;
+        throw;
+    }
+
+    auto loaded = std::make_shared<LoadedMap>();
+    loaded->contentHash = hash;
+    loaded->topology = std::make_shared<const MapTopology>(*map);
+    loaded->prototype = std::shared_ptr<const Map>(map);
+    return loaded;
+}
+
+std::vector<std::shared_ptr<const LoadedMap>> MapCache::load(const std::vector<std::string> &filenames,
+                                                             std::vector<std::string> &errors) {
+    // Read and hash every file
+    struct MapFile {
+        bool isReadable = false;
+        std::string text;
+        uint64_t hash = 0;
+    };
+    std::vector<std::future<MapFile>> reads;
+    reads.reserve(filenames.size());
+    for (const std::string &filename: filenames) {
+        reads.push_back(pool.submit([&filename]() {
+            MapFile file;
+            std::ifstream input(MAPS_DIR + filename, std::ios::binary);
+            if (input) {
+                std::ostringstream text;
+                text << input.rdbuf();
+                file.isReadable = true;
+                file.text = text.str();
+                file.hash = hashContent(file.text);
+            }
+            return file;
+        }));
+    }
+    std::vector<MapFile> files;
+    files.reserve(filenames.size());
+    for (std::future<MapFile> &read: reads) {
+        files.push_back(pool.await(read));
+    }
+
+    // Build the maps whose text was never seen, once per text
+    std::unordered_map<uint64_t, std::future<std::shared_ptr<const LoadedMap>>> builds;
+    {
+        std::lock_guard<std::mutex> lock(mapsMutex);
+        for (size_t i = 0; i < files.size(); i++) {
+            const MapFile &file = files[i];
+            if (!file.isReadable || maps.count(file.hash) != 0 || builds.count(file.hash) != 0) {
+                continue;
+            }
+            builds.emplace(file.hash, pool.submit([&filename = filenames[i], &file]() {
+                return build(filename, file.text, file.hash);
+            }));
+        }
+    }
+
+    std::unordered_map<uint64_t, std::string> buildErrors;
+    for (auto &[hash, future]: builds) {
+        try {
+            std::shared_ptr<const LoadedMap> loaded = pool.await(future);
+            std::lock_guard<std::mutex> lock(mapsMutex);
+            maps.emplace(hash, std::move(loaded));
+        } catch (std::exception &exp) {
+            buildErrors.emplace(hash, exp.what());
+        }
+    }
+
+    std::vector<std::shared_ptr<const LoadedMap>> loadedMaps;
+    loadedMaps.reserve(filenames.size());
+    std::lock_guard<std::mutex> lock(mapsMutex);
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!files[i].isReadable) {
+            errors.push_back("File " + filenames[i] + " doesn't exist");
+            loadedMaps.emplace_back(nullptr);
+        } else if (buildErrors.count(files[i].hash) != 0) {
+            errors.push_back("Could not load/validate map " + filenames[i] + ": " + buildErrors[files[i].hash]);
+            loadedMaps.emplace_back(nullptr);
+        } else {
+            loadedMaps.push_back(maps.at(files[i].hash));
+        }
+    }
+    return loadedMaps;
+}
+
+size_t MapCache::size() {
+    std::lock_guard<std::mutex> lock(mapsMutex);
+    return maps.size();
+}
+
+MapCache &MapCache::shared() {
+    static MapCache cache(ThreadPool::shared());
+    return cache;
+}
@@ -0,0 +1,61 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_MAP_CACHE_H
+#define COMP_345_PROJECT_TEAM_N12_MAP_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "map.h"
+#include "game_state/map_topology.h"
+
+class ThreadPool;
+
+// A map file parsed and validated once. Games never play on the prototype: each one plays on a fresh copy of it, and
+// every game shares the immutable topology.
+struct LoadedMap {
+    // The hash of the text of the map file.
+    uint64_t contentHash = 0;
+    std::shared_ptr<const Map> prototype;
+    std::shared_ptr<const MapTopology> topology;
+};
+
+// Loads map files in parallel, keeping every valid map by the hash of its text, so that a file (or another file with
+// the same text) is only parsed and validated once.
+class MapCache {
+private:
+    ThreadPool &pool;
+
+    // The maps loaded so far, by content hash.
+    std::unordered_map<uint64_t, std::shared_ptr<const LoadedMap>> maps;
+    std::mutex mapsMutex;
+
+    // Returns the hash of the text of a map file (64-bit FNV-1a).
+    static uint64_t hashContent(const std::string &text);
+
+    // Parses and validates the text of a map file. Throws an exception if the map is invalid.
+    static std::shared_ptr<const LoadedMap> build(const std::string &filename, const std::string &text, uint64_t hash);
+
+public:
+    // One param constructor which takes the pool loading the files.
+    explicit MapCache(ThreadPool &pool);
+
+    // A cache is shared through references, so it cannot be copied.
+    MapCache(const MapCache &cache) = delete;
+    MapCache &operator=(const MapCache &cache) = delete;
+
+    // Loads the given files from the maps directory. The files are read and hashed in parallel, then the texts not
+    // seen before are parsed and validated in parallel. Returns one map per file, in order; a file which cannot be
+    // read or holds an invalid map gives nullptr, and the reason is added to the errors.
+    std::vector<std::shared_ptr<const LoadedMap>> load(const std::vector<std::string> &filenames,
+                                                       std::vector<std::string> &errors);
+
+    // Getter for the number of distinct maps loaded so far.
+    size_t size();
+
+    // Returns the cache shared by the whole application, loading on the shared thread pool.
+    static MapCache &shared();
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_MAP_CACHE_H
@@ -0,0 +1,556 @@
+#include "map_editor.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include "map.h"
+
+// The implementation file of the MapEditor class.
+
+namespace {
+    // Map files separate their fields with spaces, so the names written in them cannot hold any.
+    string fileName(string text) {
+        std::replace_if(text.begin(), text.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); }, '_');
+        return text.empty() ? "_" : text;
+    }
+}
+
+// One param constructor which starts an empty map of the given name.
+MapEditor::MapEditor(const string &name) : name(name) {}
+
+// One param constructor which starts from the continents, territories and borders of the given map. The borders of
+// the editor are two-way, so a map with a one-way border cannot be edited: Map::validate follows the borders in their
+// direction only, and the editor would not tell whether such a map is valid.
+MapEditor::MapEditor(Map &map) : name(map.getName()) {
+    for (unsigned int id = 1; id <= map.getContinentsSize(); id++) {
+        Continent *continent = map.getContinentByID(static_cast<int>(id));
+        addContinent(continent->getName(), continent->getColour(), continent->getArmyBonusNumber());
+    }
+    for (unsigned int id = 1; id <= map.getSize(); id++) {
+        Territory *territory = map.getTerritoryByID(static_cast<int>(id));
+        addTerritory(territory->getName(), territory->getX(), territory->getY(), territory->getContinentId());
+    }
+    for (unsigned int id = 1; id <= map.getSize(); id++) {
+        Territory *territory = map.getTerritoryByID(static_cast<int>(id));
+        for (Territory *neighbour: territory->getNeighbours()) {
+            const list<Territory *> &backwards = neighbour->getNeighbours();
+            if (std::find(backwards.begin(), backwards.end(), territory) == backwards.end()) {
+                throw std::runtime_error("Error: the border from " + territory->getName() + " to " +
+                                         neighbour->getName() + " is one-way, and the map editor only has two-way borders");
+            }
+            addBorder(static_cast<int>(id), neighbour->getId());
+        }
+    }
+}
+
+// Returns true if the given ID is a territory of the map.
+bool MapEditor::hasTerritory(int territoryId) const {
+    return territoryId >= 1 && territoryId <= static_cast<int>(territories.size()) && territories[territoryId - 1].exists;
+}
+
+// Returns true if the given ID is a continent of the map.
+bool MapEditor::hasContinent(int continentId) const {
+    return continentId >= 1 && continentId <= static_cast<int>(continents.size()) && continents[continentId - 1].exists;
+}
+
+// Returns true if a border between two territories counts for the given components.
+bool MapEditor::isCounted(const Components &components, int first, int second) const {
+    return !components.isPerContinent || territories[first - 1].continentId == territories[second - 1].continentId;
+}
+
+// Counts a component of the given continent more, or less. Only the components of the continents are counted by
+// continent, since the number of components of the map is the number of its labels.
+void MapEditor::countComponent(const Components &components, int continentId, int delta) {
+    if (!components.isPerContinent) {
+        return;
+    }
+    ContinentNode &continent = continents[continentId - 1];
+    bool wasDisconnected = continent.numComponents > 1;
+    continent.numComponents += delta;
+    numDisconnectedContinents += (continent.numComponents > 1) - wasDisconnected;
+}
+
+// Puts a territory in a component of its own.
+void MapEditor::addComponent(Components &components, int territoryId) {
+    int label = components.nextLabel++;
+    components.labels[territoryId - 1] = label;
+    components.sizes[label] = 1;
+    countComponent(components, territories[territoryId - 1].continentId, 1);
+}
+
+// Joins the components of two territories after a border was added between them. The territories of the smaller
+// component take the label of the larger one.
+void MapEditor::joinComponents(Components &components, int first, int second) {
+    int firstLabel = components.labels[first - 1];
+    int secondLabel = components.labels[second - 1];
+    if (firstLabel == secondLabel) {
+        return;
+    }
+    if (components.sizes[firstLabel] < components.sizes[secondLabel]) {
+        std::swap(first, second);
+        std::swap(firstLabel, secondLabel);
+    }
+
+    vector<int> queue = {second};
+    components.labels[second - 1] = firstLabel;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        for (int neighbour: territories[current - 1].neighbours) {
+            if (components.labels[neighbour - 1] == secondLabel && isCounted(components, current, neighbour)) {
+                components.labels[neighbour - 1] = firstLabel;
+                queue.push_back(neighbour);
+            }
+        }
+    }
+
+    components.sizes[firstLabel] += components.sizes[secondLabel];
+    components.sizes.erase(secondLabel);
+    countComponent(components, territories[second - 1].continentId, -1);
+}
+
+// Takes a territory out of its component after its counted borders were cut. The territory has no label afterwards.
+void MapEditor::detachTerritory(Components &components, int territoryId, const vector<int> &formerNeighbours) {
+    int label = components.labels[territoryId - 1];
+    components.labels[territoryId - 1] = -1;
+    if (--components.sizes[label] == 0) {
+        components.sizes.erase(label);
+        countComponent(components, territories[territoryId - 1].continentId, -1);
+        return;
+    }
+
+    // Only the neighbours of the same component may have been split from each other
+    vector<int> seeds;
+    for (int neighbour: formerNeighbours) {
+        if (components.labels[neighbour - 1] == label) {
+            seeds.push_back(neighbour);
+        }
+    }
+    splitComponent(components, seeds);
+}
+
+// Splits the component of the given territories into the pieces it now makes. Every territory starts a search of the
+// component, and the searches take one step each in turn. Two searches which meet are in the same piece and go on as
+// one. A search which ends before the others has found a whole piece, which gets a new label, and the last search left
+// keeps the label of the component without going any further.
+void MapEditor::splitComponent(Components &components, const vector<int> &seeds) {
+    if (seeds.size() < 2) {
+        return;
+    }
+    int label = components.labels[seeds[0] - 1];
+
+    struct Search {
+        int parent;
+        bool isFinished = false;
+        size_t head = 0;
+        vector<int> queue;
+    };
+    vector<Search> searches;
+    std::unordered_map<int, int> searchOf;
+    for (int seed: seeds) {
+        if (searchOf.emplace(seed, static_cast<int>(searches.size())).second) {
+            searches.push_back({static_cast<int>(searches.size()), false, 0, {seed}});
+        }
+    }
+
+    auto findSearch = [&](int search) {
+        while (searches[search].parent != search) {
+            search = searches[search].parent = searches[searches[search].parent].parent;
+        }
+        return search;
+    };
+
+    size_t numRunning = searches.size();
+    while (numRunning > 1) {
+        for (size_t s = 0; s < searches.size() && numRunning > 1; s++) {
+            Search &search = searches[s];
+            if (search.parent != static_cast<int>(s) || search.isFinished) {
+                continue;
+            }
+
+            if (search.head == search.queue.size()) {
+                // The piece is whole: the searched territories are all the territories it has
+                int pieceLabel = components.nextLabel++;
+                for (int territoryId: search.queue) {
+                    components.labels[territoryId - 1] = pieceLabel;
+                }
+                components.sizes[pieceLabel] = static_cast<int>(search.queue.size());
+                components.sizes[label] -= static_cast<int>(search.queue.size());
+                countComponent(components, territories[search.queue[0] - 1].continentId, 1);
+                search.isFinished = true;
+                numRunning--;
+                continue;
+            }
+
+            int current = search.queue[search.head++];
+            for (int neighbour: territories[current - 1].neighbours) {
+                if (components.labels[neighbour - 1] != label || !isCounted(components, current, neighbour)) {
+                    continue;
+                }
+                auto found = searchOf.find(neighbour);
+                if (found == searchOf.end()) {
+                    searchOf.emplace(neighbour, static_cast<int>(s));
+                    search.queue.push_back(neighbour);
+                    continue;
+                }
+                int other = findSearch(found->second);
+                if (other != static_cast<int>(s)) {
+                    // The searches met: the other one goes on as part of this one
+                    Search &met = searches[other];
+                    search.queue.insert(search.queue.end(), met.queue.begin(), met.queue.end());
+                    std::rotate(search.queue.begin() + static_cast<long>(search.head),
+                                search.queue.end() - static_cast<long>(met.queue.size()),
+                                search.queue.end() - static_cast<long>(met.queue.size() - met.head));
+                    search.head += met.head;
+                    met.queue.clear();
+                    met.parent = static_cast<int>(s);
+                    numRunning--;
+                }
+            }
+        }
+    }
+}
+
+// Adds a continent. Returns its ID.
+int MapEditor::addContinent(const string &continentName, const string &colour, int armyBonus) {
+    ContinentNode continent;
+    continent.exists = true;
+    continent.name = continentName;
+    continent.colour = colour;
+    continent.armyBonus = armyBonus;
+    continents.push_back(continent);
+    numContinents++;
+    numEmptyContinents++;
+    return static_cast<int>(continents.size());
+}
+
+// Removes a continent, which must have no territories.
+bool MapEditor::removeContinent(int continentId) {
+    if (!hasContinent(continentId) || continents[continentId - 1].size > 0) {
+        return false;
+    }
+    continents[continentId - 1].exists = false;
+    numContinents--;
+    numEmptyContinents--;
+    return true;
+}
+
+// Adds a territory to a continent. Returns its ID, or 0 if there is no such continent.
+int MapEditor::addTerritory(const string &territoryName, int x, int y, int continentId) {
+    if (!hasContinent(continentId)) {
+        return 0;
+    }
+    TerritoryNode territory;
+    territory.exists = true;
+    territory.name = territoryName;
+    territory.x = x;
+    territory.y = y;
+    territory.continentId = continentId;
+    territories.push_back(territory);
+    int territoryId = static_cast<int>(territories.size());
+
+    if (continents[continentId - 1].size++ == 0) {
+        numEmptyContinents--;
+    }
+    numTerritories++;
+    mapComponents.labels.push_back(-1);
+    continentComponents.labels.push_back(-1);
+    addComponent(mapComponents, territoryId);
+    addComponent(continentComponents, territoryId);
+    return territoryId;
+}
+
+// Removes a territory and its borders.
+bool MapEditor::removeTerritory(int territoryId) {
+    if (!hasTerritory(territoryId)) {
+        return false;
+    }
+    TerritoryNode &territory = territories[territoryId - 1];
+    vector<int> formerNeighbours;
+    formerNeighbours.swap(territory.neighbours);
+    for (int neighbour: formerNeighbours) {
+        vector<int> &borders = territories[neighbour - 1].neighbours;
+        borders.erase(std::find(borders.begin(), borders.end(), territoryId));
+    }
+
+    detachTerritory(mapComponents, territoryId, formerNeighbours);
+    detachTerritory(continentComponents, territoryId, formerNeighbours);
+
+    if (--continents[territory.continentId - 1].size == 0) {
+        numEmptyContinents++;
+    }
+    territory.exists = false;
+    numTerritories--;
+    return true;
+}
+
+// Adds a border between two territories.
+bool MapEditor::addBorder(int first, int second) {
+    if (first == second || !hasTerritory(first) || !hasTerritory(second)) {
+        return false;
+    }
+    vector<int> &firstBorders = territories[first - 1].neighbours;
+    if (std::find(firstBorders.begin(), firstBorders.end(), second) != firstBorders.end()) {
+        return false;
+    }
+    firstBorders.push_back(second);
+    territories[second - 1].neighbours.push_back(first);
+
+    joinComponents(mapComponents, first, second);
+    if (isCounted(continentComponents, first, second)) {
+        joinComponents(continentComponents, first, second);
+    }
+    return true;
+}
+
+// Removes the border between two territories.
+bool MapEditor::removeBorder(int first, int second) {
+    if (!hasTerritory(first) || !hasTerritory(second)) {
+        return false;
+    }
+    vector<int> &firstBorders = territories[first - 1].neighbours;
+    auto border = std::find(firstBorders.begin(), firstBorders.end(), second);
+    if (border == firstBorders.end()) {
+        return false;
+    }
+    firstBorders.erase(border);
+    vector<int> &secondBorders = territories[second - 1].neighbours;
+    secondBorders.erase(std::find(secondBorders.begin(), secondBorders.end(), first));
+
+    splitComponent(mapComponents, {first, second});
+    if (isCounted(continentComponents, first, second)) {
+        splitComponent(continentComponents, {first, second});
+    }
+    return true;
+}
+
+// Moves a territory to another continent. The territory leaves the component of its old continent as if it was
+// removed from it, and joins the components of its neighbours on the new continent as if its borders were added.
+bool MapEditor::moveTerritory(int territoryId, int continentId) {
+    if (!hasTerritory(territoryId) || !hasContinent(continentId)) {
+        return false;
+    }
+    TerritoryNode &territory = territories[territoryId - 1];
+    if (territory.continentId == continentId) {
+        return true;
+    }
+
+    detachTerritory(continentComponents, territoryId, territory.neighbours);
+    if (--continents[territory.continentId - 1].size == 0) {
+        numEmptyContinents++;
+    }
+
+    territory.continentId = continentId;
+    if (continents[continentId - 1].size++ == 0) {
+        numEmptyContinents--;
+    }
+    addComponent(continentComponents, territoryId);
+    for (int neighbour: territory.neighbours) {
+        if (isCounted(continentComponents, territoryId, neighbour)) {
+            joinComponents(continentComponents, territoryId, neighbour);
+        }
+    }
+    return true;
+}
+
+// Getter for the number of territories.
+int MapEditor::getNumberOfTerritories() const {
+    return numTerritories;
+}
+
+// Getter for the number of continents.
+int MapEditor::getNumberOfContinents() const {
+    return numContinents;
+}
+
+// Getter for the number of connected components of the map.
+int MapEditor::getNumberOfComponents() const {
+    return static_cast<int>(mapComponents.sizes.size());
+}
+
+// Getter for the number of connected components of a continent.
+int MapEditor::getNumberOfComponents(int continentId) const {
+    return hasContinent(continentId) ? continents[continentId - 1].numComponents : 0;
+}
+
+// Returns true if two territories are connected through any continent.
+bool MapEditor::areConnected(int first, int second) const {
+    return hasTerritory(first) && hasTerritory(second) &&
+           mapComponents.labels[first - 1] == mapComponents.labels[second - 1];
+}
+
+// Returns true if two territories are connected within their continent.
+bool MapEditor::areConnectedInContinent(int first, int second) const {
+    return hasTerritory(first) && hasTerritory(second) &&
+           continentComponents.labels[first - 1] == continentComponents.labels[second - 1];
+}
+
+// Returns true if the map would pass Map::validate.
+bool MapEditor::isValid() const {
+    return numTerritories > 0 && numEmptyContinents == 0 && mapComponents.sizes.size() == 1 &&
+           numDisconnectedContinents == 0;
+}
+
+// Returns the reason the map is invalid, or an empty string if it is valid. Only an invalid map has its continents
+// looked at.
+string MapEditor::getValidationError() const {
+    if (isValid()) {
+        return "";
+    }
+    for (const ContinentNode &continent: continents) {
+        if (continent.exists && continent.size == 0) {
+            return "Continent " + continent.name + " does not have a country";
+        }
+    }
+    if (mapComponents.sizes.size() != 1) {
+        return "Error: Map is not a connected graph!";
+    }
+    for (const ContinentNode &continent: continents) {
+        if (continent.exists && continent.numComponents > 1) {
+            return "ERROR! Continent " + continent.name + " is not connected!";
+        }
+    }
+    return "";
+}
+
+// Builds a new map from the edited one, with its continents and territories numbered from 1 in the order they were
+// added.
+Map *MapEditor::build() const {
+    vector<int> continentIds(continents.size(), 0);
+    vector<int> territoryIds(territories.size(), 0);
+    int nextId = 1;
+    for (size_t i = 0; i < continents.size(); i++) {
+        continentIds[i] = continents[i].exists ? nextId++ : 0;
+    }
+    nextId = 1;
+    for (size_t i = 0; i < territories.size(); i++) {
+        territoryIds[i] = territories[i].exists ? nextId++ : 0;
+    }
+
+    Map *map = new Map(name);
+    for (const ContinentNode &continent: continents) {
+        if (continent.exists) {
+            map->addContinent(new Continent(continent.name, continent.colour, continent.armyBonus));
+        }
+    }
+    for (size_t i = 0; i < territories.size(); i++) {
+        const TerritoryNode &node = territories[i];
+        if (node.exists) {
+            int continentId = continentIds[node.continentId - 1];
+            auto *territory = new Territory(territoryIds[i], node.name, node.x, node.y, continentId);
+            map->getContinentByID(continentId)->addTerritory(territory);
+            map->addTerritory(territory);
+        }
+    }
+    for (size_t i = 0; i < territories.size(); i++) {
+        for (int neighbour: territories[i].neighbours) {
+            map->addEdge(territoryIds[i], territoryIds[neighbour - 1]);
+        }
+    }
+    return map;
+}
+
+// Writes the edited map in the format of the map files, which MapLoader reads back.
+void MapEditor::write(std::ostream &out) const {
+    vector<int> continentIds(continents.size(), 0);
+    vector<int> territoryIds(territories.size(), 0);
+
+    out << "; map: " << fileName(name) << "\n; written by the map editor\n\n[continents]\n";
+    int nextId = 1;
+    for (size_t i = 0; i < continents.size(); i++) {
+        if (continents[i].exists) {
+            continentIds[i] = nextId++;
+            out << fileName(continents[i].name) << " " << continents[i].armyBonus << " "
+                << fileName(continents[i].colour) << "\n";
+        }
+    }
+
+    out << "\n[countries]\n";
+    nextId = 1;
+    for (size_t i = 0; i < territories.size(); i++) {
+        const TerritoryNode &territory = territories[i];
+        if (territory.exists) {
+            territoryIds[i] = nextId++;
+            out << territoryIds[i] << " " << fileName(territory.name) << " "
+                << continentIds[territory.continentId - 1] << " " << territory.x << " " << territory.y << "\n";
+        }
+    }
+
+    // A territory without borders has no line, which only happens on a map of a single territory
+    out << "\n[borders]\n";
+    for (size_t i = 0; i < territories.size(); i++) {
+        if (territories[i].exists && !territories[i].neighbours.empty()) {
+            out << territoryIds[i];
+            for (int neighbour: territories[i].neighbours) {
+                out << " " << territoryIds[neighbour - 1];
+            }
+            out << "\n";
+        }
+    }
+}
+
+namespace {
+    // Prints what the editor tells of the map after an edit next to what Map::validate finds on the built map, and
+    // returns true if they agree.
+    bool checkEdit(const MapEditor &editor, const string &edit) {
+        std::cout << "\n**********" << edit << "**********" << std::endl;
+        bool isEditorValid = editor.isValid();
+        std::cout << "Editor: " << (isEditorValid ? "valid" : "invalid (" + editor.getValidationError() + ")") << ", "
+             << editor.getNumberOfComponents() << " component(s)" << std::endl;
+
+        Map *map = editor.build();
+        bool isMapValid = true;
+        try {
+            map->validate();
+        } catch (std::runtime_error &exp) {
+            std::cout << exp.what() << std::endl;
+            isMapValid = false;
+        }
+        delete map;
+
+        std::cout << (isEditorValid == isMapValid ? "Agreed with Map::validate" : "Error: disagreed with Map::validate")
+             << std::endl;
+        return isEditorValid == isMapValid;
+    }
+}
+
+// Free function in order to test the functionality of the MapEditor.
+void map_editor_driver() {
+    std::cout << "\n***************************MapEditor driver function***************************" << std::endl;
+
+    // Two continents joined by a single border: West is the chain 1-2-3, East the chain 4-5
+    MapEditor editor("driver");
+    int west = editor.addContinent("West", "blue", 3);
+    int east = editor.addContinent("East", "red", 2);
+    int first = editor.addTerritory("First", 10, 10, west);
+    int second = editor.addTerritory("Second", 20, 10, west);
+    int third = editor.addTerritory("Third", 30, 10, west);
+    int fourth = editor.addTerritory("Fourth", 40, 10, east);
+    int fifth = editor.addTerritory("Fifth", 50, 10, east);
+    editor.addBorder(first, second);
+    editor.addBorder(second, third);
+    editor.addBorder(third, fourth);
+    editor.addBorder(fourth, fifth);
+    bool isAgreed = checkEdit(editor, "Map built");
+
+    // Third-Fourth is the only border between the continents, so removing it cuts the map in two
+    editor.removeBorder(third, fourth);
+    isAgreed &= checkEdit(editor, "Bridge border Third-Fourth removed");
+    editor.addBorder(third, fourth);
+    isAgreed &= checkEdit(editor, "Bridge border Third-Fourth added back");
+
+    // Second holds West together, so removing it cuts the continent and the map
+    editor.removeTerritory(second);
+    isAgreed &= checkEdit(editor, "Cut territory Second removed");
+    int middle = editor.addTerritory("Middle", 20, 20, west);
+    editor.addBorder(first, middle);
+    editor.addBorder(middle, third);
+    isAgreed &= checkEdit(editor, "Territory Middle added in its place");
+
+    // Third borders East, so it can join it, but Fifth cannot join West away from Fourth
+    editor.moveTerritory(third, east);
+    isAgreed &= checkEdit(editor, "Territory Third moved to East");
+    editor.moveTerritory(fifth, west);
+    isAgreed &= checkEdit(editor, "Territory Fifth moved to West");
+
+    std::cout << "\n" << (isAgreed ? "The editor agreed with Map::validate after every edit"
+                              : "Error: the editor disagreed with Map::validate") << std::endl;
+}
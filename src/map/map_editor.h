@@ -0,0 +1,157 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_MAP_EDITOR_H
+#define COMP_345_PROJECT_TEAM_N12_MAP_EDITOR_H
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+// Forward declaration.
+class Map;
+
+// A map being edited: continents and territories can be added and removed, borders added and removed, and territories
+// moved between continents. The editor keeps the connected components of the whole map and of every continent up to
+// date after each edit, so that the validity of the map (the rules checked by Map::validate) is known at once, without
+// the traversal of the whole map that Map::validate makes:
+//
+// - a border joining two components relabels the smaller one, so a territory is relabeled O(log n) times at most;
+// - a border or a territory removed from a component searches from its ends in lockstep, and stops as soon as the
+//   searches meet or all but one are exhausted, so a split costs the size of the pieces cut off rather than the map.
+//
+// Borders are two-way, as they are in map files, which is what makes the connected components match the traversal of
+// Map::validate; a map with a one-way border is refused. The IDs of the territories and continents are never reused,
+// and build() numbers them from 1 in the order they were added, as map files do.
+class MapEditor {
+private:
+    // A territory of the map, or a removed one.
+    struct TerritoryNode {
+        bool exists = false;
+        string name;
+        int x = 0;
+        int y = 0;
+        int continentId = 0;
+        vector<int> neighbours;
+    };
+
+    // A continent of the map, or a removed one.
+    struct ContinentNode {
+        bool exists = false;
+        string name;
+        string colour;
+        int armyBonus = 0;
+        int size = 0;
+
+        // The number of connected components of the continent.
+        int numComponents = 0;
+    };
+
+    // The connected components of the map, or of the continents: a label per territory and the size of every label.
+    struct Components {
+        // True if only the borders within a continent count.
+        bool isPerContinent;
+        vector<int> labels;
+        std::unordered_map<int, int> sizes;
+        int nextLabel = 0;
+
+        // One param constructor which starts with no territories.
+        explicit Components(bool isPerContinent) : isPerContinent(isPerContinent) {}
+    };
+
+    string name;
+    vector<TerritoryNode> territories;
+    vector<ContinentNode> continents;
+    int numTerritories = 0;
+    int numContinents = 0;
+    int numEmptyContinents = 0;
+    int numDisconnectedContinents = 0;
+    Components mapComponents{false};
+    Components continentComponents{true};
+
+    // Returns true if the given IDs are a territory or a continent of the map.
+    [[nodiscard]] bool hasTerritory(int territoryId) const;
+    [[nodiscard]] bool hasContinent(int continentId) const;
+
+    // Returns true if a border between two territories counts for the given components.
+    [[nodiscard]] bool isCounted(const Components &components, int first, int second) const;
+
+    // Counts a component of the given continent more, or less.
+    void countComponent(const Components &components, int continentId, int delta);
+
+    // Puts a territory in a component of its own.
+    void addComponent(Components &components, int territoryId);
+
+    // Joins the components of two territories after a border was added between them, relabeling the smaller one.
+    void joinComponents(Components &components, int first, int second);
+
+    // Takes a territory out of its component after its counted borders were cut, splitting what is left of the
+    // component if the territory held it together. The former neighbours are the territories it was bordering.
+    void detachTerritory(Components &components, int territoryId, const vector<int> &formerNeighbours);
+
+    // Splits the component of the given territories, which were connected before a border or a territory was removed,
+    // into the pieces it now makes.
+    void splitComponent(Components &components, const vector<int> &seeds);
+
+public:
+    // One param constructor which starts an empty map of the given name.
+    explicit MapEditor(const string &name);
+
+    // One param constructor which starts from the continents, territories and borders of the given map. The IDs of
+    // the map are kept. Throws a runtime_error if the map has a one-way border.
+    explicit MapEditor(Map &map);
+
+    // Adds a continent. Returns its ID.
+    int addContinent(const string &continentName, const string &colour, int armyBonus);
+
+    // Removes a continent, which must have no territories. Returns false if it cannot.
+    bool removeContinent(int continentId);
+
+    // Adds a territory to a continent. Returns its ID, or 0 if there is no such continent.
+    int addTerritory(const string &territoryName, int x, int y, int continentId);
+
+    // Removes a territory and its borders. Returns false if there is no such territory.
+    bool removeTerritory(int territoryId);
+
+    // Adds a border between two territories. Returns false if they are the same, missing, or already bordering.
+    bool addBorder(int first, int second);
+
+    // Removes the border between two territories. Returns false if there is none.
+    bool removeBorder(int first, int second);
+
+    // Moves a territory to another continent. Returns false if either is missing.
+    bool moveTerritory(int territoryId, int continentId);
+
+    // Getters for the number of territories and continents.
+    [[nodiscard]] int getNumberOfTerritories() const;
+    [[nodiscard]] int getNumberOfContinents() const;
+
+    // Getter for the number of connected components of the map.
+    [[nodiscard]] int getNumberOfComponents() const;
+
+    // Getter for the number of connected components of a continent (0 if there is no such continent).
+    [[nodiscard]] int getNumberOfComponents(int continentId) const;
+
+    // Returns true if two territories are connected, through any continent or within their continent.
+    [[nodiscard]] bool areConnected(int first, int second) const;
+    [[nodiscard]] bool areConnectedInContinent(int first, int second) const;
+
+    // Returns true if the map would pass Map::validate: it has territories, no continent is empty, the map is
+    // connected and every continent is connected. Takes constant time.
+    [[nodiscard]] bool isValid() const;
+
+    // Returns the reason the map is invalid, worded as Map::validate words it, or an empty string if it is valid.
+    [[nodiscard]] string getValidationError() const;
+
+    // Builds a new map from the edited one, with its continents and territories numbered from 1.
+    [[nodiscard]] Map *build() const;
+
+    // Writes the edited map in the format of the map files, with its continents and territories numbered from 1.
+    void write(std::ostream &out) const;
+};
+
+// Free function in order to test the functionality of the MapEditor.
+void map_editor_driver();
+
+#endif //COMP_345_PROJECT_TEAM_N12_MAP_EDITOR_H
@@ -0,0 +1,74 @@
+#include "map_renderer.h"
+#include "player/player.h"
+
+// The implementation file of the MapDeltaRenderer class.
+
+int MapDeltaRenderer::fullDumpInterval = 10;
+
+MapDeltaRenderer::MapDeltaRenderer() : renderedMap(nullptr), rendersSinceFullDump(0) {}
+
+MapDeltaRenderer::TerritorySnapshot MapDeltaRenderer::snapshotOf(const Territory& territory) {
+    TerritorySnapshot snapshot;
+    snapshot.owner = territory.getOwner() != nullptr ? territory.getOwner()->getPName() : "no one";
+    snapshot.numberOfArmies = territory.getNumberOfArmies();
+    return snapshot;
+}
+
+void MapDeltaRenderer::render(std::ostream& out, Map& map) {
+    if (&map != renderedMap || rendersSinceFullDump + 1 >= fullDumpInterval) {
+        renderFull(out, map);
+    } else {
+        renderDelta(out, map);
+    }
+}
+
+// The dirty territories are taken as well, since the full dump already shows them.
+void MapDeltaRenderer::renderFull(std::ostream& out, Map& map) {
+    map.takeDirtyTerritories();
+    out << &map << std::endl;
+
+    printed.resize(map.getSize());
+    for (unsigned int i = 0; i < map.getSize(); i++) {
+        printed[i] = snapshotOf(*map.getTerritoryByID(static_cast<int>(i) + 1));
+    }
+    renderedMap = &map;
+    rendersSinceFullDump = 0;
+}
+
+// A territory may be dirty and still be as it was last printed (armies moved out and back), in which case it is
+// skipped.
+void MapDeltaRenderer::renderDelta(std::ostream& out, Map& map) {
+    rendersSinceFullDump++;
+
+    int numChanged = 0;
+    out << "Changes on map " << map.getName() << ":" << std::endl;
+    for (Territory* territory : map.takeDirtyTerritories()) {
+        TerritorySnapshot now = snapshotOf(*territory);
+        TerritorySnapshot& before = printed[territory->getId() - 1];
+        if (now.owner == before.owner && now.numberOfArmies == before.numberOfArmies) {
+            continue;
+        }
+
+        out << "Country #" << territory->getId() << " of name " << territory->getName() << ": ";
+        if (now.owner != before.owner) {
+            out << "owner " << before.owner << " -> " << now.owner << ", ";
+        }
+        out << "armies " << before.numberOfArmies << " -> " << now.numberOfArmies << std::endl;
+        before = std::move(now);
+        numChanged++;
+    }
+    out << numChanged << " of " << map.getSize() << " countries changed (full map in "
+        << fullDumpInterval - rendersSinceFullDump << " prints)" << std::endl;
+}
+
+void MapDeltaRenderer::reset() {
+    renderedMap = nullptr;
+}
+
+int MapDeltaRenderer::getFullDumpInterval() {
+    return fullDumpInterval;
+}
+
+void MapDeltaRenderer::setFullDumpInterval(int interval) {
+    fullDumpInterval = interval < 1 ? 1 : interval;
+}
@@ -0,0 +1,55 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_MAP_RENDERER_H
+#define COMP_345_PROJECT_TEAM_N12_MAP_RENDERER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "map.h"
+
+// Prints the state of a map during a game. Printing every territory at every phase buries the few that changed on a
+// large map, so the renderer prints the whole map only once every fullDumpInterval renders, and in between only the
+// territories the map reports as dirty whose owner or number of armies differ from what was last printed.
+class MapDeltaRenderer {
+private:
+    // The owner and number of armies of a territory, as last printed.
+    struct TerritorySnapshot {
+        std::string owner;
+        int numberOfArmies = 0;
+    };
+
+    // The map last rendered (nullptr before the first render), and its territories as last printed, by id - 1.
+    const Map* renderedMap;
+    std::vector<TerritorySnapshot> printed;
+
+    // The number of renders since the last full dump.
+    int rendersSinceFullDump;
+
+    // The number of renders between two full dumps (1 to always print the whole map).
+    static int fullDumpInterval;
+
+    // Returns the snapshot of a territory as it is now.
+    static TerritorySnapshot snapshotOf(const Territory& territory);
+
+    // Prints the whole map and remembers every territory.
+    void renderFull(std::ostream& out, Map& map);
+
+    // Prints the territories which changed since the last render.
+    void renderDelta(std::ostream& out, Map& map);
+
+public:
+    // Default constructor, whose first render is a full dump.
+    MapDeltaRenderer();
+
+    // Prints the map: the whole map on the first render of a map and every fullDumpInterval renders, or else what
+    // changed since the last render.
+    void render(std::ostream& out, Map& map);
+
+    // Forgets what was printed, so that the next render is a full dump (at the start of a game).
+    void reset();
+
+    // Getter and setter for the number of renders between two full dumps.
+    static int getFullDumpInterval();
+    static void setFullDumpInterval(int interval);
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_MAP_RENDERER_H
@@ -1,36 +1,99 @@
 #include "logging_observer.h"
+#include <algorithm>
 
 /////////////////////// Observer class ///////////////////////
 Observer::Observer() {}
 Observer::~Observer() {}
 
-/////////////////////// Subject class ///////////////////////
-Subject::Subject() {
-    _observers = new list<Observer*>;
+/////////////////////// ObserverRegistry class ///////////////////////
+thread_local ObserverRegistry *ObserverRegistry::currentRegistry = nullptr;
+thread_local EventRecorder *ObserverRegistry::currentRecorder = nullptr;
+
+void ObserverRegistry::subscribe(LogEvent event, Observer* o) {
+    vector<Observer*> &eventObservers = observers[static_cast<size_t>(event)];
+    if (find(eventObservers.begin(), eventObservers.end(), o) == eventObservers.end()) {
+        eventObservers.push_back(o);
+    }
+}
+
+void ObserverRegistry::subscribeAll(Observer* o) {
+    for (size_t event = 0; event < NUM_LOG_EVENTS; event++) {
+        subscribe(static_cast<LogEvent>(event), o);
+    }
+}
+
+void ObserverRegistry::unsubscribe(Observer* o) {
+    for (vector<Observer*> &eventObservers : observers) {
+        eventObservers.erase(remove(eventObservers.begin(), eventObservers.end(), o), eventObservers.end());
+    }
 }
 
-Subject::~Subject() {
-    delete _observers;
+void ObserverRegistry::notify(LogEvent event, const ILoggable& log) const {
+    for (Observer* o : observers[static_cast<size_t>(event)]) {
+        o->Update(log);
+    }
 }
 
-void Subject::Attach(Observer* o) {
-    _observers->push_back(o);
+ObserverRegistry* ObserverRegistry::current() {
+    return currentRegistry;
 }
 
-void Subject::Detach(Observer *o) {
-    _observers->remove(o);
+void ObserverRegistry::setCurrent(ObserverRegistry* registry) {
+    currentRegistry = registry;
 }
 
-void Subject::Notify(const ILoggable& log) {
-    list<Observer*>::iterator i = _observers->begin();
-    for(; i != _observers->end(); ++i)
-        (*i)->Update(log);
+EventRecorder* ObserverRegistry::currentRecording() {
+    return currentRecorder;
 }
 
-list<Observer*>* Subject::getAllObservers() const {
-    return this->_observers;
+void ObserverRegistry::setCurrentRecording(EventRecorder* recorder) {
+    currentRecorder = recorder;
+}
+
+/////////////////////// EventRecorder class ///////////////////////
+void EventRecorder::record(LogEvent event, const ILoggable& log) {
+    LogFields fields;
+    log.addLogFields(fields);
+    events.emplace_back(event, log.stringToLog(), std::move(fields));
+}
+
+void EventRecorder::replay(const ObserverRegistry& registry) {
+    for (const auto &[event, text, fields] : events) {
+        registry.notify(event, RecordedLog(text, fields));
+    }
+    events.clear();
+}
+
+/////////////////////// Subject class ///////////////////////
+Subject::Subject() {}
+
+Subject::~Subject() {}
+
+void Subject::Notify(LogEvent event, const ILoggable& log) const {
+    EventRecorder *recorder = ObserverRegistry::currentRecording();
+    if (recorder != nullptr) {
+        recorder->record(event, log);
+        return;
+    }
+    ObserverRegistry *registry = ObserverRegistry::current();
+    if (registry != nullptr) {
+        registry->notify(event, log);
+    }
 }
 
 /////////////////////// ILoggable class ///////////////////////
 ILoggable::ILoggable() {}
 ILoggable::~ILoggable() {}
+
+void ILoggable::addLogFields(LogFields&) const {}
+
+/////////////////////// RecordedLog class ///////////////////////
+RecordedLog::RecordedLog(const string& text, const LogFields& fields) : text(text), fields(fields) {}
+
+string RecordedLog::stringToLog() const {
+    return text;
+}
+
+void RecordedLog::addLogFields(LogFields& logFields) const {
+    logFields = fields;
+}
@@ -1,13 +1,50 @@
 #pragma once
 
-#include <list>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
 class Observer;
 class Subject;
 class ILoggable;
+class EventRecorder;
+
+// The kinds of events that subjects notify their observers of.
+enum class LogEvent : uint8_t {
+    // A command was read by the command processor.
+    commandRead,
+    // The effect of a command was saved.
+    commandEffect,
+    // An order was added to an orders list.
+    orderIssued,
+    // An order was executed.
+    orderExecuted,
+    // The game engine moved to another state.
+    stateChanged
+};
+
+// The number of kinds of events.
+constexpr size_t NUM_LOG_EVENTS = 5;
+
+// The structured fields of an event, kept by the observers indexing the log. The fields that do not apply to an event
+// keep their default value.
+struct LogFields {
+    // The kind of order ("deploy", "advance"...), or empty if the event is not about an order.
+    string_view orderType;
+    // The name of the player the event is about.
+    string player;
+    // The ids of the territories the event is about (-1 if none).
+    int sourceTerritory = -1;
+    int targetTerritory = -1;
+    // True if the event is an attack on a territory of another player.
+    bool isBattle = false;
+};
 
 class Observer {
 public:
@@ -16,16 +53,64 @@ public:
     virtual void Update(const ILoggable& log) = 0;
 };
 
+// The observers of a game, registered once per kind of event instead of once per subject. A registry is made current
+// for the thread playing the game, and every subject notifies the current registry, so subjects keep no state and
+// registering an observer costs the same however many commands and orders are created.
+class ObserverRegistry {
+private:
+    // The observers of each kind of event, indexed by LogEvent.
+    vector<Observer*> observers[NUM_LOG_EVENTS];
+
+    // The registry notified by the subjects of the current thread.
+    static thread_local ObserverRegistry *currentRegistry;
+
+    // The recorder keeping the events of the current thread instead of the registry (nullptr if there is none).
+    static thread_local EventRecorder *currentRecorder;
+
+public:
+    // Registers an observer for one kind of event.
+    void subscribe(LogEvent event, Observer* o);
+
+    // Registers an observer for every kind of event.
+    void subscribeAll(Observer* o);
+
+    // Removes an observer from every kind of event.
+    void unsubscribe(Observer* o);
+
+    // Sends an event to its observers.
+    void notify(LogEvent event, const ILoggable& log) const;
+
+    // Getter for the registry of the current thread (nullptr if there is none).
+    static ObserverRegistry* current();
+
+    // Setter for the registry of the current thread.
+    static void setCurrent(ObserverRegistry* registry);
+
+    // Getter and setter for the recorder of the current thread.
+    static EventRecorder* currentRecording();
+    static void setCurrentRecording(EventRecorder* recorder);
+};
+
+// Keeps the events sent on a thread, so that they can be sent to a registry later. Work done on other threads records
+// its events, and the thread owning the registry replays them in the order the work would have been done in.
+class EventRecorder {
+private:
+    // The events, with the text to log and the fields of their subject at the time they were sent.
+    vector<tuple<LogEvent, string, LogFields>> events;
+public:
+    // Keeps an event.
+    void record(LogEvent event, const ILoggable& log);
+
+    // Sends the kept events to the given registry, in the order they were recorded, then forgets them.
+    void replay(const ObserverRegistry& registry);
+};
+
+// A subject sends its events to the current registry, so it does not keep a list of observers of its own.
 class Subject {
 public:
     Subject();
     ~Subject();
-    virtual void Attach(Observer* o);
-    virtual void Detach(Observer* o);
-    virtual void Notify(const ILoggable& log);
-    list<Observer*>* getAllObservers() const;
-private:
-    list<Observer*> *_observers;
+    void Notify(LogEvent event, const ILoggable& log) const;
 };
 
 class ILoggable {
@@ -33,4 +118,18 @@ public:
     ILoggable();
     ~ILoggable();
     virtual string stringToLog() const = 0;
-};
\ No newline at end of file
+
+    // Fills the structured fields of the event. Loggables without any fields keep the default values.
+    virtual void addLogFields(LogFields& fields) const;
+};
+
+// A loggable holding the text and the fields an event was recorded with.
+class RecordedLog : public ILoggable {
+private:
+    const string& text;
+    const LogFields& fields;
+public:
+    RecordedLog(const string& text, const LogFields& fields);
+    string stringToLog() const override;
+    void addLogFields(LogFields& logFields) const override;
+};
@@ -0,0 +1,144 @@
+#include "battle_odds.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using std::vector;
+
+// The implementation file of the BattleOdds class.
+
+namespace {
+    constexpr double ATTACK_SUCCESS = ATTACK_SUCCESS_PERCENT / 100.0;
+    constexpr double DEFENCE_SUCCESS = DEFENCE_SUCCESS_PERCENT / 100.0;
+
+    // Returns the probabilities of every number of successes of n trials, for every n up to maxTrials, indexed by
+    // [n][successes].
+    vector<vector<double>> binomialTable(int maxTrials, double success) {
+        vector<vector<double>> pmf(maxTrials + 1);
+        pmf[0] = {1.0};
+        for (int n = 1; n <= maxTrials; n++) {
+            pmf[n].assign(n + 1, 0.0);
+            for (int k = 0; k < n; k++) {
+                pmf[n][k] += pmf[n - 1][k] * (1 - success);
+                pmf[n][k + 1] += pmf[n - 1][k] * success;
+            }
+        }
+        return pmf;
+    }
+
+    // Cumulative distribution function of the standard normal distribution.
+    double normalCdf(double z) {
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+
+    // Density function of the standard normal distribution.
+    double normalPdf(double z) {
+        return std::exp(-0.5 * z * z) / std::sqrt(2.0 * std::numbers::pi);
+    }
+}
+
+// Default constructor which computes every battle of the table. The attackers first kill min(X, defenders) armies,
+// where X follows the binomial distribution of the attacking round; the defenders left then kill min(Y, attackers)
+// armies, where Y follows the binomial distribution of the defending round.
+BattleOdds::BattleOdds() {
+    vector<vector<double>> attackPmf = binomialTable(MAX_TABLE_ARMIES, ATTACK_SUCCESS);
+    vector<vector<double>> defencePmf = binomialTable(MAX_TABLE_ARMIES, DEFENCE_SUCCESS);
+
+    // The expected number of attackers left when the given number of defenders survived the attacking round
+    vector<vector<double>> attackersLeftAfterDefence(MAX_TABLE_ARMIES + 1, vector<double>(MAX_TABLE_ARMIES + 1));
+    for (int attackers = 0; attackers <= MAX_TABLE_ARMIES; attackers++) {
+        for (int defenders = 0; defenders <= MAX_TABLE_ARMIES; defenders++) {
+            double expected = 0;
+            for (int kills = 0; kills <= defenders; kills++) {
+                expected += defencePmf[defenders][kills] * std::max(attackers - kills, 0);
+            }
+            attackersLeftAfterDefence[attackers][defenders] = expected;
+        }
+    }
+
+    for (int attackers = 0; attackers <= MAX_TABLE_ARMIES; attackers++) {
+        for (int defenders = 0; defenders <= MAX_TABLE_ARMIES; defenders++) {
+            BattleOutcome result{0, 0, static_cast<double>(defenders)};
+            if (attackers > 0) {
+                result.expectedDefendersLeft = 0;
+                for (int kills = 0; kills <= attackers; kills++) {
+                    double probability = attackPmf[attackers][kills];
+                    int defendersLeft = defenders - std::min(kills, defenders);
+                    if (defendersLeft == 0) {
+                        result.winProbability += probability;
+                        result.expectedAttackersLeft += probability * attackers;
+                    } else {
+                        result.expectedAttackersLeft += probability * attackersLeftAfterDefence[attackers][defendersLeft];
+                        result.expectedDefendersLeft += probability * defendersLeft;
+                    }
+                }
+            }
+            outcomes[attackers * (MAX_TABLE_ARMIES + 1) + defenders] = result;
+        }
+    }
+}
+
+// Returns the outcome of a large battle, where the number of kills of the attacking round is close to a normal
+// distribution. The defending round is approximated by its mean.
+BattleOutcome BattleOdds::approximate(int attackers, int defenders) {
+    if (attackers == 0) {
+        return {0, 0, static_cast<double>(defenders)};
+    }
+    if (defenders == 0) {
+        return {1, static_cast<double>(attackers), 0};
+    }
+
+    double mean = ATTACK_SUCCESS * attackers;
+    double deviation = std::sqrt(ATTACK_SUCCESS * (1 - ATTACK_SUCCESS) * attackers);
+
+    // The attackers win if they kill at least every defender (with a continuity correction)
+    double winProbability = 1 - normalCdf((defenders - 0.5 - mean) / deviation);
+
+    // Expected value of max(defenders - kills, 0) for normally distributed kills
+    double z = (defenders - mean) / deviation;
+    double defendersLeft = (defenders - mean) * normalCdf(z) + deviation * normalPdf(z);
+
+    double attackersLeft = std::max(0.0, attackers - DEFENCE_SUCCESS * defendersLeft);
+    return {winProbability, attackersLeft, defendersLeft};
+}
+
+// Returns the table, built on first use. The construction of a function-local static is thread-safe.
+const BattleOdds &BattleOdds::table() {
+    static const BattleOdds odds;
+    return odds;
+}
+
+// Returns the outcome of the given battle: looked up in the table, or approximated for larger battles.
+BattleOutcome BattleOdds::outcome(int attackers, int defenders) const {
+    attackers = std::max(attackers, 0);
+    defenders = std::max(defenders, 0);
+    if (attackers > MAX_TABLE_ARMIES || defenders > MAX_TABLE_ARMIES) {
+        return approximate(attackers, defenders);
+    }
+    return outcomes[attackers * (MAX_TABLE_ARMIES + 1) + defenders];
+}
+
+// Returns the probability that the attackers capture the territory.
+double BattleOdds::winProbability(int attackers, int defenders) const {
+    return outcome(attackers, defenders).winProbability;
+}
+
+// Returns the smallest number of attackers capturing the territory with at least the given probability. The chance of
+// winning grows with the number of attackers, so the number is found with a binary search.
+int BattleOdds::attackersNeeded(int defenders, double probability, int maxAttackers) const {
+    if (maxAttackers < 1 || winProbability(maxAttackers, defenders) < probability) {
+        return -1;
+    }
+    int low = 1;
+    int high = maxAttackers;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (winProbability(middle, defenders) >= probability) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
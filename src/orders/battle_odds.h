@@ -0,0 +1,58 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_BATTLE_ODDS_H
+#define COMP_345_PROJECT_TEAM_N12_BATTLE_ODDS_H
+
+#include <cstddef>
+
+// The rules of a battle, as played by Advance::execute: every attacking army kills a defending army with this chance
+// (in percent), then every surviving defending army kills an attacking army with the other chance.
+constexpr int ATTACK_SUCCESS_PERCENT = 60;
+constexpr int DEFENCE_SUCCESS_PERCENT = 70;
+
+// The outcome of a battle, on average.
+struct BattleOutcome {
+    // The probability that the attackers capture the territory.
+    double winProbability;
+
+    // The expected number of attacking and defending armies left after the battle.
+    double expectedAttackersLeft;
+    double expectedDefendersLeft;
+};
+
+// The exact odds of every battle between at most MAX_TABLE_ARMIES attackers and MAX_TABLE_ARMIES defenders, computed
+// once from the binomial distributions of the two rounds of a battle. Larger battles use a normal approximation of the
+// same distributions, so strategies can weigh an attack in constant time instead of simulating it.
+class BattleOdds {
+public:
+    // The largest number of attackers or defenders found in the table.
+    static constexpr int MAX_TABLE_ARMIES = 64;
+
+private:
+    // The outcome of every battle in the table, indexed by attackers * (MAX_TABLE_ARMIES + 1) + defenders.
+    BattleOutcome outcomes[(MAX_TABLE_ARMIES + 1) * (MAX_TABLE_ARMIES + 1)];
+
+    // Default constructor which fills the table.
+    BattleOdds();
+
+    // Returns the outcome of a battle too large for the table.
+    static BattleOutcome approximate(int attackers, int defenders);
+
+public:
+    // The table is built once and shared, so it cannot be copied.
+    BattleOdds(const BattleOdds &odds) = delete;
+    BattleOdds &operator=(const BattleOdds &odds) = delete;
+
+    // Returns the table, built on first use.
+    static const BattleOdds &table();
+
+    // Returns the outcome of the given battle.
+    [[nodiscard]] BattleOutcome outcome(int attackers, int defenders) const;
+
+    // Returns the probability that the attackers capture the territory.
+    [[nodiscard]] double winProbability(int attackers, int defenders) const;
+
+    // Returns the smallest number of attackers capturing the territory with at least the given probability, or -1 if
+    // no number of attackers up to maxAttackers does.
+    [[nodiscard]] int attackersNeeded(int defenders, double probability, int maxAttackers) const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_BATTLE_ODDS_H
@@ -0,0 +1,141 @@
+#include "order_scheduler.h"
+#include <algorithm>
+#include <future>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include "concurrency/thread_pool.h"
+#include "game_state/game_random.h"
+
+// The implementation file of the OrderScheduler class.
+
+// One param constructor which takes the pool running the waves.
+OrderScheduler::OrderScheduler(ThreadPool &pool) : pool(pool) {}
+
+// Returns the seed of the random stream of the order at the given position of a sequence. The seed is mixed, so that
+// the streams of neighbouring positions do not overlap.
+uint64_t OrderScheduler::orderSeed(uint64_t sequenceSeed, size_t position) {
+    return GameRandom(sequenceSeed + position).next();
+}
+
+// Splits the sequence into waves. The footprints only hold territories, which never change, so they are all known
+// before any order is executed. An order goes in the wave after the last one claiming any of its territories, and an
+// exclusive order in a wave of its own after every earlier order, which no later order may go before.
+vector<vector<size_t>> OrderScheduler::buildWaves(const vector<Order *> &sequence) {
+    vector<vector<size_t>> waves;
+
+    // The last wave claiming each territory, and the first wave the next orders may go in
+    std::unordered_map<const Territory *, size_t> lastWaves;
+    size_t firstWave = 0;
+
+    OrderFootprint footprint;
+    for (size_t position = 0; position < sequence.size(); position++) {
+        footprint.territories.clear();
+        footprint.isExclusive = false;
+        sequence[position]->addToFootprint(footprint);
+
+        size_t wave = firstWave;
+        if (footprint.isExclusive) {
+            wave = waves.size();
+            firstWave = wave + 1;
+        } else {
+            for (const Territory *territory: footprint.territories) {
+                auto lastWave = lastWaves.find(territory);
+                if (lastWave != lastWaves.end()) {
+                    wave = std::max(wave, lastWave->second + 1);
+                }
+            }
+            for (const Territory *territory: footprint.territories) {
+                lastWaves[territory] = wave;
+            }
+        }
+
+        if (wave == waves.size()) {
+            waves.emplace_back();
+        }
+        waves[wave].push_back(position);
+    }
+    return waves;
+}
+
+// Executes one order with its own random stream. The stream of the calling thread is restored afterwards, since a
+// thread waiting on the pool may run orders of another wave.
+void OrderScheduler::executeOrder(Order *order, uint64_t sequenceSeed, size_t position) {
+    GameRandom &random = GameRandom::current();
+    uint64_t savedState = random.getState();
+    random.seed(orderSeed(sequenceSeed, position));
+    order->execute();
+    random.setState(savedState);
+}
+
+// Executes part of a wave, keeping the events, the output and the changes to players of every order. The recorder,
+// the output and the changes of the calling thread are restored afterwards.
+void OrderScheduler::executeDeferred(const vector<Order *> &sequence, const vector<size_t> &wave, size_t first,
+                                     size_t last, vector<DeferredOrder> &deferred, uint64_t sequenceSeed) {
+    EventRecorder *previousRecorder = ObserverRegistry::currentRecording();
+    PlayerChanges *previousChanges = PlayerChanges::current();
+    std::ostream *previousOutput = &Order::output();
+    std::ostringstream output;
+    Order::setOutput(&output);
+
+    for (size_t i = first; i < last; i++) {
+        DeferredOrder &order = deferred[wave[i]];
+        ObserverRegistry::setCurrentRecording(&order.events);
+        PlayerChanges::setCurrent(&order.changes);
+        executeOrder(sequence[wave[i]], sequenceSeed, wave[i]);
+        order.output = output.str();
+        output.str("");
+    }
+
+    ObserverRegistry::setCurrentRecording(previousRecorder);
+    PlayerChanges::setCurrent(previousChanges);
+    Order::setOutput(previousOutput);
+}
+
+// Executes the orders of the sequence, one wave at a time. A wave is split in one part per thread of the pool, plus
+// one for the calling thread, rather than one task per order. An order whose earlier orders are all done is executed
+// as is on the calling thread; any other order is deferred, and what it left is printed, sent and made as soon as the
+// orders before it are done, so it comes in sequence order whatever wave the order was put in.
+void OrderScheduler::execute(const vector<Order *> &sequence, uint64_t sequenceSeed) {
+    vector<vector<size_t>> waves = buildWaves(sequence);
+
+    // What every position of the sequence left, which positions were executed, and the first position whose
+    // output was not sent yet
+    vector<DeferredOrder> deferred(sequence.size());
+    vector<bool> isDone(sequence.size(), false);
+    size_t nextToSend = 0;
+
+    for (const vector<size_t> &wave: waves) {
+        if (wave.size() == 1 && wave[0] == nextToSend) {
+            executeOrder(sequence[wave[0]], sequenceSeed, wave[0]);
+        } else {
+            size_t numParts = std::min<size_t>(wave.size(), pool.size() + 1);
+            vector<std::future<void>> executions;
+            executions.reserve(numParts - 1);
+            for (size_t part = 1; part < numParts; part++) {
+                size_t first = wave.size() * part / numParts;
+                size_t last = wave.size() * (part + 1) / numParts;
+                executions.push_back(pool.submit([&sequence, &wave, &deferred, first, last, sequenceSeed]() {
+                    executeDeferred(sequence, wave, first, last, deferred, sequenceSeed);
+                }));
+            }
+            executeDeferred(sequence, wave, 0, wave.size() / numParts, deferred, sequenceSeed);
+            for (std::future<void> &execution: executions) {
+                pool.await(execution);
+            }
+        }
+
+        for (size_t position: wave) {
+            isDone[position] = true;
+        }
+        ObserverRegistry *registry = ObserverRegistry::current();
+        for (; nextToSend < sequence.size() && isDone[nextToSend]; nextToSend++) {
+            DeferredOrder &order = deferred[nextToSend];
+            Order::output() << order.output;
+            if (registry != nullptr) {
+                order.events.replay(*registry);
+            }
+            order.changes.apply();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_ORDER_SCHEDULER_H
+#define COMP_345_PROJECT_TEAM_N12_ORDER_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "orders/orders.h"
+
+using std::string;
+using std::vector;
+
+class ThreadPool;
+
+// Executes a sequence of orders in waves of orders that do not conflict. Two orders conflict when their footprints
+// share a territory, and an exclusive order conflicts with every other order. Every order goes in the wave after the
+// last wave holding an earlier order it conflicts with, so conflicting orders are always executed in sequence order,
+// and a wave holds every order of a front that is not waiting on another one. Every order rolls its battles with its
+// own random stream, seeded from the seed of the sequence and its position in it, and the changes it makes to players
+// are made in sequence order, so the board after the sequence is the same as when the orders are executed one after
+// the other.
+class OrderScheduler {
+private:
+    // What an order executed on another thread leaves for the thread playing the game: the events it sent, what it
+    // printed and the changes it made to players.
+    struct DeferredOrder {
+        EventRecorder events;
+        string output;
+        PlayerChanges changes;
+    };
+
+    // The pool running the orders of a wave.
+    ThreadPool &pool;
+
+    // Splits the sequence into waves (positions in the sequence, in sequence order), in one pass over the orders.
+    static vector<vector<size_t>> buildWaves(const vector<Order *> &sequence);
+
+    // Executes one order of the sequence with its own random stream.
+    static void executeOrder(Order *order, uint64_t sequenceSeed, size_t position);
+
+    // Executes the orders of a wave from index first to index last (excluded) on the calling thread, keeping what
+    // each one leaves.
+    static void executeDeferred(const vector<Order *> &sequence, const vector<size_t> &wave, size_t first,
+                                size_t last, vector<DeferredOrder> &deferred, uint64_t sequenceSeed);
+
+public:
+    // One param constructor which takes the pool running the waves.
+    explicit OrderScheduler(ThreadPool &pool);
+
+    // Returns the seed of the random stream of the order at the given position of a sequence.
+    static uint64_t orderSeed(uint64_t sequenceSeed, size_t position);
+
+    // Executes the orders of the sequence. What the orders print, the events they send to the current registry and
+    // the changes they make to players come in sequence order, as when the orders are executed one after the other.
+    void execute(const vector<Order *> &sequence, uint64_t sequenceSeed);
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_ORDER_SCHEDULER_H
@@ -1,46 +1,108 @@
 #include "orders.h"
+#include "player/player.h"
+#include <type_traits>
+#include "game_state/game_random.h"
+#include "battle_odds.h"
 #include <stdlib.h>
 
+////////////////////////////PlayerChanges CLASS////////////////////////////////////
+thread_local PlayerChanges* PlayerChanges::currentChanges = nullptr;
+
+//Gives a territory to a new owner, keeping the change to the territories of the players if changes are being kept
+void PlayerChanges::transferTerritory(Territory& territory, Player& newOwner, bool isConquest) {
+    Transfer transfer{&territory, territory.getOwner(), &newOwner, isConquest};
+    territory.setOwner(&newOwner);
+    if (currentChanges != nullptr) {
+        currentChanges->transfers.push_back(transfer);
+    } else {
+        makeTransfer(transfer);
+    }
+}
+
+//Turns a neutral player aggressive, keeping the change if changes are being kept
+void PlayerChanges::attackPlayer(Player& player) {
+    if (currentChanges != nullptr) {
+        currentChanges->attackedPlayers.push_back(&player);
+    } else {
+        makeAttacked(&player);
+    }
+}
+
+//Moves a territory from the territories of its old owner to those of its new owner, which already owns it
+void PlayerChanges::makeTransfer(const Transfer& transfer) {
+    if (transfer.oldOwner != nullptr) {
+        transfer.oldOwner->removeTerritory(*transfer.territory);
+    }
+    transfer.newOwner->getTerritories()->push_back(transfer.territory);
+    if (transfer.isConquest) {
+        transfer.newOwner->setConqueredTerritoryInTurn(true);
+    }
+}
+
+//Check if a Neutral Player was attacked -> If Yes, player will become an Aggressive Player. A player attacked twice
+//is only turned once.
+void PlayerChanges::makeAttacked(Player* player) {
+    if (player->getPlayerStrategy()->printStrategy() == "neutral strategy") {
+        player->setStrategy(new AggressivePlayerStrategy());
+        player->setPName("Neutral-Aggressive");
+        Order::output() << "Neutral player " << player->getPName()
+                        << " was attacked! The player will now become an Aggressive player." << endl;
+    }
+}
+
+//Makes the kept changes, in the order they were kept
+void PlayerChanges::apply() {
+    for (Player* player : attackedPlayers) {
+        makeAttacked(player);
+    }
+    for (const Transfer& transfer : transfers) {
+        makeTransfer(transfer);
+    }
+    attackedPlayers.clear();
+    transfers.clear();
+}
+
+//Getter for the changes kept by the orders of the current thread
+PlayerChanges* PlayerChanges::current() {
+    return currentChanges;
+}
+
+//Setter for the changes kept by the orders of the current thread
+void PlayerChanges::setCurrent(PlayerChanges* changes) {
+    currentChanges = changes;
+}
+
 ////////////////////////////Order CLASS////////////////////////////////////
+thread_local ostream* Order::currentOutput = nullptr;
+
 //Default constructor
-Order::Order(): issuingPlayer(nullptr) {}
+Order::Order(): description(""), effect(""), issuingPlayer(nullptr) {}
 
 //Parameterized constructor which initializes an Order with the provided description and effect
-Order::Order(const string& description, const string& effect) {
-    this->description = new string(description);
-    this->effect = new string(effect);
-    this->issuingPlayer = nullptr;
-}
+Order::Order(const char* description, const char* effect)
+    : description(description), effect(effect), issuingPlayer(nullptr) {}
 
 //Parameterized constructor which initializes an Order with the provided description, effect and issuingPlayer
-Order::Order(const string& description, const string& effect, Player& issuingPlayer) {
-    this->description = new string(description);
-    this->effect = new string(effect);
-    this->issuingPlayer = &issuingPlayer;   //shallow copy because want to refer to same player
-}
+Order::Order(const char* description, const char* effect, Player& issuingPlayer)
+    : description(description), effect(effect), issuingPlayer(&issuingPlayer) {}   //shallow copy because want to refer to same player
 
 //Copy constructor
-Order::Order(const Order& order) {
-    this->description = new string(*(order.description));
-    this->effect = new string(*(order.effect));
-    this->issuingPlayer = order.issuingPlayer;    //shallow copy because want to refer to same player
-}
+Order::Order(const Order& order)
+    : description(order.description), effect(order.effect), issuingPlayer(order.issuingPlayer) {}    //shallow copy because want to refer to same player
 
 //Destructor
 Order::~Order() {
-    delete description;
-    delete effect;
     //delete issuingPlayer; //should I call this or let the Player destructor handle it??????
     this->issuingPlayer = nullptr;
 }
 
 //Getter to retrieve the description of an Order
-string* Order::getDescription() const {
+string_view Order::getDescription() const {
     return this->description;
 }
 
 //Getter to retrieve the effect of an Order
-string* Order::getEffect() const {
+string_view Order::getEffect() const {
     return this->effect;
 }
 
@@ -50,28 +112,44 @@ Player* Order::getIssuingPlayer() const {
 }
 
 //Setter to set the description of an Order
-void Order::setDescription(const string& description) {
-    delete this->description;
-    this->description = new string(description);
+void Order::setDescription(const char* description) {
+    this->description = description;
 }
 
 //Setter to set the effect of an Order
-void Order::setEffect(const string& effect) {
-    delete this->effect;
-    this->effect = new string(effect);
+void Order::setEffect(const char* effect) {
+    this->effect = effect;
 }
 
 void Order::setIssuingPlayer(Player& issuingPlayer) {
     this->issuingPlayer = &issuingPlayer;
 }
 
+//An order reads or changes no territory unless it says so
+void Order::addToFootprint(OrderFootprint&) const {}
+
+//Getter for the stream the orders of the current thread print to
+ostream& Order::output() {
+    return currentOutput != nullptr ? *currentOutput : cout;
+}
+
+//Setter for the stream the orders of the current thread print to
+void Order::setOutput(ostream* stream) {
+    currentOutput = stream;
+}
+
+//Fills the fields of the log with the name of the issuing player
+void Order::addLogFields(LogFields& fields) const {
+    if (this->issuingPlayer != nullptr) {
+        fields.player = this->issuingPlayer->getPName();
+    }
+}
+
 //Defining the assignment operator
 Order& Order::operator=(const Order& order) {
     if (this != &order) {
-        delete this->description;
-        delete this->effect;
-        this->description = new string(*(order.description));
-        this->effect = new string(*(order.effect));
+        this->description = order.description;
+        this->effect = order.effect;
         this->issuingPlayer = order.getIssuingPlayer();  //shallow copy because want to refer to same player
     }
     return *this;
@@ -79,7 +157,7 @@ Order& Order::operator=(const Order& order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Order& order) {
-	out << *(order.description);
+	out << order.description;
 	return out;
 }
 
@@ -111,9 +189,9 @@ Deploy::~Deploy() {
 
 //Checks if a Deploy order is valid
 bool Deploy::validate() {
-    cout << "Validating Deploy Order..." << endl;
+    output() << "Validating Deploy Order..." << endl;
     if (this->targetTerritory->getOwner() != this->getIssuingPlayer()) {
-        cout << "Invalid: target territory does not belong to player issuing the order!" << endl;
+        output() << "Invalid: target territory does not belong to player issuing the order!" << endl;
         return false;
     }
     return true;
@@ -121,16 +199,21 @@ bool Deploy::validate() {
 
 //Executes a Deploy order
 void Deploy::execute() {
-    cout << "Deploy::execute() --> Player: " << *this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << " | Armies: " << this->numArmies << endl;
+    output() << "Deploy::execute() --> Player: " << this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << " | Armies: " << this->numArmies << endl;
     if (this->validate()) {
-        cout << "Executing Deploy Order..." << endl;
+        output() << "Executing Deploy Order..." << endl;
         this->targetTerritory->addArmies(this->numArmies);
-        cout << *this->getEffect() << endl;
-        Notify(*this);
+        output() << this->getEffect() << endl;
+        Notify(LogEvent::orderExecuted, *this);
     }
 
 }
 
+//Adds the target territory to the footprint of a Deploy order
+void Deploy::addToFootprint(OrderFootprint& footprint) const {
+    footprint.territories.push_back(this->targetTerritory);
+}
+
 //Defining the assignment operator
 Deploy& Deploy::operator=(const Deploy& deploy_order) {
     Order::operator=(deploy_order);
@@ -141,7 +224,7 @@ Deploy& Deploy::operator=(const Deploy& deploy_order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Deploy& deploy) {
-	out << *deploy.getDescription();
+	out << deploy.getDescription();
     return out;
 }
 
@@ -155,6 +238,23 @@ string Deploy::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type and the territories of the Deploy order
+void Deploy::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "deploy";
+    fields.targetTerritory = this->targetTerritory->getId();
+}
+
+//Getter for the target territory of the order
+Territory* Deploy::getTargetTerritory() const {
+    return this->targetTerritory;
+}
+
+//Getter for the number of armies deployed
+int Deploy::getNumArmies() const {
+    return this->numArmies;
+}
+
 ////////////////////////////Advance CLASS////////////////////////////////////
 //Default constructor
 Advance::Advance(): Order("An advance order tells a certain number of army units to move from a source territory to a target adjacent territory.", "Moved a number of armies from source territory to adjacent target territory.") {
@@ -186,52 +286,52 @@ Advance::~Advance() {
 
 //Checks if an Advance order is valid
 bool Advance::validate() {
-    cout << "Validating Advance Order..." << endl;
+    output() << "Validating Advance Order..." << endl;
     if (this->sourceTerritory->getOwner() != this->getIssuingPlayer()) {
-        cout << "INVALID: source territory does not belong to player issuing the order!" << endl;
+        output() << "INVALID: source territory does not belong to player issuing the order!" << endl;
         return false;
     }
     else if (this->sourceTerritory->getNumberOfArmies() < this->numArmies) {
-        cout << "INVALID: The source territory (" << this->sourceTerritory->getName() << ") has " << this->sourceTerritory->getNumberOfArmies() << " armies, but you wish to Advance with " << this->numArmies << " armies." << endl;
+        output() << "INVALID: The source territory (" << this->sourceTerritory->getName() << ") has " << this->sourceTerritory->getNumberOfArmies() << " armies, but you wish to Advance with " << this->numArmies << " armies." << endl;
         return false;
     }
     //Checks if the target territory is one of the neighboring territories of the source territory.
     for(Territory* neighbor: this->targetTerritory->getNeighbours()){
         if(this->sourceTerritory == neighbor){
-            cout << "Advance validation success: sourceTerritory " << sourceTerritory->getName() << " is a neighbor of targetTerritory " << targetTerritory->getName() << endl;
+            output() << "Advance validation success: sourceTerritory " << sourceTerritory->getName() << " is a neighbor of targetTerritory " << targetTerritory->getName() << endl;
             return true;
         }
     }
-    cout << "Advance validation failure: sourceTerritory " << sourceTerritory->getName() << " is not a neighbor of targetTerritory " << targetTerritory->getName() << endl;
+    output() << "Advance validation failure: sourceTerritory " << sourceTerritory->getName() << " is not a neighbor of targetTerritory " << targetTerritory->getName() << endl;
     return false;
 }
 
 //Executes an Advance order
 void Advance::execute() {
-    cout << "Advance::execute() --> Player: " << *this->getIssuingPlayer()->getPName() << " | Source territory: " << this->sourceTerritory->getName() << " | Target territory: " << this->targetTerritory->getName() << " | Attacking Armies: " << this->numArmies << endl;
+    output() << "Advance::execute() --> Player: " << this->getIssuingPlayer()->getPName() << " | Source territory: " << this->sourceTerritory->getName() << " | Target territory: " << this->targetTerritory->getName() << " | Attacking Armies: " << this->numArmies << endl;
     if (this->validate()) {
-        cout << "Executing Advance Order..." << endl;
-        Notify(*this);
+        output() << "Executing Advance Order..." << endl;
+        Notify(LogEvent::orderExecuted, *this);
         bool bothTerritoriesBelongToTheIssuingPlayer = this->sourceTerritory->getOwner() == this->getIssuingPlayer() && this->targetTerritory->getOwner() == this->getIssuingPlayer();
         if (bothTerritoriesBelongToTheIssuingPlayer) {
-            cout << "Both Territories belong to the issuing player!" << endl;
+            output() << "Both Territories belong to the issuing player!" << endl;
             this->targetTerritory->addArmies(this->numArmies);
             this->sourceTerritory->removeArmies(this->numArmies);
             this->setEffect("army units are moved from the source to the target territory.");
-            cout << "Army units moved from the source to the target territory." << endl;
+            output() << "Army units moved from the source to the target territory." << endl;
         }
         else {
             if (this->getIssuingPlayer()->isPlayerFriend(this->sourceTerritory->getOwner())) {
-                cout << "You cannot attack this player!" << endl;
+                output() << "You cannot attack this player!" << endl;
                 return;
             }
             int attackingArmies = this->numArmies;
             int defendingArmies = targetTerritory->getNumberOfArmies();
             this->sourceTerritory->removeArmies(attackingArmies);
-            cout << "Advance::execute() BEFORE BATTLE | Attacking armies: " << attackingArmies << " | Defending armies: " << defendingArmies << endl;
+            output() << "Advance::execute() BEFORE BATTLE | Attacking armies: " << attackingArmies << " | Defending armies: " << defendingArmies << endl;
             for (int i = 0; i < attackingArmies; i++) {
-                int chanceOfAttack = rand() % 100 + 1;
-                if (chanceOfAttack <= 60) {
+                int chanceOfAttack = GameRandom::current().nextInt(100) + 1;
+                if (chanceOfAttack <= ATTACK_SUCCESS_PERCENT) {
                     if (defendingArmies == 0) {
                         break;
                     }
@@ -240,40 +340,39 @@ void Advance::execute() {
             }
 
             for (int i = 0; i < defendingArmies; i++) {
-                int chanceOfDefence = rand() % 100 + 1;
-                if (chanceOfDefence <= 70) {
+                int chanceOfDefence = GameRandom::current().nextInt(100) + 1;
+                if (chanceOfDefence <= DEFENCE_SUCCESS_PERCENT) {
                     if (attackingArmies == 0) {
                         break;
                     }
                     attackingArmies--;
                 }
             }
-            cout << "Advance::execute() AFTER BATTLE | Attacking armies: " << attackingArmies << " | Defending armies: " << defendingArmies << endl;
-            //Check if Neutral Player was attacked -> If Yes, player will become an Aggressive Player
-            if (targetTerritory->getOwner()->getPlayerStrategy()->printStrategy() == "neutral strategy") {
-                targetTerritory->getOwner()->setStrategy(new AggressivePlayerStrategy());
-                targetTerritory->getOwner()->setPName("Neutral-Aggressive");
-                cout << "Neutral player " << *targetTerritory->getOwner()->getPName()
-                     << " was attacked! The player will now become an Aggressive player." << endl;
-            }
+            output() << "Advance::execute() AFTER BATTLE | Attacking armies: " << attackingArmies << " | Defending armies: " << defendingArmies << endl;
+            //A Neutral Player attacked will become an Aggressive Player
+            PlayerChanges::attackPlayer(*targetTerritory->getOwner());
             //All enemies dead and you still have attacking armies
             if (attackingArmies > 0 && defendingArmies == 0) {
 
-                this->targetTerritory->getOwner()->removeTerritory(*targetTerritory);
-                this->getIssuingPlayer()->acquireTerritory(targetTerritory);
+                PlayerChanges::transferTerritory(*targetTerritory, *this->getIssuingPlayer(), true);
                 targetTerritory->setNumberOfArmies(attackingArmies);
-                this->getIssuingPlayer()->setConqueredTerritoryInTurn(true);
                 this->setEffect("Target territory successfully captured!");
             }
             else {
                 targetTerritory->setNumberOfArmies(defendingArmies);
                 this->setEffect("The defending armies won the battle. You did not conquer the target territory!");
             }
-            cout << *this->getEffect() << endl;
+            output() << this->getEffect() << endl;
         }
     }
 }
 
+//Adds both territories to the footprint of an Advance order
+void Advance::addToFootprint(OrderFootprint& footprint) const {
+    footprint.territories.push_back(this->sourceTerritory);
+    footprint.territories.push_back(this->targetTerritory);
+}
+
 //Defining the assignment operator
 Advance& Advance::operator=(const Advance& adv_order) {
     Order::operator=(adv_order);
@@ -285,7 +384,7 @@ Advance& Advance::operator=(const Advance& adv_order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Advance& advance) {
-	out << *advance.getDescription();
+	out << advance.getDescription();
 	return out;
 }
 
@@ -300,6 +399,31 @@ string Advance::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type and the territories of the Advance order
+void Advance::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "advance";
+    fields.sourceTerritory = this->sourceTerritory->getId();
+    fields.targetTerritory = this->targetTerritory->getId();
+    //The order is logged before it is carried out, so the target still has its defender
+    fields.isBattle = this->targetTerritory->getOwner() != this->getIssuingPlayer();
+}
+
+//Getter for the source territory of the order
+Territory* Advance::getSourceTerritory() const {
+    return this->sourceTerritory;
+}
+
+//Getter for the target territory of the order
+Territory* Advance::getTargetTerritory() const {
+    return this->targetTerritory;
+}
+
+//Getter for the number of armies advanced
+int Advance::getNumArmies() const {
+    return this->numArmies;
+}
+
 ////////////////////////////Bomb CLASS////////////////////////////////////
 //Default constructor
 Bomb::Bomb(): Order("A bomb order targets a territory owned by another player than the one issuing the order. Its result is to remove half of the armies from this territory.", "Half of the armies removed from target territory.") {
@@ -324,12 +448,12 @@ Bomb::~Bomb() {
 
 //Checks if a Bomb order is valid
 bool Bomb::validate() {
-    cout << "Validating Bomb Order..." << endl;
+    output() << "Validating Bomb Order..." << endl;
     if (this->targetTerritory->getOwner() == this->getIssuingPlayer()) {
-        cout << "INVALID: target territory belongs to the player that issued the order!" << endl;
+        output() << "INVALID: target territory belongs to the player that issued the order!" << endl;
     }
     else if (this->getIssuingPlayer()->isPlayerFriend(this->targetTerritory->getOwner())) {
-        cout << "INVALID: You cannot attack this player!" << endl;
+        output() << "INVALID: You cannot attack this player!" << endl;
     }
     else {
         list<Territory*> neighbourTerritories = this->targetTerritory->getNeighbours();
@@ -338,28 +462,31 @@ bool Bomb::validate() {
                 return true;
             }
         }
-        cout << "INVALID: The target territory is not adjacent to one of the territory owned by the player issuing the order!" << endl;
+        output() << "INVALID: The target territory is not adjacent to one of the territory owned by the player issuing the order!" << endl;
     }
     return false;
 }
 
 //Executes a Bomb order
 void Bomb::execute() {
-    cout << "Bomb::execute() --> Issuing Player: " << *this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << " | Target territory Player: " << *this->targetTerritory->getOwner()->getPName() << endl;
+    output() << "Bomb::execute() --> Issuing Player: " << this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << " | Target territory Player: " << this->targetTerritory->getOwner()->getPName() << endl;
     if (this->validate()) {
-        cout << "Executing Bomb Order..." << endl;
+        output() << "Executing Bomb Order..." << endl;
         this->targetTerritory->setNumberOfArmies(this->targetTerritory->getNumberOfArmies() / 2);
         this->setEffect("Removed half of the armies from the target territory!");
-        cout << *this->getEffect() << endl;
-
-        //Check if Neutral Player was attacked -> If Yes, player will become an Aggressive Player
-        if (targetTerritory->getOwner()->getPlayerStrategy()->printStrategy() == "neutral strategy") {
-            targetTerritory->getOwner()->setStrategy(new AggressivePlayerStrategy());
-            targetTerritory->getOwner()->setPName("Neutral-Aggressive");
-            cout << "Neutral player " << *targetTerritory->getOwner()->getPName()
-                 << " was attacked! The player will now become an Aggressive player." << endl;
-        }
-        Notify(*this);
+        output() << this->getEffect() << endl;
+
+        //A Neutral Player attacked will become an Aggressive Player
+        PlayerChanges::attackPlayer(*targetTerritory->getOwner());
+        Notify(LogEvent::orderExecuted, *this);
+    }
+}
+
+//Adds the target territory and its neighbours (whose owners are checked) to the footprint of a Bomb order
+void Bomb::addToFootprint(OrderFootprint& footprint) const {
+    footprint.territories.push_back(this->targetTerritory);
+    for (Territory* neighbour : this->targetTerritory->getNeighbours()) {
+        footprint.territories.push_back(neighbour);
     }
 }
 
@@ -372,7 +499,7 @@ Bomb& Bomb::operator=(const Bomb& bomb_order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Bomb& bomb) {
-	out << *bomb.getDescription();
+	out << bomb.getDescription();
 	return out;
 }
 
@@ -387,6 +514,18 @@ string Bomb::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type and the territories of the Bomb order
+void Bomb::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "bomb";
+    fields.targetTerritory = this->targetTerritory->getId();
+}
+
+//Getter for the target territory of the order
+Territory* Bomb::getTargetTerritory() const {
+    return this->targetTerritory;
+}
+
 ////////////////////////////Blockade CLASS////////////////////////////////////
 //Default constructor
 Blockade::Blockade(): Order("A blockade order targets a territory that belongs to the player issuing the order", "double  the  number of  armies on the territory  and to  transfer the ownership  of  the  territory to the Neutral player.") {
@@ -404,6 +543,7 @@ Blockade::Blockade(Player& issuingPlayer, Player& neutralPlayer,Territory& targe
 //Copy constructor
 Blockade::Blockade(const Blockade& blockade_order): Order(blockade_order) {
     this->targetTerritory = blockade_order.targetTerritory;
+    this->neutralPlayer = blockade_order.neutralPlayer;
 }
 
 //Destructor
@@ -413,9 +553,9 @@ Blockade::~Blockade() {
 
 //Checks if a Blockade order is valid
 bool Blockade::validate() {
-    cout << "Validating Blockade Order..." << endl;
+    output() << "Validating Blockade Order..." << endl;
     if (this->targetTerritory->getOwner() != this->getIssuingPlayer()) {
-        cout << "INVALID: target territory belongs to an enemy player!" << endl;
+        output() << "INVALID: target territory belongs to an enemy player!" << endl;
         return false;
     }
     return true;
@@ -423,30 +563,35 @@ bool Blockade::validate() {
 
 //Executes a Blockade order
 void Blockade::execute() {
-    cout << "Blockade::execute() --> Issuing Player: " << *this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << endl;
+    output() << "Blockade::execute() --> Issuing Player: " << this->getIssuingPlayer()->getPName() << " | Target territory: " << this->targetTerritory->getName() << endl;
     if (this->validate()) {
-        cout << "Executing Blockcade Order..." << endl;
-        Notify(*this);
+        output() << "Executing Blockcade Order..." << endl;
+        Notify(LogEvent::orderExecuted, *this);
 
         this->targetTerritory->addArmies(this->targetTerritory->getNumberOfArmies());
-        this->getIssuingPlayer()->removeTerritory(*this->targetTerritory);
 
         //Neutral player owner
-        neutralPlayer->acquireTerritory(targetTerritory);
+        PlayerChanges::transferTerritory(*targetTerritory, *neutralPlayer, false);
         this->getEffect();
     }
 }
 
+//Adds the target territory to the footprint of a Blockade order
+void Blockade::addToFootprint(OrderFootprint& footprint) const {
+    footprint.territories.push_back(this->targetTerritory);
+}
+
 //Defining the assignment operator
 Blockade& Blockade::operator=(const Blockade& blockade_order) {
     Order::operator=(blockade_order);
     this->targetTerritory = blockade_order.targetTerritory;
+    this->neutralPlayer = blockade_order.neutralPlayer;
     return *this;
 }
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Blockade& blockade) {
-	out << *blockade.getDescription();
+	out << blockade.getDescription();
 	return out;
 }
 
@@ -460,6 +605,23 @@ string Blockade::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type and the territories of the Blockade order
+void Blockade::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "blockade";
+    fields.targetTerritory = this->targetTerritory->getId();
+}
+
+//Getter for the target territory of the order
+Territory* Blockade::getTargetTerritory() const {
+    return this->targetTerritory;
+}
+
+//Getter for the neutral player receiving the territory
+Player* Blockade::getNeutralPlayer() const {
+    return this->neutralPlayer;
+}
+
 ////////////////////////////Airlift CLASS////////////////////////////////////
 //Default constructor
 Airlift::Airlift(): Order("An airlift order tells a certain number of armies taken from a source territory to be moved to a target territory, the source and the target territory being owned by the player issuing the order.", "Armies moved from source territory to target territory") {
@@ -491,17 +653,17 @@ Airlift::~Airlift() {
 
 //Checks if an Airlift order is valid
 bool Airlift::validate() {
-    cout << "Validating Airlift Order..." << endl;
+    output() << "Validating Airlift Order..." << endl;
     if (this->sourceTerritory->getOwner() != this->getIssuingPlayer()) {
-        cout << "INVALID: Source territory does not belong to the issuing player!" << endl;
+        output() << "INVALID: Source territory does not belong to the issuing player!" << endl;
         return false;
     }
     else if (this->targetTerritory->getOwner() != this->getIssuingPlayer()) {
-        cout << "INVALID: Target territory does not belong to the issuing player!" << endl;
+        output() << "INVALID: Target territory does not belong to the issuing player!" << endl;
         return false;
     }
     else if (this->sourceTerritory->getNumberOfArmies() < this->numArmies) {
-        cout << "INVALID: The source territory (" << this->sourceTerritory->getName() << ") has " << this->sourceTerritory->getNumberOfArmies() << " armies, but you wish to Airlift with " << this->numArmies << " armies." << endl;
+        output() << "INVALID: The source territory (" << this->sourceTerritory->getName() << ") has " << this->sourceTerritory->getNumberOfArmies() << " armies, but you wish to Airlift with " << this->numArmies << " armies." << endl;
         return false;
     }
     return true;
@@ -509,16 +671,22 @@ bool Airlift::validate() {
 
 //Executes an Airlift order
 void Airlift::execute() {
-    cout << "Airlift::execute() --> Issuing Player: " << *this->getIssuingPlayer()->getPName() << " | Source territory: " << this->sourceTerritory->getName() << " | Target territory: " << this->targetTerritory->getName() << " | Num Armies: " << this->numArmies << endl;
+    output() << "Airlift::execute() --> Issuing Player: " << this->getIssuingPlayer()->getPName() << " | Source territory: " << this->sourceTerritory->getName() << " | Target territory: " << this->targetTerritory->getName() << " | Num Armies: " << this->numArmies << endl;
     if (this->validate()) {
-        cout << "Executing Airlift Order..." << endl;
+        output() << "Executing Airlift Order..." << endl;
         this->sourceTerritory->removeArmies(numArmies);
         this->targetTerritory->addArmies(numArmies);
-        cout << *this->getEffect() << endl;
-        Notify(*this);
+        output() << this->getEffect() << endl;
+        Notify(LogEvent::orderExecuted, *this);
     }
 }
 
+//Adds both territories to the footprint of an Airlift order
+void Airlift::addToFootprint(OrderFootprint& footprint) const {
+    footprint.territories.push_back(this->sourceTerritory);
+    footprint.territories.push_back(this->targetTerritory);
+}
+
 //Defining the assignment operator
 Airlift& Airlift::operator=(const Airlift& airlift_order) {
     Order::operator=(airlift_order);
@@ -530,7 +698,7 @@ Airlift& Airlift::operator=(const Airlift& airlift_order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Airlift& airlift) {
-	out << *airlift.getDescription();
+	out << airlift.getDescription();
 	return out;
 }
 
@@ -544,6 +712,29 @@ string Airlift::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type and the territories of the Airlift order
+void Airlift::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "airlift";
+    fields.sourceTerritory = this->sourceTerritory->getId();
+    fields.targetTerritory = this->targetTerritory->getId();
+}
+
+//Getter for the source territory of the order
+Territory* Airlift::getSourceTerritory() const {
+    return this->sourceTerritory;
+}
+
+//Getter for the target territory of the order
+Territory* Airlift::getTargetTerritory() const {
+    return this->targetTerritory;
+}
+
+//Getter for the number of armies airlifted
+int Airlift::getNumArmies() const {
+    return this->numArmies;
+}
+
 ////////////////////////////Negotiate CLASS////////////////////////////////////
 //Default constructor
 Negotiate::Negotiate(): Order("A negotiate order targets an enemy player. It results in the target player and the player issuing the order to not be able to successfully attack each others’ territories for the remainder of the turn.", "Players cannot attack eachother for remainder of the turn.") {
@@ -568,9 +759,9 @@ Negotiate::~Negotiate() {
 
 //Checks if a Negotiate order is valid
 bool Negotiate::validate() {
-    cout << "Validating Negotiate Order..." << endl;
+    output() << "Validating Negotiate Order..." << endl;
     if (this->enemyPlayer == this->getIssuingPlayer() || this->enemyPlayer == nullptr) {
-        cout << "INVALID: Issuing player and enemy player are the same!" << endl;
+        output() << "INVALID: Issuing player and enemy player are the same!" << endl;
         return false;
     }
     return true;
@@ -578,17 +769,22 @@ bool Negotiate::validate() {
 
 //Executes a Negotiate order
 void Negotiate::execute() {
-    cout << "Negotiate::execute() --> Issuing Player: " << *this->getIssuingPlayer()->getPName() << " | Enemy Player: " << *this->enemyPlayer->getPName() << endl;
+    output() << "Negotiate::execute() --> Issuing Player: " << this->getIssuingPlayer()->getPName() << " | Enemy Player: " << this->enemyPlayer->getPName() << endl;
     if (this->validate()) {
-        cout << "Executing Negotiate Order..." << endl;
-        Notify(*this);
+        output() << "Executing Negotiate Order..." << endl;
+        Notify(LogEvent::orderExecuted, *this);
 
         this->getIssuingPlayer()->addFriendPlayer(this->enemyPlayer);
         this->enemyPlayer->addFriendPlayer(this->getIssuingPlayer());
-        cout << *this->getEffect() << endl;
+        output() << this->getEffect() << endl;
     }
 }
 
+//Makes the footprint of a Negotiate order exclusive: every attack reads the friends of its issuing player
+void Negotiate::addToFootprint(OrderFootprint& footprint) const {
+    footprint.isExclusive = true;
+}
+
 //Defining the assignment operator
 Negotiate& Negotiate::operator=(const Negotiate& negotiate_order) {
     Order::operator=(negotiate_order);
@@ -598,7 +794,7 @@ Negotiate& Negotiate::operator=(const Negotiate& negotiate_order) {
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const Negotiate& negotiate) {
-	out << *negotiate.getDescription();
+	out << negotiate.getDescription();
 	return out;
 }
 
@@ -612,41 +808,55 @@ string Negotiate::stringToLog() const {
     return message;
 }
 
+//Fills the fields of the log with the type of the Negotiate order
+void Negotiate::addLogFields(LogFields& fields) const {
+    Order::addLogFields(fields);
+    fields.orderType = "negotiate";
+}
+
+//Getter for the enemy player of the order
+Player* Negotiate::getEnemyPlayer() const {
+    return this->enemyPlayer;
+}
+
 ////////////////////////////OrdersList CLASS////////////////////////////////////
 //Default constructor
-OrdersList::OrdersList() {
-    this->orders = new vector<Order*>();
-}
+OrdersList::OrdersList() = default;
 
 //Copy constructor
-OrdersList::OrdersList(const OrdersList& o_list): OrdersList() {
-    for (int i = 0; i < o_list.getOrders()->size(); i++) {
-       Order* o = o_list.orders->at(i)->clone();
-       this->addOrder(o);
+OrdersList::OrdersList(const OrdersList& o_list) {
+    this->orders.reserve(o_list.orders.size());
+    for (Order* order : o_list.orders) {
+       this->addOrder(order->clone());
     }
 }
 
+//Move constructor, which takes the orders of the given list and leaves it empty. The observers stay attached to the
+//given list, since they know it by its address.
+OrdersList::OrdersList(OrdersList&& o_list) noexcept : orders(std::move(o_list.orders)) {
+    o_list.orders.clear();
+}
+
+static_assert(std::is_nothrow_move_constructible_v<OrdersList>, "Orders lists must be relocated without copies");
+
 //Destructor
 OrdersList::~OrdersList() {
     //delete each order on heap
-    for (Order* order : *this->orders) {
+    for (Order* order : this->orders) {
         delete order;
     }
-    this->orders->clear();  //delete all Order pointers in vector
-    delete this->orders;    //delete orders pointer
-    this->orders = nullptr;
 }
 
 //Move an Order in the vector to a new index by providing its current index and the index it should be moved to
 void OrdersList::move(int currentIndex, int newIndex) {
-    int order_list_size = this->orders->size();
+    int order_list_size = this->orders.size();
     if (order_list_size == 0) {
         cout << "Cannot move an order because there are no orders in the OrdersList!" << endl;
     }
     else if (currentIndex < order_list_size && newIndex < order_list_size && currentIndex >= 0 && newIndex >= 0) {
-        Order* orderToMove = this->orders->at(currentIndex);
-        this->orders->insert(this->orders->begin() + newIndex, orderToMove);
-        this->orders->erase(this->orders->begin() + currentIndex);
+        Order* orderToMove = this->orders.at(currentIndex);
+        this->orders.insert(this->orders.begin() + newIndex, orderToMove);
+        this->orders.erase(this->orders.begin() + currentIndex);
     }
     else {
         cout << "Invalid Index position specified" << endl;
@@ -655,19 +865,24 @@ void OrdersList::move(int currentIndex, int newIndex) {
 
 //Remove an order in the vector by specifying its respective index
 void OrdersList::remove(const int orderIndex) {
-    if (this->orders->empty()) {
+    if (this->orders.empty()) {
         cout << "Cannot remove an order because there are no orders in the OrdersList!" << endl;
-    } else if (orderIndex >= 0 && orderIndex < this->orders->size()) {
-        delete this->orders->at(orderIndex);    //free memory
-        this->orders->erase(this->orders->begin() + orderIndex);    //deletes pointer from vector
+    } else if (orderIndex >= 0 && orderIndex < this->orders.size()) {
+        delete this->orders.at(orderIndex);    //free memory
+        this->orders.erase(this->orders.begin() + orderIndex);    //deletes pointer from vector
     } else {
         cout << "Invalid order position" << endl;
     }
 }
 
 //Getter for the vector of orders
-vector<Order*>* OrdersList::getOrders() const {
-    return this->orders;
+vector<Order*>* OrdersList::getOrders() {
+    return &this->orders;
+}
+
+//Getter for the vector of orders of a const list
+const vector<Order*>* OrdersList::getOrders() const {
+    return &this->orders;
 }
 
 //Add an order to the vector by providing an Order
@@ -676,23 +891,35 @@ void OrdersList::addOrder(Order* order) {
         cout << "null pointer! Order cannot be added!" << endl;
     }
     else {
-        this->orders->push_back(order);
+        this->orders.push_back(order);
     }
-    Notify(*this);
+    Notify(LogEvent::orderIssued, *this);
 }
 
 //Defining the assignment operator
 OrdersList& OrdersList::operator=(const OrdersList& o_list) {
     if (this != &o_list) {
         //delete all orders in left hand side OrdersList
-        for (int index = 0; index < this->orders->size(); index++) {
-            this->remove(index);
+        for (Order* order : this->orders) {
+            delete order;
         }
+        this->orders.clear();
         //add all orders from right hand side OrdersList into left hand side
-        for (int i = 0; i < o_list.getOrders()->size(); i++) {
-            Order* o = o_list.orders->at(i)->clone();
-            this->addOrder(o);
+        for (Order* order : o_list.orders) {
+            this->addOrder(order->clone());
+        }
+    }
+    return *this;
+}
+
+//Defining the move assignment operator, which deletes the orders of this list and takes the orders of the given list
+OrdersList& OrdersList::operator=(OrdersList&& o_list) noexcept {
+    if (this != &o_list) {
+        for (Order* order : this->orders) {
+            delete order;
         }
+        this->orders = std::move(o_list.orders);
+        o_list.orders.clear();
     }
     return *this;
 }
@@ -704,17 +931,17 @@ void OrdersList::operator+(Order* order) {
 
 // Override virtual pure function from ILoggable
 string OrdersList::stringToLog() const {
-    vector<Order*>::iterator it = orders->end() - 1;
-    string& effect = *(*it)->getEffect();
-    string& description = *(*it)->getDescription();
+    const Order* order = orders.back();
+    string_view effect = order->getEffect();
+    string_view description = order->getDescription();
     string message = "An Order has been added to an OrdersList with an effect of " + std::string(effect) + ". " + std::string(description);
     return message;
 }
 
 //Defining the output operator
 ostream& operator<<(ostream& out, const OrdersList& ol) {
-	out << "The OrdersList contains " << ol.orders->size() << " orders:" << endl;
-    for (Order* order : *(ol.orders)) {
+	out << "The OrdersList contains " << ol.orders.size() << " orders:" << endl;
+    for (Order* order : ol.orders) {
         out << *order << endl;
     }
 	return out;
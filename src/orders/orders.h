@@ -4,6 +4,7 @@
 #include <vector>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include "map/map.h"
 using namespace std;
 
@@ -11,27 +12,81 @@ using namespace std;
 class Player;
 class Territory;
 
+// The territories an order reads or changes when it is executed. Orders with disjoint footprints give the same result
+// whichever one is executed first, so they can be executed at the same time. The territories of a map never change,
+// so neither does the footprint of an order. The changes an order makes to players go through PlayerChanges rather
+// than the footprint, except for the friends of a player, which every attack reads: an order changing them is
+// exclusive, and is executed alone.
+struct OrderFootprint {
+    vector<const Territory*> territories;
+    bool isExclusive = false;
+};
+
+// The changes orders make to players rather than to territories: a territory changing owner moves between the
+// territories of two players, a player conquering a territory earns a card, and a neutral player attacked turns
+// aggressive. An order executed on another thread keeps them here while other orders run, and the thread playing the
+// game makes them once the orders before it are done, so the players change in the order of the orders. An order
+// executed by the thread playing the game makes them at once.
+class PlayerChanges {
+private:
+    // A territory given to a new owner.
+    struct Transfer {
+        Territory *territory;
+        Player *oldOwner;
+        Player *newOwner;
+        bool isConquest;
+    };
+
+    vector<Transfer> transfers;
+    vector<Player*> attackedPlayers;
+
+    // The changes kept by the orders of the current thread (nullptr if they are made at once).
+    static thread_local PlayerChanges *currentChanges;
+
+    // Moves a territory to the territories of its new owner, and turns a neutral player aggressive.
+    static void makeTransfer(const Transfer &transfer);
+    static void makeAttacked(Player *player);
+
+public:
+    // Gives a territory to a new owner. The territory changes owner at once; the territories of the players change
+    // with the other changes. A conquest earns the new owner a card at the end of the turn.
+    static void transferTerritory(Territory &territory, Player &newOwner, bool isConquest);
+
+    // Turns a neutral player aggressive, since it was attacked. Any other player is left as it is.
+    static void attackPlayer(Player &player);
+
+    // Makes the kept changes, in the order they were kept, then forgets them.
+    void apply();
+
+    // Getter and setter for the changes kept by the orders of the current thread.
+    static PlayerChanges* current();
+    static void setCurrent(PlayerChanges* changes);
+};
+
 // This class implements a generic order.
 class Order : public Subject, public ILoggable {
 private:
-    //A string which describes the order.
-    string *description;
+    //A string which describes the order. Descriptions and effects are static texts, so an order only points to them.
+    const char *description;
 
     //A string which contains the effect of the order.
-    string *effect;
+    const char *effect;
 
     //Player that issues the order
     Player* issuingPlayer;
 
+    //The stream the orders of the current thread print to (nullptr for the console)
+    static thread_local ostream *currentOutput;
+
 public:
     //Default constructor which initializes a generic order.
     Order();
 
     //A parameterized constructor which initializes an order with the provided description and effect
-    Order(const string& description, const string& effect);
+    Order(const char* description, const char* effect);
 
     //A parameterized constructor which initializes an order with the provided description, effect and issuing player
-    Order(const string& description, const string& effect, Player& issuingPlayer);
+    Order(const char* description, const char* effect, Player& issuingPlayer);
 
     //Copy constructor
     Order(const Order& order);
@@ -45,23 +100,36 @@ public:
     //Executes an order if it is valid.
     virtual void execute() = 0;
 
+    //Adds the territories the order reads or changes to the footprint. An order reading or changing no territory has
+    //an empty footprint.
+    virtual void addToFootprint(OrderFootprint& footprint) const;
+
+    //Getter for the stream the orders of the current thread print to, which is the console unless it was set
+    static ostream& output();
+
+    //Setter for the stream the orders of the current thread print to (nullptr for the console)
+    static void setOutput(ostream* stream);
+
+    //Fills the fields of the log with the issuing player of the order
+    void addLogFields(LogFields& fields) const override;
+
     //clones an Order instance
     virtual Order* clone() const = 0;
 
     //Getter for the description of the order
-    string* getDescription() const;
+    string_view getDescription() const;
 
     //Getter for the effect of the order
-    string* getEffect() const;
+    string_view getEffect() const;
 
     //Getter for the issuing player of the order
     Player* getIssuingPlayer() const;
 
     //Setter for the description of the order
-    void setDescription(const string& description);
+    void setDescription(const char* description);
 
     //Setter for the effect of the order
-    void setEffect(const string& effect);
+    void setEffect(const char* effect);
 
     //Setter for the issuing player of the order
     void setIssuingPlayer(Player& issuingPlayer);
@@ -98,6 +166,9 @@ public:
     //Executes a Deploy order
     void execute() override;
 
+    //Adds the territories read or changed by the Deploy order to the footprint
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Deploy& deploy);
 
@@ -106,6 +177,15 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type and the territories of the Deploy order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the target territory
+    Territory* getTargetTerritory() const;
+
+    //Getter for the number of armies
+    int getNumArmies() const;
 };
 
 // This class implements an Advance order.
@@ -134,6 +214,9 @@ public:
     //Executes an Advance order
     void execute() override;
 
+    //Adds the territories read or changed by the Advance order to the footprint
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Advance& advance);
 
@@ -142,6 +225,18 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type and the territories of the Advance order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the source territory
+    Territory* getSourceTerritory() const;
+
+    //Getter for the target territory
+    Territory* getTargetTerritory() const;
+
+    //Getter for the number of armies
+    int getNumArmies() const;
 };
 
 // This class implements a Bomb order.
@@ -168,6 +263,9 @@ public:
     //Executes a Bomb order
     void execute() override;
 
+    //Adds the territories read or changed by the Bomb order to the footprint
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Bomb& bomb);
 
@@ -176,6 +274,12 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type and the territories of the Bomb order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the target territory
+    Territory* getTargetTerritory() const;
 };
 
 // This class implements a Blockade order.
@@ -203,6 +307,9 @@ public:
     //Executes a Blockade order
     void execute() override;
 
+    //Adds the territories read or changed by the Blockade order to the footprint
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Blockade& blockade);
 
@@ -211,6 +318,15 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type and the territories of the Blockade order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the target territory
+    Territory* getTargetTerritory() const;
+
+    //Getter for the neutral player
+    Player* getNeutralPlayer() const;
 };
 
 // This class implements an Airlift order.
@@ -239,6 +355,9 @@ public:
     //Executes an Airlift order
     void execute() override;
 
+    //Adds the territories read or changed by the Airlift order to the footprint
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Airlift& airlift);
 
@@ -247,6 +366,18 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type and the territories of the Airlift order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the source territory
+    Territory* getSourceTerritory() const;
+
+    //Getter for the target territory
+    Territory* getTargetTerritory() const;
+
+    //Getter for the number of armies
+    int getNumArmies() const;
 };
 
 // This class implements a Negotiate order.
@@ -273,6 +404,9 @@ public:
     //Executes a Negotiate order
     void execute() override;
 
+    //Makes the footprint of the Negotiate order exclusive, since it changes the friends of two players
+    void addToFootprint(OrderFootprint& footprint) const override;
+
     //Defining the output operator
     friend ostream & operator<<(ostream& out, const Negotiate& negotiate);
 
@@ -281,12 +415,18 @@ public:
 
     // Override class from Order
     string stringToLog() const override;
+
+    //Fills the fields of the log with the type of the Negotiate order
+    void addLogFields(LogFields& fields) const override;
+
+    //Getter for the enemy player
+    Player* getEnemyPlayer() const;
 };
 
 // This class implements an OrdersList which contains the orders created.
 class OrdersList : public Subject, public ILoggable {
 private:
-    vector<Order*>* orders;
+    vector<Order*> orders;
 public:
     //Default constructor
     OrdersList();
@@ -294,6 +434,9 @@ public:
     //Copy constructor
     OrdersList(const OrdersList& o_list);
 
+    //Move constructor
+    OrdersList(OrdersList&& o_list) noexcept;
+
     //Destructor
     ~OrdersList();
 
@@ -304,7 +447,10 @@ public:
     void remove(int orderPosition);
 
     //Getter for the vector of orders
-    vector<Order*>* getOrders() const;
+    vector<Order*>* getOrders();
+
+    //Getter for the vector of orders of a const list
+    const vector<Order*>* getOrders() const;
 
     //Add an order to the vector by providing an Order
     void addOrder(Order* order);
@@ -315,6 +461,9 @@ public:
     //Defining the assignment operator
     OrdersList& operator=(const OrdersList& ordersList);
 
+    //Defining the move assignment operator
+    OrdersList& operator=(OrdersList&& ordersList) noexcept;
+
     //Defining the addition operator
     void operator+(Order* order);
 
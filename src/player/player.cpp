@@ -1,4 +1,5 @@
 #include "player.h"
+#include <type_traits>
 #include <ctime>
 
 using namespace std;
@@ -6,71 +7,66 @@ using namespace std;
 // The implementation file of the Player class.
 
 // Default constructor which initializes the territories, hand and ordersList for the Player.
-Player::Player(){
-
-    //Territories, hand and ordersList initialization.
-    territories = new std::vector<Territory*>{};
-    hand = new Hand();
-    ordersList = new OrdersList();
-    this->friendPlayers = vector<Player*>();
-    this->conqueredTerritoryInTurn = false;
-    reinforcementPool = new int();
-    pname = new string("Default Player Name");
-    bool isNeutral = new bool();
-    playerStrategy = new HumanPlayerStrategy();
-};
+// The territories, hand and orders list are held by value, so they are not allocated one by one.
+Player::Player()
+        : conqueredTerritoryInTurn(false), reinforcementPool(0), pname("Default Player Name"), isNeutral(false),
+          playerStrategy(new HumanPlayerStrategy()) {}
 
 // Parameterized constructor to create a player with a name and a player strategy
-Player::Player(const string& pname, PlayerStrategy* newPlayerStrategy) {
-    territories = new std::vector<Territory*>{};
-    hand = new Hand();
-    ordersList = new OrdersList();
-    this->pname = new string(pname);
-    reinforcementPool = new int();
-    friendPlayers = vector<Player*>();
-    conqueredTerritoryInTurn = false;
-    if(pname == "Neutral"){
-        isNeutral = new bool(true);
-    }else{
-        isNeutral = new bool(false);
-    }
-    this->playerStrategy = newPlayerStrategy->clone();
-}
+Player::Player(const string& pname, PlayerStrategy* newPlayerStrategy)
+        : conqueredTerritoryInTurn(false), reinforcementPool(0), pname(pname), isNeutral(pname == "Neutral"),
+          playerStrategy(newPlayerStrategy->clone()) {}
 
 // Copy constructor.
-Player::Player(const Player &pl) {
-    this->territories = new std::vector<Territory*>(*pl.territories);
-    this->hand = new Hand(*pl.hand);
-    this->ordersList = new OrdersList(*pl.ordersList);
+Player::Player(const Player &pl)
+        : territories(pl.territories), hand(pl.hand), ordersList(pl.ordersList),
+          conqueredTerritoryInTurn(pl.conqueredTerritoryInTurn), reinforcementPool(0), pname(pl.pname),
+          isNeutral(false), playerStrategy(pl.playerStrategy->clone()) {
     for (Player* player : pl.friendPlayers) {
         this->friendPlayers.push_back(new Player(*player));
     }
-    this->conqueredTerritoryInTurn = pl.conqueredTerritoryInTurn;
-    this->pname = new string(*pl.pname);
-    this->reinforcementPool = new int();
-    this->isNeutral = new bool(false);
-    this->playerStrategy = pl.playerStrategy->clone();
 }
 
+// Move constructor, which takes the territories, cards, orders and strategy of the given player.
+Player::Player(Player &&pl) noexcept
+        : territories(std::move(pl.territories)), hand(std::move(pl.hand)), ordersList(std::move(pl.ordersList)),
+          friendPlayers(std::move(pl.friendPlayers)), conqueredTerritoryInTurn(pl.conqueredTerritoryInTurn),
+          reinforcementPool(pl.reinforcementPool), pname(std::move(pl.pname)), isNeutral(pl.isNeutral),
+          playerStrategy(pl.playerStrategy) {
+    pl.playerStrategy = nullptr;
+    takeOwnership(pl);
+}
+
+// Makes this player the owner of its territories still owned by the given player. The territories point to their
+// owner, and the map keys its ownership totals on that pointer, so they must follow the player when it is relocated.
+void Player::takeOwnership(const Player &previous) {
+    for (Territory *territory : territories) {
+        if (territory->getOwner() == &previous) {
+            territory->setOwner(this);
+        }
+    }
+}
+
+static_assert(std::is_nothrow_move_constructible_v<Player>, "Players must be relocated without copies");
+
 // Swaps the member data between two Player objects.
 void Player::swap(Player &first, Player &second) {
     std::swap(first.territories, second.territories);
     std::swap(first.hand, second.hand);
     std::swap(first.ordersList, second.ordersList);
+    std::swap(first.friendPlayers, second.friendPlayers);
+    std::swap(first.conqueredTerritoryInTurn, second.conqueredTerritoryInTurn);
     std::swap(first.pname, second.pname);
     std::swap(first.reinforcementPool, second.reinforcementPool);
+    std::swap(first.isNeutral, second.isNeutral);
     std::swap(first.playerStrategy, second.playerStrategy);
+    first.takeOwnership(second);
+    second.takeOwnership(first);
 }
 
 // Destructor.
 Player::~Player() {
-    delete territories;
-    delete hand;
-    delete ordersList;
     clearPlayerFriends();
-    delete pname;
-    delete reinforcementPool;
-    delete isNeutral;
     delete playerStrategy;
 }
 
@@ -78,8 +74,8 @@ Player::~Player() {
 ostream& operator<<(ostream& out, const Player &pl)
 {
 
-    out << "The territories collection contains " << pl.territories->size() << " territories:" << endl;
-    for (Territory* territory : *pl.territories) {
+    out << "The territories collection contains " << pl.territories.size() << " territories:" << endl;
+    for (Territory* territory : pl.territories) {
         out << territory << endl;
     }
 
@@ -98,24 +94,28 @@ Player &Player::operator=(Player pl) {
 }
 
 // Getter for the territories.
-std::vector<Territory*>* Player::getTerritories() const {
-    return territories;
+std::vector<Territory*>* Player::getTerritories() {
+    return &territories;
+}
+
+// Getter for the territories of a const player.
+const std::vector<Territory*>* Player::getTerritories() const {
+    return &territories;
 }
 
 // Setter for the territories.
 void Player::setTerritories(const std::vector<Territory*> &territories) {
-    delete this->territories;
-    this->territories = new std::vector(territories);
+    this->territories = territories;
 }
 
 // Removes a territory from the Player's collection of territories
 void Player::removeTerritory(const Territory& territory) {
     // Create an iterator that will point to the same territory owned by the player as the territory to be removed
-    vector<Territory*>::iterator it = std::find(this->territories->begin(), this->territories->end(), &territory);
+    vector<Territory*>::iterator it = std::find(this->territories.begin(), this->territories.end(), &territory);
 
     // If the territory is found, delete the reference to the territory in the collection of the player
-    if(it != this->territories->end()){
-        this->territories->erase(it);       //deleting pointer causing memory leak???? I dont think so cuz the passed territory still holds the reference
+    if(it != this->territories.end()){
+        this->territories.erase(it);       //deleting pointer causing memory leak???? I dont think so cuz the passed territory still holds the reference
     }
 }
 
@@ -130,16 +130,16 @@ ostream& operator<<(ostream& out, const std::vector<Territory*> &territories) {
 
 void Player::acquireTerritory(Territory* territory){
     territory->setOwner(this);
-    territories->push_back(territory);
+    territories.push_back(territory);
 }
 
 void Player::increasePool(int numOfArmies) {
-    *this->reinforcementPool += numOfArmies;
+    this->reinforcementPool += numOfArmies;
 }
 
 void Player::decreasePool(int numOfArmies) {
-    if(numOfArmies <= *reinforcementPool){
-        *this->reinforcementPool -= numOfArmies;
+    if(numOfArmies <= reinforcementPool){
+        this->reinforcementPool -= numOfArmies;
     }else{
         cout << "Number of armies to be removed is greater than the total number of armies in the pool." << endl;
     }
@@ -147,52 +147,73 @@ void Player::decreasePool(int numOfArmies) {
 }
 
 // Getter for the hand.
-Hand* Player::getHand() const {
-    return hand;
+Hand* Player::getHand() {
+    return &hand;
+}
+
+// Getter for the hand of a const player.
+const Hand* Player::getHand() const {
+    return &hand;
 }
 
 // Setter for the hand.
 void Player::setHand(const Hand &hand) {
-    delete this->hand;
-    this->hand = new Hand(hand);
+    this->hand = hand;
+}
+
+// Setter for the hand, which takes the cards of the given hand.
+void Player::setHand(Hand &&hand) {
+    this->hand = std::move(hand);
 }
 
 // Getter for the orders list.
-OrdersList* Player:: getOrdersList() const {
-    return ordersList;
+OrdersList* Player::getOrdersList() {
+    return &ordersList;
+}
+
+// Getter for the orders list of a const player.
+const OrdersList* Player::getOrdersList() const {
+    return &ordersList;
 }
 
 // Setter for the orders list.
 void Player::setOrdersList(const OrdersList &ordersList) {
-    delete this->ordersList;
-    this->ordersList = new OrdersList(ordersList);
+    this->ordersList = ordersList;
+}
+
+// Setter for the orders list, which takes the orders of the given list.
+void Player::setOrdersList(OrdersList &&ordersList) {
+    this->ordersList = std::move(ordersList);
 }
 
 // Getter for the player name.
-string* Player::getPName() const {
+const string& Player::getPName() const {
     return pname;
 }
 
 // Setter for the player name.
 void Player::setPName(const string &pname) {
-    delete this->pname;
-    this->pname = new string(pname);
+    this->pname = pname;
 }
 
 // Getter for the Reinforcement Pool
-int* Player::getReinforcementPool() const {
+int Player::getReinforcementPool() const {
     return reinforcementPool;
 }
 
+// Setter for the Reinforcement Pool
+void Player::setReinforcementPool(int reinforcementPool) {
+    this->reinforcementPool = reinforcementPool;
+}
+
 // Getter for the isNeutral status
-bool* Player::getIsNeutral() const{
+bool Player::getIsNeutral() const{
     return isNeutral;
 }
 
 // Setter for the isNeutral status.
-void Player::setIsNeutral(const bool& isNeutral) {
-    delete this->isNeutral;
-    this->isNeutral = new bool(isNeutral);
+void Player::setIsNeutral(bool isNeutral) {
+    this->isNeutral = isNeutral;
 }
 
 //A function which will go through the collection of territories the player owns and
@@ -210,17 +231,29 @@ vector<tuple<Territory*,Territory*,string>> Player::toDefend() {
 }
 
 //A function which creates an Order object and adds it to the list of Orders.
-void Player::issueOrder(tuple<Territory*,Territory*,string> *orderInfo, LogObserver& log){
-    playerStrategy->issueOrder(this, orderInfo, log);
+void Player::issueOrder(tuple<Territory*,Territory*,string> *orderInfo){
+    playerStrategy->issueOrder(this, orderInfo);
+}
+
+Task<vector<tuple<Territory*,Territory*,string>>> Player::toDefendAsync(InputChannel &input) {
+    return playerStrategy->toDefendAsync(this, input);
+}
+
+Task<vector<tuple<Territory*,Territory*,string>>> Player::toAttackAsync(InputChannel &input) {
+    return playerStrategy->toAttackAsync(this, input);
+}
+
+Task<void> Player::issueOrderAsync(tuple<Territory*,Territory*,string> *orderInfo, InputChannel &input) {
+    return playerStrategy->issueOrderAsync(this, orderInfo, input);
 }
 
 int Player::hasCard(int cardType){
 
     int i = 0;
 
-    for(Card* card: *hand->getHandsCards()) { //for each neighbor of a territory
+    for(Card* card: *hand.getHandsCards()) { //for each neighbor of a territory
 
-        if(*card->getType() == cardType){
+        if(card->getType() == cardType){
 
             return i;
 
@@ -235,8 +268,8 @@ int Player::hasCard(int cardType){
 }
 
 Territory* Player::findWeakestTerritory() {
-    Territory *weakest = territories->at(0);
-    for (auto territory: *territories) {
+    Territory *weakest = territories.at(0);
+    for (auto territory: territories) {
         if (territory->getNumberOfArmies() < weakest->getNumberOfArmies()) {
             weakest = territory;
         }
@@ -31,13 +31,13 @@ class Player {
 private:
 
     //A collection of territories the Player owns.
-    std::vector<Territory*>* territories;
+    std::vector<Territory*> territories;
 
     //Hand object (collection of Card objects) the Player has.
-    Hand* hand;
+    Hand hand;
 
     //An OrdersList object containing Order objects the player has issued.
-    OrdersList* ordersList;
+    OrdersList ordersList;
 
     //A collection of players for which this Player cannot attack for the remainder of the turn
     vector<Player*> friendPlayers;
@@ -46,17 +46,20 @@ private:
     bool conqueredTerritoryInTurn;
 
     //The reinforcement pool of the player that has armies that can be distributed to territories
-    int* reinforcementPool;
+    int reinforcementPool;
 
     //Name of the player
-    string* pname;
+    string pname;
 
     //Neutral player or not
-    bool* isNeutral;
+    bool isNeutral;
 
     // Player strategy class containing all the player types
     PlayerStrategy* playerStrategy;
 
+    // Makes this player the owner of its territories still owned by the given player, which they were moved from.
+    void takeOwnership(const Player &previous);
+
 public:
     // Default constructor which initializes all the maps and the current game state.
     Player();
@@ -67,6 +70,9 @@ public:
     // A copy constructor.
     Player(const Player& pl);
 
+    // A move constructor. The territories of the given player are owned by the new player afterwards.
+    Player(Player&& pl) noexcept;
+
     // Defining the assignment operator.
     Player& operator=(Player pl);
 
@@ -98,10 +104,18 @@ public:
     Territory* findWeakestTerritory();
 
     //A function that will create an Order object and add it to the list of Orders.
-    void issueOrder(tuple<Territory*,Territory*,string> *orderInfo, LogObserver& log);
+    void issueOrder(tuple<Territory*,Territory*,string> *orderInfo);
+
+    // The same as toDefend, toAttack and issueOrder, reading what the player's user decides from the given input.
+    Task<vector<tuple<Territory*,Territory*,string>>> toDefendAsync(InputChannel &input);
+    Task<vector<tuple<Territory*,Territory*,string>>> toAttackAsync(InputChannel &input);
+    Task<void> issueOrderAsync(tuple<Territory*,Territory*,string> *orderInfo, InputChannel &input);
 
     // Getter for the territories.
-    [[nodiscard]] std::vector<Territory*>* getTerritories() const;
+    [[nodiscard]] std::vector<Territory*>* getTerritories();
+
+    // Getter for the territories of a const player.
+    [[nodiscard]] const std::vector<Territory*>* getTerritories() const;
 
     // Setter for the territories.
     void setTerritories(const std::vector<Territory*> &territories);
@@ -110,17 +124,29 @@ public:
     void removeTerritory(const Territory& territory);
 
     // Getter for the hand.
-    [[nodiscard]] Hand* getHand() const;
+    [[nodiscard]] Hand* getHand();
+
+    // Getter for the hand of a const player.
+    [[nodiscard]] const Hand* getHand() const;
 
     // Setter for the hand.
     void setHand(const Hand &hand);
 
+    // Setter for the hand, which takes the cards of the given hand.
+    void setHand(Hand &&hand);
+
     // Getter for the orders list.
-    [[nodiscard]] OrdersList* getOrdersList() const;
+    [[nodiscard]] OrdersList* getOrdersList();
+
+    // Getter for the orders list of a const player.
+    [[nodiscard]] const OrdersList* getOrdersList() const;
 
     // Setter for the orders list.
     void setOrdersList(const OrdersList &ordersList);
 
+    // Setter for the orders list, which takes the orders of the given list.
+    void setOrdersList(OrdersList &&ordersList);
+
     // A function used in the assignment operator definition which swaps the member data
     // between two Player objects.
     void swap(Player &first, Player &second);
@@ -138,22 +164,25 @@ public:
     bool hasConqueredTerritoryInTurn() const;
 
     // Getter for the player name.
-    [[nodiscard]] string* getPName() const;
+    [[nodiscard]] const string& getPName() const;
 
     // Setter for the player name.
     void setPName(const string &pname);
 
     // Getter for the Reinforcement Pool
-    [[nodiscard]] int* getReinforcementPool() const;
+    [[nodiscard]] int getReinforcementPool() const;
+
+    // Setter for the Reinforcement Pool
+    void setReinforcementPool(int reinforcementPool);
 
     //Setter for the conqueredTerritoryInTurn boolean
     void setConqueredTerritoryInTurn(const bool conqueredTerritoryInTurn);
 
     // Getter for the isNeutral status
-    [[nodiscard]] bool* getIsNeutral() const;
+    [[nodiscard]] bool getIsNeutral() const;
 
     // Setter for the isNeutral status.
-    void setIsNeutral(const bool &isNeutral);
+    void setIsNeutral(bool isNeutral);
 
     // Getter for the player strategy
     PlayerStrategy* getPlayerStrategy() const;
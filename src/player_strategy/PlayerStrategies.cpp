@@ -1,5 +1,13 @@
 #include "PlayerStrategies.h"
 #include "game_engine/game_engine.h"
+#include "game_state/game_state.h"
+#include "game_state/map_topology.h"
+#include "game_state/rollout.h"
+#include "concurrency/thread_pool.h"
+#include "orders/battle_odds.h"
+#include <charconv>
+#include <chrono>
+#include <climits>
 
 /**
  * Player Strategy class
@@ -10,6 +18,23 @@ PlayerStrategy::PlayerStrategy() {}
 // Default destructor for Player Strategy
 PlayerStrategy::~PlayerStrategy() {}
 
+// A strategy which does not ask its user anything decides right away
+Task<void> PlayerStrategy::issueOrderAsync(Player *player, tuple<Territory *, Territory *, string> *orderInfo,
+                                           InputChannel &input) {
+    issueOrder(player, orderInfo);
+    co_return;
+}
+
+Task<vector<tuple<Territory *, Territory *, string>>> PlayerStrategy::toAttackAsync(Player *player,
+                                                                                    InputChannel &input) {
+    co_return toAttack(player);
+}
+
+Task<vector<tuple<Territory *, Territory *, string>>> PlayerStrategy::toDefendAsync(Player *player,
+                                                                                    InputChannel &input) {
+    co_return toDefend(player);
+}
+
 /**
 * Human strategy player
 */
@@ -31,47 +56,58 @@ PlayerStrategy *HumanPlayerStrategy::clone() const {
     return new HumanPlayerStrategy(*this);
 }
 
-void HumanPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
-    cout << "Issuing order from Human Player Strategy" << endl;
+void HumanPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
+    issueOrderAsync(player, orderInfo, InputChannel::console()).get();
+}
+
+vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toAttack(Player *player) {
+    return toAttackAsync(player, InputChannel::console()).get();
+}
+
+vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toDefend(Player *player) {
+    return toDefendAsync(player, InputChannel::console()).get();
+}
+
+Task<void> HumanPlayerStrategy::issueOrderAsync(Player *player, tuple<Territory *, Territory *, string> *orderInfo,
+                                                InputChannel &input) {
+    ostream &out = input.prompts();
+    out << "Issuing order from Human Player Strategy" << endl;
     if (get<2>(*orderInfo) == "deploy") {
-        cout << "Issuing deploy order!" << endl;
-        int reinforcementPool = *player->getReinforcementPool();
+        out << "Issuing deploy order!" << endl;
+        int reinforcementPool = player->getReinforcementPool();
         int nbrDeploy;
         bool repeat = true;
 
         do {
-            cout << "Issuing a deploy order. Your current reinforcement pool is " << reinforcementPool << endl;
-            cout << "Please enter the number of armies to deploy on " << get<0>(*orderInfo)->getName() << endl;
-            cin >> nbrDeploy;
+            out << "Issuing a deploy order. Your current reinforcement pool is " << reinforcementPool << endl;
+            out << "Please enter the number of armies to deploy on " << get<0>(*orderInfo)->getName() << endl;
+            nbrDeploy = InputChannel::toInt(co_await input.nextWord(), -1);
 
-            if (nbrDeploy <= reinforcementPool) {
+            if (nbrDeploy >= 0 && nbrDeploy <= reinforcementPool) {
                 player->decreasePool(nbrDeploy);
                 repeat = false;
-            } else if (nbrDeploy < 0 || nbrDeploy > reinforcementPool) {
-                cout << "Cannot deploy this amount of armies: " << nbrDeploy << ". Please try again." << endl;
+            } else {
+                out << "Cannot deploy this amount of armies: " << nbrDeploy << ". Please try again." << endl;
             }
         } while (repeat);
 
         Order *deploy = new Deploy(*player, *get<0>(*orderInfo), nbrDeploy);
         player->getOrdersList()->addOrder(deploy);
-        cout << "**issueOrder Deploy | Player: " << *player->getPName() << " | Target territory: "
-             << get<0>(*orderInfo)->getName() << " | Armies: " << nbrDeploy << endl;
-        log.AddSubject(*deploy);
+        out << "**issueOrder Deploy | Player: " << player->getPName() << " | Target territory: "
+            << get<0>(*orderInfo)->getName() << " | Armies: " << nbrDeploy << endl;
 
     } else if (get<2>(*orderInfo) == "negotiate") {
-        cout << "Issuing negotiate order!" << endl;
+        out << "Issuing negotiate order!" << endl;
         Order *negotiate = new Negotiate(*player, *get<1>(*orderInfo)->getOwner());
         player->getOrdersList()->addOrder(negotiate);
-        log.AddSubject(*negotiate);
 
     } else if (get<2>(*orderInfo) == "blockade") {
-        cout << "Issuing blockade order!" << endl;
+        out << "Issuing blockade order!" << endl;
         Order *blockade = new Blockade(*player, *GameEngine::getNeutralPlayer(), *get<1>(*orderInfo));
         player->getOrdersList()->addOrder(blockade);
-        log.AddSubject(*blockade);
-        cout << "**issueOrder Blockade | Player: " << *player->getPName() << " | Neutral player: "
-             << *GameEngine::getNeutralPlayer()->getPName() << " | Target territory: " << get<1>(*orderInfo)->getName()
-             << endl;
+        out << "**issueOrder Blockade | Player: " << player->getPName() << " | Neutral player: "
+            << GameEngine::getNeutralPlayer()->getPName() << " | Target territory: " << get<1>(*orderInfo)->getName()
+            << endl;
 
     } else if (get<2>(*orderInfo) == "airlift") {
         int nbrAirlift;
@@ -79,35 +115,34 @@ void HumanPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territor
 
         if (get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
             do {
-                cout << "Issuing an airlift order. Your current number of armies on territory "
-                     << get<0>(*orderInfo)->getName() << " is " << get<0>(*orderInfo)->getNumberOfArmies() << endl;
-                cout << "Please enter the number of armies to airlift to territory " << get<1>(*orderInfo)->getName()
-                     << endl;
-                cin >> nbrAirlift;
+                out << "Issuing an airlift order. Your current number of armies on territory "
+                    << get<0>(*orderInfo)->getName() << " is " << get<0>(*orderInfo)->getNumberOfArmies() << endl;
+                out << "Please enter the number of armies to airlift to territory " << get<1>(*orderInfo)->getName()
+                    << endl;
+                nbrAirlift = InputChannel::toInt(co_await input.nextWord(), -1);
 
-                if (nbrAirlift < get<0>(*orderInfo)->getNumberOfArmies()) {
+                if (nbrAirlift >= 0 && nbrAirlift < get<0>(*orderInfo)->getNumberOfArmies()) {
                     repeat = false;
                 } else if (nbrAirlift < 0 || nbrAirlift > get<0>(*orderInfo)->getNumberOfArmies()) {
-                    cout << "Cannot airlift this amount of armies: " << nbrAirlift
-                         << ". The number is either negative or more than the current amount of armies on the source territory. Please try again."
-                         << endl;
+                    out << "Cannot airlift this amount of armies: " << nbrAirlift
+                        << ". The number is either negative or more than the current amount of armies on the source territory. Please try again."
+                        << endl;
                 } else {
-                    cout << "Cannot airlift this amount of armies: " << nbrAirlift
-                         << " (must leave at least one army on source territory). Please try again." << endl;
+                    out << "Cannot airlift this amount of armies: " << nbrAirlift
+                        << " (must leave at least one army on source territory). Please try again." << endl;
                 }
             } while (repeat);
 
             Order *airlift = new Airlift(*player, *get<0>(*orderInfo), *get<1>(*orderInfo),
                                          nbrAirlift);
-            cout << "**issueOrder Airlift | Player: " << *player->getPName() << " | Source territory: "
-                 << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName()
-                 << " | Armies left on source territory: " << get<0>(*orderInfo)->getNumberOfArmies() - nbrAirlift
-                 << endl;
+            out << "**issueOrder Airlift | Player: " << player->getPName() << " | Source territory: "
+                << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName()
+                << " | Armies left on source territory: " << get<0>(*orderInfo)->getNumberOfArmies() - nbrAirlift
+                << endl;
             player->getOrdersList()->addOrder(airlift);
-            log.AddSubject(*airlift);
         } else {
-            cout << "Cannot issue airlift order because numArmies source territory " << get<0>(*orderInfo)->getName()
-                 << ", armies = " << get<0>(*orderInfo)->getNumberOfArmies() << " is less than 2" << endl;
+            out << "Cannot issue airlift order because numArmies source territory " << get<0>(*orderInfo)->getName()
+                << ", armies = " << get<0>(*orderInfo)->getNumberOfArmies() << " is less than 2" << endl;
         }
     } else if (get<2>(*orderInfo) == "advance") {
         int nbrAdvance;
@@ -115,65 +150,64 @@ void HumanPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territor
 
         if (get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
             do {
-                cout << "Issuing an advance order." << endl;
-                cout << "Your current number of armies on the source territory " << get<0>(*orderInfo)->getName()
-                     << " is "
-                     << get<0>(*orderInfo)->getNumberOfArmies() << endl;
+                out << "Issuing an advance order." << endl;
+                out << "Your current number of armies on the source territory " << get<0>(*orderInfo)->getName()
+                    << " is "
+                    << get<0>(*orderInfo)->getNumberOfArmies() << endl;
 
                 if (get<0>(*orderInfo)->getOwner() == get<1>(*orderInfo)->getOwner()) {
-                    cout << "The current number of armies on the FRIENDLY target territory "
-                         << get<1>(*orderInfo)->getName() << " is " << get<1>(*orderInfo)->getNumberOfArmies() << endl;
+                    out << "The current number of armies on the FRIENDLY target territory "
+                        << get<1>(*orderInfo)->getName() << " is " << get<1>(*orderInfo)->getNumberOfArmies() << endl;
                 } else {
-                    cout << "The current number of armies on the HOSTILE target territory "
-                         << get<1>(*orderInfo)->getName() << " is " << get<1>(*orderInfo)->getNumberOfArmies() << endl;
+                    out << "The current number of armies on the HOSTILE target territory "
+                        << get<1>(*orderInfo)->getName() << " is " << get<1>(*orderInfo)->getNumberOfArmies() << endl;
                 }
 
-                cout << "Please enter the number of armies to advance from territory " << get<0>(*orderInfo)->getName()
-                     << " to territory " << get<1>(*orderInfo)->getName() << endl;
-                cin >> nbrAdvance;
+                out << "Please enter the number of armies to advance from territory " << get<0>(*orderInfo)->getName()
+                    << " to territory " << get<1>(*orderInfo)->getName() << endl;
+                nbrAdvance = InputChannel::toInt(co_await input.nextWord(), -1);
 
-                if (nbrAdvance < get<0>(*orderInfo)->getNumberOfArmies()) {
+                if (nbrAdvance >= 0 && nbrAdvance < get<0>(*orderInfo)->getNumberOfArmies()) {
                     repeat = false;
                 } else if (nbrAdvance < 0 || nbrAdvance > get<0>(*orderInfo)->getNumberOfArmies()) {
-                    cout << "Cannot advance this amount of armies: " << nbrAdvance
-                         << ". The number is either negative or more than the current amount of armies on the source territory. Please try again."
-                         << endl;
+                    out << "Cannot advance this amount of armies: " << nbrAdvance
+                        << ". The number is either negative or more than the current amount of armies on the source territory. Please try again."
+                        << endl;
                 } else {
-                    cout << "Cannot advance this amount of armies: " << nbrAdvance
-                         << " (must leave at least one army on source territory). Please try again." << endl;
+                    out << "Cannot advance this amount of armies: " << nbrAdvance
+                        << " (must leave at least one army on source territory). Please try again." << endl;
                 }
             } while (repeat);
 
             Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo),
                                          nbrAdvance);
             player->getOrdersList()->addOrder(advance);
-            log.AddSubject(*advance);
-            cout << "**issueOrder Advance | Player: " << *player->getPName() << " | Source territory: "
-                 << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName()
-                 << " , owner: " << *get<1>(*orderInfo)->getOwner()->getPName()
-                 << " | Armies left on source territory: " << get<0>(*orderInfo)->getNumberOfArmies() - nbrAdvance
-                 << endl;
+            out << "**issueOrder Advance | Player: " << player->getPName() << " | Source territory: "
+                << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName()
+                << " , owner: " << get<1>(*orderInfo)->getOwner()->getPName()
+                << " | Armies left on source territory: " << get<0>(*orderInfo)->getNumberOfArmies() - nbrAdvance
+                << endl;
         } else {
-            cout << "Cannot issue advance order because numArmies source territory " << get<0>(*orderInfo)->getName()
-                 << ", armies = " << get<0>(*orderInfo)->getNumberOfArmies() << " is less than 2" << endl;
+            out << "Cannot issue advance order because numArmies source territory " << get<0>(*orderInfo)->getName()
+                << ", armies = " << get<0>(*orderInfo)->getNumberOfArmies() << " is less than 2" << endl;
         }
     } else if (get<2>(*orderInfo) == "bomb") {
-        cout << "Issuing a bomb order." << endl;
+        out << "Issuing a bomb order." << endl;
         Order *bomb = new Bomb(*player, *get<1>(*orderInfo));
         player->getOrdersList()->addOrder(bomb);
-        cout << "**issueOrder Bomb | Player: " << *player->getPName() << " | Target territory: "
-             << get<1>(*orderInfo)->getName() << endl;
-        log.AddSubject(*bomb);
+        out << "**issueOrder Bomb | Player: " << player->getPName() << " | Target territory: "
+            << get<1>(*orderInfo)->getName() << endl;
     }
 }
 
-vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toAttack(Player *player) {
-    cout << "toAttack method from Human Player Strategy" << endl;
+Task<vector<tuple<Territory *, Territory *, string>>> HumanPlayerStrategy::toAttackAsync(Player *player,
+                                                                                         InputChannel &input) {
+    ostream &out = input.prompts();
+    out << "toAttack method from Human Player Strategy" << endl;
     vector<tuple<Territory *, Territory *, string>> toAttack;
     //Copy of the player's hand to keep track of which cards are going to be played
     std::map<int, pair<string, int>> tempHand;
     int sourceTerritoryIndex;
-    int targetTerritoryIndex;
     string targetTerritoryInput;
     int orderType;
     bool shouldContinue = true;
@@ -186,27 +220,27 @@ vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toAttack(Pl
                 {4, pair("negotiate", 0)}};
     //Counts the number of cards for each type
     for (Card *card: *player->getHand()->getHandsCards()) {
-        tempHand[*card->getType()].second += 1;
+        tempHand[card->getType()].second += 1;
     }
 
     do {
         chooseTerritoryAgain = true;
-        cout << "Here are your current possible attack order types:\n" << endl;
+        out << "Here are your current possible attack order types:\n" << endl;
 
-        cout << "Attack order type #" << 0 << ": Attack order type name: " << tempHand[0].first
-             << " | Number of such cards in hand: " << tempHand[0].second << endl;
-        cout << "Attack order type #" << 1 << ": Attack order type name: " << "advance" << endl;
+        out << "Attack order type #" << 0 << ": Attack order type name: " << tempHand[0].first
+            << " | Number of such cards in hand: " << tempHand[0].second << endl;
+        out << "Attack order type #" << 1 << ": Attack order type name: " << "advance" << endl;
 
-        cout << "Enter the wanted attack order type (enter -1 if you wish to move on):" << endl;
+        out << "Enter the wanted attack order type (enter -1 if you wish to move on):" << endl;
 
-        cin >> orderType;
+        orderType = InputChannel::toInt(co_await input.nextWord(), -2);
 
         if (orderType == -1) {
             shouldContinue = false;
             continue;
         } else if (orderType < 0 || orderType > 1) {
-            cout << "The order type number " << orderType << " doesn't exist! Please enter a number between 0-1!"
-                 << endl;
+            out << "The order type number " << orderType << " doesn't exist! Please enter a number between 0-1!"
+                << endl;
             continue;
         }
         switch (orderType) {
@@ -215,83 +249,62 @@ vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toAttack(Pl
                 break;
             default:
                 if (tempHand[orderType].second == 0) {
-                    cout << "You have no cards of type " << tempHand[orderType].first << " to play in your hand!"
-                         << endl;
+                    out << "You have no cards of type " << tempHand[orderType].first << " to play in your hand!"
+                        << endl;
                     continue;
                 }
                 orderName = tempHand[orderType].first;
                 tempHand[orderType].second -= 1;
         }
 
-        cout << "\nYou selected a attack order of type " << orderName << "\n" << endl;
+        out << "\nYou selected a attack order of type " << orderName << "\n" << endl;
 
         do {
-            cout
+            out
                     << "-Choose two territories from the list below. Type the first territory id, hit enter, and then type the second territory id and hit enter."
                     << endl;
-            cout
+            out
                     << "-For advance and bomb, the second territory should be neighbouring the first one (and should be a hostile territory)."
                     << endl;
-            cout
+            out
                     << "-For advance and bomb, the second id should be formatted like so \"2-5\"."
                     << endl;
 
-            cout
+            out
                     << "This means that the second territory is territory with id 5 which is a neighbour of territory with id 2.\n"
                     << endl;
 
 
-            printPlayerTerritories(player);
+            printPlayerTerritories(player, out);
 
-            cout << "\nEnter source territory id:" << endl;
-            cin >> sourceTerritoryIndex;
+            out << "\nEnter source territory id:" << endl;
+            sourceTerritoryIndex = InputChannel::toInt(co_await input.nextWord(), -1);
 
-            cout << "\nEnter target territory id:" << endl;
-            cin >> targetTerritoryInput;
-
-            try {
-                Territory *sourceTerritory = player->getTerritories()->at(sourceTerritoryIndex);
-                Territory *targetTerritory = nullptr;
-                auto end = targetTerritoryInput.find('-');
-                if (end == string::npos) {
-                    targetTerritoryIndex = stoi(targetTerritoryInput);
-                    targetTerritory = player->getTerritories()->at(targetTerritoryIndex);
-                } else {
-                    int outterTer = stoi(targetTerritoryInput.substr(0, end));
-                    int innerTer = stoi(targetTerritoryInput.substr(end + 1, targetTerritoryInput.size()));
-                    int count = 0;
-                    for (auto const &entry: player->getTerritories()->at(outterTer)->getNeighbours()) {
-                        if (count == innerTer) {
-                            targetTerritory = entry;
-                            break;
-                        }
-                        count++;
-                    }
-                }
-
-                if (targetTerritory == nullptr) {
-                    throw out_of_range("No neighbour territory found with " + targetTerritoryInput);
-                }
+            out << "\nEnter target territory id:" << endl;
+            targetTerritoryInput = co_await input.nextWord();
 
+            Territory *sourceTerritory = nullptr;
+            Territory *targetTerritory = nullptr;
+            if (findTerritories(player, sourceTerritoryIndex, targetTerritoryInput, sourceTerritory, targetTerritory)) {
                 toAttack.emplace_back(sourceTerritory, targetTerritory, orderName);
                 chooseTerritoryAgain = false;
-
-            } catch (out_of_range &e) {
-                cerr << "Incorrect first or second territory id! Choose two territories again." << endl;
+            } else {
+                out << "Incorrect first or second territory id! Choose two territories again." << endl;
             }
         } while (chooseTerritoryAgain);
 
     } while (shouldContinue);
-    return toAttack;
+    co_return toAttack;
 }
 
-vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toDefend(Player *player) {
-    cout << "toDefend method from Human Player Strategy" << endl;
+Task<vector<tuple<Territory *, Territory *, string>>> HumanPlayerStrategy::toDefendAsync(Player *player,
+                                                                                         InputChannel &input) {
+    ostream &out = input.prompts();
+    out << "toDefend method from Human Player Strategy" << endl;
     vector<tuple<Territory *, Territory *, string>> toDefend;
     //Copy of the player's hand to keep track of which cards are going to be played
     std::map<int, pair<string, int>> tempHand;
     int sourceTerritoryIndex;
-    int targetTerritoryIndex;
     string targetTerritoryInput;
     int orderType;
     bool shouldContinue = true;
@@ -304,34 +317,34 @@ vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toDefend(Pl
                 {4, pair("negotiate", 0)}};
     //Counts the number of cards for each type
     for (Card *card: *player->getHand()->getHandsCards()) {
-        tempHand[*card->getType()].second += 1;
+        tempHand[card->getType()].second += 1;
     }
 
     do {
         chooseTerritoryAgain = true;
-        cout << "Here are your current possible defend order types:\n" << endl;
+        out << "Here are your current possible defend order types:\n" << endl;
 
-        cout << "Defend order type #" << 0 << ": Defend order type name: " << "deploy" << endl;
-        cout << "Defend order type #" << 1 << ": Defend order type name: " << tempHand[1].first
-             << " | Number of such cards in hand: " << tempHand[1].second << endl;
-        cout << "Defend order type #" << 2 << ": Defend order type name: " << tempHand[2].first
-             << " | Number of such cards in hand: " << tempHand[2].second << endl;
-        cout << "Defend order type #" << 3 << ": Defend order type name: " << tempHand[3].first
-             << " | Number of such cards in hand: " << tempHand[3].second << endl;
-        cout << "Defend order type #" << 4 << ": Defend order type name: " << tempHand[4].first
-             << " | Number of such cards in hand: " << tempHand[4].second << endl;
-        cout << "Defend order type #" << 5 << ": Defend order type name: " << "advance" << endl;
+        out << "Defend order type #" << 0 << ": Defend order type name: " << "deploy" << endl;
+        out << "Defend order type #" << 1 << ": Defend order type name: " << tempHand[1].first
+            << " | Number of such cards in hand: " << tempHand[1].second << endl;
+        out << "Defend order type #" << 2 << ": Defend order type name: " << tempHand[2].first
+            << " | Number of such cards in hand: " << tempHand[2].second << endl;
+        out << "Defend order type #" << 3 << ": Defend order type name: " << tempHand[3].first
+            << " | Number of such cards in hand: " << tempHand[3].second << endl;
+        out << "Defend order type #" << 4 << ": Defend order type name: " << tempHand[4].first
+            << " | Number of such cards in hand: " << tempHand[4].second << endl;
+        out << "Defend order type #" << 5 << ": Defend order type name: " << "advance" << endl;
 
-        cout << "Enter the wanted defend order type (enter -1 if you wish to move on):" << endl;
+        out << "Enter the wanted defend order type (enter -1 if you wish to move on):" << endl;
 
-        cin >> orderType;
+        orderType = InputChannel::toInt(co_await input.nextWord(), -2);
 
         if (orderType == -1) {
             shouldContinue = false;
             continue;
         } else if (orderType < 0 || orderType > 5) {
-            cout << "The order type number " << orderType << " doesn't exist! Please enter a number between 0-5!"
-                 << endl;
+            out << "The order type number " << orderType << " doesn't exist! Please enter a number between 0-5!"
+                << endl;
             continue;
         }
         switch (orderType) {
@@ -343,81 +356,93 @@ vector<tuple<Territory *, Territory *, string>> HumanPlayerStrategy::toDefend(Pl
                 break;
             default:
                 if (tempHand[orderType].second == 0) {
-                    cout << "You have no cards of type " << tempHand[orderType].first << " to play in your hand!"
-                         << endl;
+                    out << "You have no cards of type " << tempHand[orderType].first << " to play in your hand!"
+                        << endl;
                     continue;
                 }
                 orderName = tempHand[orderType].first;
                 tempHand[orderType].second -= 1;
         }
 
-        cout << "\nYou selected a defend order of type " << orderName << "\n" << endl;
+        out << "\nYou selected a defend order of type " << orderName << "\n" << endl;
 
         do {
-            cout
+            out
                     << "Choose two territories from the list below. Type the first territory id, hit enter, and then type the second territory id and hit enter."
                     << endl;
-            cout << "For deploy and blockade, the same territory should be entered." << endl;
-            cout
+            out << "For deploy and blockade, the same territory should be entered." << endl;
+            out
                     << "For negotiate, the second territory should be neighbouring the first one (and should be a hostile territory)."
                     << endl;
-            cout
+            out
                     << "For negotiate, the second id should be formatted like so \"2-5\" which means that the second territory is territory with id 5 which is a neighbour of territory with id 2.\n"
                     << endl;
 
-            printPlayerTerritories(player);
-
-            cout << "\nEnter source territory id:" << endl;
-            cin >> sourceTerritoryIndex;
+            printPlayerTerritories(player, out);
 
-            cout << "\nEnter target territory id:" << endl;
-            cin >> targetTerritoryInput;
+            out << "\nEnter source territory id:" << endl;
+            sourceTerritoryIndex = InputChannel::toInt(co_await input.nextWord(), -1);
 
-            try {
-                Territory *sourceTerritory = player->getTerritories()->at(sourceTerritoryIndex);
-                Territory *targetTerritory = nullptr;
-                auto end = targetTerritoryInput.find('-');
-                if (end == string::npos) {
-                    targetTerritoryIndex = stoi(targetTerritoryInput);
-                    targetTerritory = player->getTerritories()->at(targetTerritoryIndex);
-                } else {
-                    int outterTer = stoi(targetTerritoryInput.substr(0, end));
-                    int innerTer = stoi(targetTerritoryInput.substr(end + 1, targetTerritoryInput.size()));
-                    int count = 0;
-                    for (auto const &entry: player->getTerritories()->at(outterTer)->getNeighbours()) {
-                        if (count == innerTer) {
-                            targetTerritory = entry;
-                            break;
-                        }
-                        count++;
-                    }
-                }
-
-                if (targetTerritory == nullptr) {
-                    throw out_of_range("No neighbour territory found with " + targetTerritoryInput);
-                }
+            out << "\nEnter target territory id:" << endl;
+            targetTerritoryInput = co_await input.nextWord();
 
+            Territory *sourceTerritory = nullptr;
+            Territory *targetTerritory = nullptr;
+            if (findTerritories(player, sourceTerritoryIndex, targetTerritoryInput, sourceTerritory, targetTerritory)) {
                 toDefend.emplace_back(sourceTerritory, targetTerritory, orderName);
                 chooseTerritoryAgain = false;
-
-            } catch (out_of_range &e) {
-                cerr << e.what() << endl;
-                cerr << "Incorrect first or second territory id! Choose two territories again." << endl;
+            } else {
+                out << "Incorrect first or second territory id! Choose two territories again." << endl;
             }
         } while (chooseTerritoryAgain);
 
     } while (shouldContinue);
 
-    return toDefend;
+    co_return toDefend;
 }
 
-void HumanPlayerStrategy::printPlayerTerritories(const Player *player) {
+bool HumanPlayerStrategy::findTerritories(Player *player, int sourceIndex, const string &targetInput,
+                                          Territory *&source, Territory *&target) {
+    vector<Territory *> *territories = player->getTerritories();
+    if (sourceIndex < 0 || static_cast<size_t>(sourceIndex) >= territories->size()) {
+        return false;
+    }
+    source = territories->at(sourceIndex);
+
+    // The target is either one of the player's territories ("5") or a neighbour of one ("2-5")
+    auto end = targetInput.find('-');
+    if (end == string::npos) {
+        int targetIndex = InputChannel::toInt(targetInput, -1);
+        if (targetIndex < 0 || static_cast<size_t>(targetIndex) >= territories->size()) {
+            return false;
+        }
+        target = territories->at(targetIndex);
+        return true;
+    }
+
+    int outterTer = InputChannel::toInt(targetInput.substr(0, end), -1);
+    int innerTer = InputChannel::toInt(targetInput.substr(end + 1), -1);
+    if (outterTer < 0 || static_cast<size_t>(outterTer) >= territories->size()) {
+        return false;
+    }
+    int count = 0;
+    for (auto const &entry: territories->at(outterTer)->getNeighbours()) {
+        if (count == innerTer) {
+            target = entry;
+            return true;
+        }
+        count++;
+    }
+    return false;
+}
+
+void HumanPlayerStrategy::printPlayerTerritories(const Player *player, ostream &out) {
     for (int i = 0; i < player->getTerritories()->size(); i++) {
-        cout << "\nTerritory number #" << i << ": " << player->getTerritories()->at(i) << endl;
+        out << "\nTerritory number #" << i << ": " << player->getTerritories()->at(i) << endl;
 
         int count = 0;
         for (auto const &entry: player->getTerritories()->at(i)->getNeighbours()) {
-            cout << "\t-Neighbour Territory number #" << count << ": " << entry << endl;
+            out << "\t-Neighbour Territory number #" << count << ": " << entry << endl;
             count++;
         }
     }
@@ -430,6 +455,14 @@ void HumanPlayerStrategy::printPlayerTerritories(const Player *player) {
 // Default constructor
 AggressivePlayerStrategy::AggressivePlayerStrategy() {}
 
+// One param constructor which takes the parameters of the strategy
+AggressivePlayerStrategy::AggressivePlayerStrategy(const StrategyParameters &parameters) : parameters(parameters) {}
+
+// Getter for the parameters of the strategy
+const StrategyParameters &AggressivePlayerStrategy::getParameters() const {
+    return parameters;
+}
+
 // Default destructor
 AggressivePlayerStrategy::~AggressivePlayerStrategy() {}
 
@@ -444,14 +477,13 @@ PlayerStrategy *AggressivePlayerStrategy::clone() const {
     return new AggressivePlayerStrategy(*this);
 }
 
-void AggressivePlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
+void AggressivePlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
     cout << "Issuing order from Aggressive Player Strategy" << endl;
     if (get<2>(*orderInfo) == "deploy") {
-        int reinforcementPool = *player->getReinforcementPool();
+        int reinforcementPool = player->getReinforcementPool();
         Order *deploy = new Deploy(*player, *get<0>(*orderInfo), reinforcementPool);
         player->getOrdersList()->addOrder(deploy);
-        cout << "**issueOrder Deploy | Player: " << *player->getPName() << " | Target territory: " << get<0>(*orderInfo)->getName() << " | Armies: " << reinforcementPool << endl;
-        log.AddSubject(*deploy);
+        cout << "**issueOrder Deploy | Player: " << player->getPName() << " | Target territory: " << get<0>(*orderInfo)->getName() << " | Armies: " << reinforcementPool << endl;
         player->decreasePool(reinforcementPool);
     }
     else if (get<2>(*orderInfo) == "negotiate") {
@@ -462,45 +494,43 @@ void AggressivePlayerStrategy::issueOrder(Player *player, tuple<Territory *, Ter
     }
     else if (get<2>(*orderInfo) == "airlift" && get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
         Order *airlift = new Airlift(*player, *get<0>(*orderInfo), *get<1>(*orderInfo), get<0>(*orderInfo)->getNumberOfArmies() - 1);
-        cout << "**issueOrder Airlift | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
+        cout << "**issueOrder Airlift | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
         player->getOrdersList()->addOrder(airlift);
-        log.AddSubject(*airlift);
     }
     else if (get<2>(*orderInfo) == "advance") {
         //Defend Advance
         if (get<0>(*orderInfo)->getOwner() == get<1>(*orderInfo)->getOwner() && get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
             Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo),get<0>(*orderInfo)->getNumberOfArmies() - 1);
             player->getOrdersList()->addOrder(advance);
-            cout << "**issueOrder Advance | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
-            log.AddSubject(*advance);
+            cout << "**issueOrder Advance | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
         }
         else {  //Attack Advance
-            int differenceOfArmies = get<0>(*orderInfo)->getNumberOfArmies() - get<1>(*orderInfo)->getNumberOfArmies();
-            if (differenceOfArmies > 5) {
-                Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo), get<0>(*orderInfo)->getNumberOfArmies() - differenceOfArmies + 5);
-                player->getOrdersList()->addOrder(advance);
-                cout << "**issueOrder Advance | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - differenceOfArmies + 5 << endl;
-                log.AddSubject(*advance);
+            // Send the fewest armies that are likely to capture the target, or every army if the odds are still good
+            const BattleOdds &odds = BattleOdds::table();
+            int sourceArmies = get<0>(*orderInfo)->getNumberOfArmies();
+            int targetArmies = get<1>(*orderInfo)->getNumberOfArmies();
+            int attackingArmies = odds.attackersNeeded(targetArmies, parameters.get(StrategyParameters::targetWinProbability), sourceArmies);
+            if (attackingArmies < 0 && odds.winProbability(sourceArmies, targetArmies) >= parameters.get(StrategyParameters::minWinProbability)) {
+                attackingArmies = sourceArmies;
             }
-            else if (differenceOfArmies >= 1) {
-                Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo),get<0>(*orderInfo)->getNumberOfArmies());
+            if (attackingArmies > 0) {
+                Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo), attackingArmies);
                 player->getOrdersList()->addOrder(advance);
-                cout << "**issueOrder Advance | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() << endl;
-                log.AddSubject(*advance);
+                cout << "**issueOrder Advance | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << attackingArmies << endl;
             }
             else {
                 cout << "Cannot issue Advance order because numArmies source territory "
-                     << get<0>(*orderInfo)->getName() << ", armies = " << get<0>(*orderInfo)->getNumberOfArmies()
-                     << " is less than or equal to the numArmies target territory " << get<1>(*orderInfo)->getName()
-                     << ", armies = " << get<1>(*orderInfo)->getNumberOfArmies() << endl;
+                     << get<0>(*orderInfo)->getName() << ", armies = " << sourceArmies
+                     << " is unlikely to capture the target territory " << get<1>(*orderInfo)->getName()
+                     << ", armies = " << targetArmies << " (win probability "
+                     << odds.winProbability(sourceArmies, targetArmies) << ")" << endl;
             }
         }
     }
     else if (get<2>(*orderInfo) == "bomb") {
         Order *bomb = new Bomb(*player, *get<1>(*orderInfo));
         player->getOrdersList()->addOrder(bomb);
-        cout << "**issueOrder Bomb | Player: " << *player->getPName() << " | Target territory: " << get<1>(*orderInfo)->getName() << endl;
-        log.AddSubject(*bomb);
+        cout << "**issueOrder Bomb | Player: " << player->getPName() << " | Target territory: " << get<1>(*orderInfo)->getName() << endl;
     }
 }
 
@@ -514,18 +544,13 @@ vector<tuple<Territory *, Territory *, string>> AggressivePlayerStrategy::toAtta
     tempHand = {{0,0},{1,0},{2,0},{3,0},{4,0}};
     //Counts the number of cards for each type
     for(Card *card: *player->getHand()->getHandsCards()){
-        tempHand[*card->getType()] += 1;
+        tempHand[card->getType()] += 1;
     }
     //Find strongest territory
-    Territory* strongestTerritory = player->getTerritories()->at(0);
-    for (Territory* terr : *player->getTerritories()) {
-        if (terr->getNumberOfArmies() > strongestTerritory->getNumberOfArmies() && !checkIfAllNeighborsBelongToSamePlayer(terr)) {
-            strongestTerritory = terr;
-        }
-    }
+    Territory* strongestTerritory = findStrongestTerritory(player);
     //Attack neighbors of strongest territory
     for (Territory* neighbor: strongestTerritory->getNeighbours()) {
-        if (tempHand[0] > 0 && neighbor->getNumberOfArmies() > strongestTerritory->getNumberOfArmies()) {
+        if (tempHand[0] > 0 && neighbor->getNumberOfArmies() > parameters.get(StrategyParameters::bombArmyRatio) * strongestTerritory->getNumberOfArmies()) {
             toAttack.emplace_back(strongestTerritory,neighbor,"bomb");
             tempHand[0]--;
         }
@@ -533,11 +558,16 @@ vector<tuple<Territory *, Territory *, string>> AggressivePlayerStrategy::toAtta
             toAttack.emplace_back(strongestTerritory, neighbor,"advance");
         }
     }
-    //Attack neighbors of other territories
+    //Attack neighbors of other territories: enemies that all the armies of the territory are likely to capture, and
+    //weaker territories of the player
+    const BattleOdds &odds = BattleOdds::table();
     for (Territory* territory: *player->getTerritories()) {
-        if (territory != strongestTerritory) {
+        if (territory != strongestTerritory && territory->getNumberOfArmies() > 0) {
             for (Territory* neighbor: territory->getNeighbours()) {
-                if(neighbor->getNumberOfArmies() < territory->getNumberOfArmies() && territory->getNumberOfArmies() > 0){
+                bool isWorthAttacking = neighbor->getOwner() == player
+                        ? neighbor->getNumberOfArmies() < territory->getNumberOfArmies()
+                        : odds.winProbability(territory->getNumberOfArmies(), neighbor->getNumberOfArmies()) >= parameters.get(StrategyParameters::minWinProbability);
+                if (isWorthAttacking) {
                     toAttack.emplace_back(territory,neighbor,"advance");
                 }
             }
@@ -556,15 +586,10 @@ vector<tuple<Territory *, Territory *, string>> AggressivePlayerStrategy::toDefe
     tempHand = {{0,0},{1,0},{2,0},{3,0},{4,0}};
     //Counts the number of cards for each type
     for(Card *card: *player->getHand()->getHandsCards()){
-        tempHand[*card->getType()] += 1;
+        tempHand[card->getType()] += 1;
     }
     //Find strongest territory
-    Territory* strongestTerritory = player->getTerritories()->at(0);
-    for (Territory* terr : *player->getTerritories()) {
-        if (terr->getNumberOfArmies() > strongestTerritory->getNumberOfArmies() && !checkIfAllNeighborsBelongToSamePlayer(terr)) {
-            strongestTerritory = terr;
-        }
-    }
+    Territory* strongestTerritory = findStrongestTerritory(player);
     //Deploy all of reinforcement pool on strongest territory
     if (!player->getTerritories()->empty()) {
         toDefend.emplace_back(strongestTerritory, strongestTerritory, "deploy");
@@ -579,7 +604,7 @@ vector<tuple<Territory *, Territory *, string>> AggressivePlayerStrategy::toDefe
                 break;
             }
         }
-        if (tempHand[3] > 0 && !addedAdvanceOrder && territory->getNumberOfArmies() > 2 && territory != strongestTerritory) {
+        if (tempHand[3] > 0 && !addedAdvanceOrder && territory->getNumberOfArmies() >= parameters.get(StrategyParameters::airliftMinArmies) && territory != strongestTerritory) {
             toDefend.emplace_back(territory, strongestTerritory,"airlift");
             tempHand[3]--;
         }
@@ -597,6 +622,43 @@ bool AggressivePlayerStrategy::checkIfAllNeighborsBelongToSamePlayer(Territory*
     return true;
 }
 
+//Finds the territory with the most armies which is not surrounded by the player's territories. Ties go to the territory
+//on the continent with the fewest territories left for the player to take, which the continent graph of the map gives
+//without looking at the other territories.
+Territory* AggressivePlayerStrategy::findStrongestTerritory(Player* player) {
+    Territory* strongestTerritory = player->getTerritories()->at(0);
+    Map* map = strongestTerritory->getMap();
+    if (map == nullptr) {
+        for (Territory* terr : *player->getTerritories()) {
+            if (terr->getNumberOfArmies() > strongestTerritory->getNumberOfArmies() && !checkIfAllNeighborsBelongToSamePlayer(terr)) {
+                strongestTerritory = terr;
+            }
+        }
+        return strongestTerritory;
+    }
+
+    //Number of territories the player is missing on each continent, with the continents it owns last
+    const ContinentGraph& continents = map->getContinentGraph();
+    vector<int> missingTerritories(continents.getNumberOfContinents() + 1, INT_MAX);
+    for (int id = 1; id <= continents.getNumberOfContinents(); id++) {
+        int missing = continents.getSize(id) - continents.getOwnedCount(id, player);
+        if (missing > 0) {
+            missingTerritories[id] = missing;
+        }
+    }
+
+    for (Territory* terr : *player->getTerritories()) {
+        int armies = terr->getNumberOfArmies();
+        int strongestArmies = strongestTerritory->getNumberOfArmies();
+        bool isCloserToContinent = armies == strongestArmies && terr != strongestTerritory &&
+                missingTerritories[terr->getContinentId()] < missingTerritories[strongestTerritory->getContinentId()];
+        if ((armies > strongestArmies || isCloserToContinent) && !checkIfAllNeighborsBelongToSamePlayer(terr)) {
+            strongestTerritory = terr;
+        }
+    }
+    return strongestTerritory;
+}
+
 /**
 * Benevolent strategy player
 */
@@ -627,27 +689,24 @@ bool BenevolentPlayerStrategy::checkIfAllNeighborsBelongToSamePlayer(Territory*
     return true;
 }
 
-void BenevolentPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
+void BenevolentPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
     cout << "Issuing order from Benevolent Player Strategy" << endl;
     if (get<2>(*orderInfo) == "deploy") {
-        int reinforcementPool = *player->getReinforcementPool();
+        int reinforcementPool = player->getReinforcementPool();
         Order *deploy = new Deploy(*player, *get<0>(*orderInfo), reinforcementPool/2);
         player->getOrdersList()->addOrder(deploy);
-        cout << "**issueOrder Deploy | Player: " << *player->getPName() << " | Target territory: " << get<0>(*orderInfo)->getName() << " | Armies: " << reinforcementPool << endl;
-        log.AddSubject(*deploy);
+        cout << "**issueOrder Deploy | Player: " << player->getPName() << " | Target territory: " << get<0>(*orderInfo)->getName() << " | Armies: " << reinforcementPool << endl;
     }
     //Defend Advance
     else if (get<2>(*orderInfo) == "advance" && get<0>(*orderInfo)->getOwner() == get<1>(*orderInfo)->getOwner() && get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
         Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo),get<0>(*orderInfo)->getNumberOfArmies()/2);
         player->getOrdersList()->addOrder(advance);
-        cout << "**issueOrder Advance | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
-        log.AddSubject(*advance);
+        cout << "**issueOrder Advance | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
     }
     else if (get<2>(*orderInfo) == "airlift" && get<0>(*orderInfo)->getNumberOfArmies() >= 2) {
         Order *airlift = new Airlift(*player, *get<0>(*orderInfo), *get<1>(*orderInfo), get<0>(*orderInfo)->getNumberOfArmies()/2);
-        cout << "**issueOrder Airlift | Player: " << *player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
+        cout << "**issueOrder Airlift | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << get<0>(*orderInfo)->getNumberOfArmies() - 1 << endl;
         player->getOrdersList()->addOrder(airlift);
-        log.AddSubject(*airlift);
     }
 }
 
@@ -668,7 +727,7 @@ vector<tuple<Territory *, Territory *, string>> BenevolentPlayerStrategy::toDefe
     tempHand = {{0,0},{1,0},{2,0},{3,0},{4,0}};
     //Counts the number of cards for each type
     for(Card *card: *player->getHand()->getHandsCards()){
-        tempHand[*card->getType()] += 1;
+        tempHand[card->getType()] += 1;
     }
     //Find weakest territory
     Territory* weakestTerritory = player->getTerritories()->at(0);
@@ -720,7 +779,7 @@ PlayerStrategy *NeutralPlayerStrategy::clone() const {
     return new NeutralPlayerStrategy(*this);
 }
 
-void NeutralPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
+void NeutralPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
     cout << "Issuing order from Neutral Player Strategy" << endl;
     cout << "Neutral player does not issue any orders!" << endl;
 }
@@ -760,7 +819,7 @@ PlayerStrategy *CheaterPlayerStrategy::clone() const {
     return new CheaterPlayerStrategy(*this);
 }
 
-void CheaterPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) {
+void CheaterPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
     cout << "Issuing order from Cheater Player Strategy..." << endl;
     cout << "The cheater player never issues an order. No matter the given order, he just conquers everything !" << endl;
 }
@@ -784,4 +843,323 @@ vector<tuple<Territory *, Territory *, string>> CheaterPlayerStrategy::toDefend(
     cout << "Cheater player never defends his territory, he just conquers territory, I'm a cheater..." << endl;
     vector<tuple<Territory *, Territory *, string>> toDefend{};
     return toDefend;
-}
\ No newline at end of file
+}
+
+/**
+* Monte Carlo strategy player
+*/
+
+namespace {
+    // A candidate plan of the Monte Carlo player: the territory receiving the whole reinforcement pool, then the
+    // attacks (source ID, target ID) made with every army but one of their source.
+    struct MonteCarloCandidate {
+        int deployTarget;
+        vector<pair<int, int>> attacks;
+    };
+
+    // Returns the weakest neighbour of a territory that can be attacked by the given player, or 0 if there is none.
+    int weakestEnemyNeighbour(const GameState &state, const MapTopology &topology, int territoryId, int playerIndex) {
+        int weakest = 0;
+        for (const int *it = topology.neighboursBegin(territoryId); it != topology.neighboursEnd(territoryId); it++) {
+            int owner = state.getOwner(*it);
+            if (owner == playerIndex || (owner >= 0 && state.areFriends(playerIndex, owner))) {
+                continue;
+            }
+            if (weakest == 0 || state.getArmies(*it) < state.getArmies(weakest)) {
+                weakest = *it;
+            }
+        }
+        return weakest;
+    }
+
+    // Builds the candidate plans: for each of the strongest border territories, deploy there and either hold, attack
+    // its weakest enemy neighbour, or also attack from every other territory that outnumbers its weakest neighbour.
+    vector<MonteCarloCandidate> buildCandidates(const GameState &state, const MapTopology &topology,
+                                                const RolloutSimulator &simulator, int playerIndex,
+                                                int maxDeployTargets) {
+        vector<int> borders;
+        for (int id = 1; id <= state.getNumberOfTerritories(); id++) {
+            if (state.getOwner(id) == playerIndex && simulator.isBorder(state, id)) {
+                borders.push_back(id);
+            }
+        }
+        std::stable_sort(borders.begin(), borders.end(), [&state](int first, int second) {
+            return state.getArmies(first) > state.getArmies(second);
+        });
+        if (borders.size() > static_cast<size_t>(maxDeployTargets)) {
+            borders.resize(maxDeployTargets);
+        }
+
+        vector<MonteCarloCandidate> candidates;
+        for (int deployTarget: borders) {
+            candidates.push_back({deployTarget, {}});
+
+            int weakest = weakestEnemyNeighbour(state, topology, deployTarget, playerIndex);
+            if (weakest == 0) {
+                continue;
+            }
+            candidates.push_back({deployTarget, {{deployTarget, weakest}}});
+
+            MonteCarloCandidate allOut{deployTarget, {{deployTarget, weakest}}};
+            for (int id = 1; id <= state.getNumberOfTerritories(); id++) {
+                if (id == deployTarget || state.getOwner(id) != playerIndex) {
+                    continue;
+                }
+                int target = weakestEnemyNeighbour(state, topology, id, playerIndex);
+                bool alreadyTargeted = std::any_of(allOut.attacks.begin(), allOut.attacks.end(),
+                                                   [target](const pair<int, int> &attack) {
+                                                       return attack.second == target;
+                                                   });
+                if (target != 0 && !alreadyTargeted && state.getArmies(id) - 1 > state.getArmies(target)) {
+                    allOut.attacks.emplace_back(id, target);
+                }
+            }
+            if (allOut.attacks.size() > 1) {
+                candidates.push_back(allOut);
+            }
+        }
+        return candidates;
+    }
+
+    // Plays a candidate plan on a state: deploy the whole pool, then resolve the attacks that are still possible.
+    void applyCandidate(GameState &state, const RolloutSimulator &simulator, int playerIndex,
+                        const MonteCarloCandidate &candidate) {
+        state.setArmies(candidate.deployTarget,
+                        state.getArmies(candidate.deployTarget) + state.getReinforcementPool(playerIndex));
+        state.setReinforcementPool(playerIndex, 0);
+
+        for (const pair<int, int> &attack: candidate.attacks) {
+            if (state.getOwner(attack.first) == playerIndex && state.getOwner(attack.second) != playerIndex &&
+                state.getArmies(attack.first) > 1) {
+                simulator.resolveBattle(state, playerIndex, attack.first, attack.second,
+                                        state.getArmies(attack.first) - 1);
+            }
+        }
+    }
+
+    // Returns the policy used to roll out a player, from the name of its strategy.
+    RolloutPolicy rolloutPolicyOf(Player *player) {
+        string strategy = player->getPlayerStrategy()->printStrategy();
+        if (strategy == "neutral strategy" || strategy == "benevolent strategy") {
+            return RolloutPolicy::passive;
+        }
+        if (strategy == "cheater strategy") {
+            return RolloutPolicy::cheater;
+        }
+        return RolloutPolicy::aggressive;
+    }
+}
+
+// Default constructor
+MonteCarloPlayerStrategy::MonteCarloPlayerStrategy() : MonteCarloPlayerStrategy(64, 200, 3) {}
+
+// Constructor which takes the number of simulations, the time budget of a turn, the depth of the rollouts and the
+// number of deploy targets of the candidate plans
+MonteCarloPlayerStrategy::MonteCarloPlayerStrategy(int simulations, int timeBudgetMs, int rolloutDepth,
+                                                   int deployTargets)
+        : simulations(simulations), timeBudgetMs(timeBudgetMs), rolloutDepth(rolloutDepth),
+          deployTargets(deployTargets), plannedDeployTarget(nullptr) {}
+
+// Creates a Monte Carlo strategy from its name, with the values given after "montecarlo", separated by colons. Every
+// value must be a positive number.
+MonteCarloPlayerStrategy *MonteCarloPlayerStrategy::fromName(const string &name) {
+    const string PREFIX = "montecarlo";
+    if (name.compare(0, PREFIX.size(), PREFIX) != 0 || (name.size() > PREFIX.size() && name[PREFIX.size()] != ':')) {
+        return nullptr;
+    }
+
+    MonteCarloPlayerStrategy defaults;
+    int values[] = {defaults.simulations, defaults.timeBudgetMs, defaults.rolloutDepth, defaults.deployTargets};
+    size_t numValues = 0;
+    size_t position = PREFIX.size();
+    while (position < name.size()) {
+        if (numValues == std::size(values)) {
+            return nullptr;
+        }
+        const char *first = name.data() + position + 1;
+        const char *last = name.data() + name.size();
+        int value = 0;
+        auto [end, error] = std::from_chars(first, last, value);
+        if (error != std::errc() || end == first || value < 1 || (end != last && *end != ':')) {
+            return nullptr;
+        }
+        values[numValues++] = value;
+        position = end - name.data();
+    }
+    return new MonteCarloPlayerStrategy(values[0], values[1], values[2], values[3]);
+}
+
+// Default destructor
+MonteCarloPlayerStrategy::~MonteCarloPlayerStrategy() {}
+
+// Print the strategy
+string MonteCarloPlayerStrategy::printStrategy() {
+    string strategy = "montecarlo strategy";
+    return strategy;
+}
+
+// clone a Monte Carlo Player Strategy
+PlayerStrategy *MonteCarloPlayerStrategy::clone() const {
+    return new MonteCarloPlayerStrategy(*this);
+}
+
+// Forgets the plan of the previous turn
+void MonteCarloPlayerStrategy::clearPlan() {
+    plannedDeployTarget = nullptr;
+    plannedAttacks.clear();
+    plannedAttackArmies.clear();
+}
+
+// Getter for the number of simulations
+int MonteCarloPlayerStrategy::getSimulations() const {
+    return simulations;
+}
+
+// Getter for the time budget of a turn in milliseconds
+int MonteCarloPlayerStrategy::getTimeBudgetMs() const {
+    return timeBudgetMs;
+}
+
+// Getter for the depth of the rollouts
+int MonteCarloPlayerStrategy::getRolloutDepth() const {
+    return rolloutDepth;
+}
+
+// Getter for the number of deploy targets of the candidate plans
+int MonteCarloPlayerStrategy::getDeployTargets() const {
+    return deployTargets;
+}
+
+void MonteCarloPlayerStrategy::issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) {
+    cout << "Issuing order from Monte Carlo Player Strategy" << endl;
+    if (get<2>(*orderInfo) == "deploy") {
+        int reinforcementPool = player->getReinforcementPool();
+        Order *deploy = new Deploy(*player, *get<0>(*orderInfo), reinforcementPool);
+        player->getOrdersList()->addOrder(deploy);
+        cout << "**issueOrder Deploy | Player: " << player->getPName() << " | Target territory: " << get<0>(*orderInfo)->getName() << " | Armies: " << reinforcementPool << endl;
+        player->decreasePool(reinforcementPool);
+    }
+    else if (get<2>(*orderInfo) == "advance") {
+        auto plannedArmies = plannedAttackArmies.find(get<1>(*orderInfo));
+        if (plannedArmies == plannedAttackArmies.end() || plannedArmies->second < 1) {
+            cout << "Cannot issue Advance order to territory " << get<1>(*orderInfo)->getName() << " because it is not part of the plan of this turn" << endl;
+            return;
+        }
+        Order *advance = new Advance(*player, *get<0>(*orderInfo), *get<1>(*orderInfo), plannedArmies->second);
+        player->getOrdersList()->addOrder(advance);
+        cout << "**issueOrder Advance | Player: " << player->getPName() << " | Source territory: " << get<0>(*orderInfo)->getName() << " | Target territory: " << get<1>(*orderInfo)->getName() << " | Armies: " << plannedArmies->second << endl;
+    }
+    else {
+        cout << "A Monte Carlo Player does not do " << get<2>(*orderInfo) << " order. It does Deploy and Advance" << endl;
+    }
+}
+
+vector<tuple<Territory *, Territory *, string>> MonteCarloPlayerStrategy::toAttack(Player *) {
+    cout << "toAttack method from Monte Carlo Player Strategy" << endl;
+    return plannedAttacks;
+}
+
+vector<tuple<Territory *, Territory *, string>> MonteCarloPlayerStrategy::toDefend(Player *player) {
+    cout << "toDefend method from Monte Carlo Player Strategy" << endl;
+    vector<tuple<Territory *, Territory *, string>> toDefend;
+    clearPlan();
+    if (player->getTerritories()->empty())
+        return toDefend;
+
+    // Without a running game to roll out, fall back to deploying on the first territory
+    GameEngine *engine = GameEngine::getActiveEngine();
+    if (engine == nullptr) {
+        plannedDeployTarget = player->getTerritories()->at(0);
+        toDefend.emplace_back(plannedDeployTarget, plannedDeployTarget, "deploy");
+        return toDefend;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs);
+
+    GameState root(*engine);
+    // Tournament games share the topology of their map; other games extract it from the board
+    shared_ptr<const MapTopology> topology = engine->getMapTopology();
+    if (topology == nullptr) {
+        topology = make_shared<const MapTopology>(*engine->getMap());
+    }
+    int playerIndex = root.getPlayerIndex(player);
+
+    vector<RolloutPolicy> policies;
+    for (int i = 0; i < root.getNumberOfPlayers(); i++) {
+        policies.push_back(rolloutPolicyOf(root.getPlayer(i)));
+    }
+    const RolloutSimulator simulator(*topology, policies);
+
+    vector<MonteCarloCandidate> candidates = buildCandidates(root, *topology, simulator, playerIndex, deployTargets);
+    if (candidates.empty()) {
+        plannedDeployTarget = player->getTerritories()->at(0);
+        toDefend.emplace_back(plannedDeployTarget, plannedDeployTarget, "deploy");
+        return toDefend;
+    }
+
+    // Every candidate gets its own task and its own state buffer, which is forked from the root before each rollout.
+    // The seed of a rollout only depends on the root and on the rollout itself, so the result does not depend on the
+    // number of threads. Each candidate is rolled out at least once, even when the deadline has already passed.
+    int rolloutsPerCandidate = std::max(1, simulations / static_cast<int>(candidates.size()));
+    uint64_t rootSeed = root.getRandom().getState();
+    int numTerritories = root.getNumberOfTerritories();
+    int numPlayers = root.getNumberOfPlayers();
+    int depth = rolloutDepth;
+
+    ThreadPool &pool = ThreadPool::shared();
+    vector<std::future<pair<double, int>>> results;
+    for (size_t c = 0; c < candidates.size(); c++) {
+        const MonteCarloCandidate &candidate = candidates[c];
+        results.push_back(pool.submit([&root, &simulator, &candidate, c, playerIndex, rolloutsPerCandidate, rootSeed,
+                                       numTerritories, numPlayers, depth, deadline]() {
+            GameState rollout(numTerritories, numPlayers, 0, 0);
+            double totalScore = 0.0;
+            int rollouts = 0;
+            for (int r = 0; r < rolloutsPerCandidate; r++) {
+                if (r > 0 && std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+                root.forkInto(rollout);
+                rollout.getRandom().setState(rootSeed ^ (static_cast<uint64_t>(c + 1) << 32) ^ static_cast<uint64_t>(r + 1));
+                applyCandidate(rollout, simulator, playerIndex, candidate);
+                simulator.playTurns(rollout, playerIndex, depth);
+                totalScore += simulator.evaluate(rollout, playerIndex);
+                rollouts++;
+            }
+            return pair<double, int>(totalScore, rollouts);
+        }));
+    }
+
+    size_t bestCandidate = 0;
+    double bestScore = -1.0;
+    int totalRollouts = 0;
+    for (size_t c = 0; c < results.size(); c++) {
+        pair<double, int> result = pool.await(results[c]);
+        double meanScore = result.first / result.second;
+        totalRollouts += result.second;
+        if (meanScore > bestScore) {
+            bestScore = meanScore;
+            bestCandidate = c;
+        }
+    }
+
+    // Turn the chosen plan back into territories and armies
+    Map *map = engine->getMap();
+    const MonteCarloCandidate &chosen = candidates[bestCandidate];
+    int reinforcementPool = player->getReinforcementPool();
+    plannedDeployTarget = map->getTerritoryByID(chosen.deployTarget);
+    for (const pair<int, int> &attack: chosen.attacks) {
+        Territory *source = map->getTerritoryByID(attack.first);
+        Territory *target = map->getTerritoryByID(attack.second);
+        int armies = source->getNumberOfArmies() - 1 + (source == plannedDeployTarget ? reinforcementPool : 0);
+        plannedAttacks.emplace_back(source, target, "advance");
+        plannedAttackArmies[target] = armies;
+    }
+
+    cout << "Monte Carlo plan for " << player->getPName() << ": deploy on " << plannedDeployTarget->getName()
+         << " and attack " << plannedAttacks.size() << " territories | Expected score: " << bestScore
+         << " | Candidates: " << candidates.size() << " | Rollouts: " << totalRollouts << endl;
+
+    toDefend.emplace_back(plannedDeployTarget, plannedDeployTarget, "deploy");
+    return toDefend;
+}
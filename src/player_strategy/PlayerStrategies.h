@@ -1,6 +1,10 @@
 #pragma once
 
 #include "orders/orders.h"
+#include "concurrency/task.h"
+#include "command_processor/input_channel.h"
+#include "player_strategy/strategy_parameters.h"
+#include <map>
 
 class Territory;
 class Order;
@@ -11,8 +15,8 @@ public:
     // Default constructor
     PlayerStrategy();
 
-    // Default destructor
-    ~PlayerStrategy();
+    // Virtual destructor, since players delete their strategies through this class
+    virtual ~PlayerStrategy();
 
     // clones a PlayerStrategy clone
     [[nodiscard]] virtual PlayerStrategy *clone() const = 0;
@@ -21,7 +25,7 @@ public:
      * Method that takes an Order parameter will issue an order depending on the chosen player strategy
      * @param order the order to be issued
      */
-    virtual void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) = 0;
+    virtual void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) = 0;
 
     /**
      * Method that takes none arguments, attacks a territory and returns nothing
@@ -40,6 +44,16 @@ public:
      * @return
      */
      virtual string printStrategy() = 0;
+
+    /**
+     * The same decisions as issueOrder, toAttack and toDefend, for a game which may have to wait for its user to answer.
+     * The coroutines read the answers from the given input, and suspend until they arrive. A strategy which asks
+     * nothing decides right away, with the methods above.
+     */
+    virtual Task<void> issueOrderAsync(Player *player, tuple<Territory *, Territory *, string> *orderInfo,
+                                       InputChannel &input);
+    virtual Task<vector<tuple<Territory *, Territory *, string>>> toAttackAsync(Player *player, InputChannel &input);
+    virtual Task<vector<tuple<Territory *, Territory *, string>>> toDefendAsync(Player *player, InputChannel &input);
 };
 
 class HumanPlayerStrategy : public PlayerStrategy {
@@ -58,16 +72,27 @@ public:
     string printStrategy() override;
 
     // issueOrder method for the human player type
-    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver &log) override;
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
 
     // toAttack method for the human player
     vector<tuple<Territory *, Territory *, string>> toAttack(Player *player) override;
 
-    // toDefend method for the cheater player
+    // toDefend method for the human player
     vector<tuple<Territory *, Territory *, string>> toDefend(Player *player) override;
 
+    // The decisions of the human player, asked on the given input. The methods above ask them on the console.
+    Task<void> issueOrderAsync(Player *player, tuple<Territory *, Territory *, string> *orderInfo,
+                               InputChannel &input) override;
+    Task<vector<tuple<Territory *, Territory *, string>>> toAttackAsync(Player *player, InputChannel &input) override;
+    Task<vector<tuple<Territory *, Territory *, string>>> toDefendAsync(Player *player, InputChannel &input) override;
+
+    // Finds the territories the user chose: the source by its index in the player's territories, and the target by its
+    // index ("5") or as a neighbour of one of them ("2-5"). Returns false if they do not exist.
+    static bool findTerritories(Player *player, int sourceIndex, const string &targetInput, Territory *&source,
+                                Territory *&target);
+
     // Prints all the player's territories
-    static void printPlayerTerritories(const Player *player);
+    static void printPlayerTerritories(const Player *player, ostream &out = cout);
 };
 
 class AggressivePlayerStrategy : public PlayerStrategy {
@@ -75,10 +100,19 @@ private:
     // clones a AggressivePlayerStrategy clone
     [[nodiscard]] PlayerStrategy *clone() const override;
 
+    // The constants the decisions of the aggressive player depend on (see StrategyParameters).
+    StrategyParameters parameters;
+
 public:
-    // Default constructor
+    // Default constructor, with the default parameters
     AggressivePlayerStrategy();
 
+    // One param constructor which takes the parameters of the strategy
+    explicit AggressivePlayerStrategy(const StrategyParameters &parameters);
+
+    // Getter for the parameters of the strategy
+    [[nodiscard]] const StrategyParameters &getParameters() const;
+
     // Destructor
     ~AggressivePlayerStrategy();
 
@@ -86,7 +120,7 @@ public:
     string printStrategy() override;
 
     // issueOrder method for the aggressive player type
-    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) override;
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
 
     // toAttack method for the aggressive player
     vector<tuple<Territory*,Territory*,string>> toAttack(Player* player) override;
@@ -96,6 +130,10 @@ public:
 
     //Checks if all neighbors of a territory belong to the same player (owner)
     bool checkIfAllNeighborsBelongToSamePlayer(Territory* terr);
+
+    //Finds the territory with the most armies which is not surrounded by the player's territories. Among equally strong
+    //territories, prefers the one on the continent the player is closest to owning.
+    Territory* findStrongestTerritory(Player* player);
 };
 
 class BenevolentPlayerStrategy : public PlayerStrategy {
@@ -114,7 +152,7 @@ public:
     string printStrategy() override;
 
     // issueOrder method for the benevolent player type
-    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) override;
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
 
     // toAttack method for the benevolent player
     vector<tuple<Territory*,Territory*,string>> toAttack(Player* player) override;
@@ -142,7 +180,7 @@ public:
     string printStrategy() override;
 
     // issueOrder method for the neutral player type
-    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) override;
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
 
     // toAttack method for the neutral player
     vector<tuple<Territory*,Territory*,string>> toAttack(Player* player) override;
@@ -167,7 +205,7 @@ public:
     string printStrategy() override;
 
     // issueOrder method for the cheater player type
-    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo, LogObserver& log) override;
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
 
     // toAttack method for the cheater player
     vector<tuple<Territory*,Territory*,string>> toAttack(Player* player) override;
@@ -177,3 +215,69 @@ public:
 };
 
 
+class MonteCarloPlayerStrategy : public PlayerStrategy {
+private:
+    // The number of rollouts played for each turn, spread over the candidate plans.
+    int simulations;
+
+    // The time budget of a turn in milliseconds. No new rollout is started once it is spent.
+    int timeBudgetMs;
+
+    // The number of full turns played in each rollout after the candidate plan.
+    int rolloutDepth;
+
+    // The number of strongest border territories a candidate plan deploys on (each gives up to three candidates).
+    int deployTargets;
+
+    // The plan chosen in toDefend: where the reinforcements go, and the attacks with the armies they should use.
+    Territory *plannedDeployTarget;
+    vector<tuple<Territory *, Territory *, string>> plannedAttacks;
+    std::map<Territory *, int> plannedAttackArmies;
+
+    // clones a MonteCarloPlayerStrategy clone
+    [[nodiscard]] PlayerStrategy *clone() const override;
+
+    // Forgets the plan of the previous turn
+    void clearPlan();
+
+public:
+    // Default constructor
+    MonteCarloPlayerStrategy();
+
+    // Constructor which takes the number of simulations, the time budget of a turn, the depth of the rollouts and the
+    // number of deploy targets of the candidate plans
+    MonteCarloPlayerStrategy(int simulations, int timeBudgetMs, int rolloutDepth, int deployTargets = 4);
+
+    // Creates a Monte Carlo strategy from its name in a tournament or an addplayer command:
+    // "montecarlo[:<simulations>[:<time budget in ms>[:<rollout depth>[:<deploy targets>]]]]", the values left out
+    // keeping their default. Returns nullptr if the name is not of this form.
+    static MonteCarloPlayerStrategy *fromName(const string &name);
+
+    // Destructor
+    ~MonteCarloPlayerStrategy();
+
+    // Output operator
+    string printStrategy() override;
+
+    // issueOrder method for the monte carlo player type
+    void issueOrder(Player *player, tuple<Territory *, Territory *, string> *orderInfo) override;
+
+    // toAttack method for the monte carlo player, returns the attacks of the plan chosen in toDefend
+    vector<tuple<Territory *, Territory *, string>> toAttack(Player *player) override;
+
+    // toDefend method for the monte carlo player, rolls out the candidate plans and keeps the best one
+    vector<tuple<Territory *, Territory *, string>> toDefend(Player *player) override;
+
+    // Getter for the number of simulations
+    [[nodiscard]] int getSimulations() const;
+
+    // Getter for the time budget of a turn in milliseconds
+    [[nodiscard]] int getTimeBudgetMs() const;
+
+    // Getter for the depth of the rollouts
+    [[nodiscard]] int getRolloutDepth() const;
+
+    // Getter for the number of deploy targets of the candidate plans
+    [[nodiscard]] int getDeployTargets() const;
+};
+
@@ -0,0 +1,154 @@
+#include "strategy_parameters.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+// The implementation file of the StrategyParameters class.
+
+namespace {
+    // The named parameter sets, and the last file they were loaded from.
+    std::map<string, StrategyParameters> namedSets;
+    string loadedPath;
+    mutex namedSetsMutex;
+
+    // The names of the strategies a parameter set cannot take.
+    const string BUILT_IN_STRATEGIES[] = {"human", "aggressive", "benevolent", "neutral", "cheater", "montecarlo"};
+
+    // Checks that a name can be used for a parameter set: it is a single word, it does not split a list of strategies
+    // or the settings of a strategy, and it is not the name of a strategy.
+    bool isValidName(const string &name) {
+        if (name.empty() || name.find_first_of(",: \t") != string::npos) {
+            return false;
+        }
+        return std::find(begin(BUILT_IN_STRATEGIES), end(BUILT_IN_STRATEGIES), name) == end(BUILT_IN_STRATEGIES);
+    }
+}
+
+// Default constructor which gives every parameter its default value.
+StrategyParameters::StrategyParameters() : values() {
+    for (size_t i = 0; i < NUM_PARAMETERS; i++) {
+        values[i] = SPECS[i].defaultValue;
+    }
+}
+
+// Getter for a parameter.
+double StrategyParameters::get(Parameter parameter) const {
+    return values[parameter];
+}
+
+// Setter for a parameter, kept in the range of its spec.
+void StrategyParameters::set(Parameter parameter, double value) {
+    const ParameterSpec &spec = SPECS[parameter];
+    value = std::clamp(value, spec.minValue, spec.maxValue);
+    values[parameter] = spec.isInteger ? std::round(value) : value;
+}
+
+// Returns the parameters as "name=value" pairs separated by spaces.
+string StrategyParameters::toString() const {
+    ostringstream text;
+    for (size_t i = 0; i < NUM_PARAMETERS; i++) {
+        text << (i == 0 ? "" : " ") << SPECS[i].name << "=" << values[i];
+    }
+    return text.str();
+}
+
+// Sets the parameters given as "name=value" pairs separated by spaces.
+bool StrategyParameters::parse(const string &text) {
+    istringstream stream(text);
+    for (string pair; stream >> pair;) {
+        size_t equals = pair.find('=');
+        if (equals == string::npos) {
+            return false;
+        }
+        string_view name = string_view(pair).substr(0, equals);
+        auto spec = std::find_if(begin(SPECS), end(SPECS), [&](const ParameterSpec &s) { return s.name == name; });
+        if (spec == end(SPECS)) {
+            return false;
+        }
+        try {
+            set(static_cast<Parameter>(spec - begin(SPECS)), stod(pair.substr(equals + 1)));
+        } catch (exception &e) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Gives a name to a parameter set.
+void StrategyParameters::define(const string &name, const StrategyParameters &parameters) {
+    lock_guard<mutex> lock(namedSetsMutex);
+    namedSets[name] = parameters;
+}
+
+// Finds the parameter set with the given name.
+bool StrategyParameters::find(const string &name, StrategyParameters &parameters) {
+    lock_guard<mutex> lock(namedSetsMutex);
+    auto namedSet = namedSets.find(name);
+    if (namedSet == namedSets.end()) {
+        return false;
+    }
+    parameters = namedSet->second;
+    return true;
+}
+
+// Reads the named parameter sets of a file and defines them.
+bool StrategyParameters::load(const string &path) {
+    ifstream file(path);
+    if (!file) {
+        cerr << "Error: Cannot read the strategy parameters file " << path << endl;
+        return false;
+    }
+
+    vector<pair<string, StrategyParameters>> sets;
+    string line;
+    for (int lineNumber = 1; getline(file, line); lineNumber++) {
+        line = line.substr(0, line.find('#'));
+        istringstream stream(line);
+        string name;
+        string strategy;
+        if (!(stream >> name)) {
+            continue;
+        }
+
+        StrategyParameters parameters;
+        string rest;
+        getline(stream >> strategy, rest);
+        if (!isValidName(name) || strategy != "aggressive" || !parameters.parse(rest)) {
+            cerr << "Error: Invalid parameter set at line " << lineNumber << " of " << path
+                 << ", expected \"<name> aggressive <parameter>=<value> ...\"" << endl;
+            return false;
+        }
+        sets.emplace_back(name, parameters);
+    }
+
+    lock_guard<mutex> lock(namedSetsMutex);
+    for (const auto &[name, parameters]: sets) {
+        namedSets[name] = parameters;
+    }
+    loadedPath = path;
+    return true;
+}
+
+// Getter for the path of the last file loaded.
+string StrategyParameters::getLoadedPath() {
+    lock_guard<mutex> lock(namedSetsMutex);
+    return loadedPath;
+}
+
+// Writes named parameter sets to a file, each preceded by its comment.
+bool StrategyParameters::save(const string &path, const vector<pair<string, StrategyParameters>> &sets,
+                              const vector<string> &comments) {
+    ofstream file(path);
+    for (size_t i = 0; i < sets.size(); i++) {
+        if (i < comments.size()) {
+            file << "# " << comments[i] << "\n";
+        }
+        file << sets[i].first << " aggressive " << sets[i].second.toString() << "\n";
+    }
+    file.flush();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// One tunable constant of a strategy: its name, its default value and the range searched by the strategy tuner.
+struct ParameterSpec {
+    string_view name;
+    double defaultValue;
+    double minValue;
+    double maxValue;
+    bool isInteger;
+};
+
+// The constants driving the decisions of the aggressive strategy. The default values are the ones the strategy always
+// used, so a strategy built without parameters plays as before.
+//
+// Parameter sets can be given a name, and a tournament can then use that name as a player strategy (see
+// "-strategies <file>", and the strategy tuner which writes such files). A file of parameter sets has one set per
+// line, with '#' starting a comment:
+//
+//     <name> aggressive minWinProbability=0.45 targetWinProbability=0.85 airliftMinArmies=4 bombArmyRatio=1.2
+//
+// where the parameters not given keep their default value.
+class StrategyParameters {
+public:
+    // The parameters, indexing SPECS.
+    enum Parameter : size_t {
+        // The aggressive player attacks a territory it captures at least this often with every army it has there...
+        minWinProbability,
+        // ...and sends the fewest armies that capture it at least this often when it can spare them.
+        targetWinProbability,
+        // The fewest armies a territory must have for the aggressive player to airlift them to its strongest territory.
+        airliftMinArmies,
+        // The aggressive player bombs a neighbour of its strongest territory with more than this many times its armies.
+        bombArmyRatio
+    };
+
+    static constexpr size_t NUM_PARAMETERS = 4;
+
+    static constexpr ParameterSpec SPECS[NUM_PARAMETERS] = {
+            {"minWinProbability", 0.5, 0.05, 0.95, false},
+            {"targetWinProbability", 0.9, 0.5, 0.99, false},
+            {"airliftMinArmies", 3, 2, 20, true},
+            {"bombArmyRatio", 1, 0.25, 4, false}
+    };
+
+private:
+    array<double, NUM_PARAMETERS> values;
+
+public:
+    // Default constructor which gives every parameter its default value.
+    StrategyParameters();
+
+    // Getter for a parameter.
+    [[nodiscard]] double get(Parameter parameter) const;
+
+    // Setter for a parameter, which keeps it in the range of its spec (and rounds it if it is an integer).
+    void set(Parameter parameter, double value);
+
+    // Returns the parameters as "name=value" pairs separated by spaces.
+    [[nodiscard]] string toString() const;
+
+    // Sets the parameters given as "name=value" pairs separated by spaces. Returns false if a pair is invalid.
+    bool parse(const string &text);
+
+    // Gives a name to a parameter set, replacing the set already named so. Safe to call from any thread.
+    static void define(const string &name, const StrategyParameters &parameters);
+
+    // Finds the parameter set with the given name. Returns false if there is none.
+    static bool find(const string &name, StrategyParameters &parameters);
+
+    // Reads the named parameter sets of a file and defines them. Returns false (with the reason on cerr) if the file
+    // cannot be read or a line is invalid.
+    static bool load(const string &path);
+
+    // Getter for the path of the last file loaded (empty if none was).
+    static string getLoadedPath();
+
+    // Writes named parameter sets to a file, each preceded by a comment. Returns false if it cannot be written.
+    static bool save(const string &path, const vector<pair<string, StrategyParameters>> &namedSets,
+                     const vector<string> &comments);
+};
@@ -0,0 +1,441 @@
+#include "game_server.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "game_engine/game_engine.h"
+#include "game_log/indexed_log.h"
+
+// The implementation file of the GameServer class.
+
+namespace {
+    // The epoll ids of the listening socket and of the eventfd. Sessions use the ids after them.
+    constexpr uint64_t LISTENER_ID = 0;
+    constexpr uint64_t WAKE_ID = 1;
+
+    // The number of events handled per call to epoll_wait, and how long a call waits for one (so that a stop request
+    // is seen even when nothing happens).
+    constexpr int MAX_EVENTS = 64;
+    constexpr int WAIT_MS = 200;
+
+    // A stream buffer dropping everything written to it. The engines print their progress to cout, which would be
+    // unreadable with many games at once, so the server silences it.
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override {
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char *, std::streamsize count) override {
+            return count;
+        }
+    };
+
+    // Makes a file descriptor non-blocking.
+    bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    // Plays a session: runs the commands of the client until the game ends with quit, replying to each one.
+    Task<void> playSession(GameEngine &engine, InputChannel &input) {
+        while (engine.getCurrentState() != EngineState::end) {
+            std::string line = co_await input.nextLine();
+
+            std::string result;
+            bool isValid = false;
+            try {
+                isValid = co_await engine.runCommand(line, result);
+            } catch (std::exception &exp) {
+                result = std::string("The command failed: ") + exp.what();
+            }
+            input.prompts() << (isValid ? "OK " : "ERROR ") << engine.getCurrentStateName() << " | " << result << "\n";
+        }
+    }
+}
+
+volatile std::sig_atomic_t GameServer::stopRequested = 0;
+
+GameServer::GameServer(std::string socketPath, unsigned int numWorkers)
+        : socketPath(std::move(socketPath)), listenFd(-1), epollFd(-1), wakeFd(-1), workers(numWorkers),
+          nextSessionId(WAKE_ID + 1) {}
+
+GameServer::~GameServer() {
+    for (auto &[id, session]: sessions) {
+        if (session->fd >= 0) {
+            ::close(session->fd);
+        }
+    }
+    sessions.clear();
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+    }
+    if (epollFd >= 0) {
+        ::close(epollFd);
+    }
+}
+
+bool GameServer::open() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: The socket path " << socketPath << " is too long" << std::endl;
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    epollFd = epoll_create1(0);
+    wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (listenFd < 0 || epollFd < 0 || wakeFd < 0 || !setNonBlocking(listenFd)) {
+        std::cerr << "Error: Could not create the server sockets: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // A socket file left by a server which did not shut down cleanly would make bind fail
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listenFd, SOMAXCONN) != 0) {
+        std::cerr << "Error: Could not listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTENER_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = WAKE_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+void GameServer::run() {
+    std::signal(SIGINT, [](int) { stopRequested = 1; });
+    std::signal(SIGTERM, [](int) { stopRequested = 1; });
+    std::signal(SIGPIPE, SIG_IGN);
+
+    epoll_event events[MAX_EVENTS];
+    while (!stopRequested) {
+        int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, WAIT_MS);
+        if (numEvents < 0 && errno != EINTR) {
+            std::cerr << "Error: epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < numEvents; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == LISTENER_ID) {
+                acceptClients();
+                continue;
+            }
+            if (id == WAKE_ID) {
+                finishCommands();
+                continue;
+            }
+
+            auto slot = sessions.find(id);
+            if (slot == sessions.end() || slot->second->fd < 0) {
+                continue;
+            }
+            GameSession &session = *slot->second;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                readFrom(id, session);
+            }
+            if (session.fd >= 0 && (events[i].events & EPOLLOUT)) {
+                writeTo(id, session);
+            }
+        }
+        collectSessions();
+    }
+
+    // Let the running commands finish, since their engines belong to the sessions
+    std::cerr << "Stopping the server..." << std::endl;
+    for (auto &[id, session]: sessions) {
+        session->commands.clear();
+        session->isEnding = true;
+    }
+    bool isRunning = true;
+    while (isRunning) {
+        finishCommands();
+        isRunning = false;
+        for (const auto &[id, session]: sessions) {
+            isRunning = isRunning || session->isRunning;
+        }
+        if (isRunning) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+void GameServer::acceptClients() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (!setNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+
+        // Sessions play tournaments at the same time, so every session writes its own tournament files
+        uint64_t id = nextSessionId++;
+        auto session = std::make_unique<GameSession>();
+        session->fd = fd;
+        session->engine = std::make_unique<GameEngine>("-console");
+        session->engine->setWaitsForInput(false);
+        session->engine->setTurnLimit(SERVER_TURN_LIMIT);
+        session->engine->setTournamentFileSuffix("-session" + std::to_string(id));
+        session->engine->setInput(&session->input);
+        session->play = playSession(*session->engine, session->input);
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        sessions.emplace(id, std::move(session));
+    }
+}
+
+void GameServer::readFrom(uint64_t id, GameSession &session) {
+    // A client which hung up and was then closed on the other side cannot be written to either: its replies are
+    // dropped, and the socket is no longer watched while its lines are run
+    if (session.isHungUp) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+        session.output.clear();
+        session.isWatchingWrites = false;
+        return;
+    }
+
+    char buffer[4096];
+    while (true) {
+        ssize_t count = read(session.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            session.received.append(buffer, static_cast<size_t>(count));
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count == 0) {
+            // The client hung up: the lines it sent are still run, so only the replies are watched for now
+            session.isHungUp = true;
+            epoll_event event{};
+            event.events = session.isWatchingWrites ? static_cast<uint32_t>(EPOLLOUT) : 0;
+            event.data.u64 = id;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+            break;
+        }
+        close(id, session);
+        return;
+    }
+
+    // The last line of a client which hung up does not need its newline
+    if (session.isHungUp && !session.received.empty() && session.received.back() != '\n') {
+        session.received += '\n';
+    }
+
+    size_t lineStart = 0;
+    size_t lineEnd;
+    while ((lineEnd = session.received.find('\n', lineStart)) != std::string::npos) {
+        std::string line = session.received.substr(lineStart, lineEnd - lineStart);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && !session.isEnding) {
+            session.commands.push_back(std::move(line));
+        }
+        lineStart = lineEnd + 1;
+    }
+    session.received.erase(0, lineStart);
+
+    if (session.received.size() > SERVER_MAX_LINE) {
+        session.received.clear();
+        session.commands.clear();
+        session.output += "ERROR - | The command line is too long\n";
+        session.isEnding = true;
+    }
+
+    dispatch(id, session);
+    endIfHungUp(session);
+    writeTo(id, session);
+}
+
+void GameServer::writeTo(uint64_t id, GameSession &session) {
+    while (!session.output.empty()) {
+        ssize_t count = send(session.fd, session.output.data(), session.output.size(), MSG_NOSIGNAL);
+        if (count > 0) {
+            session.output.erase(0, static_cast<size_t>(count));
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            // The client is gone, so the replies cannot be written anymore
+            session.output.clear();
+        } else {
+            break;
+        }
+    }
+
+    bool needsWrites = !session.output.empty();
+    if (needsWrites != session.isWatchingWrites) {
+        epoll_event event{};
+        event.events = (session.isHungUp ? 0 : static_cast<uint32_t>(EPOLLIN)) |
+                       (needsWrites ? static_cast<uint32_t>(EPOLLOUT) : 0);
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+        session.isWatchingWrites = needsWrites;
+    }
+}
+
+void GameServer::endIfHungUp(GameSession &session) {
+    if (session.isHungUp && !session.isRunning) {
+        session.commands.clear();
+        session.isEnding = true;
+    }
+}
+
+void GameServer::dispatch(uint64_t id, GameSession &session) {
+    if (session.isRunning || session.isEnding || (session.isStarted && session.commands.empty())) {
+        return;
+    }
+    while (!session.commands.empty()) {
+        session.input.push(std::move(session.commands.front()));
+        session.commands.pop_front();
+    }
+    session.isRunning = true;
+
+    // The session is not destroyed while it runs, and the event loop leaves its engine, input and coroutine alone
+    GameSession *running = &session;
+    workers.submit([this, id, running]() {
+        {
+            GameEngine::ThreadScope scope(*running->engine);
+            if (!running->isStarted) {
+                running->isStarted = true;
+                running->play.start();
+            } else if (running->input.isWaiting()) {
+                running->input.takeWaiting().resume();
+            }
+        }
+
+        Completion completion{id, running->input.takeOutput(), running->play.isDone()};
+        if (!completion.isDone && running->input.isWaitingForAnswer()) {
+            completion.output += "INPUT\n";
+        }
+        {
+            std::lock_guard<std::mutex> lock(completedMutex);
+            completed.push_back(std::move(completion));
+        }
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void) written;
+    });
+}
+
+void GameServer::finishCommands() {
+    uint64_t wakeCount;
+    while (read(wakeFd, &wakeCount, sizeof(wakeCount)) > 0) {}
+
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completions.swap(completed);
+    }
+
+    for (auto &[id, output, isDone]: completions) {
+        auto slot = sessions.find(id);
+        if (slot == sessions.end()) {
+            continue;
+        }
+        GameSession &session = *slot->second;
+        session.isRunning = false;
+        if (session.fd < 0) {
+            continue;
+        }
+
+        session.output += output;
+        // A game which reached its end state (quit) takes no more commands
+        if (isDone) {
+            session.commands.clear();
+            session.isEnding = true;
+        }
+        dispatch(id, session);
+        endIfHungUp(session);
+        writeTo(id, session);
+    }
+    collectSessions();
+}
+
+void GameServer::close(uint64_t, GameSession &session) {
+    if (session.fd >= 0) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+        ::close(session.fd);
+        session.fd = -1;
+    }
+    session.commands.clear();
+    session.isEnding = true;
+}
+
+void GameServer::collectSessions() {
+    for (auto slot = sessions.begin(); slot != sessions.end();) {
+        GameSession &session = *slot->second;
+        if (session.isEnding && !session.isRunning && session.fd >= 0 && session.output.empty()) {
+            close(slot->first, session);
+        }
+        if (session.fd < 0 && !session.isRunning) {
+            slot = sessions.erase(slot);
+        } else {
+            ++slot;
+        }
+    }
+}
+
+size_t GameServer::getNumberOfSessions() const {
+    return sessions.size();
+}
+
+// Free function which runs the game server. The argument is "-server <socketpath> [<workers>]".
+int game_server_driver(const std::string &cmdArg) {
+    std::istringstream args(cmdArg);
+    std::string mode;
+    std::string socketPath;
+    unsigned int numWorkers = std::thread::hardware_concurrency();
+    args >> mode >> socketPath >> numWorkers;
+    if (socketPath.empty()) {
+        std::cerr << "Usage: -server <socketpath> [<workers>]" << std::endl;
+        return 1;
+    }
+
+    // Every session would overwrite the same indexed log file
+    IndexedLogObserver::setGameLogIndexed(false);
+
+    NullBuffer nullBuffer;
+    std::streambuf *consoleBuffer = std::cout.rdbuf(&nullBuffer);
+
+    int status = 0;
+    {
+        GameServer server(socketPath, numWorkers);
+        if (server.open()) {
+            std::cerr << "Serving games on " << socketPath << " with " << numWorkers << " workers" << std::endl;
+            server.run();
+        } else {
+            status = 1;
+        }
+    }
+
+    std::cout.rdbuf(consoleBuffer);
+    return status;
+}
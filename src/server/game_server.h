@@ -0,0 +1,147 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_GAME_SERVER_H
+#define COMP_345_PROJECT_TEAM_N12_GAME_SERVER_H
+
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "concurrency/task.h"
+#include "concurrency/thread_pool.h"
+#include "command_processor/input_channel.h"
+
+class GameEngine;
+
+// The number of turns after which a game played in a server session is a draw, so that a game nobody can win does not
+// keep a worker busy forever.
+constexpr int SERVER_TURN_LIMIT = 500;
+
+// The longest command line accepted from a client.
+constexpr size_t SERVER_MAX_LINE = 64 * 1024;
+
+// A client of the server, playing its own game on its own engine.
+struct GameSession {
+    // The socket of the client (-1 once it is closed).
+    int fd = -1;
+
+    std::unique_ptr<GameEngine> engine;
+
+    // The lines of the client, as the engine reads them, and the coroutine playing the session, which suspends
+    // whenever it waits for a line: the next command, or the answer of a human player.
+    InputChannel input;
+    Task<void> play;
+    bool isStarted = false;
+
+    // The bytes read which do not make a full line yet, the lines waiting for the engine and the replies not written
+    // yet.
+    std::string received;
+    std::deque<std::string> commands;
+    std::string output;
+
+    // True while a worker resumes the session. Only that worker touches the engine, the input and the coroutine then,
+    // and the session is only destroyed once it is done.
+    bool isRunning = false;
+
+    // True once the socket is watched for writing as well as reading.
+    bool isWatchingWrites = false;
+
+    // True once the client stopped sending: the lines it sent are still run, and then the session ends.
+    bool isHungUp = false;
+
+    // True once the game ended (quit), or once the client hung up and its lines were run: no more commands are run,
+    // and the session is closed as soon as its replies are written.
+    bool isEnding = false;
+};
+
+// Hosts independent game sessions on a Unix domain socket. Every connection is a session with its own game engine,
+// driven with the command language of the console, one line per command and one line of reply per command:
+// "OK <state> | <effect>" or "ERROR <state> | <reason>". When a human player of the game has to decide, the session
+// sends the prompts followed by a line "INPUT", and the next lines of the client are the answers. The tournament log,
+// journal and results files of a session end with "-session<id>", so sessions can play tournaments at the same time.
+//
+// A single thread multiplexes the sockets with epoll; the games are played by a pool of workers. A game waiting for
+// its client is a suspended coroutine, which holds no worker: a worker resumes it when lines arrive, until it waits
+// again, so even a single worker serves any number of interactive games. The lines of a session are handled in order,
+// while different sessions run in parallel. A worker hands the output of a session back to the event loop through an
+// eventfd.
+class GameServer {
+private:
+    std::string socketPath;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+
+    // The workers resuming the sessions. They are not the shared pool, so that a game waiting on the shared pool never
+    // resumes another session on its own thread.
+    ThreadPool workers;
+
+    // The sessions, by id. Ids are never reused, unlike file descriptors.
+    std::unordered_map<uint64_t, std::unique_ptr<GameSession>> sessions;
+    uint64_t nextSessionId;
+
+    // The output of the sessions resumed by the workers, and whether their coroutine ended, waiting for the event loop.
+    struct Completion {
+        uint64_t id;
+        std::string output;
+        bool isDone;
+    };
+    std::vector<Completion> completed;
+    std::mutex completedMutex;
+
+    // Set by SIGINT and SIGTERM.
+    static volatile std::sig_atomic_t stopRequested;
+
+    // Accepts every pending connection.
+    void acceptClients();
+
+    // Reads what the client sent and queues its complete lines. Once the client hung up, its last line is queued even
+    // without a newline.
+    void readFrom(uint64_t id, GameSession &session);
+
+    // Writes as many replies as the socket takes, and watches the socket for writing while some are left.
+    void writeTo(uint64_t id, GameSession &session);
+
+    // Gives the waiting lines of the session to its engine and has a worker resume it, unless one already does.
+    void dispatch(uint64_t id, GameSession &session);
+
+    // Ends the session of a client which hung up once no worker runs its lines anymore.
+    void endIfHungUp(GameSession &session);
+
+    // Hands the output of the workers to their sessions.
+    void finishCommands();
+
+    // Closes the socket of the session. The session itself is destroyed by collectSessions.
+    void close(uint64_t id, GameSession &session);
+
+    // Destroys the sessions whose socket is closed and whose command is done, or which have nothing left to write.
+    void collectSessions();
+
+public:
+    // Two param constructor which takes the path of the socket and the number of workers.
+    GameServer(std::string socketPath, unsigned int numWorkers);
+
+    // A server owns sockets, so it cannot be copied.
+    GameServer(const GameServer &server) = delete;
+    GameServer &operator=(const GameServer &server) = delete;
+
+    // Destructor which closes every socket and removes the socket file.
+    ~GameServer();
+
+    // Creates the socket and starts listening. Returns false (with the reason on cerr) if it cannot.
+    bool open();
+
+    // Serves the clients until SIGINT or SIGTERM, then lets the running workers finish.
+    void run();
+
+    // Getter for the number of open sessions.
+    [[nodiscard]] size_t getNumberOfSessions() const;
+};
+
+// Free function which runs the game server for the "-server <socketpath> [<workers>]" read mode.
+int game_server_driver(const std::string &cmdArg);
+
+#endif //COMP_345_PROJECT_TEAM_N12_GAME_SERVER_H
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrency/thread_pool.h"
+#include "game_engine/game_engine.h"
+#include "game_state/game_random.h"
+#include "player_strategy/strategy_parameters.h"
+
+using namespace std;
+
+// Tunes the parameters of the aggressive strategy with an evolution strategy. Every generation, each candidate
+// parameter set plays headless tournament games against each opponent strategy on each map, in parallel, and scores
+// one point per win and half a point per draw. The best quarter of the candidates is kept, and the rest of the next
+// generation is made of mutated crossovers of them, with mutations shrinking from one generation to the next. The
+// best parameter sets of the last generation are written to a file, which tournaments load with "-strategies <file>"
+// and use under the names "tuned-1", "tuned-2", ...
+//
+// All the candidates of a generation play the same seeds, so that their scores differ by their parameters more than by
+// their dice.
+//
+// Usage: WARZONE_STRATEGY_TUNER -M <listofmapfiles> -P <listofopponentstrategies> [-N <population>]
+//        [-E <generations>] [-G <gamesperopponentandmap>] [-D <maxnumberofturns>] [-K <setskept>] [-O <file>]
+
+namespace {
+    // A stream buffer dropping everything written to it, to silence the progress the engines print to cout.
+    class NullBuffer : public streambuf {
+    protected:
+        int overflow(int c) override {
+            return traits_type::not_eof(c);
+        }
+
+        streamsize xsputn(const char *, streamsize count) override {
+            return count;
+        }
+    };
+
+    // A candidate parameter set and its score in the last generation.
+    struct Candidate {
+        StrategyParameters parameters;
+        double score = 0;
+    };
+
+    // Returns a value uniformly distributed in [0, 1).
+    double nextUniform(GameRandom &random) {
+        return static_cast<double>(random.next() >> 11) * 0x1.0p-53;
+    }
+
+    // Returns a normally distributed value of mean 0 and deviation 1.
+    double nextGaussian(GameRandom &random) {
+        double u = 1 - nextUniform(random);
+        double v = nextUniform(random);
+        return sqrt(-2 * log(u)) * cos(2 * numbers::pi * v);
+    }
+
+    // Moves every parameter by a normally distributed fraction of its range, of the given deviation.
+    StrategyParameters mutate(const StrategyParameters &parameters, double deviation, GameRandom &random) {
+        StrategyParameters mutated = parameters;
+        for (size_t i = 0; i < StrategyParameters::NUM_PARAMETERS; i++) {
+            const ParameterSpec &spec = StrategyParameters::SPECS[i];
+            auto parameter = static_cast<StrategyParameters::Parameter>(i);
+            mutated.set(parameter, parameters.get(parameter) +
+                                   nextGaussian(random) * deviation * (spec.maxValue - spec.minValue));
+        }
+        return mutated;
+    }
+
+    // Takes every parameter from one of the two parents.
+    StrategyParameters crossover(const StrategyParameters &first, const StrategyParameters &second, GameRandom &random) {
+        StrategyParameters child = first;
+        for (size_t i = 0; i < StrategyParameters::NUM_PARAMETERS; i++) {
+            auto parameter = static_cast<StrategyParameters::Parameter>(i);
+            if (random.next() & 1) {
+                child.set(parameter, second.get(parameter));
+            }
+        }
+        return child;
+    }
+
+    // Plays the games of a candidate against one opponent: gamesPerMap games on every map, each seeded by its map and
+    // number. Returns the points of the candidate and the number of games, or -1 games if the tournament is invalid.
+    pair<double, int> playMatch(const string &candidateName, const string &opponent, const string &maps, int gamesPerMap,
+                                int maxTurns, uint64_t seed) {
+        GameEngine engine("-console");
+        engine.setWaitsForInput(false);
+
+        int games = -1;
+        vector<string> args = {"tournament", "-M", maps, "-P", candidateName + "," + opponent, "-G",
+                               to_string(gamesPerMap), "-D", to_string(maxTurns)};
+        if (!engine.configureTournament(args, games) || engine.getTournamentMapCount() == 0) {
+            return {0, -1};
+        }
+
+        double points = 0;
+        int numGames = 0;
+        for (int map = 0; map < static_cast<int>(engine.getTournamentMapCount()); map++) {
+            for (int game = 0; game < gamesPerMap; game++) {
+                GameRandom::current().seed(seed ^ (static_cast<uint64_t>(map) << 32 | static_cast<uint32_t>(game)));
+                string winner = engine.playTournamentGame(map, make_shared<MemoryLogSink>());
+                points += winner == "1-" + candidateName ? 1 : winner == "draw" ? 0.5 : 0;
+                numGames++;
+            }
+        }
+        return {points, numGames};
+    }
+}
+
+int main(int argc, char const *argv[]) {
+    string maps;
+    vector<string> opponents;
+    int population = 8;
+    int generations = 5;
+    int gamesPerMap = 2;
+    int maxTurns = 30;
+    int numKept = 3;
+    string outputPath = "../log/strategyparameters.txt";
+
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 == argc) {
+            cerr << "Missing value for option " << option << endl;
+            return 1;
+        }
+        string value = argv[++i];
+        if (option == "-M") {
+            maps = value;
+        } else if (option == "-P") {
+            stringstream stream(value);
+            for (string opponent; getline(stream, opponent, ',');) {
+                opponents.push_back(opponent);
+            }
+        } else if (option == "-N") {
+            population = max(2, atoi(value.c_str()));
+        } else if (option == "-E") {
+            generations = max(1, atoi(value.c_str()));
+        } else if (option == "-G") {
+            gamesPerMap = max(1, atoi(value.c_str()));
+        } else if (option == "-D") {
+            maxTurns = atoi(value.c_str());
+        } else if (option == "-K") {
+            numKept = max(1, atoi(value.c_str()));
+        } else if (option == "-O") {
+            outputPath = value;
+        } else {
+            cerr << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+    if (maps.empty() || opponents.empty()) {
+        cerr << "Usage: " << argv[0] << " -M <listofmapfiles> -P <listofopponentstrategies> [-N <population>] "
+             << "[-E <generations>] [-G <gamesperopponentandmap>] [-D <maxnumberofturns>] [-K <setskept>] [-O <file>]"
+             << endl;
+        return 1;
+    }
+    numKept = min(numKept, population);
+
+    // The games are played on a pool of their own: a game waiting on the shared pool runs its tasks, and must never
+    // run another game on its thread
+    ThreadPool pool(max(1u, thread::hardware_concurrency()));
+    GameRandom random;
+
+    // The first generation is the default parameters and mutations of them
+    vector<Candidate> candidates(population);
+    double deviation = 0.25;
+    for (size_t c = 1; c < candidates.size(); c++) {
+        candidates[c].parameters = mutate(candidates[0].parameters, deviation, random);
+    }
+
+    NullBuffer nullBuffer;
+    streambuf *consoleBuffer = cout.rdbuf(&nullBuffer);
+
+    int gamesPerCandidate = 0;
+    for (int generation = 1; generation <= generations; generation++) {
+        for (size_t c = 0; c < candidates.size(); c++) {
+            StrategyParameters::define("tuning-" + to_string(c), candidates[c].parameters);
+        }
+
+        // Every candidate plays every opponent at once
+        uint64_t seed = random.next();
+        vector<vector<future<pair<double, int>>>> matches(candidates.size());
+        for (size_t c = 0; c < candidates.size(); c++) {
+            for (const string &opponent: opponents) {
+                matches[c].push_back(pool.submit([=]() {
+                    return playMatch("tuning-" + to_string(c), opponent, maps, gamesPerMap, maxTurns, seed);
+                }));
+            }
+        }
+
+        for (size_t c = 0; c < candidates.size(); c++) {
+            double points = 0;
+            int numGames = 0;
+            for (auto &match: matches[c]) {
+                auto [matchPoints, matchGames] = match.get();
+                if (matchGames < 0) {
+                    cout.rdbuf(consoleBuffer);
+                    cerr << "Error: invalid tournament for maps \"" << maps << "\" and the given opponents" << endl;
+                    return 1;
+                }
+                points += matchPoints;
+                numGames += matchGames;
+            }
+            candidates[c].score = points / max(1, numGames);
+            gamesPerCandidate = numGames;
+        }
+
+        stable_sort(candidates.begin(), candidates.end(),
+                    [](const Candidate &a, const Candidate &b) { return a.score > b.score; });
+        cerr << "Generation " << generation << ": best score " << fixed << setprecision(3) << candidates[0].score
+             << " (" << candidates[0].parameters.toString() << ")" << endl;
+
+        if (generation == generations) {
+            break;
+        }
+
+        // Keep the best quarter, and replace the others with mutated crossovers of them
+        size_t numElites = max<size_t>(2, candidates.size() / 4);
+        deviation *= 0.8;
+        for (size_t c = numElites; c < candidates.size(); c++) {
+            const StrategyParameters &first = candidates[random.nextInt(static_cast<int>(numElites))].parameters;
+            const StrategyParameters &second = candidates[random.nextInt(static_cast<int>(numElites))].parameters;
+            candidates[c].parameters = mutate(crossover(first, second, random), deviation, random);
+        }
+    }
+
+    cout.rdbuf(consoleBuffer);
+
+    vector<pair<string, StrategyParameters>> best;
+    vector<string> comments;
+    for (int k = 0; k < numKept; k++) {
+        best.emplace_back("tuned-" + to_string(k + 1), candidates[k].parameters);
+        ostringstream comment;
+        comment << "score " << fixed << setprecision(3) << candidates[k].score << " over " << gamesPerCandidate
+                << " games against " << opponents.size() << " opponent(s), after " << generations << " generation(s)";
+        comments.push_back(comment.str());
+    }
+    if (!StrategyParameters::save(outputPath, best, comments)) {
+        cerr << "Error: Cannot write " << outputPath << endl;
+        return 1;
+    }
+    cerr << "Wrote the " << numKept << " best parameter sets to " << outputPath << endl;
+    return 0;
+}
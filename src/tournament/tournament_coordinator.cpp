@@ -0,0 +1,411 @@
+#include "tournament_coordinator.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "game_engine/game_engine.h"
+#include "game_log/game_telemetry.h"
+#include "game_log/indexed_log.h"
+#include "game_log/log_observer.h"
+#include "game_state/game_random.h"
+#include "player_strategy/strategy_parameters.h"
+
+// The implementation file of the TournamentCoordinator class.
+
+namespace {
+    // The descriptor of the socket to the coordinator in a worker process.
+    constexpr int WORKER_FD = 3;
+
+    // The number of shards every worker gets on average, so that the workers finishing first take on more games.
+    constexpr size_t SHARDS_PER_WORKER = 4;
+
+    // Sends a whole message on a socket.
+    bool sendAll(int fd, const string &text) {
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t count = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    // Reads the next line of a socket into line, keeping what follows it in received. Returns false at the end.
+    bool readLine(int fd, string &received, string &line) {
+        size_t lineEnd;
+        while ((lineEnd = received.find('\n')) == string::npos) {
+            char buffer[4096];
+            ssize_t count = read(fd, buffer, sizeof(buffer));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                return false;
+            }
+            received.append(buffer, static_cast<size_t>(count));
+        }
+        line = received.substr(0, lineEnd);
+        received.erase(0, lineEnd + 1);
+        return true;
+    }
+
+    // Plays the shards sent by the coordinator until it closes the socket.
+    int runWorker(int fd) {
+        GameEngine engine("-console");
+        engine.setWaitsForInput(false);
+
+        string received;
+        string line;
+        if (!readLine(fd, received, line)) {
+            return 1;
+        }
+
+        vector<string> commandArgs;
+        std::istringstream command(line);
+        for (string arg; command >> arg;) {
+            commandArgs.push_back(arg);
+        }
+        int gamesPerMap = -1;
+        if (commandArgs.size() < 9 || !engine.configureTournament(commandArgs, gamesPerMap)) {
+            std::cerr << "Tournament worker: invalid tournament \"" << line << "\"" << std::endl;
+            return 1;
+        }
+
+        while (readLine(fd, received, line)) {
+            std::istringstream shard(line);
+            string tag;
+            shard >> tag;
+            if (tag != "shard") {
+                std::cerr << "Tournament worker: unknown message \"" << line << "\"" << std::endl;
+                return 1;
+            }
+
+            int mapIndex;
+            int gameIndex;
+            uint64_t seed;
+            while (shard >> mapIndex >> gameIndex >> seed) {
+                GameRandom::current().seed(seed);
+                auto gameLog = std::make_shared<MemoryLogSink>();
+                string winner;
+                TournamentGameResult gameResult;
+                gameResult.mapIndex = mapIndex;
+                gameResult.gameIndex = gameIndex;
+                try {
+                    winner = engine.playTournamentGame(mapIndex, gameLog, &gameResult);
+                } catch (std::out_of_range &error) {
+                    std::cerr << "Tournament worker: no map at index " << mapIndex << std::endl;
+                    return 1;
+                }
+
+                // The records of the game for the indexed log, kept in memory if the coordinator writes one
+                string indexedRecords;
+                if (engine.getIndexedLog() != nullptr) {
+                    indexedRecords = engine.getIndexedLog()->takeGameRecords();
+                }
+
+                std::ostringstream result;
+                result << "result " << mapIndex << " " << gameIndex << " " << winner << " "
+                       << GameRandom::current().getState() << " " << gameLog->getContents().size() << " "
+                       << indexedRecords.size() << " "
+                       << gameResult.seed << " " << gameResult.turnsPlayed << " " << gameResult.wallTimeMicros << " "
+                       << gameResult.territories.size();
+                for (size_t k = 0; k < gameResult.territories.size(); k++) {
+                    result << " " << gameResult.territories[k] << " " << gameResult.armies[k] << " "
+                           << gameResult.eliminationTurns[k];
+                }
+                result << "\n" << gameLog->getContents() << indexedRecords;
+                if (!sendAll(fd, result.str())) {
+                    return 1;
+                }
+            }
+        }
+        return 0;
+    }
+}
+
+// Returns the seed of a game, the same whichever worker plays it.
+uint64_t TournamentCoordinator::gameSeed(uint64_t seed, const pair<int, int> &game) {
+    GameRandom random(seed ^ (static_cast<uint64_t>(game.first) << 32 | static_cast<uint32_t>(game.second)));
+    return random.next();
+}
+
+// Two param constructor which takes the number of workers and the arguments of the tournament command.
+TournamentCoordinator::TournamentCoordinator(int numWorkers, const vector<string> &commandArgs)
+        : numWorkers(std::max(1, numWorkers)) {
+    for (size_t i = 0; i < commandArgs.size(); i++) {
+        commandLine += (i == 0 ? "" : " ") + commandArgs[i];
+    }
+}
+
+// Destructor which stops the workers still running.
+TournamentCoordinator::~TournamentCoordinator() {
+    for (Worker &worker: workers) {
+        stop(worker, true);
+    }
+}
+
+// Starts a worker process: the same program, with the read mode of a worker and the socket at WORKER_FD. The output of
+// the worker is dropped, since the games it plays are logged by the coordinator.
+bool TournamentCoordinator::spawn(Worker &worker) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        return false;
+    }
+
+    // Everything the child uses is prepared before the fork: only async-signal-safe calls are made between the fork
+    // and the exec. A worker loads the same strategy parameter sets as the coordinator, writes the telemetry of its
+    // games if the coordinator would, and keeps the records of its games for the indexed log if the coordinator
+    // writes one.
+    string mode = "-worker " + std::to_string(WORKER_FD);
+    string strategiesOption = "-strategies";
+    string strategiesPath = StrategyParameters::getLoadedPath();
+    string telemetryOption = "-telemetry";
+    string indexOption = "-indexlog";
+    char programName[] = "WARZONE_APPLICATION";
+    vector<char *> argv = {programName, mode.data()};
+    if (!strategiesPath.empty()) {
+        argv.push_back(strategiesOption.data());
+        argv.push_back(strategiesPath.data());
+    }
+    if (GameTelemetry::isTelemetryEnabled()) {
+        argv.push_back(telemetryOption.data());
+    }
+    if (IndexedLogObserver::isGameLogIndexed()) {
+        argv.push_back(indexOption.data());
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (fds[1] == WORKER_FD) {
+            fcntl(WORKER_FD, F_SETFD, 0);
+        } else {
+            dup2(fds[1], WORKER_FD);
+        }
+        int nullFd = open("/dev/null", O_WRONLY);
+        if (nullFd >= 0) {
+            dup2(nullFd, STDOUT_FILENO);
+        }
+        execv("/proc/self/exe", argv.data());
+        _exit(127);
+    }
+
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return false;
+    }
+
+    worker.pid = pid;
+    worker.fd = fds[0];
+    worker.received.clear();
+    worker.shard.clear();
+    return sendAll(worker.fd, commandLine + "\n");
+}
+
+// Closes the socket of a worker, which makes an idle worker exit, and waits for it to end.
+void TournamentCoordinator::stop(Worker &worker, bool force) {
+    if (worker.pid > 0 && force) {
+        kill(worker.pid, SIGKILL);
+    }
+    if (worker.fd >= 0) {
+        close(worker.fd);
+        worker.fd = -1;
+    }
+    if (worker.pid > 0) {
+        waitpid(worker.pid, nullptr, 0);
+        worker.pid = -1;
+    }
+}
+
+// Reads the results a worker sent. A result is only handled once its whole log arrived.
+bool TournamentCoordinator::readResults(Worker &worker, const vector<pair<int, int>> &games,
+                                        const ResultHandler &onResult) {
+    char buffer[65536];
+    ssize_t count = read(worker.fd, buffer, sizeof(buffer));
+    if (count < 0 && errno == EINTR) {
+        return true;
+    }
+    if (count <= 0) {
+        return false;
+    }
+    worker.received.append(buffer, static_cast<size_t>(count));
+
+    size_t lineEnd;
+    while ((lineEnd = worker.received.find('\n')) != string::npos) {
+        std::istringstream header(worker.received.substr(0, lineEnd));
+        string tag;
+        TournamentJournal::GameRecord record{};
+        TournamentGameResult result;
+        size_t logSize;
+        size_t indexSize;
+        size_t numPlayers;
+        if (!(header >> tag >> record.mapIndex >> record.gameIndex >> record.winner >> record.randomState >> logSize
+                     >> indexSize >> result.seed >> result.turnsPlayed >> result.wallTimeMicros >> numPlayers) ||
+            tag != "result" || numPlayers > MAX_TOURNAMENT_PLAYERS) {
+            return false;
+        }
+        result.mapIndex = record.mapIndex;
+        result.gameIndex = record.gameIndex;
+        result.territories.resize(numPlayers);
+        result.armies.resize(numPlayers);
+        result.eliminationTurns.resize(numPlayers);
+        for (size_t k = 0; k < numPlayers; k++) {
+            if (!(header >> result.territories[k] >> result.armies[k] >> result.eliminationTurns[k])) {
+                return false;
+            }
+        }
+        if (worker.received.size() - (lineEnd + 1) < logSize + indexSize) {
+            break;
+        }
+
+        // The result must be one of the games of the shard of the worker
+        auto slot = std::find_if(worker.shard.begin(), worker.shard.end(), [&](size_t index) {
+            return games[index].first == record.mapIndex && games[index].second == record.gameIndex;
+        });
+        if (slot == worker.shard.end()) {
+            return false;
+        }
+        size_t index = *slot;
+        worker.shard.erase(slot);
+
+        string gameLog = worker.received.substr(lineEnd + 1, logSize);
+        string indexedRecords = worker.received.substr(lineEnd + 1 + logSize, indexSize);
+        worker.received.erase(0, lineEnd + 1 + logSize + indexSize);
+        onResult(index, record, std::move(result), gameLog, indexedRecords);
+    }
+    return true;
+}
+
+// Plays the given games in the worker processes.
+size_t TournamentCoordinator::play(const vector<pair<int, int>> &games, uint64_t seed, const ResultHandler &onResult) {
+    std::deque<size_t> queue;
+    for (size_t i = 0; i < games.size(); i++) {
+        queue.push_back(i);
+    }
+    vector<int> attempts(games.size(), 0);
+    size_t numPlayed = 0;
+
+    workers.resize(std::min(static_cast<size_t>(numWorkers), games.size()));
+    size_t shardSize = std::max<size_t>(1, games.size() / (workers.size() * SHARDS_PER_WORKER + 1));
+    std::cout << "Playing " << games.size() << " games in " << workers.size() << " worker processes" << std::endl;
+
+    // Puts the unfinished games of a worker which stopped back at the front of the queue
+    auto requeue = [&](Worker &worker) {
+        for (auto index = worker.shard.rbegin(); index != worker.shard.rend(); index++) {
+            if (++attempts[*index] < MAX_GAME_ATTEMPTS) {
+                queue.push_front(*index);
+            } else {
+                std::cerr << "Error: Game " << games[*index].second + 1 << " on map index " << games[*index].first
+                          << " stopped " << MAX_GAME_ATTEMPTS << " workers, it is left to the tournament" << std::endl;
+            }
+        }
+        worker.shard.clear();
+        stop(worker, true);
+    };
+
+    auto countResult = [&](size_t index, const TournamentJournal::GameRecord &record, TournamentGameResult result,
+                           const string &gameLog, const string &indexedRecords) {
+        numPlayed++;
+        onResult(index, record, std::move(result), gameLog, indexedRecords);
+    };
+
+    while (true) {
+        // Hand a shard to every idle worker, starting a new worker in place of one which stopped
+        for (Worker &worker: workers) {
+            if (queue.empty()) {
+                break;
+            }
+            if (!worker.shard.empty()) {
+                continue;
+            }
+            if (worker.fd < 0 && !spawn(worker)) {
+                std::cerr << "Error: Cannot start a tournament worker" << std::endl;
+                stop(worker, true);
+                continue;
+            }
+
+            std::ostringstream shard;
+            shard << "shard";
+            while (!queue.empty() && worker.shard.size() < shardSize) {
+                size_t index = queue.front();
+                queue.pop_front();
+                worker.shard.push_back(index);
+                shard << " " << games[index].first << " " << games[index].second << " " << gameSeed(seed, games[index]);
+            }
+            shard << "\n";
+            if (!sendAll(worker.fd, shard.str())) {
+                requeue(worker);
+            }
+        }
+
+        // Wait for the results of the busy workers. Without any, every game is either played or given up.
+        vector<pollfd> pollFds;
+        vector<Worker *> polledWorkers;
+        for (Worker &worker: workers) {
+            if (!worker.shard.empty()) {
+                pollFds.push_back({worker.fd, POLLIN, 0});
+                polledWorkers.push_back(&worker);
+            }
+        }
+        if (pollFds.empty()) {
+            break;
+        }
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (size_t p = 0; p < pollFds.size(); p++) {
+            if (pollFds[p].revents != 0 && !readResults(*polledWorkers[p], games, countResult)) {
+                std::cerr << "A tournament worker stopped, the " << polledWorkers[p]->shard.size()
+                          << " unfinished games of its shard go back to the queue" << std::endl;
+                requeue(*polledWorkers[p]);
+            }
+        }
+    }
+
+    for (Worker &worker: workers) {
+        if (!worker.shard.empty()) {
+            requeue(worker);
+        }
+        stop(worker, false);
+    }
+    return numPlayed;
+}
+
+// Free function which runs a tournament worker. The argument is "-worker <fd>".
+int tournament_worker_driver(const string &cmdArg) {
+    std::istringstream args(cmdArg);
+    string mode;
+    int fd = -1;
+    args >> mode >> fd;
+    if (fd < 0) {
+        std::cerr << "Usage: -worker <fd>" << std::endl;
+        return 1;
+    }
+
+    // The coordinator writes the log of the games and the indexed log, from what the workers send it
+    LogObserver::setGameLogInMemory(true);
+    IndexedLogObserver::setGameLogInMemory(true);
+
+    int status = runWorker(fd);
+    close(fd);
+    return status;
+}
@@ -0,0 +1,105 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_TOURNAMENT_COORDINATOR_H
+#define COMP_345_PROJECT_TEAM_N12_TOURNAMENT_COORDINATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+#include "tournament_journal.h"
+#include "tournament_results.h"
+
+using std::function;
+using std::pair;
+using std::string;
+using std::vector;
+
+// The number of times a game is handed to a worker before the coordinator gives up on it, when every worker playing
+// it crashed.
+constexpr int MAX_GAME_ATTEMPTS = 3;
+
+// Plays the games of a tournament in worker processes, so that the games are isolated from each other and from the
+// process running the tournament: a strategy which is not thread-safe or which crashes only takes its worker down.
+//
+// The games are split into shards of consecutive games, and every worker plays one shard at a time. A worker is a
+// WARZONE_APPLICATION started with the "-worker <fd>" read mode, talking to the coordinator over a Unix socket pair
+// with a line protocol:
+//
+//     coordinator: tournament -M <maps> -P <strategies> -G <games> -D <turns> [-S <turns>]   (once, first)
+//     coordinator: shard <map index> <game index> <seed> [<map index> <game index> <seed> ...]
+//     worker:      result <map index> <game index> <winner, or draw> <random state> <log size> <index size> <seed>
+//                         <turns played> <wall time in microseconds> <players>
+//                         [<territories> <armies> <elimination turn> ...]
+//                  followed by the <log size> bytes of the game log and the <index size> bytes of the records of the
+//                  game for the indexed log (none unless the coordinator writes one)
+//
+// The worker seeds its random generator with the seed of a game before playing it, so a game played again after a
+// crash rolls the same battles. When a worker dies, the games of its shard without a result go back to the queue, and
+// a new worker takes its place. Nothing in the protocol needs the worker to run on the same machine, apart from finding
+// the map files under the same names.
+class TournamentCoordinator {
+public:
+    // Receives the result of a game, with the position of the game in the list given to play(), its log and its records
+    // for the indexed log, as IndexedLogObserver::takeGameRecords() returns them. The row of the game has the numbers
+    // the worker sent, without the names of the map and of the players.
+    using ResultHandler = function<void(size_t index, const TournamentJournal::GameRecord &record,
+                                        TournamentGameResult result, const string &gameLog,
+                                        const string &indexedRecords)>;
+
+private:
+    // A worker process, and the socket the coordinator talks to it with (-1 once it is closed).
+    struct Worker {
+        pid_t pid = -1;
+        int fd = -1;
+
+        // The bytes read which do not make a whole result yet.
+        string received;
+
+        // The positions of the games of its shard not finished yet.
+        vector<size_t> shard;
+    };
+
+    int numWorkers;
+
+    // The tournament command, sent to every worker so that it loads the same maps and players.
+    string commandLine;
+
+    vector<Worker> workers;
+
+    // Starts a worker process. Returns false if it cannot.
+    bool spawn(Worker &worker);
+
+    // Closes the socket of a worker and waits for it to end, killing it first if it may still run.
+    void stop(Worker &worker, bool kill);
+
+    // Reads the results a worker sent. Returns false if the worker hung up or sent something invalid.
+    bool readResults(Worker &worker, const vector<pair<int, int>> &games, const ResultHandler &onResult);
+
+public:
+    // Two param constructor which takes the number of workers and the arguments of the tournament command.
+    TournamentCoordinator(int numWorkers, const vector<string> &commandArgs);
+
+    // A coordinator owns processes, so it cannot be copied.
+    TournamentCoordinator(const TournamentCoordinator &coordinator) = delete;
+    TournamentCoordinator &operator=(const TournamentCoordinator &coordinator) = delete;
+
+    // Destructor which stops the workers still running.
+    ~TournamentCoordinator();
+
+    // Returns the seed of the given (map index, game index) game from the seed given to play(), the same whichever
+    // process plays it.
+    static uint64_t gameSeed(uint64_t seed, const pair<int, int> &game);
+
+    // Plays the given (map index, game index) games, calling onResult on the calling thread as every result arrives,
+    // in no particular order. The seed of every game is derived from the given seed and from the game. Returns the
+    // number of games played; the games left out crashed every worker they were given to, or no worker could start, and
+    // are left to the caller, which seeds them with gameSeed() so that they roll the same battles.
+    size_t play(const vector<pair<int, int>> &games, uint64_t seed, const ResultHandler &onResult);
+};
+
+// Free function which runs a tournament worker. The argument is "-worker <fd>", where fd is the socket to the
+// coordinator.
+int tournament_worker_driver(const string &cmdArg);
+
+#endif //COMP_345_PROJECT_TEAM_N12_TOURNAMENT_COORDINATOR_H
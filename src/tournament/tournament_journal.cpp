@@ -0,0 +1,109 @@
+#include "tournament_journal.h"
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+// The implementation file of the TournamentJournal class.
+
+namespace {
+    // Reads the record of a game from a line of the journal. Returns false if the line is not a game record.
+    bool parseRecord(const string &line, TournamentJournal::GameRecord &record) {
+        std::istringstream stream(line);
+        string tag;
+        string rest;
+        if (!(stream >> tag >> record.mapIndex >> record.gameIndex >> record.winner >> record.randomState)) {
+            return false;
+        }
+        return tag == "game" && record.mapIndex >= 0 && record.gameIndex >= 0 && !(stream >> rest);
+    }
+}
+
+// One param constructor which takes the path of the journal.
+TournamentJournal::TournamentJournal(string path) : path(std::move(path)) {}
+
+// Starts the journal of a new tournament, replacing the journal of the last one.
+bool TournamentJournal::begin(const vector<string> &tournamentArgs) {
+    commandArgs = tournamentArgs;
+    records.clear();
+
+    os.open(path, std::ios::out | std::ios::trunc);
+    for (size_t i = 0; i < commandArgs.size(); i++) {
+        os << (i == 0 ? "" : " ") << commandArgs[i];
+    }
+    os << '\n' << std::flush;
+    return static_cast<bool>(os);
+}
+
+// Reads the journal of the last tournament. Only the lines ending with a new line were written completely: the file is
+// cut after the last of them, so that the next record does not continue a line left unfinished by a crash.
+bool TournamentJournal::load() {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    commandArgs.clear();
+    records.clear();
+
+    size_t validEnd = 0;
+    size_t lineEnd;
+    while ((lineEnd = text.find('\n', validEnd)) != string::npos) {
+        string line = text.substr(validEnd, lineEnd - validEnd);
+        if (validEnd == 0) {
+            std::istringstream stream(line);
+            for (string arg; stream >> arg;) {
+                commandArgs.push_back(arg);
+            }
+        } else {
+            GameRecord record{};
+            if (!parseRecord(line, record)) {
+                break;
+            }
+            records.push_back(std::move(record));
+        }
+        validEnd = lineEnd + 1;
+    }
+
+    if (commandArgs.empty()) {
+        return false;
+    }
+
+    std::error_code error;
+    if (validEnd < text.size()) {
+        std::filesystem::resize_file(path, validEnd, error);
+    }
+    os.open(path, std::ios::out | std::ios::app);
+    return !error && static_cast<bool>(os);
+}
+
+// Adds the result of a game to the journal, written at once and flushed so that it outlives the process.
+void TournamentJournal::append(const GameRecord &record) {
+    std::ostringstream line;
+    line << "game " << record.mapIndex << " " << record.gameIndex << " " << record.winner << " " << record.randomState
+         << '\n';
+    os << line.str() << std::flush;
+    records.push_back(record);
+}
+
+// Returns the result of a game already played, or nullptr if it was not.
+const TournamentJournal::GameRecord *TournamentJournal::find(int mapIndex, int gameIndex) const {
+    for (const GameRecord &record: records) {
+        if (record.mapIndex == mapIndex && record.gameIndex == gameIndex) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+// Getter for the arguments of the command which started the tournament.
+const vector<string> &TournamentJournal::getCommandArgs() const {
+    return commandArgs;
+}
+
+// Getter for the games recorded so far.
+const vector<TournamentJournal::GameRecord> &TournamentJournal::getRecords() const {
+    return records;
+}
@@ -0,0 +1,73 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_TOURNAMENT_JOURNAL_H
+#define COMP_345_PROJECT_TEAM_N12_TOURNAMENT_JOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using std::ofstream;
+using std::string;
+using std::vector;
+
+// The path of the journal of the last tournament started.
+#define TOURNAMENT_JOURNAL_PATH "../log/tournamentjournal.txt"
+
+// An append-only record of the progress of a tournament, so that a tournament which crashed or was stopped can go on
+// where it stopped (see the resumetournament command). The first line of the journal is the command which started the
+// tournament, and every game played adds a line once it is over:
+//
+//     game <map index> <game index> <winner, or draw> <state of the random generator after the game>
+//
+// Every line is flushed as soon as it is written. A line cut short by a crash is not a complete record, and is dropped
+// the next time the journal is loaded.
+class TournamentJournal {
+public:
+    // The result of one game of the tournament.
+    struct GameRecord {
+        int mapIndex;
+        int gameIndex;
+        string winner;
+        uint64_t randomState;
+    };
+
+private:
+    // The file of the journal.
+    string path;
+    ofstream os;
+
+    // The arguments of the command which started the tournament, and the games recorded so far, in the order they
+    // were played.
+    vector<string> commandArgs;
+    vector<GameRecord> records;
+
+public:
+    // One param constructor which takes the path of the journal. Nothing is read or written until begin() or load().
+    explicit TournamentJournal(string path);
+
+    // A journal owns its file, so it cannot be copied.
+    TournamentJournal(const TournamentJournal &journal) = delete;
+    TournamentJournal &operator=(const TournamentJournal &journal) = delete;
+
+    // Starts the journal of a new tournament, replacing the journal of the last one. Returns false if the journal
+    // cannot be written.
+    bool begin(const vector<string> &tournamentArgs);
+
+    // Reads the journal of the last tournament, and opens it so that the games still to be played are added to it.
+    // Returns false if there is no journal.
+    bool load();
+
+    // Adds the result of a game to the journal.
+    void append(const GameRecord &record);
+
+    // Returns the result of a game already played, or nullptr if it was not.
+    [[nodiscard]] const GameRecord *find(int mapIndex, int gameIndex) const;
+
+    // Getter for the arguments of the command which started the tournament.
+    [[nodiscard]] const vector<string> &getCommandArgs() const;
+
+    // Getter for the games recorded so far.
+    [[nodiscard]] const vector<GameRecord> &getRecords() const;
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_TOURNAMENT_JOURNAL_H
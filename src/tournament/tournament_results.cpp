@@ -0,0 +1,341 @@
+#include "tournament_results.h"
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <utility>
+
+// The implementation file of the TournamentResultStore class.
+
+namespace {
+    // The first bytes of a store file, and of every block.
+    constexpr char FILE_MAGIC[8] = {'W', 'Z', 'R', 'S', '0', '0', '0', '1'};
+    constexpr char BLOCK_MAGIC[4] = {'W', 'Z', 'R', 'B'};
+
+    // The size of the header of a block: its magic, rows, new strings, payload size and checksum.
+    constexpr size_t BLOCK_HEADER_SIZE = 4 + 4 + 4 + 8 + 8;
+
+    // Returns the 64-bit FNV-1a hash of some bytes.
+    uint64_t checksum(const char *bytes, size_t size) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(bytes[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    // Appends the bytes of a number to a buffer.
+    template<typename T>
+    void putValue(string &buffer, T value) {
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    // Reads a number from a buffer, moving the cursor past it. Returns false if the buffer is too short.
+    template<typename T>
+    bool getValue(const string &buffer, size_t &cursor, T &value) {
+        if (buffer.size() - cursor < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    // Reads a column of the given number of rows from a buffer, moving the cursor past it.
+    template<typename T>
+    bool getColumn(const string &buffer, size_t &cursor, size_t rows, vector<T> &column) {
+        if ((buffer.size() - cursor) / sizeof(T) < rows) {
+            return false;
+        }
+        column.resize(rows);
+        std::memcpy(column.data(), buffer.data() + cursor, rows * sizeof(T));
+        cursor += rows * sizeof(T);
+        return true;
+    }
+
+    // Joins the names of the participants of a game with commas, and splits them back.
+    string joinNames(const vector<string> &names) {
+        string joined;
+        for (size_t i = 0; i < names.size(); i++) {
+            joined += (i == 0 ? "" : ",") + names[i];
+        }
+        return joined;
+    }
+
+    vector<string> splitNames(const string &joined) {
+        vector<string> names;
+        std::istringstream stream(joined);
+        for (string name; std::getline(stream, name, ',');) {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    // Returns the key of a game in the index of the rows.
+    uint64_t gameKey(int mapIndex, int gameIndex) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(mapIndex)) << 32 | static_cast<uint32_t>(gameIndex);
+    }
+}
+
+// Returns the name of the winner, or "draw".
+string TournamentGameResult::getWinnerName() const {
+    return winner >= 0 && winner < static_cast<int>(participants.size()) ? participants[winner] : "draw";
+}
+
+// Returns the number of rows of the block.
+size_t TournamentResultColumns::size() const {
+    return mapIndices.size();
+}
+
+// One param constructor which takes the path of the store.
+TournamentResultStore::TournamentResultStore(string path) : path(std::move(path)) {}
+
+// Destructor which writes the rows still buffered.
+TournamentResultStore::~TournamentResultStore() {
+    if (os.is_open()) {
+        flush();
+    }
+}
+
+// Returns the index of a string in the dictionary, adding it if it is new.
+uint32_t TournamentResultStore::intern(const string &text) {
+    auto [entry, isNew] = dictionaryIndices.emplace(text, static_cast<uint32_t>(dictionary.size()));
+    if (isNew) {
+        dictionary.push_back(text);
+    }
+    return entry->second;
+}
+
+// Adds a row to the rows in memory, replacing the row of the same game if there is one.
+void TournamentResultStore::remember(TournamentGameResult result) {
+    auto [entry, isNew] = resultIndices.emplace(gameKey(result.mapIndex, result.gameIndex), results.size());
+    if (isNew) {
+        results.push_back(std::move(result));
+    } else {
+        results[entry->second] = std::move(result);
+    }
+}
+
+// Starts the results of a new tournament, replacing the results of the last one.
+bool TournamentResultStore::begin() {
+    results.clear();
+    resultIndices.clear();
+    numWritten = 0;
+    dictionary.clear();
+    dictionaryIndices.clear();
+    numDictionaryWritten = 0;
+
+    os.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    os.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    os.flush();
+    return static_cast<bool>(os);
+}
+
+// Reads the results of the last tournament. The file is cut after its last whole block, so that the next block does
+// not follow a block left unfinished by a crash.
+bool TournamentResultStore::load() {
+    results.clear();
+    resultIndices.clear();
+    dictionary.clear();
+    dictionaryIndices.clear();
+
+    uint64_t validLength = scan(path, [this](const TournamentResultColumns &columns,
+                                             const vector<string> &blockDictionary) {
+        for (size_t row = 0; row < columns.size(); row++) {
+            TournamentGameResult result;
+            result.mapIndex = columns.mapIndices[row];
+            result.gameIndex = columns.gameIndices[row];
+            result.mapName = blockDictionary[columns.mapNames[row]];
+            result.seed = columns.seeds[row];
+            result.participants = splitNames(blockDictionary[columns.participants[row]]);
+            result.winner = columns.winners[row];
+            result.turnsPlayed = columns.turnsPlayed[row];
+            result.wallTimeMicros = columns.wallTimesMicros[row];
+            for (size_t k = 0; k < result.participants.size() && k < MAX_TOURNAMENT_PLAYERS; k++) {
+                result.territories.push_back(columns.territories[k][row]);
+                result.armies.push_back(columns.armies[k][row]);
+                result.eliminationTurns.push_back(columns.eliminationTurns[k][row]);
+            }
+            remember(std::move(result));
+        }
+        dictionary = blockDictionary;
+    });
+    if (validLength == 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < dictionary.size(); i++) {
+        dictionaryIndices.emplace(dictionary[i], static_cast<uint32_t>(i));
+    }
+    numWritten = results.size();
+    numDictionaryWritten = dictionary.size();
+
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) > validLength) {
+        std::filesystem::resize_file(path, validLength, error);
+    }
+    os.open(path, std::ios::out | std::ios::binary | std::ios::app);
+    return !error && static_cast<bool>(os);
+}
+
+// Adds the result of a game, and writes a block once there are enough rows buffered.
+void TournamentResultStore::append(const TournamentGameResult &result) {
+    remember(result);
+    if (results.size() - numWritten >= BLOCK_ROWS) {
+        flush();
+    }
+}
+
+// Writes the rows buffered so far as a block, with the strings they added to the dictionary.
+bool TournamentResultStore::flush() {
+    size_t rows = results.size() - numWritten;
+    if (rows == 0) {
+        return static_cast<bool>(os);
+    }
+
+    vector<uint32_t> mapNames;
+    vector<uint32_t> participants;
+    for (size_t row = numWritten; row < results.size(); row++) {
+        mapNames.push_back(intern(results[row].mapName));
+        participants.push_back(intern(joinNames(results[row].participants)));
+    }
+
+    string payload;
+    for (size_t i = numDictionaryWritten; i < dictionary.size(); i++) {
+        putValue(payload, static_cast<uint32_t>(dictionary[i].size()));
+        payload += dictionary[i];
+    }
+
+    auto putColumn = [&](auto valueOf) {
+        for (size_t row = numWritten; row < results.size(); row++) {
+            putValue(payload, valueOf(results[row]));
+        }
+    };
+    putColumn([](const TournamentGameResult &r) { return static_cast<int32_t>(r.mapIndex); });
+    putColumn([](const TournamentGameResult &r) { return static_cast<int32_t>(r.gameIndex); });
+    for (uint32_t mapName: mapNames) {
+        putValue(payload, mapName);
+    }
+    putColumn([](const TournamentGameResult &r) { return r.seed; });
+    for (uint32_t participant: participants) {
+        putValue(payload, participant);
+    }
+    putColumn([](const TournamentGameResult &r) { return static_cast<int32_t>(r.winner); });
+    putColumn([](const TournamentGameResult &r) { return static_cast<int32_t>(r.turnsPlayed); });
+    putColumn([](const TournamentGameResult &r) { return r.wallTimeMicros; });
+    for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+        putColumn([k](const TournamentGameResult &r) {
+            return static_cast<int32_t>(k < r.territories.size() ? r.territories[k] : 0);
+        });
+    }
+    for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+        putColumn([k](const TournamentGameResult &r) { return k < r.armies.size() ? r.armies[k] : int64_t{0}; });
+    }
+    for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+        putColumn([k](const TournamentGameResult &r) {
+            return static_cast<int32_t>(k < r.eliminationTurns.size() ? r.eliminationTurns[k] : 0);
+        });
+    }
+
+    string header(BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+    putValue(header, static_cast<uint32_t>(rows));
+    putValue(header, static_cast<uint32_t>(dictionary.size() - numDictionaryWritten));
+    putValue(header, static_cast<uint64_t>(payload.size()));
+    putValue(header, checksum(payload.data(), payload.size()));
+
+    os.write(header.data(), static_cast<std::streamsize>(header.size()));
+    os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    os.flush();
+    numWritten = results.size();
+    numDictionaryWritten = dictionary.size();
+    return static_cast<bool>(os);
+}
+
+// Returns the result of a game, or nullptr if there is none.
+const TournamentGameResult *TournamentResultStore::find(int mapIndex, int gameIndex) const {
+    auto entry = resultIndices.find(gameKey(mapIndex, gameIndex));
+    return entry == resultIndices.end() ? nullptr : &results[entry->second];
+}
+
+// Getter for the rows recorded so far.
+const vector<TournamentGameResult> &TournamentResultStore::getResults() const {
+    return results;
+}
+
+// Reads the blocks of a store file one after the other. The reading stops at the first block which is cut short or
+// fails its checksum.
+uint64_t TournamentResultStore::scan(const string &path, const BlockHandler &onBlock) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(FILE_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        return 0;
+    }
+    std::error_code error;
+    uint64_t fileSize = std::filesystem::file_size(path, error);
+    uint64_t validLength = sizeof(FILE_MAGIC);
+
+    vector<string> dictionary;
+    string header(BLOCK_HEADER_SIZE, '\0');
+    string payload;
+    while (file.read(header.data(), static_cast<std::streamsize>(header.size()))) {
+        size_t cursor = sizeof(BLOCK_MAGIC);
+        uint32_t rows;
+        uint32_t numNewStrings;
+        uint64_t payloadSize;
+        uint64_t payloadChecksum;
+        getValue(header, cursor, rows);
+        getValue(header, cursor, numNewStrings);
+        getValue(header, cursor, payloadSize);
+        getValue(header, cursor, payloadChecksum);
+        if (std::memcmp(header.data(), BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 ||
+            payloadSize > fileSize - validLength - BLOCK_HEADER_SIZE) {
+            break;
+        }
+        payload.resize(payloadSize);
+        if (!file.read(payload.data(), static_cast<std::streamsize>(payloadSize)) ||
+            checksum(payload.data(), payload.size()) != payloadChecksum) {
+            break;
+        }
+
+        cursor = 0;
+        bool isValid = true;
+        for (uint32_t i = 0; i < numNewStrings && isValid; i++) {
+            uint32_t length;
+            isValid = getValue(payload, cursor, length) && payload.size() - cursor >= length;
+            if (isValid) {
+                dictionary.push_back(payload.substr(cursor, length));
+                cursor += length;
+            }
+        }
+
+        TournamentResultColumns columns;
+        isValid = isValid &&
+                  getColumn(payload, cursor, rows, columns.mapIndices) &&
+                  getColumn(payload, cursor, rows, columns.gameIndices) &&
+                  getColumn(payload, cursor, rows, columns.mapNames) &&
+                  getColumn(payload, cursor, rows, columns.seeds) &&
+                  getColumn(payload, cursor, rows, columns.participants) &&
+                  getColumn(payload, cursor, rows, columns.winners) &&
+                  getColumn(payload, cursor, rows, columns.turnsPlayed) &&
+                  getColumn(payload, cursor, rows, columns.wallTimesMicros);
+        for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+            isValid = isValid && getColumn(payload, cursor, rows, columns.territories[k]);
+        }
+        for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+            isValid = isValid && getColumn(payload, cursor, rows, columns.armies[k]);
+        }
+        for (size_t k = 0; k < MAX_TOURNAMENT_PLAYERS; k++) {
+            isValid = isValid && getColumn(payload, cursor, rows, columns.eliminationTurns[k]);
+        }
+        for (size_t row = 0; row < rows && isValid; row++) {
+            isValid = columns.mapNames[row] < dictionary.size() && columns.participants[row] < dictionary.size();
+        }
+        if (!isValid) {
+            break;
+        }
+
+        onBlock(columns, dictionary);
+        validLength += BLOCK_HEADER_SIZE + payloadSize;
+    }
+    return validLength;
+}
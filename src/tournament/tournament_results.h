@@ -0,0 +1,152 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_TOURNAMENT_RESULTS_H
+#define COMP_345_PROJECT_TEAM_N12_TOURNAMENT_RESULTS_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::array;
+using std::function;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+// The path of the results of the last tournament started.
+#define TOURNAMENT_RESULTS_PATH "../log/tournamentresults.bin"
+
+// The most players a tournament game has, and so the number of player columns of the result store.
+constexpr size_t MAX_TOURNAMENT_PLAYERS = 4;
+
+// The outcome of one game of a tournament, which is one row of the result store.
+struct TournamentGameResult {
+    int mapIndex = 0;
+    int gameIndex = 0;
+    string mapName;
+
+    // The state of the random generator when the game started, from which the game plays again the same way (0 if it
+    // is not known).
+    uint64_t seed = 0;
+
+    // The names of the players, in the order of the tournament strategies.
+    vector<string> participants;
+
+    // The index of the winner among the participants, or -1 for a draw.
+    int winner = -1;
+
+    // The number of turns played and the time the game took, or -1 if they are not known (a game only recovered from
+    // the journal of the tournament).
+    int turnsPlayed = -1;
+    int64_t wallTimeMicros = -1;
+
+    // For every participant: the territories and armies it had at the end, and the turn it was eliminated in (0 if it
+    // was not).
+    vector<int> territories;
+    vector<int64_t> armies;
+    vector<int> eliminationTurns;
+
+    // Returns the name of the winner, or "draw".
+    [[nodiscard]] string getWinnerName() const;
+};
+
+// The rows of one block of the result store, column by column. The names of the maps and the lists of participants
+// are given as indices in the dictionary of the store. The player columns have a row for every game, and the players
+// a game did not have are left at 0.
+struct TournamentResultColumns {
+    vector<int32_t> mapIndices;
+    vector<int32_t> gameIndices;
+    vector<uint32_t> mapNames;
+    vector<uint64_t> seeds;
+    vector<uint32_t> participants;
+    vector<int32_t> winners;
+    vector<int32_t> turnsPlayed;
+    vector<int64_t> wallTimesMicros;
+    array<vector<int32_t>, MAX_TOURNAMENT_PLAYERS> territories;
+    array<vector<int64_t>, MAX_TOURNAMENT_PLAYERS> armies;
+    array<vector<int32_t>, MAX_TOURNAMENT_PLAYERS> eliminationTurns;
+
+    // Returns the number of rows of the block.
+    [[nodiscard]] size_t size() const;
+};
+
+// The results of a tournament, one row per game, kept in a columnar file so that aggregating over many games only
+// reads arrays of numbers. The rows are buffered and written as blocks of up to BLOCK_ROWS rows:
+//
+//     file:   "WZRS0001" block...
+//     block:  "WZRB" <rows: u32> <new strings: u32> <payload size: u64> <payload checksum: u64> payload
+//     payload: every new string (<length: u32> <bytes>), then every column in the order of TournamentResultColumns,
+//              as an array of one fixed size value per row
+//
+// The numbers are in the byte order of the machine. The strings of the map names and of the lists of participants
+// (the names separated by commas) make one dictionary for the whole file, and a block only adds the strings the blocks
+// before it did not have. A block cut short by a crash fails its checksum, and is dropped when the store is loaded.
+class TournamentResultStore {
+public:
+    // The number of rows written together as a block.
+    static constexpr size_t BLOCK_ROWS = 1024;
+
+    // Receives the columns of a block, and the dictionary of the store up to that block.
+    using BlockHandler = function<void(const TournamentResultColumns &columns, const vector<string> &dictionary)>;
+
+private:
+    // The file of the store.
+    string path;
+    ofstream os;
+
+    // The rows recorded so far, in the order they were appended, the position of every game among them, and the
+    // number of rows already written to the file.
+    vector<TournamentGameResult> results;
+    std::unordered_map<uint64_t, size_t> resultIndices;
+    size_t numWritten = 0;
+
+    // The strings of the dictionary, the index of every string, and the number of strings already written to the file.
+    vector<string> dictionary;
+    std::unordered_map<string, uint32_t> dictionaryIndices;
+    size_t numDictionaryWritten = 0;
+
+    // Returns the index of a string in the dictionary, adding it if it is new.
+    uint32_t intern(const string &text);
+
+    // Adds a row to the rows in memory.
+    void remember(TournamentGameResult result);
+
+public:
+    // One param constructor which takes the path of the store. Nothing is read or written until begin() or load().
+    explicit TournamentResultStore(string path);
+
+    // A store owns its file, so it cannot be copied.
+    TournamentResultStore(const TournamentResultStore &store) = delete;
+    TournamentResultStore &operator=(const TournamentResultStore &store) = delete;
+
+    // Destructor which writes the rows still buffered.
+    ~TournamentResultStore();
+
+    // Starts the results of a new tournament, replacing the results of the last one. Returns false if the file cannot
+    // be written.
+    bool begin();
+
+    // Reads the results of the last tournament, and opens the file so that the games still to be played are added to
+    // it. Returns false if there are no results.
+    bool load();
+
+    // Adds the result of a game. The row is written with the next block.
+    void append(const TournamentGameResult &result);
+
+    // Writes the rows buffered so far as a block. Returns false if the file cannot be written.
+    bool flush();
+
+    // Returns the result of a game, or nullptr if there is none.
+    [[nodiscard]] const TournamentGameResult *find(int mapIndex, int gameIndex) const;
+
+    // Getter for the rows recorded so far.
+    [[nodiscard]] const vector<TournamentGameResult> &getResults() const;
+
+    // Reads the blocks of a store file one after the other, without turning the columns into rows. Returns the length
+    // of the file up to the end of its last whole block, or 0 if it is not a store file.
+    static uint64_t scan(const string &path, const BlockHandler &onBlock);
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_TOURNAMENT_RESULTS_H
@@ -0,0 +1,119 @@
+#include "tournament_statistics.h"
+#include <algorithm>
+#include <cmath>
+
+// The implementation file of the TournamentStatistics class.
+
+// Constructor which takes the number of players of the tournament, the confidence level of the intervals and the
+// most games that can be played on the map. There is an interval for every player and the draws at every look.
+TournamentStatistics::TournamentStatistics(int numPlayers, double confidence, int maxGames)
+        : wins(numPlayers, 0), draws(0), gamesPlayed(0), confidence(confidence),
+          zScore(zScoreFor(confidence, std::max(1, maxGames) * (numPlayers + 1))) {}
+
+// Records a game won by the player at the given index.
+void TournamentStatistics::recordWin(int playerIndex) {
+    wins.at(playerIndex)++;
+    gamesPlayed++;
+}
+
+// Records a game ending in a draw.
+void TournamentStatistics::recordDraw() {
+    draws++;
+    gamesPlayed++;
+}
+
+// Getter for the number of games recorded so far.
+int TournamentStatistics::getGamesPlayed() const {
+    return gamesPlayed;
+}
+
+// Getter for the number of games won by a player.
+int TournamentStatistics::getWins(int playerIndex) const {
+    return wins.at(playerIndex);
+}
+
+// Getter for the number of draws.
+int TournamentStatistics::getDraws() const {
+    return draws;
+}
+
+// Getter for the confidence level.
+double TournamentStatistics::getConfidence() const {
+    return confidence;
+}
+
+// Returns the number of games with the given outcome (a player index, or -1 for a draw).
+int TournamentStatistics::outcomeCount(int outcome) const {
+    return outcome < 0 ? draws : wins.at(outcome);
+}
+
+// Returns the interval of the win rate of a player, or of the draw rate for index -1.
+pair<double, double> TournamentStatistics::rateInterval(int outcome) const {
+    return wilsonInterval(outcomeCount(outcome), gamesPlayed, zScore);
+}
+
+// Returns the most frequent outcome so far. Players come before draws when tied.
+int TournamentStatistics::getLeader() const {
+    int leader = -1;
+    for (int i = 0; i < static_cast<int>(wins.size()); i++) {
+        if (wins[i] > outcomeCount(leader) || (leader < 0 && wins[i] == draws)) {
+            leader = i;
+        }
+    }
+    return leader;
+}
+
+// Checks if the lower bound of the leader's interval is above the upper bound of every other outcome's interval.
+bool TournamentStatistics::isLeaderSeparated() const {
+    if (gamesPlayed == 0) {
+        return false;
+    }
+
+    int leader = getLeader();
+    double leaderLowerBound = rateInterval(leader).first;
+
+    for (int outcome = -1; outcome < static_cast<int>(wins.size()); outcome++) {
+        if (outcome != leader && rateInterval(outcome).second >= leaderLowerBound) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the Wilson score interval of a proportion. Unlike the usual normal approximation it stays inside [0, 1] and
+// remains meaningful with few trials or with proportions close to 0 or 1, which is the common case in a tournament.
+pair<double, double> TournamentStatistics::wilsonInterval(int successes, int trials, double zScore) {
+    if (trials == 0) {
+        return {0.0, 1.0};
+    }
+
+    double n = trials;
+    double p = successes / n;
+    double z2 = zScore * zScore;
+    double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    double halfWidth = zScore * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+    return {std::max(0.0, center - halfWidth), std::min(1.0, center + halfWidth)};
+}
+
+// Returns the two-sided z-score of a confidence level, found by bisection on the normal distribution function.
+double TournamentStatistics::zScoreFor(double confidence) {
+    double target = (1 + confidence) / 2;
+    double low = 0.0;
+    double high = 10.0;
+    for (int i = 0; i < 100; i++) {
+        double middle = (low + high) / 2;
+        double cumulative = 0.5 * std::erfc(-middle / std::sqrt(2.0));
+        if (cumulative < target) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return (low + high) / 2;
+}
+
+// Returns the two-sided z-score of each of the given number of intervals. By the union bound, the intervals all hold
+// together if each one misses with a probability of (1 - confidence) / numIntervals at most.
+double TournamentStatistics::zScoreFor(double confidence, int numIntervals) {
+    return zScoreFor(1 - (1 - confidence) / numIntervals);
+}
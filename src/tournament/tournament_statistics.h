@@ -0,0 +1,79 @@
+#ifndef COMP_345_PROJECT_TEAM_N12_TOURNAMENT_STATISTICS_H
+#define COMP_345_PROJECT_TEAM_N12_TOURNAMENT_STATISTICS_H
+
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+// Keeps the outcomes of the games played on one map of a tournament (a win for one of the players, or a draw) and
+// estimates the rate of every outcome with a Wilson score interval. It is used by the adaptive tournament to stop
+// playing a map once the leading outcome can no longer be caught at the chosen confidence level.
+//
+// The adaptive tournament looks at the intervals after every game, and stops at the first look where the leader is
+// separated, so intervals at the plain confidence level would stop on a chance lead far more often than the level
+// says. The error rate is split evenly (a Bonferroni correction) over every look and every outcome: the intervals all
+// hold together at every look, and a map is wrongly decided with a probability of 1 - confidence at most.
+class TournamentStatistics {
+private:
+    // The number of games won by each player of the tournament, in the order the players were given.
+    vector<int> wins;
+
+    // The number of games ending in a draw.
+    int draws;
+
+    // The number of games recorded so far.
+    int gamesPlayed;
+
+    // The confidence level of the intervals (e.g. 0.95) and the two-sided z-score of each interval at each look.
+    double confidence;
+    double zScore;
+
+    // Returns the number of games with the given outcome (a player index, or -1 for a draw).
+    [[nodiscard]] int outcomeCount(int outcome) const;
+
+public:
+    // Constructor which takes the number of players of the tournament, the confidence level of the intervals and the
+    // most games that can be played on the map, which is the number of looks at the intervals.
+    TournamentStatistics(int numPlayers, double confidence, int maxGames);
+
+    // Records a game won by the player at the given index.
+    void recordWin(int playerIndex);
+
+    // Records a game ending in a draw.
+    void recordDraw();
+
+    // Getter for the number of games recorded so far.
+    [[nodiscard]] int getGamesPlayed() const;
+
+    // Getter for the number of games won by a player.
+    [[nodiscard]] int getWins(int playerIndex) const;
+
+    // Getter for the number of draws.
+    [[nodiscard]] int getDraws() const;
+
+    // Getter for the confidence level.
+    [[nodiscard]] double getConfidence() const;
+
+    // Returns the interval of the win rate of a player, or of the draw rate for index -1.
+    [[nodiscard]] pair<double, double> rateInterval(int outcome) const;
+
+    // Returns the most frequent outcome so far (a player index, or -1 when draws are the most frequent outcome).
+    [[nodiscard]] int getLeader() const;
+
+    // Checks if the lower bound of the leader's interval is above the upper bound of every other outcome's interval.
+    [[nodiscard]] bool isLeaderSeparated() const;
+
+    // Returns the Wilson score interval of a proportion, for the given number of successes, trials and z-score.
+    static pair<double, double> wilsonInterval(int successes, int trials, double zScore);
+
+    // Returns the two-sided z-score of a confidence level (e.g. 1.96 for 0.95).
+    static double zScoreFor(double confidence);
+
+    // Returns the two-sided z-score of each of the given number of intervals, so that they all hold together at the
+    // given confidence level (e.g. 2.24 for 0.95 and 2 intervals).
+    static double zScoreFor(double confidence, int numIntervals);
+};
+
+#endif //COMP_345_PROJECT_TEAM_N12_TOURNAMENT_STATISTICS_H